@@ -75,7 +75,7 @@ namespace gz
       /// is filled.
       /// \param[out] _heights Vector containing the terrain heights.
       private: template <typename T>
-      void FillHeights(T *_data, int _imgHeight, int _imgWidth,
+      void FillHeights(const T *_data, int _imgHeight, int _imgWidth,
         unsigned int _pitch, int _subSampling, unsigned int _vertSize,
         const gz::math::Vector3d &_size,
         const gz::math::Vector3d &_scale,
@@ -52,14 +52,17 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
 
   GZ_ASSERT(imgWidth == imgHeight, "Heightmap image must be square");
 
+  // Read the pixels in place
+  const common::Image::PixelView view = this->img.View();
+
   // Bytes per row
-  unsigned int pitch = this->img.Pitch();
+  unsigned int pitch = static_cast<unsigned int>(view.Pitch());
 
   // Get the image format so we can arrange our heightmap
   // Currently supported: 8-bit and 16-bit.
-  auto imgFormat = this->img.PixelFormat();
+  auto imgFormat = view.Format();
 
-  auto data = this->img.Data();
+  const unsigned char *data = view.Data();
 
   if (imgFormat == common::Image::PixelFormatType::L_INT8 ||
     imgFormat == common::Image::PixelFormatType::RGB_INT8 ||
@@ -72,7 +75,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     imgFormat == common::Image::PixelFormatType::BGR_INT8 ||
     imgFormat == common::Image::PixelFormatType::BGRA_INT8)
   {
-    this->FillHeights<unsigned char>(&data[0], imgHeight, imgWidth, pitch,
+    this->FillHeights<unsigned char>(data, imgHeight, imgWidth, pitch,
         _subSampling, _vertSize, _size, _scale, _flipY, _heights);
   }
   else if (imgFormat == common::Image::PixelFormatType::BGR_INT16 ||
@@ -81,7 +84,7 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     imgFormat == common::Image::PixelFormatType::RGB_INT16 ||
     imgFormat == common::Image::PixelFormatType::R_FLOAT16)
   {
-    uint16_t *dataShort = reinterpret_cast<uint16_t *>(&data[0]);
+    const uint16_t *dataShort = reinterpret_cast<const uint16_t *>(data);
     this->FillHeights<uint16_t>(dataShort, imgHeight, imgWidth, pitch,
         _subSampling, _vertSize, _size, _scale, _flipY, _heights);
   }
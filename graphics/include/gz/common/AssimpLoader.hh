@@ -17,8 +17,12 @@
 #ifndef GZ_COMMON_ASSIMPLOADER_HH_
 #define GZ_COMMON_ASSIMPLOADER_HH_
 
+#include <chrono>
 #include <string>
+#include <utility>
+#include <vector>
 #include <gz/common/graphics/Export.hh>
+#include <gz/common/AssimpPostProcess.hh>
 #include <gz/common/MeshLoader.hh>
 
 #include <gz/utils/ImplPtr.hh>
@@ -42,6 +46,51 @@ namespace gz
       /// \return Pointer to a new Mesh
       public: virtual Mesh *Load(const std::string &_filename) override;
 
+      /// \brief Set whether textures are decoded into images. Consumers
+      /// that only need the geometry, such as physics and collision
+      /// checking, skip the cost of decoding by disabling it. Materials
+      /// then hold the names of their textures, without image data.
+      /// \param[in] _enabled True to decode textures, which is the default
+      public: void SetTextureDecoding(bool _enabled);
+
+      /// \brief Get whether textures are decoded into images
+      /// \return True if textures are decoded
+      /// \sa SetTextureDecoding
+      public: bool TextureDecoding() const;
+
+      /// \brief Set the post-processing passes run on loaded scenes
+      /// \param[in] _profile Set of passes, DEFAULT unless changed
+      public: void SetPostProcessProfile(AssimpPostProcess _profile);
+
+      /// \brief Get the post-processing passes run on loaded scenes
+      /// \return Set of passes
+      /// \sa SetPostProcessProfile
+      public: AssimpPostProcess PostProcessProfile() const;
+
+      /// \brief Set whether the post-processing passes are timed one by
+      /// one. By default the file is read with all the passes of the
+      /// profile at once. When timed, the file is read first and the passes
+      /// are applied one at a time, in the order assimp runs them together.
+      /// Use it to tune profiles for asset classes: passes that depend on
+      /// each other through the scene flags may give slightly different
+      /// scenes when applied separately.
+      /// \param[in] _enabled True to time each pass, false by default
+      /// \sa PostProcessTimes
+      public: void SetPostProcessTiming(bool _enabled);
+
+      /// \brief Get whether the post-processing passes are timed one by one
+      /// \return True if each pass is timed
+      /// \sa SetPostProcessTiming
+      public: bool PostProcessTiming() const;
+
+      /// \brief Get how long each step of the last Load took in assimp.
+      /// The first step is "Import", which reads the file, and includes all
+      /// the post-processing passes unless they are timed. When they are,
+      /// it is followed by every pass of the profile, in the order they ran.
+      /// \return Name and duration of every step
+      public: std::vector<std::pair<std::string,
+              std::chrono::steady_clock::duration>> PostProcessTimes() const;
+
       /// \internal
       /// \brief Pointer to private data.
       GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
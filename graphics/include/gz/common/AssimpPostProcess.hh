@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_ASSIMPPOSTPROCESS_HH_
+#define GZ_COMMON_ASSIMPPOSTPROCESS_HH_
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Sets of assimp post-processing passes run on loaded scenes
+    enum class AssimpPostProcess
+    {
+      /// \brief Only the passes the conversion needs: flipping texture
+      /// coordinates, triangulation, generating missing normals and
+      /// populating armatures. Suited to assets that were already cleaned.
+      FAST,
+
+      /// \brief The fast passes, plus joining identical vertices, removing
+      /// degenerate faces and redundant materials and sorting primitives
+      /// by type
+      DEFAULT,
+
+      /// \brief The default passes, plus merging instanced and small meshes,
+      /// splitting large meshes and reordering vertices for the post
+      /// transform cache. Meshes may be merged, so the submeshes can differ
+      /// from the default profile.
+      OPTIMIZE
+    };
+  }
+}
+#endif
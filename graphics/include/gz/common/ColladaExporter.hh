@@ -107,6 +107,18 @@ namespace gz
           const std::vector<math::Matrix4d> &_submeshToMatrix,
           const std::vector<ColladaLight> &_lights);
 
+      /// \brief Write the geometries straight to the file instead of
+      /// building them in an XML document first. The file is the same, but
+      /// large meshes are exported with a fraction of the memory.
+      /// Disabled by default.
+      /// \param[in] _streaming True to stream the geometries
+      public: void SetStreaming(bool _streaming);
+
+      /// \brief Get whether geometries are written straight to the file
+      /// \return True if the geometries are streamed
+      /// \sa SetStreaming
+      public: bool Streaming() const;
+
       /// \brief Pointer to private data.
       GZ_UTILS_IMPL_PTR(dataPtr)
     };
@@ -51,6 +51,21 @@ namespace gz
       /// returns whatever geometry could be recovered.
       public: virtual Mesh *Load(const std::string &_filename);
 
+      /// \brief Set whether the geometries of a scene are loaded in
+      /// parallel. The nodes are visited first, then the geometries they
+      /// instance are loaded on a worker pool and added to the mesh in the
+      /// order of the nodes, so the mesh is the same as with a serial load.
+      /// Documents with controllers are always loaded serially. Disabled
+      /// by default.
+      /// \param[in] _parallel True to load geometries in parallel
+      public: void SetParallelGeometry(bool _parallel);
+
+      /// \brief Get whether the geometries of a scene are loaded in
+      /// parallel
+      /// \return True if geometries are loaded in parallel
+      /// \sa SetParallelGeometry
+      public: bool ParallelGeometry() const;
+
       /// \internal
       /// \brief Pointer to private data.
       GZ_UTILS_IMPL_PTR(dataPtr)
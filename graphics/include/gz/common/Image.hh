@@ -17,11 +17,13 @@
 #ifndef GZ_COMMON_IMAGE_HH_
 #define GZ_COMMON_IMAGE_HH_
 
+#include <cstddef>
 #include <cstring>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <gz/math/Color.hh>
 
@@ -108,6 +110,168 @@ namespace gz
                 COMPRESSED_JPEG
               };
 
+      /// \brief View of the pixels of an image, which accesses the bitmap in
+      /// place instead of copying it like Data(). Rows are in memory order,
+      /// the first row is the top of the image, while Pixel() counts rows
+      /// from the bottom. A view is invalidated when the image is loaded, set
+      /// from data or rescaled.
+      /// \tparam ByteT const unsigned char for a read only view, unsigned
+      /// char for a writable view
+      /// \sa View, MutableView
+      public: template <typename ByteT>
+      class PixelViewT
+      {
+        /// \brief Constructor. Creates an empty view.
+        public: PixelViewT() = default;
+
+        /// \brief Constructor.
+        /// \param[in] _data Pointer to the first byte of the top row.
+        /// \param[in] _width Width in pixels.
+        /// \param[in] _height Height in pixels.
+        /// \param[in] _pitch Distance between rows in bytes.
+        /// \param[in] _channels Number of channels of a pixel.
+        /// \param[in] _channelStride Size of a channel in bytes.
+        /// \param[in] _format Pixel format.
+        public: PixelViewT(ByteT *_data, unsigned int _width,
+                    unsigned int _height, std::size_t _pitch,
+                    unsigned int _channels, unsigned int _channelStride,
+                    PixelFormatType _format)
+                : data(_data), width(_width), height(_height), pitch(_pitch),
+                  channels(_channels), channelStride(_channelStride),
+                  format(_format)
+        {
+        }
+
+        /// \brief Constructor. Makes a read only view of a writable view.
+        /// \param[in] _other View to convert.
+        public: template <typename OtherT, typename = std::enable_if_t<
+                    std::is_convertible_v<OtherT *, ByteT *>>>
+                PixelViewT(const PixelViewT<OtherT> &_other)
+                : PixelViewT(_other.Data(), _other.Width(), _other.Height(),
+                    _other.Pitch(), _other.Channels(),
+                    _other.ChannelStride(), _other.Format())
+        {
+        }
+
+        /// \brief Check if the view has pixels.
+        /// \return False for the view of an invalid image.
+        public: bool Valid() const
+        {
+          return this->data != nullptr;
+        }
+
+        /// \brief Get the bitmap.
+        /// \return Pointer to the first byte of the top row.
+        public: ByteT *Data() const
+        {
+          return this->data;
+        }
+
+        /// \brief Get the width.
+        /// \return Width in pixels.
+        public: unsigned int Width() const
+        {
+          return this->width;
+        }
+
+        /// \brief Get the height.
+        /// \return Height in pixels.
+        public: unsigned int Height() const
+        {
+          return this->height;
+        }
+
+        /// \brief Get the distance between the starts of two rows.
+        /// \return Pitch in bytes.
+        public: std::size_t Pitch() const
+        {
+          return this->pitch;
+        }
+
+        /// \brief Get the number of channels of a pixel.
+        /// \return Number of channels, from 1 to 4.
+        public: unsigned int Channels() const
+        {
+          return this->channels;
+        }
+
+        /// \brief Get the size of a channel, which is the distance between
+        /// two channels of a pixel.
+        /// \return 1 for 8 bit, 2 for 16 bit or 4 for float channels.
+        public: unsigned int ChannelStride() const
+        {
+          return this->channelStride;
+        }
+
+        /// \brief Get the distance between two pixels of a row.
+        /// \return Size of a pixel in bytes.
+        public: std::size_t PixelStride() const
+        {
+          return static_cast<std::size_t>(this->channels) *
+              this->channelStride;
+        }
+
+        /// \brief Get the pixel format.
+        /// \return Format of the pixels, as given by Image::PixelFormat.
+        public: PixelFormatType Format() const
+        {
+          return this->format;
+        }
+
+        /// \brief Get the size of the bitmap.
+        /// \return Size of all the rows in bytes.
+        public: std::size_t ByteSize() const
+        {
+          return this->pitch * this->height;
+        }
+
+        /// \brief Get a row. The caller must ensure _y is lower than
+        /// Height().
+        /// \param[in] _y Row, 0 being the top of the image.
+        /// \return Pointer to the first byte of the row.
+        public: ByteT *Row(unsigned int _y) const
+        {
+          return this->data + _y * this->pitch;
+        }
+
+        /// \brief Get a pixel. The caller must ensure the coordinates are
+        /// within the image.
+        /// \param[in] _x Column.
+        /// \param[in] _y Row, 0 being the top of the image.
+        /// \return Pointer to the first channel of the pixel.
+        public: ByteT *PixelData(unsigned int _x, unsigned int _y) const
+        {
+          return this->Row(_y) + _x * this->PixelStride();
+        }
+
+        /// \brief Pointer to the first byte of the top row
+        private: ByteT *data = nullptr;
+
+        /// \brief Width in pixels
+        private: unsigned int width = 0u;
+
+        /// \brief Height in pixels
+        private: unsigned int height = 0u;
+
+        /// \brief Distance between rows in bytes
+        private: std::size_t pitch = 0u;
+
+        /// \brief Number of channels of a pixel
+        private: unsigned int channels = 0u;
+
+        /// \brief Size of a channel in bytes
+        private: unsigned int channelStride = 0u;
+
+        /// \brief Pixel format
+        private: PixelFormatType format = UNKNOWN_PIXEL_FORMAT;
+      };
+
+      /// \brief Read only view of the pixels of an image
+      public: using PixelView = PixelViewT<const unsigned char>;
+
+      /// \brief Writable view of the pixels of an image
+      public: using MutablePixelView = PixelViewT<unsigned char>;
+
 
       /// \brief Convert a string to a Image::PixelFormat.
       /// \param[in] _format Pixel format string. \sa Image::PixelFormatNames
@@ -200,6 +364,14 @@ namespace gz
       /// \return The image RGBA data
       public: std::vector<unsigned char> RGBAData() const;
 
+      /// \brief Get a read only view of the pixels, without copying them.
+      /// \return The view, empty if the image is not valid
+      public: PixelView View() const;
+
+      /// \brief Get a writable view of the pixels, to process them in place.
+      /// \return The view, empty if the image is not valid
+      public: MutablePixelView MutableView();
+
       /// \brief Get the width
       /// \return The image width
       public: unsigned int Width() const;
@@ -235,10 +407,51 @@ namespace gz
       /// \return The average color
       public: math::Color AvgColor() const;
 
-      /// \brief Get the max color
+      /// \brief Get the average color of a subset of the pixels, to preview
+      /// large images. Only the pixels whose coordinates, as given to
+      /// Pixel(), are multiples of _stride are read.
+      /// \param[in] _stride Distance between two read pixels, 1 to read all
+      /// of them
+      /// \return The average color of the read pixels
+      public: math::Color AvgColor(unsigned int _stride) const;
+
+      /// \brief Get the max color, which is the first pixel, in the order
+      /// of Pixel() coordinates, with the highest sum of red, green and
+      /// blue. Black images have a max color of 0.
       /// \return The max color
       public: math::Color MaxColor() const;
 
+      /// \brief Get the max color of a subset of the pixels.
+      /// \sa AvgColor(unsigned int)
+      /// \param[in] _stride Distance between two read pixels, 1 to read all
+      /// of them
+      /// \return The max color of the read pixels
+      public: math::Color MaxColor(unsigned int _stride) const;
+
+      /// \brief Get the min color, which is the first pixel, in the order
+      /// of Pixel() coordinates, with the lowest sum of red, green and blue.
+      /// \sa AvgColor(unsigned int)
+      /// \param[in] _stride Distance between two read pixels, 1 to read all
+      /// of them
+      /// \return The min color of the read pixels
+      public: math::Color MinColor(unsigned int _stride = 1) const;
+
+      /// \brief Count the values of a channel in bins that split [0, 1]
+      /// evenly. Values are scaled like Pixel() does, but integer values
+      /// are binned exactly: a value v of a channel of n bits goes in the
+      /// bin v * _bins / 2^n, so that 256 bins of an 8 bit image count every
+      /// value separately. Float values are clamped to [0, 1]. Gray is red,
+      /// green and blue, and images without alpha are opaque.
+      /// \sa AvgColor(unsigned int)
+      /// \param[in] _channel Channel to count
+      /// \param[in] _bins Number of bins
+      /// \param[in] _stride Distance between two read pixels, 1 to read all
+      /// of them
+      /// \return Number of read pixels in every bin, empty if the image is
+      /// not valid or _bins is 0
+      public: std::vector<std::size_t> Histogram(Channel _channel,
+                  unsigned int _bins = 256, unsigned int _stride = 1) const;
+
       /// \brief Rescale the image
       /// \param[in] _width New image width
       /// \param[in] _height New image height
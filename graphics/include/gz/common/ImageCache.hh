@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_IMAGECACHE_HH_
+#define GZ_COMMON_IMAGECACHE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gz/common/Image.hh>
+#include <gz/common/graphics/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class ImageCache ImageCache.hh gz/common/ImageCache.hh
+    /// \brief Decodes image files once and shares the images between all the
+    /// users of the same file. Images are indexed by the resolved path of the
+    /// file and the requested pixel format. A file that changed on disk since
+    /// it was decoded is decoded again.
+    class GZ_COMMON_GRAPHICS_VISIBLE ImageCache
+    {
+      /// \brief Load counters and resident memory
+      public: class Statistics
+      {
+        /// \brief Number of loads that found the image already decoded, or
+        /// being decoded by another thread
+        public: uint64_t hits = 0u;
+
+        /// \brief Number of loads that decoded the file, including failed
+        /// loads
+        public: uint64_t misses = 0u;
+
+        /// \brief Number of images removed to stay within the memory budget
+        public: uint64_t evictions = 0u;
+
+        /// \brief Number of images in the cache
+        public: std::size_t residentCount = 0u;
+
+        /// \brief Memory used by the pixels of the images in the cache
+        public: std::size_t residentBytes = 0u;
+      };
+
+      /// \brief Default memory budget of the images in bytes. Images
+      /// that nothing else holds are only kept within this budget, so
+      /// textures of removed meshes do not stay in memory for the life of
+      /// the process.
+      public: static constexpr std::size_t DefaultMemoryBudget =
+                  256u * 1024u * 1024u;
+
+      /// \brief Constructor. Most users share the cache returned by
+      /// Instance.
+      public: ImageCache();
+
+      /// \brief Get the cache shared by the whole process
+      /// \return The cache
+      public: static ImageCache *Instance();
+
+      /// \brief Load an image, or get the image decoded by an earlier load
+      /// of the same file with the same format. The file is searched like in
+      /// Image::Load. Different files can be loaded from several threads at
+      /// the same time, threads that load a file which is being decoded wait
+      /// for its image.
+      /// \param[in] _filename Path of the image file
+      /// \param[in] _format Pixel format to decode to, as in Image::Load.
+      /// std::nullopt keeps the format of the file.
+      /// \return The image, nullptr if the file could not be decoded
+      public: std::shared_ptr<const Image> Load(const std::string &_filename,
+                  std::optional<Image::PixelFormatType> _format =
+                      std::nullopt);
+
+      /// \brief Set the memory budget of the images. While their memory use
+      /// is over the budget, the least recently loaded images that are only
+      /// held by the cache are removed. A removed image is decoded again on
+      /// the next Load.
+      /// \param[in] _bytes Budget in bytes, DefaultMemoryBudget by
+      /// default. 0 disables eviction.
+      public: void SetMemoryBudget(std::size_t _bytes);
+
+      /// \brief Get the memory budget of the images
+      /// \return Budget in bytes, 0 if eviction is disabled
+      /// \sa SetMemoryBudget
+      public: std::size_t MemoryBudget() const;
+
+      /// \brief Get the counters of the cache
+      /// \return Load hits, misses, evictions and resident memory
+      public: Statistics Stats() const;
+
+      /// \brief Remove all the images from the cache. Images that are still
+      /// held elsewhere stay valid, but are decoded again on the next Load.
+      public: void Clear();
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
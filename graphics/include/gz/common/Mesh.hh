@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include <gz/math/Matrix4.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Vector2.hh>
 
@@ -189,6 +190,11 @@ namespace gz
       /// \param[in] _vec Amount to translate vertices.
       public: void Translate(const gz::math::Vector3d &_vec);
 
+      /// \brief Apply an affine transform to all submeshes.
+      /// \param[in] _transform Affine transform.
+      /// \sa SubMesh::Transform
+      public: void Transform(const gz::math::Matrix4d &_transform);
+
       /// \brief Compute the volume of this mesh. The primitive type
       /// must be TRIANGLES.
       ///
@@ -212,6 +218,11 @@ namespace gz
       /// no triangulated submeshes.
       public: gz::math::Vector3d Centroid() const;
 
+      /// \brief Get the memory used by the mesh.
+      /// \return Sum of SubMesh::MemorySize, plus the size of the texture
+      /// images held by the materials, in bytes.
+      public: std::size_t MemorySize() const;
+
       /// \brief Private data pointer.
       GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
     };
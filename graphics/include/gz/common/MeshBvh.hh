@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_MESHBVH_HH_
+#define GZ_COMMON_MESHBVH_HH_
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/common/graphics/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief forward declaration
+    class Mesh;
+    class SubMesh;
+
+    /// \class MeshBvh MeshBvh.hh gz/common/MeshBvh.hh
+    /// \brief Bounding volume hierarchy over the triangles of a submesh or
+    /// a mesh, used to accelerate ray casts, closest point and box overlap
+    /// queries.
+    ///
+    /// The hierarchy is built with a binned surface area heuristic and
+    /// stored as a flat array of nodes, with the two children of a node
+    /// next to each other. The triangle vertices are copied in leaf order,
+    /// so the hierarchy stays valid if the source mesh is modified or
+    /// destroyed, but it needs to be rebuilt to reflect those changes.
+    /// Only TRIANGLES submeshes are included.
+    class GZ_COMMON_GRAPHICS_VISIBLE MeshBvh
+    {
+      /// \brief Identifies a triangle of the source mesh.
+      public: struct TriangleId
+      {
+        /// \brief Index of the submesh in the source mesh. Always 0 when
+        /// the hierarchy is built from a single submesh.
+        unsigned int subMesh = 0u;
+
+        /// \brief Index of the triangle in the submesh. Its vertex indices
+        /// start at index 3 * triangle of the submesh.
+        unsigned int triangle = 0u;
+      };
+
+      /// \brief Result of a ray cast.
+      public: struct RayHit
+      {
+        /// \brief Triangle that was hit.
+        TriangleId id;
+
+        /// \brief Distance from the ray origin to the hit point.
+        double distance = 0.0;
+
+        /// \brief Hit point.
+        gz::math::Vector3d point;
+
+        /// \brief Unit geometric normal of the triangle, following its
+        /// winding order.
+        gz::math::Vector3d normal;
+      };
+
+      /// \brief Result of a closest point query.
+      public: struct PointHit
+      {
+        /// \brief Triangle that contains the closest point.
+        TriangleId id;
+
+        /// \brief Distance from the query point to the closest point.
+        double distance = 0.0;
+
+        /// \brief Closest point on the mesh.
+        gz::math::Vector3d point;
+      };
+
+      /// \brief Constructor. Creates an empty hierarchy.
+      public: MeshBvh();
+
+      /// \brief Build the hierarchy from the triangles of a submesh,
+      /// replacing any previous content.
+      /// \param[in] _subMesh Submesh to build from.
+      /// \param[in] _parallel True to build the lower levels of the
+      /// hierarchy on a pool of worker threads. Only large meshes are built
+      /// in parallel, and queries return the same results in both cases.
+      /// \return True on success, false if the submesh is not made of
+      /// triangles or has invalid indices.
+      public: bool Build(const SubMesh &_subMesh, bool _parallel = false);
+
+      /// \brief Build the hierarchy from the triangles of all the TRIANGLES
+      /// submeshes of a mesh, replacing any previous content. Submeshes
+      /// with invalid indices are skipped.
+      /// \param[in] _mesh Mesh to build from.
+      /// \param[in] _parallel True to build the lower levels of the
+      /// hierarchy on a pool of worker threads.
+      /// \return True if at least one submesh was added.
+      public: bool Build(const Mesh &_mesh, bool _parallel = false);
+
+      /// \brief Remove all the triangles and nodes.
+      public: void Clear();
+
+      /// \brief Get the number of triangles in the hierarchy.
+      /// \return Number of triangles.
+      public: unsigned int TriangleCount() const;
+
+      /// \brief Get the number of nodes in the hierarchy.
+      /// \return Number of nodes, 0 if the hierarchy is empty.
+      public: unsigned int NodeCount() const;
+
+      /// \brief Get the bounds of all the triangles.
+      /// \return Bounding box of the hierarchy. An empty box if the
+      /// hierarchy is empty.
+      public: gz::math::AxisAlignedBox Bounds() const;
+
+      /// \brief Find the closest triangle hit by a ray.
+      /// \param[in] _origin Ray origin.
+      /// \param[in] _direction Ray direction, does not need to be
+      /// normalized.
+      /// \param[in] _maxDistance Maximum distance from the origin.
+      /// \return The closest hit, or std::nullopt if the ray does not hit
+      /// any triangle within _maxDistance.
+      public: std::optional<RayHit> Raycast(
+                  const gz::math::Vector3d &_origin,
+                  const gz::math::Vector3d &_direction,
+                  double _maxDistance =
+                    std::numeric_limits<double>::infinity()) const;
+
+      /// \brief Find the closest point on the triangles to a point.
+      /// \param[in] _point Query point.
+      /// \param[in] _maxDistance Maximum distance from the query point.
+      /// \return The closest point, or std::nullopt if no triangle is
+      /// within _maxDistance.
+      public: std::optional<PointHit> ClosestPoint(
+                  const gz::math::Vector3d &_point,
+                  double _maxDistance =
+                    std::numeric_limits<double>::infinity()) const;
+
+      /// \brief Find all the triangles that intersect a box.
+      /// \param[in] _box Query box.
+      /// \return Triangles that intersect or are contained in the box, in
+      /// no particular order.
+      public: std::vector<TriangleId> Overlap(
+                  const gz::math::AxisAlignedBox &_box) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
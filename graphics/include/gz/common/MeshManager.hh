@@ -17,6 +17,11 @@
 #ifndef GZ_COMMON_MESHMANAGER_HH_
 #define GZ_COMMON_MESHMANAGER_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
 #include <map>
 #include <utility>
 #include <string>
@@ -33,6 +38,7 @@
 #include <gz/utils/ImplPtr.hh>
 
 #include <gz/common/graphics/Types.hh>
+#include <gz/common/AssimpPostProcess.hh>
 #include <gz/common/SingletonT.hh>
 #include <gz/common/graphics/Export.hh>
 
@@ -42,6 +48,7 @@ namespace gz
   {
     /// \brief forward declaration
     class Mesh;
+    class QuantizedMesh;
     class SubMesh;
 
     /// \class MeshManager MeshManager.hh gz/common/MeshManager.hh
@@ -69,14 +76,196 @@ namespace gz
       /// \brief Load a mesh from a file.
       /// The mesh will be searched on the global SystemPaths instance provided
       /// by Util.hh.
+      /// Different meshes can be loaded from several threads at the same
+      /// time. If the mesh is already being loaded by another thread, this
+      /// waits for that load and returns its result.
+      /// The returned pointer does not keep the mesh alive; if a memory
+      /// budget is set, use LoadShared instead.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
+      /// \sa SetMemoryBudget
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load a mesh from a file, like Load, and get a shared handle
+      /// to it. The mesh is not evicted while a handle to it is held, and
+      /// stays valid after it is removed from the manager.
+      /// \param[in] _filename the path to the mesh
+      /// \return Handle to the mesh, null if it fails to load
+      /// \sa Load
+      public: std::shared_ptr<const Mesh> LoadShared(
+                  const std::string &_filename);
+
+      /// \brief Load a mesh from a file in a worker thread. Called from a
+      /// worker thread, the mesh is loaded before the function returns.
+      /// \param[in] _filename the path to the mesh
+      /// \return Future holding the value Load returns for _filename
+      /// \sa Load
+      public: std::future<const Mesh *> LoadAsync(
+                  const std::string &_filename);
+
+      /// \brief Load meshes from several files in parallel, on a pool of
+      /// worker threads shared with the loaders. Blocks until all the
+      /// meshes are loaded. Called from a worker thread, the meshes are
+      /// loaded one after the other on that thread.
+      /// \param[in] _filenames Paths to the meshes
+      /// \return Pointer to each mesh, in the same order as _filenames.
+      /// A pointer is null if its mesh fails to load.
+      /// \sa Load
+      public: std::vector<const Mesh *> LoadBatch(
+                  const std::vector<std::string> &_filenames);
+
+      /// \brief Create meshes in parallel, on the pool of worker threads
+      /// used by LoadBatch. Blocks until all the meshes are created. Like
+      /// LoadBatch, it can be nested, in which case the functions run one
+      /// after the other on the calling worker thread. Each function calls
+      /// Create functions of this manager, for example:
+      /// \code
+      /// mgr->CreateBatch({
+      ///     [mgr]() { mgr->CreateSphere("ball", 0.5f, 32, 32); },
+      ///     [mgr]() { mgr->CreateBox("crate", {1, 1, 1}, {1, 1}); }});
+      /// \endcode
+      /// \param[in] _creators Functions that create meshes
+      /// \sa CreateSphere
+      public: void CreateBatch(
+                  const std::vector<std::function<void()>> &_creators);
+
+      /// \brief Set a directory where loaded meshes are stored in a binary
+      /// format. Later loads of an unchanged file, including loads by other
+      /// processes sharing the directory, read the stored mesh instead of
+      /// parsing the file again. Meshes loaded by assimp, with each set of
+      /// post-processing passes, and by the native loaders are stored
+      /// separately. Once the directory grows over the size limit, the
+      /// least recently used meshes are removed from it.
+      /// \param[in] _path Directory, created if needed. An empty path
+      /// disables the cache, which is the default.
+      /// \param[in] _maxSize Size limit of the directory in bytes
+      public: void SetCacheDirectory(const std::string &_path,
+                  std::uintmax_t _maxSize = 1024u * 1024u * 1024u);
+
+      /// \brief Get the directory where loaded meshes are stored
+      /// \return The directory, empty if the cache is disabled
+      /// \sa SetCacheDirectory
+      public: std::string CacheDirectory() const;
+
+      /// \brief Counters of the meshes loaded from files
+      public: class Statistics
+      {
+        /// \brief Number of loads that found the mesh already loaded, or
+        /// being loaded by another thread
+        public: uint64_t hits = 0u;
+
+        /// \brief Number of loads that read the mesh from its file or from
+        /// the cache directory, including failed loads
+        public: uint64_t misses = 0u;
+
+        /// \brief Number of meshes removed to stay within the memory budget
+        public: uint64_t evictions = 0u;
+
+        /// \brief Number of misses that share the mesh of a file with the
+        /// same contents
+        /// \sa SetContentDeduplication
+        public: uint64_t deduplicated = 0u;
+
+        /// \brief Number of meshes loaded from files that are in memory
+        public: std::size_t residentCount = 0u;
+
+        /// \brief Memory used by the meshes loaded from files, as given by
+        /// Mesh::MemorySize
+        public: std::size_t residentBytes = 0u;
+      };
+
+      /// \brief Set the memory budget of the meshes loaded from files.
+      /// While their memory use is over the budget, the least recently
+      /// loaded meshes that no handle from LoadShared refers to are
+      /// removed. A removed mesh is loaded again on the next Load. Meshes
+      /// created by the Create functions are never removed.
+      ///
+      /// Pointers returned by Load, LoadBatch and MeshByName are invalid
+      /// once their mesh is removed, so hold a handle from LoadShared for as
+      /// long as a mesh is used when a budget is set.
+      /// \param[in] _bytes Budget in bytes. 0, the default, disables
+      /// eviction.
+      public: void SetMemoryBudget(std::size_t _bytes);
+
+      /// \brief Get the memory budget of the meshes loaded from files
+      /// \return Budget in bytes, 0 if eviction is disabled
+      /// \sa SetMemoryBudget
+      public: std::size_t MemoryBudget() const;
+
+      /// \brief Get the counters of the meshes loaded from files
+      /// \return Load hits, misses, evictions and resident memory
+      public: Statistics Stats() const;
+
+      /// \brief Share one mesh between files with identical contents, such
+      /// as copies of a model in different folders, or a file reached
+      /// through symbolic links or different URIs. When enabled, Load
+      /// hashes the contents of each file it has not loaded. A file with the
+      /// same contents as a loaded mesh becomes an alias of that mesh
+      /// instead of being parsed. The shared mesh keeps the name and path
+      /// it was first loaded with. Files in formats that can reference
+      /// materials and textures, which are all the formats but STL, are
+      /// only shared with files in the same directory, or in a directory
+      /// reached through symbolic links, since the textures they reference
+      /// by relative paths can differ between directories.
+      /// \param[in] _enabled True to share meshes. Disabled by default.
+      /// \sa CanonicalName
+      public: void SetContentDeduplication(bool _enabled);
+
+      /// \brief Get whether files with identical contents share one mesh
+      /// \return True if deduplication is enabled
+      /// \sa SetContentDeduplication
+      public: bool ContentDeduplication() const;
+
+      /// \brief Set whether the textures of the meshes loaded from files
+      /// are decoded into images. Processes that only need the geometry,
+      /// such as physics and collision checking, skip the cost of decoding
+      /// by disabling it. The materials of meshes loaded while it is
+      /// disabled hold the names of their textures, without image data,
+      /// and are not stored in the cache directory. These meshes are named
+      /// after the file like the others, but are kept apart from the meshes
+      /// with images, so later loads with decoding enabled load the file
+      /// again instead of getting a mesh without images. Loads with
+      /// decoding disabled get the mesh with images if it is already
+      /// loaded.
+      /// \param[in] _enabled True to decode textures, which is the default
+      /// \sa AssimpLoader::SetTextureDecoding
+      public: void SetTextureDecoding(bool _enabled);
+
+      /// \brief Get whether the textures of loaded meshes are decoded
+      /// \return True if textures are decoded
+      /// \sa SetTextureDecoding
+      public: bool TextureDecoding() const;
+
+      /// \brief Set the assimp post-processing passes run on meshes loaded
+      /// from files with the assimp loader. Meshes loaded with each profile
+      /// are stored apart in the cache directory. They are named after the
+      /// file whatever the profile, but loads with different profiles do
+      /// not share a mesh. When a file is loaded with several settings,
+      /// MeshByName and HasMesh with the file name refer to the mesh loaded
+      /// with the current settings if there is one, and RemoveMesh removes
+      /// all of them.
+      /// \param[in] _profile Set of passes, DEFAULT unless changed
+      /// \sa AssimpLoader::SetPostProcessProfile
+      public: void SetPostProcessProfile(AssimpPostProcess _profile);
+
+      /// \brief Get the assimp post-processing passes run on loaded meshes
+      /// \return Set of passes
+      /// \sa SetPostProcessProfile
+      public: AssimpPostProcess PostProcessProfile() const;
+
+      /// \brief Get the name of the mesh that a name refers to. MeshByName,
+      /// HasMesh and Load accept aliases, while RemoveMesh on an alias only
+      /// removes the alias.
+      /// \param[in] _name Name of a mesh, or of a file loaded as an alias
+      /// \return Name of the shared mesh if _name is an alias, otherwise
+      /// _name
+      public: std::string CanonicalName(const std::string &_name) const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
-      /// \param[in] _extension Exported file's format ("dae" for Collada)
+      /// \param[in] _extension Exported file's format ("dae" for Collada,
+      /// "stl" for binary STL or "obj" for Wavefront OBJ)
       /// \param[in] _exportTextures True to export texture images to
       /// '../materials/textures' folder
       public: void Export(const Mesh *_mesh, const std::string &_filename,
@@ -113,7 +302,9 @@ namespace gz
       /// MeshManager destruction. Use \ref CreateMesh instead
       public: void GZ_DEPRECATED(8) AddMesh(Mesh *_mesh);
 
-      /// \brief Remove a mesh based on a name.
+      /// \brief Remove a mesh based on a name. The meshes loaded from a file
+      /// with different texture decoding or post-processing settings are
+      /// all removed.
       /// \param[in] _name Name of the mesh to remove.
       /// \return True if the mesh was removed, false if the mesh with the
       /// provided name could not be found.
@@ -128,7 +319,15 @@ namespace gz
       public: const gz::common::Mesh *MeshByName(
                   const std::string &_name) const;
 
-      /// \brief Return true if the mesh exists.
+      /// \brief Get a shared handle to a mesh by name.
+      /// \param[in] _name the name of the mesh to look for
+      /// \return Handle to the mesh, null if not found
+      /// \sa LoadShared
+      public: std::shared_ptr<const Mesh> SharedMeshByName(
+                  const std::string &_name) const;
+
+      /// \brief Return true if the mesh exists. Quantized meshes exist,
+      /// although MeshByName returns nullptr for them.
       /// \param[in] _name the name of the mesh
       public: bool HasMesh(const std::string &_name) const;
 
@@ -139,7 +338,75 @@ namespace gz
       /// nullptr if the mesh name is already claimed.
       public: common::Mesh *CreateMesh(const std::string &_name);
 
+      /// \brief Generate a chain of simplified levels of detail (LOD) for a
+      /// mesh registered with the manager, see SimplifyMesh. Any existing
+      /// chain of the mesh is replaced, which deletes its levels: pointers
+      /// returned by MeshLod for levels above 0 become invalid, as they do
+      /// when the mesh is removed. Generation stops early when a level
+      /// cannot be simplified further within _maxError. The mesh is
+      /// simplified without blocking loads and lookups in other threads.
+      /// \param[in] _name Name of the mesh.
+      /// \param[in] _ratios Target triangle count of each level relative to
+      /// the original mesh, from the most to the least detailed level.
+      /// \param[in] _maxError Maximum allowed error of every level, in the
+      /// same units as the mesh vertices.
+      /// \return Number of levels generated, not counting the original mesh.
+      public: unsigned int GenerateLods(const std::string &_name,
+                  const std::vector<double> &_ratios = {0.5, 0.25, 0.125},
+                  double _maxError = std::numeric_limits<double>::infinity());
+
+      /// \brief Get the number of levels of detail of a mesh, including the
+      /// original mesh.
+      /// \param[in] _name Name of the mesh.
+      /// \return Number of levels, or 0 if the mesh does not exist.
+      public: unsigned int LodCount(const std::string &_name) const;
+
+      /// \brief Get a level of detail of a mesh. Level 0 is the original
+      /// mesh, levels are created by GenerateLods.
+      /// \param[in] _name Name of the mesh.
+      /// \param[in] _level Level of detail.
+      /// \return The mesh of the given level, or nullptr if not found.
+      public: const Mesh *MeshLod(const std::string &_name,
+                  unsigned int _level) const;
+
+      /// \brief Replace a mesh with a quantized copy to reduce the memory it
+      /// uses, see QuantizedMesh. The manager releases the full precision
+      /// mesh: as after RemoveMesh, pointers returned by Load and MeshByName
+      /// become invalid, while handles from LoadShared and SharedMeshByName
+      /// keep it alive. MeshByName returns nullptr until the mesh is
+      /// decoded, by DecodeMesh or by loading its file again. The name and
+      /// the aliases of the mesh stay in use, and its levels of detail are
+      /// kept.
+      /// \param[in] _name Name of the mesh.
+      /// \return True if the mesh was quantized, false if it was not found.
+      public: bool QuantizeMesh(const std::string &_name);
+
+      /// \brief Get the quantized copy of a mesh.
+      /// \param[in] _name Name of the mesh.
+      /// \return The quantized mesh, or nullptr if the mesh is not
+      /// quantized.
+      public: const QuantizedMesh *QuantizedMeshByName(
+                  const std::string &_name) const;
+
+      /// \brief Decode a quantized mesh and register it again as a full
+      /// precision mesh. If handles to the mesh it was quantized from are
+      /// still held, that mesh is registered instead of a decoded copy. The
+      /// quantized copy is deleted.
+      /// \param[in] _name Name of the mesh.
+      /// \return The decoded mesh, or nullptr if the mesh is not quantized.
+      public: const Mesh *DecodeMesh(const std::string &_name);
+
+      /// \brief Get the memory saved by quantizing a mesh.
+      /// \param[in] _name Name of the mesh.
+      /// \return Number of bytes saved in the vertex and index buffers of
+      /// the mesh, 0 if the mesh is not quantized.
+      public: std::size_t MeshMemorySaved(const std::string &_name) const;
+
       /// \brief Create a sphere mesh.
+      ///
+      /// The Create functions of primitive shapes can be called from
+      /// several threads, see CreateBatch. An empty name is an error and
+      /// creates no mesh.
       /// \param[in] _name the name of the mesh
       /// \param[in] _radius radius of the sphere in meter
       /// \param[in] _rings number of circles on th y axis
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_COMMON_MESHSIMPLIFICATION_HH_
+#define GZ_COMMON_MESHSIMPLIFICATION_HH_
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include <gz/common/graphics/Export.hh>
+#include <gz/common/SubMesh.hh>
+
+namespace gz::common
+{
+class Mesh;
+
+/// \brief Simplify a triangle submesh using quadric error metrics
+/// (Garland and Heckbert). Edges are collapsed in order of increasing
+/// error until the submesh has no more than _targetTriangleCount
+/// triangles or the next collapse would move the surface by more than
+/// _maxError.
+///
+/// Collapses never move a vertex: the surviving vertex keeps its
+/// position, normal, texture coordinates and node assignments. Open
+/// borders and texture coordinate seams are only simplified along their
+/// own direction, non-manifold vertices are left untouched and
+/// collapses that would flip a triangle are rejected. Vertex copies that
+/// share a position and texture coordinates and whose normals differ by
+/// less than 30 degrees are welded before simplifying, and their normals
+/// are averaged.
+///
+/// Only TRIANGLES submeshes are simplified. Any other primitive type, or
+/// a submesh with invalid indices, is returned unchanged.
+/// \param[in] _subMesh Submesh to simplify.
+/// \param[in] _targetTriangleCount Desired number of triangles.
+/// \param[in] _maxError Maximum allowed error, in the same units as the
+/// vertex positions.
+/// \return The simplified submesh.
+SubMesh GZ_COMMON_GRAPHICS_VISIBLE SimplifySubMesh(
+    const SubMesh &_subMesh, std::size_t _targetTriangleCount,
+    double _maxError = std::numeric_limits<double>::infinity());
+
+/// \brief Simplify every submesh of a mesh with SimplifySubMesh.
+/// The returned mesh shares the materials and skeleton of the input mesh.
+/// \param[in] _mesh Mesh to simplify.
+/// \param[in] _ratio Target triangle count of each submesh relative to
+/// its current triangle count, in the range [0, 1].
+/// \param[in] _maxError Maximum allowed error, in the same units as the
+/// vertex positions.
+/// \return The simplified mesh.
+std::unique_ptr<Mesh> GZ_COMMON_GRAPHICS_VISIBLE SimplifyMesh(
+    const Mesh &_mesh, double _ratio,
+    double _maxError = std::numeric_limits<double>::infinity());
+}  // namespace gz::common
+#endif  // GZ_COMMON_MESHSIMPLIFICATION_HH_
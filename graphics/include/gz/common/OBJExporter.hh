@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_OBJEXPORTER_HH_
+#define GZ_COMMON_OBJEXPORTER_HH_
+
+#include <string>
+
+#include <gz/common/MeshExporter.hh>
+#include <gz/common/graphics/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class OBJExporter OBJExporter.hh gz/common/OBJExporter.hh
+    /// \brief Class used to export Wavefront OBJ mesh files. The mesh is
+    /// written to disk as it is read, so the size of the mesh does not add
+    /// to the memory used.
+    class GZ_COMMON_GRAPHICS_VISIBLE OBJExporter : public MeshExporter
+    {
+      /// \brief Constructor
+      public: OBJExporter();
+
+      /// \brief Destructor
+      public: virtual ~OBJExporter();
+
+      /// \brief Export a mesh to an OBJ file. Each submesh of triangles
+      /// becomes an object, with its positions, normals and first set of
+      /// texture coordinates. Materials are written to an MTL file next to
+      /// the OBJ file.
+      /// \param[in] _mesh Pointer to the mesh to be exported
+      /// \param[in] _filename Exported file's path and name, without the
+      /// ".obj" extension
+      /// \param[in] _exportTextures True to write the files to
+      /// '<_filename>/meshes' and copy texture images to
+      /// '<_filename>/materials/textures', like ColladaExporter
+      public: virtual void Export(const Mesh *_mesh,
+          const std::string &_filename, bool _exportTextures = false);
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -47,6 +47,20 @@ namespace gz
       /// \return Pointer to a new Mesh
       public: virtual Mesh *Load(const std::string &_filename);
 
+      /// \brief Parse files on several threads instead of with
+      /// tinyobjloader. The file is memory mapped and split into ranges of
+      /// lines parsed in parallel. Corners that share the same position,
+      /// texture coordinate and normal indices also share one vertex of the
+      /// submesh, instead of each corner getting its own vertex.
+      /// Disabled by default.
+      /// \param[in] _parallel True to use the parallel parser
+      public: void SetParallelParsing(bool _parallel);
+
+      /// \brief Get whether files are parsed on several threads
+      /// \return True if the parallel parser is used
+      /// \sa SetParallelParsing
+      public: bool ParallelParsing() const;
+
       /// \internal
       /// \brief Private data pointer.
       GZ_UTILS_IMPL_PTR(dataPtr)
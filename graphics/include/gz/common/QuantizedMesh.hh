@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_QUANTIZEDMESH_HH_
+#define GZ_COMMON_QUANTIZEDMESH_HH_
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/common/graphics/Export.hh>
+#include <gz/common/graphics/Types.hh>
+#include <gz/common/SubMesh.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \class QuantizedSubMesh QuantizedMesh.hh gz/common/QuantizedMesh.hh
+    /// \brief Compressed, read only copy of a SubMesh.
+    ///
+    /// Positions are stored as 16-bit normalized integers relative to the
+    /// bounding box of the submesh, normals are octahedral encoded in two
+    /// 16-bit integers and texture coordinates are stored as half floats.
+    /// Indices and node assignments are kept as they are. Values are decoded
+    /// on access, or in bulk to float buffers.
+    ///
+    /// Quantization is lossy: positions are within 1/65535 of the bounding
+    /// box size of the original ones, normals within about 0.01 degrees and
+    /// texture coordinates have 11 significant bits.
+    class GZ_COMMON_GRAPHICS_VISIBLE QuantizedSubMesh
+    {
+      /// \brief Constructor. Creates an empty submesh.
+      public: QuantizedSubMesh();
+
+      /// \brief Constructor. Quantize a submesh.
+      /// \param[in] _subMesh Submesh to quantize.
+      public: explicit QuantizedSubMesh(const SubMesh &_subMesh);
+
+      /// \brief Get the name of the submesh.
+      /// \return The name.
+      public: std::string Name() const;
+
+      /// \brief Get the primitive type.
+      /// \return The primitive type.
+      public: SubMesh::PrimitiveType SubMeshPrimitiveType() const;
+
+      /// \brief Get the material index.
+      /// \return The material index, nullopt if the submesh has none.
+      public: std::optional<unsigned int> GetMaterialIndex() const;
+
+      /// \brief Get the minimum corner of the bounding box used to quantize
+      /// positions.
+      /// \return Min X, Y, Z of the original vertices.
+      public: gz::math::Vector3d Min() const;
+
+      /// \brief Get the maximum corner of the bounding box used to quantize
+      /// positions.
+      /// \return Max X, Y, Z of the original vertices.
+      public: gz::math::Vector3d Max() const;
+
+      /// \brief Get the number of vertices.
+      /// \return The number of vertices.
+      public: unsigned int VertexCount() const;
+
+      /// \brief Decode a vertex.
+      /// \param[in] _index Index of the vertex.
+      /// \return The vertex, or gz::math::Vector3d::Zero if the index is out
+      /// of bounds.
+      public: gz::math::Vector3d Vertex(unsigned int _index) const;
+
+      /// \brief Get the number of normals.
+      /// \return The number of normals.
+      public: unsigned int NormalCount() const;
+
+      /// \brief Decode a normal.
+      /// \param[in] _index Index of the normal.
+      /// \return The unit normal, or gz::math::Vector3d::Zero if the index
+      /// is out of bounds.
+      public: gz::math::Vector3d Normal(unsigned int _index) const;
+
+      /// \brief Get the number of texture coordinate sets.
+      /// \return The number of texture coordinate sets.
+      public: unsigned int TexCoordSetCount() const;
+
+      /// \brief Get the number of texture coordinates of a set.
+      /// \param[in] _setIndex Texture coordinate set index.
+      /// \return The number of texture coordinates, 0 if the set does not
+      /// exist.
+      public: unsigned int TexCoordCountBySet(unsigned int _setIndex) const;
+
+      /// \brief Decode a texture coordinate.
+      /// \param[in] _index Index of the texture coordinate.
+      /// \param[in] _setIndex Texture coordinate set index.
+      /// \return The texture coordinate, or gz::math::Vector2d::Zero if the
+      /// set or the index does not exist.
+      public: gz::math::Vector2d TexCoordBySet(unsigned int _index,
+                  unsigned int _setIndex) const;
+
+      /// \brief Get the number of indices.
+      /// \return The number of indices.
+      public: unsigned int IndexCount() const;
+
+      /// \brief Get a view of the indices, in the same format as the
+      /// original submesh.
+      /// \return View of the indices.
+      public: SubMesh::IndexView Indices() const;
+
+      /// \brief Get the number of vertex to skeleton node assignments.
+      /// \return The number of node assignments.
+      public: unsigned int NodeAssignmentsCount() const;
+
+      /// \brief Get a vertex to skeleton node assignment.
+      /// \param[in] _index Index of the assignment.
+      /// \return The assignment, or a default constructed one if _index is
+      /// out of bounds.
+      public: NodeAssignment NodeAssignmentByIndex(unsigned int _index) const;
+
+      /// \brief Decode all the vertices.
+      /// \return X, Y and Z of every vertex.
+      public: std::vector<float> VertexBuffer() const;
+
+      /// \brief Decode all the normals.
+      /// \return X, Y and Z of every normal.
+      public: std::vector<float> NormalBuffer() const;
+
+      /// \brief Decode all the texture coordinates of a set.
+      /// \param[in] _setIndex Texture coordinate set index.
+      /// \return U and V of every texture coordinate, empty if the set does
+      /// not exist.
+      public: std::vector<float> TexCoordBufferBySet(
+                  unsigned int _setIndex) const;
+
+      /// \brief Decode the whole submesh.
+      /// \return A submesh with the decoded values.
+      public: SubMesh Decode() const;
+
+      /// \brief Get the memory used by the quantized data.
+      /// \return Size of the vertex, index and node assignment buffers in
+      /// bytes.
+      public: std::size_t MemorySize() const;
+
+      /// \brief Get the memory used by the same data in the submesh this
+      /// was created from.
+      /// \return Size of the original vertex, index and node assignment
+      /// buffers in bytes.
+      public: std::size_t SourceMemorySize() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+
+    /// \class QuantizedMesh QuantizedMesh.hh gz/common/QuantizedMesh.hh
+    /// \brief Compressed, read only copy of a Mesh, made of
+    /// QuantizedSubMesh objects. It shares the materials and skeleton of the
+    /// original mesh.
+    class GZ_COMMON_GRAPHICS_VISIBLE QuantizedMesh
+    {
+      /// \brief Constructor. Creates an empty mesh.
+      public: QuantizedMesh();
+
+      /// \brief Constructor. Quantize all the submeshes of a mesh.
+      /// \param[in] _mesh Mesh to quantize.
+      public: explicit QuantizedMesh(const Mesh &_mesh);
+
+      /// \brief Get the name of the mesh.
+      /// \return The name.
+      public: std::string Name() const;
+
+      /// \brief Get the path the mesh was loaded from.
+      /// \return The path.
+      public: std::string Path() const;
+
+      /// \brief Get the number of submeshes.
+      /// \return The number of submeshes.
+      public: unsigned int SubMeshCount() const;
+
+      /// \brief Get a submesh.
+      /// \param[in] _index Index of the submesh.
+      /// \return The submesh, or nullptr if _index is out of bounds.
+      public: const QuantizedSubMesh *SubMeshByIndex(
+                  unsigned int _index) const;
+
+      /// \brief Get the number of materials.
+      /// \return The number of materials.
+      public: unsigned int MaterialCount() const;
+
+      /// \brief Get a material.
+      /// \param[in] _index Index of the material.
+      /// \return The material, or nullptr if _index is out of bounds.
+      public: MaterialPtr MaterialByIndex(unsigned int _index) const;
+
+      /// \brief Get the skeleton.
+      /// \return The skeleton, nullptr if the mesh has none.
+      public: SkeletonPtr MeshSkeleton() const;
+
+      /// \brief Decode the whole mesh.
+      /// \return A mesh with the decoded submeshes, sharing the materials
+      /// and skeleton of this mesh.
+      public: std::unique_ptr<Mesh> Decode() const;
+
+      /// \brief Get the memory used by the quantized submeshes.
+      /// \return Sum of QuantizedSubMesh::MemorySize.
+      public: std::size_t MemorySize() const;
+
+      /// \brief Get the memory used by the submeshes of the original mesh.
+      /// \return Sum of QuantizedSubMesh::SourceMemorySize.
+      public: std::size_t SourceMemorySize() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_STLEXPORTER_HH_
+#define GZ_COMMON_STLEXPORTER_HH_
+
+#include <string>
+
+#include <gz/common/MeshExporter.hh>
+#include <gz/common/graphics/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class STLExporter STLExporter.hh gz/common/STLExporter.hh
+    /// \brief Class used to export binary STL mesh files. The triangles of
+    /// every submesh are written to disk as they are read, so the size of
+    /// the mesh does not add to the memory used.
+    class GZ_COMMON_GRAPHICS_VISIBLE STLExporter : public MeshExporter
+    {
+      /// \brief Constructor
+      public: STLExporter();
+
+      /// \brief Destructor
+      public: virtual ~STLExporter();
+
+      /// \brief Export a mesh to a binary STL file. Only submeshes of
+      /// triangles are exported. Each triangle is written with its face
+      /// normal; materials and texture coordinates are not exported.
+      /// \param[in] _mesh Pointer to the mesh to be exported
+      /// \param[in] _filename Exported file's path and name, without the
+      /// ".stl" extension
+      /// \param[in] _exportTextures Ignored, STL files have no textures
+      public: virtual void Export(const Mesh *_mesh,
+          const std::string &_filename, bool _exportTextures = false);
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -48,21 +48,39 @@ namespace gz
       /// \param[in] _filename the mesh file
       public: virtual Mesh *Load(const std::string &_filename);
 
-      /// \brief Reads an ASCII STL (stereolithography) file.
+      /// \brief Set whether equal vertices are welded. STL files store
+      /// three vertices per triangle, each with the normal of the triangle.
+      /// When enabled, vertices with the same position and normal are
+      /// merged into one and shared through the index buffer, which keeps
+      /// flat shading and saves memory. Disabled by default.
+      /// \param[in] _weld True to weld vertices
+      public: void SetWeldVertices(bool _weld);
+
+      /// \brief Get whether equal vertices are welded
+      /// \return True if vertices are welded
+      /// \sa SetWeldVertices
+      public: bool WeldVertices() const;
+
+      /// \brief Reads an ASCII STL (stereolithography) file, from the
+      /// current position to the end. Load does not use it anymore, it is
+      /// kept for binary compatibility.
       /// \param[in] _filein the file pointer
       /// \param[out] _mesh the mesh where to load the data
       /// \return true if read was successful
       private: bool ReadAscii(FILE *_filein, Mesh *_mesh);
 
-      /// \brief Reads a binary STL (stereolithography) file.
+      /// \brief Reads a binary STL (stereolithography) file, from the
+      /// current position to the end. Load does not use it anymore, it is
+      /// kept for binary compatibility.
       /// \param[in] _filein the file pointer
-      /// \param[out] the mesh where to load the data
+      /// \param[out] _mesh the mesh where to load the data
       /// \return true if read was successful
       private: bool ReadBinary(FILE *_filein, Mesh *_mesh);
 
-      /// \brief Compares two strings for equality, disregarding case.
+      /// \brief Compares two strings for equality, disregarding case and
+      /// trailing blanks. Kept for binary compatibility.
       /// \param[in] _string1 the first string
-      /// \param[in] _string2 the seconf string
+      /// \param[in] _string2 the second string
       /// \return true if the strings are equal (same content)
       private: bool Leqi(char* _string1, char* _string2);
 
@@ -74,21 +92,24 @@ namespace gz
       /// \return The column index of the vector
       private: int RcolFind(float _a[][COR3_MAX], int _m, int _n, float _r[]);
 
-      /// \brief Reads a long int from a binary file.
+      /// \brief Reads a long int from a binary file. Kept for binary
+      /// compatibility.
       /// \param[in] _filein the file pointer
-      /// \return the value
+      /// \return the value, 0 at the end of the file
       private: uint32_t LongIntRead(FILE *_filein);
 
-      /// \brief Reads a short int from a binary file.
+      /// \brief Reads a short int from a binary file. Kept for binary
+      /// compatibility.
       /// \param[in] _filein the file pointer
       /// \param[out] _value the value read
-      /// \return true
+      /// \return false at the end of the file
       private: bool ShortIntRead(FILE *_filein, uint16_t &_value);
 
-      /// \brief Read 1 double precision float from a binary file.
+      /// \brief Read 1 double precision float from a binary file. Kept
+      /// for binary compatibility.
       /// \param[in] _filein the file pointer
-      /// \param[out] the value
-      /// \return true
+      /// \param[out] _value the value
+      /// \return false at the end of the file
       private: bool FloatRead(FILE *_filein, double &_value);
 
       /// \brief Private data pointer.
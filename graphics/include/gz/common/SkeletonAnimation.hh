@@ -64,6 +64,12 @@ namespace gz
       public: NodeAnimation *NodeAnimationByName(const std::string &_name)
           const;
 
+      /// \brief Returns a node animation, in node name order
+      /// \param[in] _index Index of the node animation
+      /// \return NodeAnimation object, nullptr if _index is out of bounds
+      public: NodeAnimation *NodeAnimationByIndex(const unsigned int _index)
+          const;
+
       /// \brief Check all nodes for x displacement
       /// \return True if x displacement found
       public: bool XDisplacement() const;
@@ -99,6 +99,10 @@ namespace gz
       /// \param[in] _trans the transfromation matrix
       public: void SetInitialTransform(const math::Matrix4d &_trans);
 
+      /// \brief Get the initial transformation
+      /// \return The transformation restored by Reset
+      public: math::Matrix4d InitialTransform() const;
+
       /// \brief Reset the transformation to the initial transformation
       /// \param[in] _resetChildren when true, performs the operation for every
       /// node in the tree
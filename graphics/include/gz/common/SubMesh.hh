@@ -17,10 +17,14 @@
 #ifndef GZ_COMMON_SUBMESH_HH_
 #define GZ_COMMON_SUBMESH_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include <gz/math/Matrix4.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Vector2.hh>
 
@@ -61,6 +65,127 @@ namespace gz
                 TRISTRIPS
               };
 
+      /// \brief Storage format of the index buffer
+      public: enum class IndexFormat
+              {
+                /// \brief 16-bit unsigned indices
+                UINT16,
+                /// \brief 32-bit unsigned indices
+                UINT32
+              };
+
+      /// \brief Index value that restarts a primitive. Adding it to a
+      /// LINESTRIPS, TRIFANS or TRISTRIPS submesh ends the current strip or
+      /// fan, and the next indices start a new one. In an IndexView it
+      /// is stored as the largest value of the storage format, 0xFFFF or
+      /// 0xFFFFFFFF, which is what graphics APIs expect.
+      public: static constexpr unsigned int PrimitiveRestartIndex =
+                  std::numeric_limits<unsigned int>::max();
+
+      /// \brief Read only view of the index buffer in its storage format.
+      /// It lets consumers upload indices without converting them. The view
+      /// is invalidated when indices are added or modified.
+      public: class IndexView
+      {
+        /// \brief Constructor. Creates an empty view.
+        public: IndexView() = default;
+
+        /// \brief Constructor.
+        /// \param[in] _format Storage format of _data.
+        /// \param[in] _data Pointer to the first index.
+        /// \param[in] _count Number of indices.
+        public: IndexView(IndexFormat _format, const void *_data,
+                    std::size_t _count)
+                : format(_format), data(_data), count(_count)
+        {
+        }
+
+        /// \brief Get the storage format.
+        /// \return Storage format of the indices.
+        public: IndexFormat Format() const
+        {
+          return this->format;
+        }
+
+        /// \brief Get the raw indices, to be interpreted according to
+        /// Format().
+        /// \return Pointer to the first index.
+        public: const void *Data() const
+        {
+          return this->data;
+        }
+
+        /// \brief Get the 16-bit indices.
+        /// \return Pointer to the first index, or nullptr if the format is
+        /// not UINT16.
+        public: const uint16_t *Data16() const
+        {
+          return this->format == IndexFormat::UINT16 ?
+              static_cast<const uint16_t *>(this->data) : nullptr;
+        }
+
+        /// \brief Get the 32-bit indices.
+        /// \return Pointer to the first index, or nullptr if the format is
+        /// not UINT32.
+        public: const uint32_t *Data32() const
+        {
+          return this->format == IndexFormat::UINT32 ?
+              static_cast<const uint32_t *>(this->data) : nullptr;
+        }
+
+        /// \brief Get the number of indices.
+        /// \return Number of indices.
+        public: std::size_t Count() const
+        {
+          return this->count;
+        }
+
+        /// \brief Get the size of a single index.
+        /// \return 2 for UINT16 or 4 for UINT32.
+        public: std::size_t ElementSize() const
+        {
+          return this->format == IndexFormat::UINT16 ? 2u : 4u;
+        }
+
+        /// \brief Get the size of the index buffer.
+        /// \return Size of all the indices in bytes.
+        public: std::size_t ByteSize() const
+        {
+          return this->count * this->ElementSize();
+        }
+
+        /// \brief Get the value that restarts a primitive in this format.
+        /// \return 0xFFFF for UINT16 or 0xFFFFFFFF for UINT32.
+        public: unsigned int RestartValue() const
+        {
+          return this->format == IndexFormat::UINT16 ?
+              std::numeric_limits<uint16_t>::max() :
+              std::numeric_limits<uint32_t>::max();
+        }
+
+        /// \brief Get an index converted to 32 bits. The caller must
+        /// ensure _i is lower than Count().
+        /// \param[in] _i Position of the index.
+        /// \return The index, PrimitiveRestartIndex for a restart.
+        public: unsigned int operator[](std::size_t _i) const
+        {
+          if (this->format == IndexFormat::UINT32)
+            return static_cast<const uint32_t *>(this->data)[_i];
+          const uint16_t index = static_cast<const uint16_t *>(this->data)[_i];
+          return index == std::numeric_limits<uint16_t>::max() ?
+              PrimitiveRestartIndex : index;
+        }
+
+        /// \brief Storage format.
+        private: IndexFormat format = IndexFormat::UINT32;
+
+        /// \brief Pointer to the first index.
+        private: const void *data = nullptr;
+
+        /// \brief Number of indices.
+        private: std::size_t count = 0u;
+      };
+
       /// \brief Constructor
       public: SubMesh();
 
@@ -89,8 +214,31 @@ namespace gz
 
       /// \brief Add an index to the mesh
       /// \param[in] _index The new vertex index
+      /// \sa AddPrimitiveRestart
       public: void AddIndex(const unsigned int _index);
 
+      /// \brief Add indices to the mesh, reserving space once
+      /// \param[in] _indices The new vertex indices, which may include
+      /// PrimitiveRestartIndex
+      /// \param[in] _count Number of indices
+      /// \sa AddIndex
+      public: void AddIndices(const unsigned int *_indices,
+          std::size_t _count);
+
+      /// \brief Add a primitive restart to the index array. Only
+      /// LINESTRIPS, TRIFANS and TRISTRIPS submeshes support it.
+      /// \sa PrimitiveRestartIndex
+      public: void AddPrimitiveRestart();
+
+      /// \brief Get whether the index array contains primitive restarts.
+      /// \return True if at least one index is PrimitiveRestartIndex.
+      public: bool HasPrimitiveRestart() const;
+
+      /// \brief Get whether a primitive type supports primitive restart.
+      /// \param[in] _type Primitive type.
+      /// \return True for LINESTRIPS, TRIFANS and TRISTRIPS.
+      public: static bool PrimitiveRestartSupported(PrimitiveType _type);
+
       /// \brief Add a vertex to the mesh
       /// \param[in] _v The new position
       public: void AddVertex(const gz::math::Vector3d &_v);
@@ -142,6 +290,62 @@ namespace gz
       public: void AddTexCoordBySet(const gz::math::Vector2d &_uv,
           unsigned int _setIndex);
 
+      /// \brief Add vertices from single precision coordinates, such as the
+      /// buffers of a model loader. Space is reserved once and the
+      /// coordinates are converted in bulk.
+      /// \param[in] _xyz X, Y and Z of the first vertex
+      /// \param[in] _count Number of vertices
+      /// \param[in] _stride Number of floats from one vertex to the next
+      public: void AddVertices(const float *_xyz, std::size_t _count,
+          std::size_t _stride = 3u);
+
+      /// \brief Add normals from single precision coordinates
+      /// \param[in] _xyz X, Y and Z of the first normal
+      /// \param[in] _count Number of normals
+      /// \param[in] _stride Number of floats from one normal to the next
+      /// \sa AddVertices
+      public: void AddNormals(const float *_xyz, std::size_t _count,
+          std::size_t _stride = 3u);
+
+      /// \brief Add texture coordinates from single precision values to a
+      /// texture coordinate set of the mesh
+      /// \param[in] _uv U and V of the first texture coordinate
+      /// \param[in] _count Number of texture coordinates
+      /// \param[in] _setIndex Texture coordinate set index
+      /// \param[in] _stride Number of floats from one texture coordinate to
+      /// the next
+      /// \sa AddVertices
+      public: void AddTexCoordsBySet(const float *_uv, std::size_t _count,
+          unsigned int _setIndex, std::size_t _stride = 2u);
+
+      /// \brief Add vertices from double precision coordinates, which are
+      /// copied without conversion
+      /// \param[in] _xyz X, Y and Z of the first vertex
+      /// \param[in] _count Number of vertices
+      /// \param[in] _stride Number of doubles from one vertex to the next
+      /// \sa AddVertices(const float *, std::size_t, std::size_t)
+      public: void AddVertices(const double *_xyz, std::size_t _count,
+          std::size_t _stride = 3u);
+
+      /// \brief Add normals from double precision coordinates
+      /// \param[in] _xyz X, Y and Z of the first normal
+      /// \param[in] _count Number of normals
+      /// \param[in] _stride Number of doubles from one normal to the next
+      /// \sa AddVertices(const double *, std::size_t, std::size_t)
+      public: void AddNormals(const double *_xyz, std::size_t _count,
+          std::size_t _stride = 3u);
+
+      /// \brief Add texture coordinates from double precision values to a
+      /// texture coordinate set of the mesh
+      /// \param[in] _uv U and V of the first texture coordinate
+      /// \param[in] _count Number of texture coordinates
+      /// \param[in] _setIndex Texture coordinate set index
+      /// \param[in] _stride Number of doubles from one texture coordinate
+      /// to the next
+      /// \sa AddVertices(const double *, std::size_t, std::size_t)
+      public: void AddTexCoordsBySet(const double *_uv, std::size_t _count,
+          unsigned int _setIndex, std::size_t _stride = 2u);
+
       /// \brief Add a vertex - skeleton node assignment
       /// \param[in] _vertex The vertex index
       /// \param[in] _node The node index
@@ -219,15 +423,32 @@ namespace gz
 
       /// \brief Get an index value from the index array
       /// \param[in] _index Array index.
-      /// \return The index, or -1 if the _index is out of bounds.
+      /// \return The index, or -1 if the _index is out of bounds or is a
+      /// primitive restart.
       public: int Index(const unsigned int _index) const;
 
       /// \brief Get the raw index pointer. This is unsafe, it is the
       /// caller's responsibility to ensure it's not indexed out of bounds.
       /// The valid range is [0; IndexCount())
+      ///
+      /// When the indices are stored with 16 bits, they are converted to
+      /// 32 bits, which invalidates views returned by Indices. Calls to
+      /// IndexPtr may run concurrently, but not with other accesses to the
+      /// indices until the conversion is done. Use Indices to read them in
+      /// their storage format.
       /// \return Raw indices
       public: const unsigned int* IndexPtr() const;
 
+      /// \brief Get a view of the index buffer in its storage format.
+      /// Indices are stored with 16 bits until an index that does not fit
+      /// is added, then all of them are converted to 32 bits.
+      /// \return View of the indices.
+      public: IndexView Indices() const;
+
+      /// \brief Get the storage format of the index buffer.
+      /// \return UINT16 while all indices fit in 16 bits, UINT32 otherwise.
+      public: IndexFormat IndexBufferFormat() const;
+
       /// \brief Set an index
       /// \param[in] _index Index of the indices
       /// \param[in] _i The new index value to set to
@@ -243,11 +464,14 @@ namespace gz
       public: NodeAssignment NodeAssignmentByIndex(
           const unsigned int _index) const;
 
-      /// \brief Get the maximum X, Y, Z values from all the vertices
+      /// \brief Get the maximum X, Y, Z values from all the vertices.
+      /// The value is cached and kept up to date as vertices are added,
+      /// set, scaled or translated, so repeated calls are cheap.
       /// \return Max X,Y,Z values from all vertices in submesh
       public: gz::math::Vector3d Max() const;
 
-      /// \brief Get the minimum X, Y, Z values from all the vertices
+      /// \brief Get the minimum X, Y, Z values from all the vertices.
+      /// The value is cached like Max().
       /// \return Min X,Y,Z values from all vertices in submesh
       public: gz::math::Vector3d Min() const;
 
@@ -286,7 +510,8 @@ namespace gz
       /// \return The number of vertex-skeleton node assignments
       public: unsigned int NodeAssignmentsCount() const;
 
-      /// \brief Get the highest value in the index array.
+      /// \brief Get the highest value in the index array, ignoring
+      /// primitive restarts.
       /// \return The highest index value.
       public: unsigned int MaxIndex() const;
 
@@ -392,6 +617,16 @@ namespace gz
       /// \param[in] _vec Amount to translate vertices.
       public: void Translate(const gz::math::Vector3d &_vec);
 
+      /// \brief Apply an affine transform to all vertices. Normals are
+      /// transformed by the inverse transpose of the rotation and scale, and
+      /// normalized. For singular transforms, such as a scale of zero along
+      /// an axis, normals follow the cofactor matrix instead, which gives
+      /// the same directions wherever they are defined. Normals are left
+      /// unchanged if the transform collapses the submesh to a line or a
+      /// point.
+      /// \param[in] _transform Affine transform. The bottom row is ignored.
+      public: void Transform(const gz::math::Matrix4d &_transform);
+
       /// \brief Compute the volume of this submesh. The primitive type
       /// must be TRIANGLES.
       ///
@@ -400,6 +635,8 @@ namespace gz
       /// representation" by Cha Zhang and Tsuhan Chen. Link:
       /// http://chenlab.ece.cornell.edu/Publication/Cha/icip01_Cha.pdf.
       /// The formula does not check for a closed (water tight) mesh.
+      /// The result is cached until the vertices, indices or primitive
+      /// type change.
       ///
       /// \return The submesh's volume. The volume can be zero if
       /// the primitive type is not TRIANGLES, or there are no triangles.
@@ -412,11 +649,19 @@ namespace gz
       /// This sums signed tetrahedron first moments, from the same family
       /// of methods as B. Mirtich, "Fast and Accurate Computation of
       /// Polyhedral Mass Properties", Journal of Graphics Tools, 1996.
+      /// The result is cached like Volume().
       /// \return The centroid position. The zero vector if the primitive
       /// type is not TRIANGLES or there are no triangles.
       public: gz::math::Vector3d Centroid() const;
 
+      /// \brief Get the memory used by the geometry of the submesh.
+      /// \return Size of the vertex, normal, texture coordinate, index and
+      /// node assignment buffers in bytes.
+      public: std::size_t MemorySize() const;
+
       /// \brief Verify that all indices point to a valid vertex in the submesh
+      /// Primitive restarts are only valid if the primitive type supports
+      /// them.
       /// \return True if all values of indices are valid, false otherwise.
       public: bool HasValidIndices() const;
 
@@ -15,8 +15,13 @@
  *
  */
 
+#include <chrono>
 #include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <stdexcept>
 #include <string>
@@ -28,6 +33,7 @@
 #include "gz/common/AssimpLoader.hh"
 #include "gz/common/Console.hh"
 #include "gz/common/Image.hh"
+#include "gz/common/ImageCache.hh"
 #include "gz/common/Material.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/Skeleton.hh"
@@ -44,6 +50,8 @@
 #include <assimp/scene.h>           // Output data structure
 #include <assimp/material.h>
 
+#include "Parallel.hh"
+
 // Disable warning for converting double to unsigned char
 #ifdef _WIN32
   #pragma warning( disable : 4244 )
@@ -54,7 +62,7 @@ namespace gz
 namespace common
 {
 
-using ImagePtr = std::shared_ptr<Image>;
+using ImagePtr = std::shared_ptr<const Image>;
 
 /// \brief Private data for the AssimpLoader class
 class AssimpLoader::Implementation
@@ -69,9 +77,32 @@ class AssimpLoader::Implementation
   public: mutable std::unordered_map<std::string,
           std::pair<ImagePtr, ImagePtr>> splitMapCache;
 
+  /// \brief Images decoded by DecodeTextures for the scene being loaded,
+  /// indexed by texture key
+  public: std::unordered_map<std::string, ImagePtr> decodedImages;
+
   /// \brief Path of the mesh being loaded, used to qualify embedded textures
   public: std::string currentMeshPath;
 
+  /// \brief True if textures are decoded into images
+  public: bool decodeTextures = true;
+
+  /// \brief Post-processing passes run on loaded scenes
+  public: AssimpPostProcess profile = AssimpPostProcess::DEFAULT;
+
+  /// \brief True if the passes run one at a time to time each of them
+  public: bool timePasses = false;
+
+  /// \brief Duration of the import and of every pass of the last load
+  public: std::vector<std::pair<std::string,
+          std::chrono::steady_clock::duration>> times;
+
+  /// \brief Read a file and run the passes of the profile, all together
+  /// or one at a time if they are timed
+  /// \param[in] _filename File to read
+  /// \return The scene, nullptr if reading or a pass failed
+  public: const aiScene *ReadFile(const std::string &_filename);
+
   /// \brief Convert a color from assimp implementation to Gazebo common
   /// \param[in] _color the assimp color to convert
   /// \return the matching math::Color
@@ -104,6 +135,16 @@ class AssimpLoader::Implementation
   /// \return Pointer to a common::Image containing the texture
   public: ImagePtr LoadEmbeddedTexture(const aiTexture* _texture) const;
 
+  /// \brief Decode the textures the materials of a scene refer to, all at
+  /// once on the shared worker pool, into decodedImages. External files
+  /// come from the ImageCache, and embedded textures that another load
+  /// decoded and that are still in use are shared instead. Materials that
+  /// IsDefaultMaterial discards are skipped.
+  /// \param[in] _scene the assimp scene
+  /// \param[in] _extension the file extension of the mesh
+  public: void DecodeTextures(const aiScene *_scene,
+              const std::string &_extension);
+
   /// \brief Utility function to generate a texture name for both embedded
   /// and external textures
   /// \param[in] _texId the unique identifier for the texture (path or index)
@@ -133,7 +174,11 @@ class AssimpLoader::Implementation
   public: std::pair<ImagePtr, ImagePtr>
           SplitMetallicRoughnessMap(const Image& _img) const;
 
-  /// \brief Convert an assimp mesh into a gz::common::SubMesh
+  /// \brief Convert an assimp mesh into a gz::common::SubMesh. Vertices
+  /// and normals are transformed with SubMesh::Transform, so normals follow
+  /// the inverse transpose of the node transform. Earlier versions rotated
+  /// and scaled normals like positions, which differs for non-uniform
+  /// scales: normals now stay perpendicular to the scaled faces.
   /// \param[in] _assimpMesh the assimp mesh to load
   /// \param[in] _transform the node transform for the mesh
   /// \return the converted common::Submesh
@@ -529,7 +574,14 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
           _scene, texturePath,
           this->GenerateTextureName(textureKey, "MetallicRoughness"), false);
 
-      if (texData == nullptr)
+      if (!this->decodeTextures)
+      {
+        pbr.SetMetalnessMap(
+            this->GenerateTextureName(textureKey, "Metalness"));
+        pbr.SetRoughnessMap(
+            this->GenerateTextureName(textureKey, "Roughness"));
+      }
+      else if (texData == nullptr)
       {
         gzerr << "Unable to load MetallicRoughness texture [" << textureKey
               << "]" << std::endl;
@@ -601,6 +653,10 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
       pbr.SetLightMap(texName, uvIdx, texData);
     }
     // else split the occlusion data from the metallicRoughness texture
+    else if (!this->decodeTextures)
+    {
+      pbr.SetLightMap(texName, uvIdx);
+    }
     else
     {
       if (!texData)
@@ -690,6 +746,13 @@ std::pair<std::string, ImagePtr> AssimpLoader::Implementation::LoadTexture(
   // Check if the texture is embedded or not
   auto embeddedTexture = _scene->GetEmbeddedTexture(_texturePath.C_Str());
 
+  // Only the name is needed if textures are not decoded
+  if (!this->decodeTextures)
+  {
+    ret.first = embeddedTexture ? _textureName : ToString(_texturePath);
+    return ret;
+  }
+
   // Check if the texture is already in the cache
   auto it = this->imageCache.find(textureKey);
   if (it != this->imageCache.end())
@@ -707,6 +770,17 @@ std::pair<std::string, ImagePtr> AssimpLoader::Implementation::LoadTexture(
     return ret;
   }
 
+  // Use the image decoded ahead of the material conversion
+  auto decoded = this->decodedImages.find(textureKey);
+  if (decoded != this->decodedImages.end())
+  {
+    ret.first = embeddedTexture ? _textureName : ToString(_texturePath);
+    ret.second = decoded->second;
+    if (ret.second && _shouldCache)
+      this->imageCache[textureKey] = ret.second;
+    return ret;
+  }
+
   if (embeddedTexture)
   {
     // Load embedded texture
@@ -727,8 +801,8 @@ std::pair<std::string, ImagePtr> AssimpLoader::Implementation::LoadTexture(
       gzdbg << "Loading external texture [" << textureKey << "]" << std::endl;
       // Textures are uploaded to the GPU as RGBA; decode straight to RGBA in a
       // single pass to avoid a later channel conversion.
-      ret.second = std::make_shared<Image>();
-      ret.second->Load(textureKey, Image::PixelFormatType::RGBA_INT8);
+      ret.second = ImageCache::Instance()->Load(textureKey,
+          Image::PixelFormatType::RGBA_INT8);
       if (_shouldCache)
       {
         this->imageCache[textureKey] = ret.second;
@@ -752,10 +826,32 @@ std::pair<ImagePtr, ImagePtr>
   const auto width = _img.Width();
   const auto height = _img.Height();
 
-  std::vector<unsigned char> metalnessData8bit =
-      _img.ChannelData(Image::Channel::BLUE);
-  std::vector<unsigned char> roughnessData8bit =
-      _img.ChannelData(Image::Channel::GREEN);
+  std::vector<unsigned char> metalnessData8bit;
+  std::vector<unsigned char> roughnessData8bit;
+  const Image::PixelView view = _img.View();
+  if (view.ChannelStride() == 1u && view.Channels() >= 3u)
+  {
+    // Decoded textures are 8 bit RGB[A], read both channels in one pass
+    // over the bitmap
+    metalnessData8bit.resize(static_cast<std::size_t>(width) * height);
+    roughnessData8bit.resize(metalnessData8bit.size());
+    std::size_t i = 0u;
+    for (unsigned int y = 0u; y < height; ++y)
+    {
+      const unsigned char *pixel = view.Row(y);
+      for (unsigned int x = 0u; x < width; ++x, ++i)
+      {
+        metalnessData8bit[i] = pixel[2];
+        roughnessData8bit[i] = pixel[1];
+        pixel += view.PixelStride();
+      }
+    }
+  }
+  else
+  {
+    metalnessData8bit = _img.ChannelData(Image::Channel::BLUE);
+    roughnessData8bit = _img.ChannelData(Image::Channel::GREEN);
+  }
 
   if (metalnessData8bit.empty() || roughnessData8bit.empty())
   {
@@ -765,10 +861,12 @@ std::pair<ImagePtr, ImagePtr>
   }
 
   // First is metal, second is rough
-  ret.first = std::make_shared<Image>();
-  ret.first->SetFromData(&metalnessData8bit[0], width, height, Image::L_INT8);
-  ret.second = std::make_shared<Image>();
-  ret.second->SetFromData(&roughnessData8bit[0], width, height, Image::L_INT8);
+  auto metalness = std::make_shared<Image>();
+  metalness->SetFromData(&metalnessData8bit[0], width, height, Image::L_INT8);
+  auto roughness = std::make_shared<Image>();
+  roughness->SetFromData(&roughnessData8bit[0], width, height, Image::L_INT8);
+  ret.first = std::move(metalness);
+  ret.second = std::move(roughness);
   return ret;
 }
 
@@ -820,46 +918,54 @@ SubMesh AssimpLoader::Implementation::CreateSubMesh(
     const aiMesh* _assimpMesh, const math::Matrix4d& _transform) const
 {
   SubMesh subMesh;
-  math::Matrix4d rot = _transform;
-  rot.SetTranslation(math::Vector3d::Zero);
-  // Now create the submesh
-  for (unsigned vertexIdx = 0; vertexIdx < _assimpMesh->mNumVertices;
-      ++vertexIdx)
+  const std::size_t vertexCount = _assimpMesh->mNumVertices;
+#ifndef ASSIMP_DOUBLE_PRECISION
+  // The arrays of aiVector3D are converted in bulk, then transformed
+  if (_assimpMesh->HasPositions())
+    subMesh.AddVertices(&_assimpMesh->mVertices[0].x, vertexCount);
+  if (_assimpMesh->HasNormals())
+    subMesh.AddNormals(&_assimpMesh->mNormals[0].x, vertexCount);
+  subMesh.Transform(_transform);
+  // Iterate over sets of texture coordinates
+  for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+  {
+    if (!_assimpMesh->HasTextureCoords(i))
+      continue;
+    subMesh.AddTexCoordsBySet(&_assimpMesh->mTextureCoords[i][0].x,
+        vertexCount, i, 3u);
+  }
+#else
+  for (std::size_t vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
   {
-    // Add the vertex
-    math::Vector3d vertex;
-    vertex.X(_assimpMesh->mVertices[vertexIdx].x);
-    vertex.Y(_assimpMesh->mVertices[vertexIdx].y);
-    vertex.Z(_assimpMesh->mVertices[vertexIdx].z);
-    vertex = _transform * vertex;
-    subMesh.AddVertex(vertex);
-    if (_assimpMesh->HasNormals()) {
-      math::Vector3d normal;
-      normal.X(_assimpMesh->mNormals[vertexIdx].x);
-      normal.Y(_assimpMesh->mNormals[vertexIdx].y);
-      normal.Z(_assimpMesh->mNormals[vertexIdx].z);
-      normal = rot * normal;
-      normal.Normalize();
-      subMesh.AddNormal(normal);
+    const aiVector3D &vertex = _assimpMesh->mVertices[vertexIdx];
+    subMesh.AddVertex(vertex.x, vertex.y, vertex.z);
+    if (_assimpMesh->HasNormals())
+    {
+      const aiVector3D &normal = _assimpMesh->mNormals[vertexIdx];
+      subMesh.AddNormal(normal.x, normal.y, normal.z);
     }
-    // Iterate over sets of texture coordinates
     for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
     {
       if (!_assimpMesh->HasTextureCoords(i))
         continue;
-      math::Vector3d texcoords;
-      texcoords.X(_assimpMesh->mTextureCoords[i][vertexIdx].x);
-      texcoords.Y(_assimpMesh->mTextureCoords[i][vertexIdx].y);
-      subMesh.AddTexCoordBySet(texcoords.X(), texcoords.Y(), i);
+      const aiVector3D &texCoord = _assimpMesh->mTextureCoords[i][vertexIdx];
+      subMesh.AddTexCoordBySet(texCoord.x, texCoord.y, i);
     }
   }
+  subMesh.Transform(_transform);
+#endif
+
+  std::vector<unsigned int> indices;
+  indices.reserve(3u * _assimpMesh->mNumFaces);
   for (unsigned faceIdx = 0; faceIdx < _assimpMesh->mNumFaces; ++faceIdx)
   {
     auto& face = _assimpMesh->mFaces[faceIdx];
-    subMesh.AddIndex(face.mIndices[0]);
-    subMesh.AddIndex(face.mIndices[1]);
-    subMesh.AddIndex(face.mIndices[2]);
+    // Points and lines are kept when primitives are not sorted by type
+    if (face.mNumIndices != 3u)
+      continue;
+    indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
   }
+  subMesh.AddIndices(indices.data(), indices.size());
   subMesh.SetMaterialIndex(_assimpMesh->mMaterialIndex);
   if (subMesh.NormalCount() == 0u){
     subMesh.RecalculateNormals();
@@ -887,8 +993,252 @@ void ThrowOnAssimpAssert(const char *_failedExpression, const char *_file,
   throw std::runtime_error(std::string("assimp assertion failure: ") +
       _failedExpression + " at " + _file + ":" + std::to_string(_line));
 }
+
+//////////////////////////////////////////////////
+/// \brief A post-processing pass and the profiles that run it
+struct PostProcessPass
+{
+  /// \brief Name reported in the timings
+  const char *name;
+
+  /// \brief Assimp flag of the pass
+  unsigned int flag;
+
+  /// \brief The least expensive profile that runs the pass
+  AssimpPostProcess profile;
+};
+
+/// \brief The passes, in the order assimp runs them when they are requested
+/// together
+const PostProcessPass kPostProcessPasses[] =
+{
+  {"FlipUVs", aiProcess_FlipUVs, AssimpPostProcess::FAST},
+  {"RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials,
+      AssimpPostProcess::DEFAULT},
+  {"FindInstances", aiProcess_FindInstances, AssimpPostProcess::OPTIMIZE},
+  {"OptimizeMeshes", aiProcess_OptimizeMeshes, AssimpPostProcess::OPTIMIZE},
+  {"FindDegenerates", aiProcess_FindDegenerates, AssimpPostProcess::DEFAULT},
+  {"PopulateArmatureData", aiProcess_PopulateArmatureData,
+      AssimpPostProcess::FAST},
+  {"Triangulate", aiProcess_Triangulate, AssimpPostProcess::FAST},
+  {"SortByPType", aiProcess_SortByPType, AssimpPostProcess::DEFAULT},
+  {"SplitLargeMeshes", aiProcess_SplitLargeMeshes,
+      AssimpPostProcess::OPTIMIZE},
+  {"GenNormals", aiProcess_GenNormals, AssimpPostProcess::FAST},
+  {"JoinIdenticalVertices", aiProcess_JoinIdenticalVertices,
+      AssimpPostProcess::DEFAULT},
+  {"ImproveCacheLocality", aiProcess_ImproveCacheLocality,
+      AssimpPostProcess::OPTIMIZE},
+};
+
+//////////////////////////////////////////////////
+/// \brief Images decoded from embedded textures, shared between loads while
+/// they are in use
+struct SharedImages
+{
+  /// \brief Protects images
+  std::mutex mutex;
+
+  /// \brief Images indexed by texture key
+  std::unordered_map<std::string, std::weak_ptr<const Image>> images;
+};
+
+/// \brief Get the images shared between loads
+/// \return The shared images
+SharedImages &Shared()
+{
+  static SharedImages shared;
+  return shared;
+}
+
+/// \brief Find an image that another load decoded and that is still in use
+/// \param[in] _key Texture key
+/// \return The image, nullptr if there is none
+ImagePtr FindSharedImage(const std::string &_key)
+{
+  SharedImages &shared = Shared();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  auto it = shared.images.find(_key);
+  if (it == shared.images.end())
+    return nullptr;
+  ImagePtr image = it->second.lock();
+  if (!image)
+    shared.images.erase(it);
+  return image;
+}
+
+/// \brief Share a decoded image with other loads
+/// \param[in] _key Texture key
+/// \param[in] _image The image
+/// \return The image of another load that decoded the same texture in the
+/// meantime, or _image
+ImagePtr ShareImage(const std::string &_key, const ImagePtr &_image)
+{
+  SharedImages &shared = Shared();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  std::weak_ptr<const Image> &entry = shared.images[_key];
+  if (ImagePtr other = entry.lock())
+    return other;
+  entry = _image;
+  return _image;
+}
 }  // namespace
 
+//////////////////////////////////////////////////
+void AssimpLoader::Implementation::DecodeTextures(const aiScene *_scene,
+    const std::string &_extension)
+{
+  this->decodedImages.clear();
+  if (!this->decodeTextures)
+    return;
+
+  // Each texture is decoded once, however many materials use it
+  struct Texture
+  {
+    std::string key;
+    const aiTexture *embedded;
+    ImagePtr image;
+  };
+  std::vector<Texture> textures;
+  auto addTexture = [&](const aiString &_texturePath)
+  {
+    std::string key = this->FullTextureKey(_texturePath.C_Str());
+    if (key.empty() || this->decodedImages.count(key) > 0u ||
+        this->imageCache.count(key) > 0u ||
+        this->splitMapCache.count(key) > 0u)
+    {
+      return;
+    }
+    const aiTexture *embedded =
+        _scene->GetEmbeddedTexture(_texturePath.C_Str());
+    ImagePtr image = embedded ? FindSharedImage(key) : nullptr;
+    if (!image && !embedded && !common::exists(key))
+      return;
+    this->decodedImages[key] = image;
+    if (!image)
+      textures.push_back({std::move(key), embedded, nullptr});
+  };
+  for (unsigned int m = 0; m < _scene->mNumMaterials; ++m)
+  {
+    const aiMaterial *material = _scene->mMaterials[m];
+    if (this->IsDefaultMaterial(material, _extension))
+      continue;
+    // The same textures as CreateMaterial loads, so that none is decoded
+    // for nothing
+    aiString texturePath;
+    auto hasTexture = [&](aiTextureType _type)
+    {
+      return material->GetTexture(_type, 0, &texturePath) == AI_SUCCESS;
+    };
+    if (hasTexture(aiTextureType_DIFFUSE))
+      addTexture(texturePath);
+    if (material->GetTexture(
+        AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE,
+        &texturePath) == AI_SUCCESS)
+    {
+      addTexture(texturePath);
+    }
+    else
+    {
+      if (hasTexture(aiTextureType_METALNESS))
+        addTexture(texturePath);
+      if (hasTexture(aiTextureType_DIFFUSE_ROUGHNESS))
+        addTexture(texturePath);
+    }
+    if (hasTexture(aiTextureType_LIGHTMAP))
+      addTexture(texturePath);
+    if (hasTexture(aiTextureType_NORMALS) || hasTexture(aiTextureType_HEIGHT))
+      addTexture(texturePath);
+    if (hasTexture(aiTextureType_EMISSIVE))
+      addTexture(texturePath);
+    if (hasTexture(aiTextureType_SPECULAR))
+      addTexture(texturePath);
+  }
+
+  auto decode = [this](Texture &_texture)
+  {
+    if (_texture.embedded)
+    {
+      _texture.image = this->LoadEmbeddedTexture(_texture.embedded);
+      return;
+    }
+    // Textures are uploaded to the GPU as RGBA; decode straight to RGBA in a
+    // single pass to avoid a later channel conversion. External files are
+    // shared through the image cache, with the materials of other meshes.
+    _texture.image = ImageCache::Instance()->Load(_texture.key,
+        Image::PixelFormatType::RGBA_INT8);
+  };
+
+  // Loads running on the pool, such as MeshManager::LoadBatch, decode on
+  // their own thread
+  const std::size_t workerCount = std::min<std::size_t>(textures.size(),
+      parallel::Concurrency());
+  std::atomic<std::size_t> next{0u};
+  std::vector<std::function<void()>> workers(workerCount,
+      [&textures, &next, &decode]()
+      {
+        for (std::size_t i = next++; i < textures.size(); i = next++)
+          decode(textures[i]);
+      });
+  parallel::Run(workers);
+
+  for (Texture &texture : textures)
+  {
+    if (texture.embedded && texture.image && texture.image->Valid())
+      texture.image = ShareImage(texture.key, texture.image);
+    this->decodedImages[texture.key] = texture.image;
+  }
+}
+
+//////////////////////////////////////////////////
+const aiScene *AssimpLoader::Implementation::ReadFile(
+    const std::string &_filename)
+{
+  using Clock = std::chrono::steady_clock;
+  this->times.clear();
+
+  auto runs = [this](const PostProcessPass &_pass)
+  {
+    return static_cast<int>(_pass.profile) <= static_cast<int>(this->profile);
+  };
+
+  // Loads read the file with all the passes at once, which lets assimp
+  // run them as one pipeline
+  unsigned int flags = 0u;
+  if (!this->timePasses)
+  {
+    for (const PostProcessPass &pass : kPostProcessPasses)
+    {
+      if (runs(pass))
+        flags |= pass.flag;
+    }
+  }
+
+  auto start = Clock::now();
+  const aiScene *scene = this->importer.ReadFile(_filename, flags);
+  this->times.emplace_back("Import", Clock::now() - start);
+  if (!this->timePasses)
+    return scene;
+
+  for (const PostProcessPass &pass : kPostProcessPasses)
+  {
+    if (scene == nullptr)
+      break;
+    if (!runs(pass))
+      continue;
+    start = Clock::now();
+    scene = this->importer.ApplyPostProcessing(pass.flag);
+    this->times.emplace_back(pass.name, Clock::now() - start);
+    if (scene == nullptr)
+    {
+      gzerr << "Post-processing pass [" << pass.name << "] failed on mesh ["
+            << _filename << "]: " << this->importer.GetErrorString()
+            << std::endl;
+    }
+  }
+  return scene;
+}
+
 //////////////////////////////////////////////////
 bool AssimpLoader::Implementation::IsDefaultMaterial(
     const aiMaterial* _assimpMat, const std::string &_extension) const
@@ -924,6 +1274,49 @@ AssimpLoader::~AssimpLoader()
 {
 }
 
+//////////////////////////////////////////////////
+void AssimpLoader::SetTextureDecoding(bool _enabled)
+{
+  this->dataPtr->decodeTextures = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool AssimpLoader::TextureDecoding() const
+{
+  return this->dataPtr->decodeTextures;
+}
+
+//////////////////////////////////////////////////
+void AssimpLoader::SetPostProcessProfile(AssimpPostProcess _profile)
+{
+  this->dataPtr->profile = _profile;
+}
+
+//////////////////////////////////////////////////
+AssimpPostProcess AssimpLoader::PostProcessProfile() const
+{
+  return this->dataPtr->profile;
+}
+
+//////////////////////////////////////////////////
+void AssimpLoader::SetPostProcessTiming(bool _enabled)
+{
+  this->dataPtr->timePasses = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool AssimpLoader::PostProcessTiming() const
+{
+  return this->dataPtr->timePasses;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::pair<std::string, std::chrono::steady_clock::duration>>
+AssimpLoader::PostProcessTimes() const
+{
+  return this->dataPtr->times;
+}
+
 //////////////////////////////////////////////////
 Mesh *AssimpLoader::Load(const std::string &_filename)
 {
@@ -933,16 +1326,7 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
   const aiScene* scene = nullptr;
   try
   {
-    scene = this->dataPtr->importer.ReadFile(_filename,
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_FindDegenerates |
-        aiProcess_RemoveRedundantMaterials |
-        aiProcess_SortByPType |
-        aiProcess_FlipUVs |
-        aiProcess_PopulateArmatureData |
-        aiProcess_Triangulate |
-        aiProcess_GenNormals |
-        0);
+    scene = this->dataPtr->ReadFile(_filename);
   }
   catch (const std::exception &_e)
   {
@@ -973,7 +1357,8 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
     useIdentityRotation);
   auto rootTransform = this->dataPtr->ConvertTransform(transform);
 
-  // Add the materials first
+  // Add the materials first, once their textures are decoded
+  this->dataPtr->DecodeTextures(scene, extension);
   for (unsigned _matIdx = 0; _matIdx < scene->mNumMaterials; ++_matIdx)
   {
     if (this->dataPtr->IsDefaultMaterial(scene->mMaterials[_matIdx], extension))
@@ -994,6 +1379,7 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
     }
     mesh->AddMaterial(mat);
   }
+  this->dataPtr->decodedImages.clear();
   // Create the skeleton
   {
     std::unordered_set<std::string> boneNames;
@@ -15,9 +15,12 @@
  *
 */
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
 
 #include "gz/common/Material.hh"
 #include "gz/common/Mesh.hh"
+#include "gz/common/Pbr.hh"
 #include "gz/common/Skeleton.hh"
 #include "gz/common/SkeletonAnimation.hh"
 #include "gz/common/SubMesh.hh"
@@ -173,3 +176,143 @@ TEST_F(AssimpLoader, CheckNonRootDisplacement)
   ASSERT_TRUE(xDisplacement);
   delete mesh;
 }
+
+/////////////////////////////////////////////////
+TEST_F(AssimpLoader, SkipTextureDecoding)
+{
+  common::AssimpLoader loader;
+  EXPECT_TRUE(loader.TextureDecoding());
+  loader.SetTextureDecoding(false);
+  EXPECT_FALSE(loader.TextureDecoding());
+
+  common::Mesh *mesh = loader.Load(
+      common::testing::TestFile("data", "fully_featured.glb"));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(7u, mesh->SubMeshCount());
+
+  // SquareShelf has full PBR textures, which keep their names only
+  auto materialId = mesh->SubMeshByIndex(1).lock()->GetMaterialIndex();
+  ASSERT_TRUE(materialId.has_value());
+  auto material = mesh->MaterialByIndex(materialId.value());
+  ASSERT_NE(nullptr, material);
+  EXPECT_FALSE(material->TextureImage().empty());
+  EXPECT_EQ(nullptr, material->TextureData());
+  auto pbr = material->PbrMaterial();
+  ASSERT_NE(nullptr, pbr);
+  EXPECT_FALSE(pbr->NormalMap().empty());
+  EXPECT_EQ(nullptr, pbr->NormalMapData());
+  EXPECT_FALSE(pbr->MetalnessMap().empty());
+  EXPECT_EQ(nullptr, pbr->MetalnessMapData());
+  EXPECT_FALSE(pbr->RoughnessMap().empty());
+  EXPECT_EQ(nullptr, pbr->RoughnessMapData());
+  EXPECT_FALSE(pbr->LightMap().empty());
+  EXPECT_EQ(nullptr, pbr->LightMapData());
+  delete mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(AssimpLoader, PostProcessProfiles)
+{
+  common::AssimpLoader loader;
+  EXPECT_EQ(common::AssimpPostProcess::DEFAULT, loader.PostProcessProfile());
+  EXPECT_FALSE(loader.PostProcessTiming());
+  EXPECT_TRUE(loader.PostProcessTimes().empty());
+
+  const std::string path = common::testing::TestFile("data",
+      "box_inst_controller_without_skeleton.dae");
+  std::unique_ptr<common::Mesh> mesh(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  const unsigned int indexCount = mesh->IndexCount();
+  const unsigned int vertexCount = mesh->VertexCount();
+  EXPECT_LT(0u, indexCount);
+  auto times = loader.PostProcessTimes();
+  ASSERT_EQ(1u, times.size());
+  EXPECT_EQ("Import", times.front().first);
+
+  // Check whether the last load ran a pass
+  auto ran = [&loader](const std::string &_pass)
+  {
+    for (const auto &step : loader.PostProcessTimes())
+    {
+      if (step.first == _pass)
+        return true;
+    }
+    return false;
+  };
+
+  // Timing the passes one by one gives the same mesh
+  loader.SetPostProcessTiming(true);
+  EXPECT_TRUE(loader.PostProcessTiming());
+  mesh.reset(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(indexCount, mesh->IndexCount());
+  EXPECT_EQ(vertexCount, mesh->VertexCount());
+  times = loader.PostProcessTimes();
+  ASSERT_LT(1u, times.size());
+  EXPECT_EQ("Import", times.front().first);
+  EXPECT_TRUE(ran("Triangulate"));
+  EXPECT_TRUE(ran("JoinIdenticalVertices"));
+  EXPECT_FALSE(ran("ImproveCacheLocality"));
+
+  // Only the default passes join identical vertices
+  loader.SetPostProcessProfile(common::AssimpPostProcess::FAST);
+  EXPECT_EQ(common::AssimpPostProcess::FAST, loader.PostProcessProfile());
+  mesh.reset(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(indexCount, mesh->IndexCount());
+  EXPECT_LE(vertexCount, mesh->VertexCount());
+  EXPECT_TRUE(ran("Triangulate"));
+  EXPECT_FALSE(ran("JoinIdenticalVertices"));
+  EXPECT_GT(times.size(), loader.PostProcessTimes().size());
+
+  loader.SetPostProcessProfile(common::AssimpPostProcess::OPTIMIZE);
+  mesh.reset(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(indexCount, mesh->IndexCount());
+  EXPECT_NE(nullptr, mesh->MeshSkeleton()->NodeById("Armature_Bone"));
+  EXPECT_TRUE(ran("JoinIdenticalVertices"));
+  EXPECT_TRUE(ran("ImproveCacheLocality"));
+  EXPECT_LT(times.size(), loader.PostProcessTimes().size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(AssimpLoader, SharedTextures)
+{
+  const std::string path =
+      common::testing::TestFile("data", "fully_featured.glb");
+  common::AssimpLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  auto materialId = mesh->SubMeshByIndex(1).lock()->GetMaterialIndex();
+  ASSERT_TRUE(materialId.has_value());
+  auto material = mesh->MaterialByIndex(materialId.value());
+  ASSERT_NE(nullptr, material);
+  ASSERT_NE(nullptr, material->TextureData());
+  EXPECT_TRUE(material->TextureData()->Valid());
+  auto pbr = material->PbrMaterial();
+  ASSERT_NE(nullptr, pbr);
+  ASSERT_NE(nullptr, pbr->NormalMapData());
+  EXPECT_NE(material->TextureData(), pbr->NormalMapData());
+
+  // Another loader shares the images that are still in use
+  common::AssimpLoader other;
+  std::unique_ptr<common::Mesh> otherMesh(other.Load(path));
+  ASSERT_NE(nullptr, otherMesh);
+  auto otherMaterial = otherMesh->MaterialByIndex(materialId.value());
+  ASSERT_NE(nullptr, otherMaterial);
+  EXPECT_EQ(material->TextureData(), otherMaterial->TextureData());
+  EXPECT_EQ(pbr->NormalMapData(),
+      otherMaterial->PbrMaterial()->NormalMapData());
+
+  // Once released, the images are decoded again
+  const unsigned int width = material->TextureData()->Width();
+  material.reset();
+  otherMaterial.reset();
+  mesh.reset();
+  otherMesh.reset();
+  mesh.reset(common::AssimpLoader().Load(path));
+  ASSERT_NE(nullptr, mesh);
+  material = mesh->MaterialByIndex(materialId.value());
+  ASSERT_NE(nullptr, material->TextureData());
+  EXPECT_EQ(width, material->TextureData()->Width());
+}
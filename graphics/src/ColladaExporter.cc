@@ -14,6 +14,11 @@
  * limitations under the License.
  *
  */
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include <gz/math/Vector3.hh>
 
 #include <gz/common/Material.hh>
@@ -57,6 +62,88 @@ static void LogTinyXml2DocumentError(
   gzwarn << warning << "\n";
 }
 
+namespace
+{
+/// \brief Writes the text of an element through an XMLPrinter in chunks,
+/// so long arrays are never held in memory as a whole
+class ChunkedText
+{
+  /// \brief Constructor
+  /// \param[in] _printer Printer of the file, with the element open
+  public: explicit ChunkedText(tinyxml2::XMLPrinter &_printer)
+  : printer(_printer)
+  {
+    this->buffer.reserve(kChunkSize + 512u);
+  }
+
+  /// \brief Append a number in fixed notation with 8 decimals, followed
+  /// by a space. The decimal separator is always a dot, whatever the
+  /// locale.
+  /// \param[in] _value Number to append
+  public: void Append(double _value)
+  {
+    // Enough for the largest double in fixed notation
+    char text[352];
+#if defined(__cpp_lib_to_chars)
+    const auto result = std::to_chars(text, text + sizeof(text), _value,
+        std::chars_format::fixed, 8);
+    this->buffer.append(text, static_cast<std::size_t>(result.ptr - text));
+#else
+    const int size = std::snprintf(text, sizeof(text), "%.8f", _value);
+    this->buffer.append(text, static_cast<std::size_t>(size));
+#endif
+    this->EndValue();
+  }
+
+  /// \brief Append an unsigned integer, followed by a space
+  /// \param[in] _value Number to append
+  public: void Append(unsigned int _value)
+  {
+    char text[16];
+    const auto result = std::to_chars(text, text + sizeof(text), _value);
+    this->buffer.append(text, static_cast<std::size_t>(result.ptr - text));
+    this->EndValue();
+  }
+
+  /// \brief Push the remaining text. The element always gets a text node,
+  /// even if it is empty, like the XML document does.
+  public: void Finish()
+  {
+    if (!this->pushed || !this->buffer.empty())
+      this->Push();
+  }
+
+  /// \brief Separate a value from the next one, and push the buffered text
+  /// once a chunk is full
+  private: void EndValue()
+  {
+    this->buffer.push_back(' ');
+    if (this->buffer.size() >= kChunkSize)
+      this->Push();
+  }
+
+  /// \brief Push the buffered text to the printer
+  private: void Push()
+  {
+    this->printer.PushText(this->buffer.c_str());
+    this->buffer.clear();
+    this->pushed = true;
+  }
+
+  /// \brief Size of the text pushed at once
+  private: static constexpr std::size_t kChunkSize = 1u << 16;
+
+  /// \brief Printer of the file
+  private: tinyxml2::XMLPrinter &printer;
+
+  /// \brief Text not pushed yet
+  private: std::string buffer;
+
+  /// \brief True once some text was pushed
+  private: bool pushed = false;
+};
+}  // namespace
+
 /// Private data for the ColladaExporter class
 class gz::common::ColladaExporter::Implementation
 {
@@ -81,6 +168,32 @@ class gz::common::ColladaExporter::Implementation
   /// XML instance
   public: void ExportGeometries(tinyxml2::XMLElement *_libraryGeometriesXml);
 
+  /// \brief Write a geometry source straight to a file
+  /// \param[in] _subMesh Pointer to a submesh
+  /// \param[in] _printer Printer of the file
+  /// \param[in] _type POSITION, NORMAL or UVMAP
+  /// \param[in] _meshID Mesh ID (mesh_<number>)
+  /// \sa ExportGeometrySource
+  public: void StreamGeometrySource(const SubMesh *_subMesh,
+      tinyxml2::XMLPrinter &_printer, GeometryType _type,
+      const char *_meshID);
+
+  /// \brief Write the library geometries element straight to a file
+  /// \param[in] _printer Printer of the file
+  /// \sa ExportGeometries
+  public: void StreamGeometries(tinyxml2::XMLPrinter &_printer);
+
+  /// \brief Save a document, writing the geometries in place of an
+  /// element of the document
+  /// \param[in] _colladaXml Root element of the document
+  /// \param[in] _libraryGeometriesXml Empty element to replace with the
+  /// geometries
+  /// \param[in] _filename Path of the file
+  /// \return True if the file was written
+  public: bool SaveStreaming(const tinyxml2::XMLElement *_colladaXml,
+      const tinyxml2::XMLElement *_libraryGeometriesXml,
+      const std::string &_filename);
+
   /// \brief Export library images element
   /// \param[in] _libraryImagesXml Pointer to the library images XML
   /// instance
@@ -127,6 +240,9 @@ class gz::common::ColladaExporter::Implementation
   /// \brief True to export texture images to '../materials/textures'
   /// folder
   public: bool exportTextures;
+
+  /// \brief True to write the geometries straight to the file
+  public: bool streaming = false;
 };
 
 //////////////////////////////////////////////////
@@ -202,10 +318,12 @@ void ColladaExporter::Export(const Mesh *_mesh, const std::string &_filename,
   tinyxml2::XMLElement *assetXml = xmlDoc.NewElement("asset");
   this->dataPtr->ExportAsset(assetXml);
 
-  // Library geometries element
+  // Library geometries element. When streaming, it stays empty and the
+  // geometries are written in its place when saving.
   tinyxml2::XMLElement *libraryGeometriesXml =
     xmlDoc.NewElement("library_geometries");
-  this->dataPtr->ExportGeometries(libraryGeometriesXml);
+  if (!this->dataPtr->streaming)
+    this->dataPtr->ExportGeometries(libraryGeometriesXml);
   colladaXml->LinkEndChild(libraryGeometriesXml);
 
   if (this->dataPtr->materialCount != 0)
@@ -320,6 +438,13 @@ void ColladaExporter::Export(const Mesh *_mesh, const std::string &_filename,
       this->dataPtr->path, this->dataPtr->filename, "meshes",
       this->dataPtr->filename + ".dae");
 
+    if (this->dataPtr->streaming)
+    {
+      this->dataPtr->SaveStreaming(colladaXml, libraryGeometriesXml,
+          finalFilename);
+      return;
+    }
+
     const tinyxml2::XMLError error = xmlDoc.SaveFile(finalFilename.c_str());
     if (tinyxml2::XML_SUCCESS != error)
     {
@@ -333,6 +458,13 @@ void ColladaExporter::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string finalFilename = gz::common::joinPaths(
       this->dataPtr->path, this->dataPtr->filename + std::string(".dae"));
 
+    if (this->dataPtr->streaming)
+    {
+      this->dataPtr->SaveStreaming(colladaXml, libraryGeometriesXml,
+          finalFilename);
+      return;
+    }
+
     const tinyxml2::XMLError error = xmlDoc.SaveFile(finalFilename.c_str());
     if (tinyxml2::XML_SUCCESS != error)
     {
@@ -342,6 +474,63 @@ void ColladaExporter::Export(const Mesh *_mesh, const std::string &_filename,
   }
 }
 
+//////////////////////////////////////////////////
+void ColladaExporter::SetStreaming(bool _streaming)
+{
+  this->dataPtr->streaming = _streaming;
+}
+
+//////////////////////////////////////////////////
+bool ColladaExporter::Streaming() const
+{
+  return this->dataPtr->streaming;
+}
+
+//////////////////////////////////////////////////
+bool ColladaExporter::Implementation::SaveStreaming(
+    const tinyxml2::XMLElement *_colladaXml,
+    const tinyxml2::XMLElement *_libraryGeometriesXml,
+    const std::string &_filename)
+{
+  FILE *file = fopen(_filename.c_str(), "w");
+  if (!file)
+  {
+    gzerr << "Could not save collada file to [" << _filename << "]\n";
+    return false;
+  }
+  std::vector<char> fileBuffer(1u << 20);
+  setvbuf(file, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+  // Same calls as XMLDocument::SaveFile, so the files are identical
+  {
+    tinyxml2::XMLPrinter printer(file);
+    printer.OpenElement(_colladaXml->Name());
+    for (const tinyxml2::XMLAttribute *attribute =
+          _colladaXml->FirstAttribute(); attribute;
+          attribute = attribute->Next())
+    {
+      printer.PushAttribute(attribute->Name(), attribute->Value());
+    }
+    for (const tinyxml2::XMLNode *child = _colladaXml->FirstChild(); child;
+        child = child->NextSibling())
+    {
+      if (child == _libraryGeometriesXml)
+        this->StreamGeometries(printer);
+      else
+        child->Accept(&printer);
+    }
+    printer.CloseElement();
+  }
+
+  const bool written = !ferror(file);
+  if (fclose(file) != 0 || !written)
+  {
+    gzerr << "Could not save collada file to [" << _filename << "]\n";
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ColladaExporter::Implementation::ExportAsset(
     tinyxml2::XMLElement *_assetXml)
@@ -565,6 +754,183 @@ void ColladaExporter::Implementation::ExportGeometries(
   }
 }
 
+//////////////////////////////////////////////////
+void ColladaExporter::Implementation::StreamGeometrySource(
+    const gz::common::SubMesh *_subMesh,
+    tinyxml2::XMLPrinter &_printer, GeometryType _type, const char *_meshID)
+{
+  char sourceId[100], sourceArrayId[107];
+  unsigned int count = 0;
+  int stride = 3;
+  if (_type == POSITION)
+  {
+    snprintf(sourceId, sizeof(sourceId), "%s-Positions", _meshID);
+    count = _subMesh->VertexCount();
+  }
+  else if (_type == NORMAL)
+  {
+    snprintf(sourceId, sizeof(sourceId), "%s-Normals", _meshID);
+    count = _subMesh->NormalCount();
+  }
+  else
+  {
+    snprintf(sourceId, sizeof(sourceId), "%s-UVMap", _meshID);
+    count = _subMesh->VertexCount();
+    stride = 2;
+  }
+
+  _printer.OpenElement("source");
+  _printer.PushAttribute("id", sourceId);
+  _printer.PushAttribute("name", sourceId);
+
+  snprintf(sourceArrayId, sizeof(sourceArrayId), "%s-array", sourceId);
+  _printer.OpenElement("float_array");
+  _printer.PushAttribute("count", count * stride);
+  _printer.PushAttribute("id", sourceArrayId);
+
+  // Same format as the std::fixed stream with a precision of 8 used by
+  // ExportGeometrySource
+  ChunkedText text(_printer);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    if (_type == POSITION)
+    {
+      const gz::math::Vector3d &vertex = _subMesh->VertexPtr()[i];
+      text.Append(vertex.X());
+      text.Append(vertex.Y());
+      text.Append(vertex.Z());
+    }
+    else if (_type == NORMAL)
+    {
+      const gz::math::Vector3d normal = _subMesh->Normal(i);
+      text.Append(normal.X());
+      text.Append(normal.Y());
+      text.Append(normal.Z());
+    }
+    else
+    {
+      const gz::math::Vector2d inTexCoord = _subMesh->TexCoordBySet(i, 0);
+      text.Append(inTexCoord.X());
+      text.Append(1 - inTexCoord.Y());
+    }
+  }
+  text.Finish();
+  _printer.CloseElement();
+
+  _printer.OpenElement("technique_common");
+  snprintf(sourceArrayId, sizeof(sourceArrayId), "#%s-array", sourceId);
+  _printer.OpenElement("accessor");
+  _printer.PushAttribute("count", count);
+  _printer.PushAttribute("source", sourceArrayId);
+  _printer.PushAttribute("stride", stride);
+  const char *names = _type == UVMAP ? "UV" : "XYZ";
+  for (const char *name = names; *name; ++name)
+  {
+    const char param[2] = {*name, '\0'};
+    _printer.OpenElement("param");
+    _printer.PushAttribute("type", "float");
+    _printer.PushAttribute("name", param);
+    _printer.CloseElement();
+  }
+  _printer.CloseElement();
+  _printer.CloseElement();
+
+  _printer.CloseElement();
+}
+
+//////////////////////////////////////////////////
+void ColladaExporter::Implementation::StreamGeometries(
+    tinyxml2::XMLPrinter &_printer)
+{
+  _printer.OpenElement("library_geometries");
+  for (unsigned int i = 0; i < this->subMeshCount; ++i)
+  {
+    std::shared_ptr<SubMesh> subMesh = this->mesh->SubMeshByIndex(i).lock();
+    if (!subMesh)
+      continue;
+
+    char meshId[100], materialId[100];
+    snprintf(meshId, sizeof(meshId), "mesh_%u", i);
+    if (subMesh->GetMaterialIndex())
+    {
+      snprintf(materialId, sizeof(materialId), "material_%u",
+          subMesh->GetMaterialIndex().value());
+    }
+    const bool hasTexCoords = subMesh->TexCoordCountBySet(0) != 0;
+
+    _printer.OpenElement("geometry");
+    _printer.PushAttribute("id", meshId);
+    _printer.OpenElement("mesh");
+
+    this->StreamGeometrySource(subMesh.get(), _printer, POSITION, meshId);
+    this->StreamGeometrySource(subMesh.get(), _printer, NORMAL, meshId);
+    if (hasTexCoords)
+      this->StreamGeometrySource(subMesh.get(), _printer, UVMAP, meshId);
+
+    char attributeValue[111];
+    _printer.OpenElement("vertices");
+    snprintf(attributeValue, sizeof(attributeValue), "%s-Vertex", meshId);
+    _printer.PushAttribute("id", attributeValue);
+    _printer.PushAttribute("name", attributeValue);
+    _printer.OpenElement("input");
+    _printer.PushAttribute("semantic", "POSITION");
+    snprintf(attributeValue, sizeof(attributeValue), "#%s-Positions", meshId);
+    _printer.PushAttribute("source", attributeValue);
+    _printer.CloseElement();
+    _printer.CloseElement();
+
+    const unsigned int indexCount = subMesh->IndexCount();
+    _printer.OpenElement("triangles");
+    _printer.PushAttribute("count", indexCount/3);
+    if (this->materialCount != 0)
+      _printer.PushAttribute("material", materialId);
+
+    _printer.OpenElement("input");
+    _printer.PushAttribute("offset", 0);
+    _printer.PushAttribute("semantic", "VERTEX");
+    snprintf(attributeValue, sizeof(attributeValue), "#%s-Vertex", meshId);
+    _printer.PushAttribute("source", attributeValue);
+    _printer.CloseElement();
+
+    _printer.OpenElement("input");
+    _printer.PushAttribute("offset", 1);
+    _printer.PushAttribute("semantic", "NORMAL");
+    snprintf(attributeValue, sizeof(attributeValue), "#%s-Normals", meshId);
+    _printer.PushAttribute("source", attributeValue);
+    _printer.CloseElement();
+
+    if (hasTexCoords)
+    {
+      _printer.OpenElement("input");
+      _printer.PushAttribute("offset", 2);
+      _printer.PushAttribute("semantic", "TEXCOORD");
+      snprintf(attributeValue, sizeof(attributeValue), "#%s-UVMap", meshId);
+      _printer.PushAttribute("source", attributeValue);
+      _printer.CloseElement();
+    }
+
+    _printer.OpenElement("p");
+    const SubMesh::IndexView indices = subMesh->Indices();
+    ChunkedText text(_printer);
+    for (unsigned int j = 0; j < indexCount; ++j)
+    {
+      const unsigned int index = indices[j];
+      text.Append(index);
+      text.Append(index);
+      if (hasTexCoords)
+        text.Append(index);
+    }
+    text.Finish();
+    _printer.CloseElement();
+
+    // triangles, mesh and geometry
+    _printer.CloseElement();
+    _printer.CloseElement();
+    _printer.CloseElement();
+  }
+  _printer.CloseElement();
+}
+
 //////////////////////////////////////////////////
 int ColladaExporter::Implementation::ExportImages(
     tinyxml2::XMLElement *_libraryImagesXml)
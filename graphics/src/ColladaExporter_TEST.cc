@@ -15,6 +15,11 @@
  *
 */
 #include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
 #include "tinyxml2.h"
 
 #include "gz/common/ColladaLoader.hh"
@@ -329,6 +334,51 @@ TEST_F(ColladaExporter, ExportMeshWithSubmeshes)
   delete meshReloaded;
 }
 
+/////////////////////////////////////////////////
+TEST_F(ColladaExporter, Streaming)
+{
+  const auto filenameIn = common::testing::TestFile("data",
+      "cordless_drill", "meshes", "cordless_drill.dae");
+  common::ColladaLoader loader;
+  std::unique_ptr<const common::Mesh> meshOriginal(loader.Load(filenameIn));
+  ASSERT_NE(nullptr, meshOriginal);
+
+  common::ColladaExporter exporter;
+  EXPECT_FALSE(exporter.Streaming());
+  const auto filenameDom = common::joinPaths(this->pathOut, "drill_dom");
+  exporter.Export(meshOriginal.get(), filenameDom, false);
+
+  exporter.SetStreaming(true);
+  EXPECT_TRUE(exporter.Streaming());
+  const auto filenameStream = common::joinPaths(this->pathOut,
+      "drill_stream");
+  exporter.Export(meshOriginal.get(), filenameStream, false);
+
+  // Both writers give the same file
+  auto readFile = [](const std::string &_path)
+  {
+    std::ifstream in(_path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  };
+  const std::string dom = readFile(filenameDom + ".dae");
+  ASSERT_FALSE(dom.empty());
+  EXPECT_EQ(dom, readFile(filenameStream + ".dae"));
+
+  // Textures are exported the same way too
+  const auto filenameTextures = common::joinPaths(this->pathOut,
+      "drill_textures");
+  exporter.Export(meshOriginal.get(), filenameTextures, true);
+  std::unique_ptr<const common::Mesh> meshReloaded(loader.Load(
+      common::joinPaths(filenameTextures, "meshes", "drill_textures.dae")));
+  ASSERT_NE(nullptr, meshReloaded);
+  EXPECT_EQ(meshOriginal->SubMeshCount(), meshReloaded->SubMeshCount());
+  EXPECT_EQ(meshOriginal->IndexCount(), meshReloaded->IndexCount());
+  EXPECT_EQ(meshOriginal->VertexCount(), meshReloaded->VertexCount());
+  EXPECT_EQ(meshOriginal->TexCoordCount(), meshReloaded->TexCoordCount());
+}
+
+/////////////////////////////////////////////////
 TEST_F(ColladaExporter, ExportLights)
 {
   const auto filenameIn = common::testing::TestFile("data", "box.dae");
@@ -15,10 +15,13 @@
  *
  */
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <charconv>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
@@ -26,6 +29,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -48,6 +52,8 @@
 #include "gz/common/Util.hh"
 #include "gz/common/ColladaLoader.hh"
 
+#include "Parallel.hh"
+
 using namespace gz;
 using namespace common;
 using RawNodeAnim = std::map<double, std::vector<NodeTransform> >;
@@ -87,6 +93,16 @@ namespace gz
       /// \brief root xml element of COLLADA data
       public: tinyxml2::XMLElement *colladaXml;
 
+      /// \brief Elements of the COLLADA data indexed by their id and sid.
+      /// Each value is the first element with that id or sid in document
+      /// order, which is the one a search of the tree finds.
+      public: std::unordered_map<std::string, tinyxml2::XMLElement *> idIndex;
+
+      /// \brief Index used by the searches: idIndex, or the one of the
+      /// loader that started this geometry worker, which is not copied
+      public: const std::unordered_map<std::string,
+              tinyxml2::XMLElement *> *ids = &idIndex;
+
       /// \brief directory of COLLADA file name
       public: std::string path;
 
@@ -123,6 +139,30 @@ namespace gz
       /// \brief Current scene being parsed
       public: tinyxml2::XMLElement *currentScene = nullptr;
 
+      /// \brief A geometry instanced by a node, with the state of the node
+      /// it is loaded with
+      public: struct GeometryJob
+      {
+        /// \brief The geometry element
+        tinyxml2::XMLElement *geometry;
+
+        /// \brief Transform of the node
+        gz::math::Matrix4d transform;
+
+        /// \brief Materials bound by the instance
+        std::map<std::string, std::string> materialMap;
+
+        /// \brief Name of the submeshes of the geometry
+        std::string nodeName;
+      };
+
+      /// \brief True to load the geometries of a scene in parallel
+      public: bool parallelGeometry = false;
+
+      /// \brief Geometries to load once the scene has been traversed, or
+      /// nullptr to load each geometry when its node is visited
+      public: std::vector<GeometryJob> *geometryJobs = nullptr;
+
       /// \brief Load a controller instance
       /// \param[in] _contrXml Pointer to the control XML instance
       /// \param[in] _skelXml Pointer the skeleton xml instance
@@ -171,6 +211,23 @@ namespace gz
                                  const gz::math::Matrix4d &_transform,
                                  Mesh *_mesh);
 
+      /// \brief Load the geometries of a scene concurrently, then add
+      /// their submeshes and materials to the mesh in the order the nodes
+      /// were visited, so the mesh matches a serial load
+      /// \param[in] _jobs Geometries in the order their nodes were visited
+      /// \param[in,out] _mesh Pointer to the mesh currently being loaded
+      public: void LoadGeometries(const std::vector<GeometryJob> &_jobs,
+                                  Mesh *_mesh);
+
+      /// \brief Index the elements of colladaXml by id and sid, in one
+      /// pass over the document
+      public: void IndexIds();
+
+      /// \brief Decode every name, attribute and text of colladaXml.
+      /// tinyxml2 decodes strings when they are first read, which modifies
+      /// the document, so this is done before several threads read it.
+      public: void DecodeStrings();
+
       /// \brief Get an XML element by ID
       /// \param[in] _parent The parent element
       /// \param[in] _name String name of the element
@@ -404,39 +461,214 @@ struct Vector2dHash
 };
 
 /////////////////////////////////////////////////
-/// \brief Parse a whitespace-delimited list of doubles from a string.
-/// Parsing stops at the first non-numeric token or on overflow.
-/// \param[in] _str Null-terminated text to parse.
-/// \param[in] _reserveCount Number of values to reserve space for up front.
-/// \return The parsed values.
-std::vector<double> parseDoubles(const char *_str, size_t _reserveCount)
+/// \brief How scanning a range of text for numbers ended
+enum class ScanEnd
 {
-  std::vector<double> result;
-  // Preallocate memory based on the known count, clamped by what the text
-  // could possibly hold (a value takes at least 2 characters including its
-  // delimiter) so a huge bogus count attribute cannot drive a huge
-  // allocation.
-  result.reserve(std::min(_reserveCount, std::strlen(_str) / 2 + 1));
-  const char *start = _str;
-  char *end{};
-  while (true)
-  {
+  /// \brief The whole range was read
+  COMPLETE,
+
+  /// \brief A token is not a number
+  INVALID,
+
+  /// \brief A number is out of range
+  RANGE,
+
+  /// \brief An index is negative
+  NEGATIVE
+};
+
+/// \brief Texts at least this long are parsed in parallel chunks
+constexpr std::size_t kParallelParseSize = 1u << 21;
+
+/// \brief Minimum length of a chunk of text parsed in parallel
+constexpr std::size_t kParseChunkSize = 1u << 20;
+
+/////////////////////////////////////////////////
+/// \brief Check whether a character is whitespace, as for std::isspace in
+/// the C locale
+/// \param[in] _c Character to check
+/// \return True if _c is whitespace
+bool isSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r' ||
+         _c == '\f' || _c == '\v';
+}
+
+/////////////////////////////////////////////////
+/// \brief Skip whitespace and a '+' sign, which std::from_chars does not
+/// accept while strtod does
+/// \param[in] _str Start of the text
+/// \param[in] _end End of the text
+/// \return Start of the next token, or _end
+const char *skipToToken(const char *_str, const char *_end)
+{
+  while (_str != _end && isSpace(*_str))
+    ++_str;
+  if (_str != _end && *_str == '+' && _str + 1 != _end && _str[1] != '-')
+    ++_str;
+  return _str;
+}
+
+/////////////////////////////////////////////////
+/// \brief Scan whitespace-delimited doubles.
+/// \param[in] _str Start of the text, which is part of a null-terminated
+/// string and ends on whitespace or on the terminator
+/// \param[in] _end End of the text
+/// \param[out] _values The values are appended to this vector
+/// \return How the scan ended
+ScanEnd scanDoubles(const char *_str, const char *_end,
+    std::vector<double> &_values)
+{
+  while ((_str = skipToToken(_str, _end)) != _end)
+  {
+    double d = 0.0;
+#if defined(__cpp_lib_to_chars)
+    auto [next, ec] = std::from_chars(_str, _end, d);
+    if (ec == std::errc::invalid_argument)
+      return ScanEnd::INVALID;
+    // Only overflow is fatal. Underflow also gives an error but strtod
+    // turns it into a harmless denormal or zero, which legitimate exporters
+    // do produce.
+    if (ec == std::errc::result_out_of_range)
+    {
+      d = std::strtod(_str, nullptr);
+      if (std::isinf(d))
+        return ScanEnd::RANGE;
+    }
+#else
+    char *next{};
     // Reset errno so a stale ERANGE set by earlier code is not misread as
     // a range error from this call.
     errno = 0;
-    double d = std::strtod(start, &end);
-    if (start == end)
-      break;
-    start = end;
-    // Only overflow is fatal. Underflow also sets ERANGE but yields a
-    // harmless denormal or zero, which legitimate exporters do produce.
+    d = std::strtod(_str, &next);
+    if (next == _str)
+      return ScanEnd::INVALID;
     if (errno == ERANGE && (d == HUGE_VAL || d == -HUGE_VAL))
+      return ScanEnd::RANGE;
+#endif
+    _values.push_back(d);
+    _str = next;
+  }
+  return ScanEnd::COMPLETE;
+}
+
+/////////////////////////////////////////////////
+/// \brief Scan whitespace-delimited unsigned integers. Negative numbers
+/// are rejected instead of wrapping to huge values, which would become
+/// out-of-bounds indices downstream.
+/// \param[in] _str Start of the text
+/// \param[in] _end End of the text
+/// \param[out] _values The values are appended to this vector
+/// \return How the scan ended
+ScanEnd scanUints(const char *_str, const char *_end,
+    std::vector<unsigned int> &_values)
+{
+  while ((_str = skipToToken(_str, _end)) != _end)
+  {
+    if (*_str == '-')
+      return ScanEnd::NEGATIVE;
+    unsigned int v = 0u;
+    auto [next, ec] = std::from_chars(_str, _end, v);
+    if (ec == std::errc::invalid_argument)
+      return ScanEnd::INVALID;
+    if (ec == std::errc::result_out_of_range)
+      return ScanEnd::RANGE;
+    _values.push_back(v);
+    _str = next;
+  }
+  return ScanEnd::COMPLETE;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace-delimited list of numbers. Large texts are
+/// split on whitespace into chunks that are parsed in parallel on the
+/// shared worker pool, unless already running on it. Parsing
+/// stops at the first token that fails to parse, as in a sequential scan.
+/// \param[in] _str Null-terminated text to parse.
+/// \param[in] _reserveCount Number of values to reserve space for up front.
+/// \param[in] _scan Function that scans a range of the text
+/// \param[out] _scanEnd How parsing ended
+/// \return The parsed values.
+template <typename T, typename Scan>
+std::vector<T> parseNumbers(const char *_str, std::size_t _reserveCount,
+    Scan _scan, ScanEnd &_scanEnd)
+{
+  const std::size_t length = std::strlen(_str);
+  const char *end = _str + length;
+  // Clamp the reserved count by what the text could possibly hold (a value
+  // takes at least 2 characters including its delimiter) so a huge bogus
+  // count attribute cannot drive a huge allocation.
+  _reserveCount = std::min(_reserveCount, length / 2 + 1);
+
+  std::size_t chunkCount = 1u;
+  if (length >= kParallelParseSize)
+  {
+    chunkCount = std::min<std::size_t>(parallel::Concurrency(),
+        length / kParseChunkSize);
+  }
+
+  std::vector<T> result;
+  if (chunkCount <= 1u)
+  {
+    result.reserve(_reserveCount);
+    _scanEnd = _scan(_str, end, result);
+    return result;
+  }
+
+  // Split on whitespace, so that no number spans two chunks
+  std::vector<const char *> bounds{_str};
+  for (std::size_t i = 1; i < chunkCount; ++i)
+  {
+    const char *bound = std::max(_str + length * i / chunkCount,
+        bounds.back());
+    while (bound != end && !isSpace(*bound))
+      ++bound;
+    bounds.push_back(bound);
+  }
+  bounds.push_back(end);
+
+  std::vector<std::vector<T>> parts(chunkCount);
+  std::vector<ScanEnd> scanEnds(chunkCount, ScanEnd::COMPLETE);
+  auto scanChunk = [&](std::size_t _chunk)
+  {
+    parts[_chunk].reserve(_reserveCount / chunkCount + 1);
+    scanEnds[_chunk] = _scan(bounds[_chunk], bounds[_chunk + 1],
+        parts[_chunk]);
+  };
+  std::vector<std::function<void()>> tasks;
+  for (std::size_t i = 0; i < chunkCount; ++i)
+    tasks.push_back([&scanChunk, i]() { scanChunk(i); });
+  parallel::Run(tasks);
+
+  result.reserve(_reserveCount);
+  _scanEnd = ScanEnd::COMPLETE;
+  for (std::size_t i = 0; i < chunkCount; ++i)
+  {
+    result.insert(result.end(), parts[i].begin(), parts[i].end());
+    if (scanEnds[i] != ScanEnd::COMPLETE)
     {
-      gzerr << "Overflow while parsing <float_array>; truncating after "
-            << result.size() << " value(s).\n";
+      _scanEnd = scanEnds[i];
       break;
     }
-    result.push_back(d);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace-delimited list of doubles from a string.
+/// Parsing stops at the first non-numeric token or on overflow.
+/// \param[in] _str Null-terminated text to parse.
+/// \param[in] _reserveCount Number of values to reserve space for up front.
+/// \return The parsed values.
+std::vector<double> parseDoubles(const char *_str, size_t _reserveCount)
+{
+  ScanEnd scanEnd;
+  std::vector<double> result =
+      parseNumbers<double>(_str, _reserveCount, scanDoubles, scanEnd);
+  if (scanEnd == ScanEnd::RANGE)
+  {
+    gzerr << "Overflow while parsing <float_array>; truncating after "
+          << result.size() << " value(s).\n";
   }
   return result;
 }
@@ -452,40 +684,18 @@ std::vector<double> parseDoubles(const char *_str, size_t _reserveCount)
 /// \return The parsed values.
 std::vector<unsigned int> parseUints(const char *_str, size_t _reserveCount)
 {
-  std::vector<unsigned int> result;
-  result.reserve(_reserveCount);
-  const char *start = _str;
-  char *end{};
-  while (true)
+  ScanEnd scanEnd;
+  std::vector<unsigned int> result =
+      parseNumbers<unsigned int>(_str, _reserveCount, scanUints, scanEnd);
+  if (scanEnd == ScanEnd::NEGATIVE)
   {
-    // Skip whitespace ourselves so a leading '-' can be rejected:
-    // strtoul silently wraps negative numbers to huge values, which would
-    // become out-of-bounds indices downstream.
-    while (*start == ' ' || *start == '\t' || *start == '\r' ||
-           *start == '\n')
-    {
-      ++start;
-    }
-    if (*start == '-')
-    {
-      gzerr << "Negative index in <p> element; truncating after "
-            << result.size() << " value(s).\n";
-      break;
-    }
-    errno = 0;
-    // auto (deduces the strtoul return type) avoids a bare 'long', which
-    // cpplint's runtime/int check rejects.
-    auto v = std::strtoul(start, &end, 10);
-    if (start == end)
-      break;
-    start = end;
-    if (errno == ERANGE || v > std::numeric_limits<unsigned int>::max())
-    {
-      gzerr << "Index out of range in <p> element; truncating after "
-            << result.size() << " value(s).\n";
-      break;
-    }
-    result.push_back(static_cast<unsigned int>(v));
+    gzerr << "Negative index in <p> element; truncating after "
+          << result.size() << " value(s).\n";
+  }
+  else if (scanEnd == ScanEnd::RANGE)
+  {
+    gzerr << "Index out of range in <p> element; truncating after "
+          << result.size() << " value(s).\n";
   }
   return result;
 }
@@ -700,6 +910,7 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
     gzerr << "Missing COLLADA tag\n";
     return nullptr;
   }
+  this->dataPtr->IndexIds();
 
   const char *version = this->dataPtr->colladaXml->Attribute("version");
   if (!version ||
@@ -737,6 +948,18 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void ColladaLoader::SetParallelGeometry(bool _parallel)
+{
+  this->dataPtr->parallelGeometry = _parallel;
+}
+
+//////////////////////////////////////////////////
+bool ColladaLoader::ParallelGeometry() const
+{
+  return this->dataPtr->parallelGeometry;
+}
+
 /////////////////////////////////////////////////
 void ColladaLoader::Implementation::LoadScene(Mesh *_mesh)
 {
@@ -753,12 +976,122 @@ void ColladaLoader::Implementation::LoadScene(Mesh *_mesh)
     return;
   }
 
+  // Skinned geometries are attached to the skeleton as they are loaded,
+  // so documents with controllers are always loaded serially
+  tinyxml2::XMLElement *controllersXml =
+      this->colladaXml->FirstChildElement("library_controllers");
+  std::vector<GeometryJob> jobs;
+  if (this->parallelGeometry &&
+      !(controllersXml && controllersXml->FirstChildElement("controller")))
+  {
+    this->geometryJobs = &jobs;
+  }
+
   tinyxml2::XMLElement *nodeXml = visSceneXml->FirstChildElement("node");
   while (nodeXml)
   {
     this->LoadNode(nodeXml, _mesh, gz::math::Matrix4d::Identity);
     nodeXml = nodeXml->NextSiblingElement("node");
   }
+
+  if (this->geometryJobs)
+  {
+    this->geometryJobs = nullptr;
+    this->LoadGeometries(jobs, _mesh);
+  }
+}
+
+/////////////////////////////////////////////////
+void ColladaLoader::Implementation::LoadGeometries(
+    const std::vector<GeometryJob> &_jobs, Mesh *_mesh)
+{
+  if (_jobs.size() < 2u)
+  {
+    for (const GeometryJob &job : _jobs)
+    {
+      this->materialMap = job.materialMap;
+      this->currentNodeName = job.nodeName;
+      this->LoadGeometry(job.geometry, job.transform, _mesh);
+    }
+    return;
+  }
+
+  // Load the materials first, so every worker shares the same instances
+  // and the mesh refers to each material once, as with a serial load
+  for (const GeometryJob &job : _jobs)
+  {
+    tinyxml2::XMLElement *meshXml =
+        job.geometry ? job.geometry->FirstChildElement("mesh") : nullptr;
+    if (!meshXml)
+      continue;
+    for (const char *type : {"triangles", "polylist"})
+    {
+      for (tinyxml2::XMLElement *xml = meshXml->FirstChildElement(type); xml;
+           xml = xml->NextSiblingElement(type))
+      {
+        const char *symbol = xml->Attribute("material");
+        if (!symbol)
+          continue;
+        auto iter = job.materialMap.find(symbol);
+        this->LoadMaterial(
+            iter != job.materialMap.end() ? iter->second : symbol);
+      }
+    }
+  }
+  this->DecodeStrings();
+
+  // Each worker loads geometries into meshes of their own, with its own
+  // caches of sources
+  std::vector<std::unique_ptr<Mesh>> meshes(_jobs.size());
+  std::atomic<std::size_t> next{0u};
+  const std::size_t workerCount = std::min<std::size_t>(_jobs.size(),
+      parallel::Concurrency());
+  std::vector<std::function<void()>> workers(workerCount,
+      [this, &_jobs, &meshes, &next]()
+      {
+        Implementation worker;
+        worker.meter = this->meter;
+        worker.filename = this->filename;
+        worker.path = this->path;
+        worker.colladaXml = this->colladaXml;
+        worker.ids = &this->idIndex;
+        worker.currentScene = this->currentScene;
+        worker.materialIds = this->materialIds;
+        for (std::size_t i = next++; i < _jobs.size(); i = next++)
+        {
+          const GeometryJob &job = _jobs[i];
+          meshes[i] = std::make_unique<Mesh>();
+          if (!job.geometry)
+            continue;
+          worker.materialMap = job.materialMap;
+          worker.currentNodeName = job.nodeName;
+          worker.LoadGeometry(job.geometry, job.transform,
+              meshes[i].get());
+        }
+      });
+  parallel::Run(workers);
+
+  // Merge in the order the nodes were visited
+  for (const auto &mesh : meshes)
+  {
+    std::vector<int> materialIndices(mesh->MaterialCount(), -1);
+    for (unsigned int i = 0u; i < mesh->MaterialCount(); ++i)
+    {
+      MaterialPtr mat = mesh->MaterialByIndex(i);
+      materialIndices[i] = _mesh->IndexOfMaterial(mat.get());
+      if (materialIndices[i] < 0)
+        materialIndices[i] = _mesh->AddMaterial(mat);
+    }
+
+    for (unsigned int i = 0u; i < mesh->SubMeshCount(); ++i)
+    {
+      auto subMesh = mesh->SubMeshByIndex(i).lock();
+      auto matIndex = subMesh->GetMaterialIndex();
+      if (matIndex && *matIndex < materialIndices.size())
+        subMesh->SetMaterialIndex(materialIndices[*matIndex]);
+      _mesh->AddSubMesh(*subMesh);
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -852,9 +1185,17 @@ void ColladaLoader::Implementation::LoadNode(
       bindMatXml = bindMatXml->NextSiblingElement("bind_material");
     }
 
-    if (_mesh->HasSkeleton())
-      _mesh->MeshSkeleton()->SetNumVertAttached(0);
-    this->LoadGeometry(geomXml, transform, _mesh);
+    if (this->geometryJobs)
+    {
+      this->geometryJobs->push_back(
+          {geomXml, transform, this->materialMap, this->currentNodeName});
+    }
+    else
+    {
+      if (_mesh->HasSkeleton())
+        _mesh->MeshSkeleton()->SetNumVertAttached(0);
+      this->LoadGeometry(geomXml, transform, _mesh);
+    }
     instGeomXml = instGeomXml->NextSiblingElement("instance_geometry");
   }
 
@@ -1649,6 +1990,63 @@ void ColladaLoader::Implementation::LoadGeometry(tinyxml2::XMLElement *_xml,
   }
 }
 
+/////////////////////////////////////////////////
+void ColladaLoader::Implementation::IndexIds()
+{
+  this->idIndex.clear();
+
+  // Visit the elements in document order without recursion, so deep
+  // documents do not exhaust the stack
+  tinyxml2::XMLElement *elem = this->colladaXml;
+  while (elem)
+  {
+    for (const char *attribute : {"id", "sid"})
+    {
+      const char *value = elem->Attribute(attribute);
+      // The first element with an id is kept, as with a search of the tree
+      if (value)
+        this->idIndex.emplace(value, elem);
+    }
+
+    tinyxml2::XMLElement *next = elem->FirstChildElement();
+    while (!next && elem != this->colladaXml)
+    {
+      next = elem->NextSiblingElement();
+      if (!next)
+        elem = elem->Parent()->ToElement();
+    }
+    elem = next;
+  }
+}
+
+/////////////////////////////////////////////////
+void ColladaLoader::Implementation::DecodeStrings()
+{
+  tinyxml2::XMLNode *node = this->colladaXml;
+  while (node)
+  {
+    node->Value();
+    if (tinyxml2::XMLElement *elem = node->ToElement())
+    {
+      for (const tinyxml2::XMLAttribute *attribute = elem->FirstAttribute();
+           attribute; attribute = attribute->Next())
+      {
+        attribute->Name();
+        attribute->Value();
+      }
+    }
+
+    tinyxml2::XMLNode *nextNode = node->FirstChild();
+    while (!nextNode && node != this->colladaXml)
+    {
+      nextNode = node->NextSibling();
+      if (!nextNode)
+        node = node->Parent();
+    }
+    node = nextNode;
+  }
+}
+
 /////////////////////////////////////////////////
 tinyxml2::XMLElement *ColladaLoader::Implementation::ElementId(
     const std::string &_name, const std::string &_id)
@@ -1665,6 +2063,13 @@ tinyxml2::XMLElement *ColladaLoader::Implementation::ElementId(
   if (!id.empty() && id[0] == '#')
     id.remove_prefix(1);
 
+  // Searches of the whole document use the index
+  if (_parent == this->colladaXml && !id.empty())
+  {
+    auto iter = this->ids->find(std::string(id));
+    return iter == this->ids->end() ? nullptr : iter->second;
+  }
+
   if ((id.empty() && _parent->Value() == _name) ||
       (_parent->Attribute("id") && _parent->Attribute("id") == id) ||
       (_parent->Attribute("sid") && _parent->Attribute("sid") == id))
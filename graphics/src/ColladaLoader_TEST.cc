@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
@@ -116,6 +117,44 @@ TEST_F(ColladaLoader, LoadBoxWithDefaultStride)
   ASSERT_EQ(1u, mesh->MeshSkeleton()->AnimationCount());
 }
 
+/////////////////////////////////////////////////
+// Ids and sids shared by several elements refer to the first one in the
+// document, and skeleton roots are only searched in the visual scene.
+TEST_F(ColladaLoader, LoadBoxWithDuplicateIds)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> reference(loader.Load(
+      common::testing::TestFile("data", "box_with_default_stride.dae")));
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      common::testing::TestFile("data", "box_with_duplicate_ids.dae")));
+  ASSERT_NE(nullptr, reference);
+  ASSERT_NE(nullptr, mesh);
+
+  EXPECT_EQ(36u, mesh->IndexCount());
+  EXPECT_EQ(35u, mesh->VertexCount());
+  EXPECT_EQ(1u, mesh->SubMeshCount());
+
+  // The source with the positions as sid comes before the one with them as
+  // id, and holds a box twice as large
+  EXPECT_EQ((reference->Max() - reference->Min()) * 2.0,
+      mesh->Max() - mesh->Min());
+
+  // The first of the two effects with the same id is used
+  ASSERT_EQ(1u, mesh->MaterialCount());
+  EXPECT_EQ(math::Color(0.8f, 0.8f, 0.8f, 1.0f),
+      mesh->MaterialByIndex(0u)->Diffuse());
+
+  // The node of the library with the id of the skeleton root comes first in
+  // the document, but is not in the visual scene
+  ASSERT_TRUE(mesh->HasSkeleton());
+  common::SkeletonPtr skeleton = mesh->MeshSkeleton();
+  ASSERT_NE(nullptr, skeleton->NodeById("Armature_Bone"));
+  EXPECT_EQ("Bone", skeleton->NodeById("Armature_Bone")->Name());
+  EXPECT_NE(nullptr, skeleton->NodeByName("Bone"));
+  EXPECT_EQ(nullptr, skeleton->NodeByName("Decoy"));
+  EXPECT_EQ(1u, skeleton->AnimationCount());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ColladaLoader, MergeBoxWithDoubleSkeleton)
 {
@@ -258,3 +297,71 @@ TEST_F(ColladaLoader, LoadMissingVisualScene)
 #endif
 }
 
+
+/////////////////////////////////////////////////
+// Loading geometries in parallel gives the same mesh as a serial load.
+TEST_F(ColladaLoader, ParallelGeometry)
+{
+  common::ColladaLoader loader;
+  EXPECT_FALSE(loader.ParallelGeometry());
+
+  for (const std::string file : {"box_with_hierarchical_nodes.dae",
+      "box_opaque.dae", "xy_triangle_texture.dae", "box.dae"})
+  {
+    loader.SetParallelGeometry(false);
+    std::unique_ptr<common::Mesh> serial(loader.Load(
+        common::testing::TestFile("data", file)));
+    loader.SetParallelGeometry(true);
+    EXPECT_TRUE(loader.ParallelGeometry());
+    std::unique_ptr<common::Mesh> parallel(loader.Load(
+        common::testing::TestFile("data", file)));
+    ASSERT_TRUE(serial) << file;
+    ASSERT_TRUE(parallel) << file;
+
+    ASSERT_EQ(serial->MaterialCount(), parallel->MaterialCount()) << file;
+    for (unsigned int i = 0u; i < serial->MaterialCount(); ++i)
+    {
+      auto expected = serial->MaterialByIndex(i);
+      auto actual = parallel->MaterialByIndex(i);
+      EXPECT_EQ(expected->Ambient(), actual->Ambient());
+      EXPECT_EQ(expected->Diffuse(), actual->Diffuse());
+      EXPECT_EQ(expected->Transparency(), actual->Transparency());
+      EXPECT_EQ(expected->TextureImage(), actual->TextureImage());
+    }
+
+    ASSERT_EQ(serial->SubMeshCount(), parallel->SubMeshCount()) << file;
+    for (unsigned int i = 0u; i < serial->SubMeshCount(); ++i)
+    {
+      auto expected = serial->SubMeshByIndex(i).lock();
+      auto actual = parallel->SubMeshByIndex(i).lock();
+      // Submeshes of unnamed nodes are numbered by a counter shared by all
+      // the loads, so only their prefix matches
+      const std::string unnamed = "unnamed_submesh_";
+      if (expected->Name().rfind(unnamed, 0u) == 0u)
+        EXPECT_EQ(0u, actual->Name().rfind(unnamed, 0u));
+      else
+        EXPECT_EQ(expected->Name(), actual->Name());
+      EXPECT_EQ(expected->GetMaterialIndex(), actual->GetMaterialIndex());
+      ASSERT_EQ(expected->VertexCount(), actual->VertexCount());
+      ASSERT_EQ(expected->NormalCount(), actual->NormalCount());
+      ASSERT_EQ(expected->IndexCount(), actual->IndexCount());
+      for (unsigned int v = 0u; v < expected->VertexCount(); ++v)
+        EXPECT_EQ(expected->Vertex(v), actual->Vertex(v));
+      for (unsigned int n = 0u; n < expected->NormalCount(); ++n)
+        EXPECT_EQ(expected->Normal(n), actual->Normal(n));
+      for (unsigned int n = 0u; n < expected->IndexCount(); ++n)
+        EXPECT_EQ(expected->Index(n), actual->Index(n));
+      ASSERT_EQ(expected->TexCoordSetCount(), actual->TexCoordSetCount());
+      for (unsigned int s = 0u; s < expected->TexCoordSetCount(); ++s)
+      {
+        ASSERT_EQ(expected->TexCoordCountBySet(s),
+            actual->TexCoordCountBySet(s));
+        for (unsigned int t = 0u; t < expected->TexCoordCountBySet(s); ++t)
+        {
+          EXPECT_EQ(expected->TexCoordBySet(t, s),
+              actual->TexCoordBySet(t, s));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_FILEWRITER_HH_
+#define GZ_COMMON_FILEWRITER_HH_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Writes a file through a large buffer, so exporters can
+    /// stream meshes to disk without building the whole file in memory
+    class FileWriter
+    {
+      /// \brief Constructor
+      /// \param[in] _path File to create or truncate
+      /// \param[in] _bufferSize Size of the buffer in bytes
+      public: explicit FileWriter(const std::string &_path,
+                  std::size_t _bufferSize = 1u << 20)
+      {
+        this->file = std::fopen(_path.c_str(), "wb");
+        this->buffer.reserve(_bufferSize);
+      }
+
+      /// \brief Destructor, closes the file
+      public: ~FileWriter()
+      {
+        this->Close();
+      }
+
+      /// \brief Copying would close the file twice
+      public: FileWriter(const FileWriter &) = delete;
+
+      /// \brief Copying would close the file twice
+      public: FileWriter &operator=(const FileWriter &) = delete;
+
+      /// \brief Check if the file was opened and every write succeeded
+      /// \return True if nothing failed so far
+      public: bool Valid() const
+      {
+        return this->file != nullptr && this->ok;
+      }
+
+      /// \brief Write bytes
+      /// \param[in] _data Bytes to write
+      /// \param[in] _size Number of bytes
+      public: void Write(const void *_data, std::size_t _size)
+      {
+        if (this->buffer.size() + _size > this->buffer.capacity())
+          this->Flush();
+        if (_size > this->buffer.capacity())
+        {
+          this->WriteFile(_data, _size);
+          return;
+        }
+        const char *bytes = static_cast<const char *>(_data);
+        this->buffer.insert(this->buffer.end(), bytes, bytes + _size);
+      }
+
+      /// \brief Write text
+      /// \param[in] _text Text to write
+      public: void Write(std::string_view _text)
+      {
+        this->Write(_text.data(), _text.size());
+      }
+
+      /// \brief Write a number as text, with the fewest digits that read
+      /// back to the same value
+      /// \param[in] _value Number to write
+      public: void Write(double _value)
+      {
+        char text[32];
+#if defined(__cpp_lib_to_chars)
+        const auto result = std::to_chars(text, text + sizeof(text), _value);
+        this->Write(text, static_cast<std::size_t>(result.ptr - text));
+#else
+        const int size = std::snprintf(text, sizeof(text), "%.17g", _value);
+        this->Write(text, static_cast<std::size_t>(size));
+#endif
+      }
+
+      /// \brief Write a number as text, with the fewest digits that read
+      /// back to the same single precision value
+      /// \param[in] _value Number to write
+      public: void Write(float _value)
+      {
+        char text[32];
+#if defined(__cpp_lib_to_chars)
+        const auto result = std::to_chars(text, text + sizeof(text), _value);
+        this->Write(text, static_cast<std::size_t>(result.ptr - text));
+#else
+        const int size = std::snprintf(text, sizeof(text), "%.9g",
+            static_cast<double>(_value));
+        this->Write(text, static_cast<std::size_t>(size));
+#endif
+      }
+
+      /// \brief Write an unsigned integer as text
+      /// \param[in] _value Number to write
+      public: void Write(uint64_t _value)
+      {
+        char text[24];
+        const auto result = std::to_chars(text, text + sizeof(text), _value);
+        this->Write(text, static_cast<std::size_t>(result.ptr - text));
+      }
+
+      /// \brief Write the buffer to the file
+      public: void Flush()
+      {
+        if (!this->buffer.empty())
+          this->WriteFile(this->buffer.data(), this->buffer.size());
+        this->buffer.clear();
+      }
+
+      /// \brief Flush and close the file
+      /// \return True if the file was opened and every write succeeded
+      public: bool Close()
+      {
+        if (!this->file)
+          return false;
+        this->Flush();
+        if (std::fclose(this->file) != 0)
+          this->ok = false;
+        this->file = nullptr;
+        return this->ok;
+      }
+
+      /// \brief Write bytes to the file, bypassing the buffer
+      /// \param[in] _data Bytes to write
+      /// \param[in] _size Number of bytes
+      private: void WriteFile(const void *_data, std::size_t _size)
+      {
+        if (!this->file || std::fwrite(_data, 1u, _size, this->file) != _size)
+          this->ok = false;
+      }
+
+      /// \brief The file, or nullptr if it could not be opened or is closed
+      private: std::FILE *file = nullptr;
+
+      /// \brief Bytes not written yet
+      private: std::vector<char> buffer;
+
+      /// \brief False once a write failed
+      private: bool ok = true;
+    };
+  }
+}
+#endif
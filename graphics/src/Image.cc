@@ -79,6 +79,8 @@
 #include <gz/common/Util.hh>
 #include <gz/common/Image.hh>
 
+#include "PixelKernels.hh"
+
 using namespace gz;
 using namespace common;
 
@@ -339,6 +341,12 @@ void Image::SetFromData(const unsigned char *_data,
     swapRedBlue = true;
     scanlineBytes = _width * 3;
   }
+  else if (_format == BGRA_INT8)
+  {
+    bpp = 32;
+    swapRedBlue = true;
+    scanlineBytes = _width * 4;
+  }
   else if ((_format == BAYER_RGGB8) ||
            (_format == BAYER_BGGR8) ||
            (_format == BAYER_GBRG8) ||
@@ -366,9 +374,8 @@ void Image::SetFromData(const unsigned char *_data,
 
   if (swapRedBlue)
   {
-    auto bitmap = reinterpret_cast<uint8_t*>(this->dataPtr->bitmap);
-    for (size_t i = 0; i < _width * _height; ++i)
-      std::swap(bitmap[3 * i], bitmap[3 * i + 2]);
+    pixelkernels::SwapRedBlue(static_cast<uint8_t *>(this->dataPtr->bitmap),
+        bpp / 8, static_cast<std::size_t>(_width) * _height);
   }
 
   this->dataPtr->width = _width;
@@ -481,134 +488,6 @@ int Image::Pitch() const
          this->dataPtr->bits_per_channel / 8;
 }
 
-//////////////////////////////////////////////////
-namespace {
-
-/// \brief Compute the luminance of an RGB triple, matching stbi__compute_y so
-/// that channel reductions stay bit-identical to stb_image.
-/// \tparam T Sample type (unsigned char for 8-bit, uint16_t for 16-bit).
-/// \param[in] _r Red component.
-/// \param[in] _g Green component.
-/// \param[in] _b Blue component.
-/// \return The computed luminance as type T.
-template <typename T>
-inline T ComputeLuminance(int _r, int _g, int _b)
-{
-  return static_cast<T>(((_r * 77) + (_g * 150) + (29 * _b)) >> 8);
-}
-
-/// \brief Convert pixel data from _inCh to _outCh channels in a single pass.
-/// _src is never modified or freed. This mirrors stbi__convert_format /
-/// stbi__convert_format16 byte-for-byte, but avoids the clone-input +
-/// copy-output overhead those functions impose (they free their input, so the
-/// caller previously had to duplicate the bitmap and then copy the result into
-/// the returned vector).
-/// \tparam T Sample type (unsigned char for 8-bit, uint16_t for 16-bit).
-/// \param[in] _src Source pixels (_npix * _inCh samples).
-/// \param[in] _inCh Number of channels in the source.
-/// \param[out] _dst Destination buffer (_npix * _outCh samples).
-/// \param[in] _outCh Number of channels to write.
-/// \param[in] _npix Number of pixels to convert.
-/// \param[in] _aMax Opaque alpha to insert (255 for 8-bit, 0xffff for 16-bit).
-/// \return False if the channel combination is unsupported.
-template <typename T>
-bool ConvertChannels(const T *_src, int _inCh, T *_dst, int _outCh,
-    std::size_t _npix, T _aMax)
-{
-  // Pack the (input, output) channel counts into one integer, _inCh * 8 +
-  // _outCh, so each supported combination maps to a unique case and can be
-  // dispatched by a single switch (mirrors stb_image's STBI__COMBO macro).
-  switch (_inCh * 8 + _outCh)
-  {
-    case 1 * 8 + 2:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 2)
-      {
-        _dst[0] = _src[0];
-        _dst[1] = _aMax;
-      }
-      break;
-    case 1 * 8 + 3:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 3)
-      {
-        _dst[0] = _dst[1] = _dst[2] = _src[0];
-      }
-      break;
-    case 1 * 8 + 4:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 4)
-      {
-        _dst[0] = _dst[1] = _dst[2] = _src[0];
-        _dst[3] = _aMax;
-      }
-      break;
-    case 2 * 8 + 1:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 1)
-      {
-        _dst[0] = _src[0];
-      }
-      break;
-    case 2 * 8 + 3:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 3)
-      {
-        _dst[0] = _dst[1] = _dst[2] = _src[0];
-      }
-      break;
-    case 2 * 8 + 4:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 4)
-      {
-        _dst[0] = _dst[1] = _dst[2] = _src[0];
-        _dst[3] = _src[1];
-      }
-      break;
-    case 3 * 8 + 4:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 4)
-      {
-        _dst[0] = _src[0];
-        _dst[1] = _src[1];
-        _dst[2] = _src[2];
-        _dst[3] = _aMax;
-      }
-      break;
-    case 3 * 8 + 1:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 1)
-      {
-        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
-      }
-      break;
-    case 3 * 8 + 2:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 2)
-      {
-        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
-        _dst[1] = _aMax;
-      }
-      break;
-    case 4 * 8 + 1:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 1)
-      {
-        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
-      }
-      break;
-    case 4 * 8 + 2:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 2)
-      {
-        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
-        _dst[1] = _src[3];
-      }
-      break;
-    case 4 * 8 + 3:
-      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 3)
-      {
-        _dst[0] = _src[0];
-        _dst[1] = _src[1];
-        _dst[2] = _src[2];
-      }
-      break;
-    default:
-      return false;
-  }
-  return true;
-}
-
-}  // namespace
 
 std::vector<unsigned char>
 Image::Implementation::DataWithChannels(int out_channels) const
@@ -634,16 +513,21 @@ Image::Implementation::DataWithChannels(int out_channels) const
   switch (this->bits_per_channel)
   {
   case 8:
-    ok = ConvertChannels(static_cast<const unsigned char *>(this->bitmap),
-        this->channels, data.data(), out_channels, npix,
-        static_cast<unsigned char>(255));
+    ok = pixelkernels::ConvertChannels(
+        static_cast<const uint8_t *>(this->bitmap), this->channels,
+        data.data(), out_channels, npix);
     break;
   case 16:
-    ok = ConvertChannels(static_cast<const uint16_t *>(this->bitmap),
-        this->channels, reinterpret_cast<uint16_t *>(data.data()),
-        out_channels, npix, static_cast<uint16_t>(0xffff));
+    ok = pixelkernels::ConvertChannels(
+        static_cast<const uint16_t *>(this->bitmap), this->channels,
+        reinterpret_cast<uint16_t *>(data.data()), out_channels, npix);
     break;
-  default:  // 32-bit float is not supported by the channel converter
+  case 32:
+    ok = pixelkernels::ConvertChannels(
+        static_cast<const float *>(this->bitmap), this->channels,
+        reinterpret_cast<float *>(data.data()), out_channels, npix);
+    break;
+  default:
     break;
   }
 
@@ -667,6 +551,30 @@ std::vector<unsigned char> Image::RGBAData() const
   return this->dataPtr->DataWithChannels(4);
 }
 
+//////////////////////////////////////////////////
+Image::PixelView Image::View() const
+{
+  if (!this->Valid())
+    return PixelView();
+
+  return PixelView(static_cast<const unsigned char *>(this->dataPtr->bitmap),
+      this->dataPtr->width, this->dataPtr->height, this->Pitch(),
+      this->dataPtr->channels, this->dataPtr->bits_per_channel / 8,
+      this->PixelFormat());
+}
+
+//////////////////////////////////////////////////
+Image::MutablePixelView Image::MutableView()
+{
+  if (!this->Valid())
+    return MutablePixelView();
+
+  return MutablePixelView(static_cast<unsigned char *>(this->dataPtr->bitmap),
+      this->dataPtr->width, this->dataPtr->height, this->Pitch(),
+      this->dataPtr->channels, this->dataPtr->bits_per_channel / 8,
+      this->PixelFormat());
+}
+
 //////////////////////////////////////////////////
 std::vector<unsigned char> Image::Data() const
 {
@@ -776,44 +684,110 @@ math::Color Image::Pixel(unsigned int _x, unsigned int _y) const
   return clr;
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the pixels of an image read by the pixel kernels
+/// \param[in] _view View of the image
+/// \param[in] _stride Distance between two read pixels
+/// \param[out] _grid The pixels
+/// \return False for float pixels, which math::Color clamps, and for
+/// formats that the pixel kernels do not read
+static bool pixelGrid(const Image::PixelView &_view, unsigned int _stride,
+    pixelkernels::Grid &_grid)
+{
+  if (!_view.Valid() || _view.ChannelStride() > 2u ||
+      _view.Channels() < 1u || _view.Channels() > 4u)
+  {
+    return false;
+  }
+
+  _grid.data = _view.Data();
+  _grid.width = _view.Width();
+  _grid.height = _view.Height();
+  _grid.pitch = _view.Pitch();
+  _grid.channels = _view.Channels();
+  _grid.channelSize = _view.ChannelStride();
+  _grid.stride = std::max(_stride, 1u);
+  return true;
+}
+
 //////////////////////////////////////////////////
 math::Color Image::AvgColor() const
 {
-  unsigned int x, y;
-  double rsum, gsum, bsum;
-  math::Color pixel;
+  return this->AvgColor(1u);
+}
 
+//////////////////////////////////////////////////
+math::Color Image::AvgColor(unsigned int _stride) const
+{
+  _stride = std::max(_stride, 1u);
+
+  // Pixel() does not read 2 channels, which are left to it to report
+  pixelkernels::Grid grid;
+  if (pixelGrid(this->View(), _stride, grid) && grid.channels != 2u)
+  {
+    // Integer sums are exact, so the average does not depend on the order
+    // in which the rows are added
+    uint64_t sums[4];
+    const std::size_t count = pixelkernels::SumChannels(grid, sums);
+    const double scale =
+        (grid.channelSize == 1u ? 255.0 : 65535.0) * static_cast<double>(count);
+    const unsigned int green = grid.channels >= 3u ? 1u : 0u;
+    const unsigned int blue = grid.channels >= 3u ? 2u : 0u;
+    return math::Color(sums[0] / scale, sums[green] / scale,
+        sums[blue] / scale);
+  }
+
+  double rsum, gsum, bsum;
   rsum = gsum = bsum = 0.0;
-  for (y = 0; y < this->Height(); ++y)
+  std::size_t count = 0u;
+  for (unsigned int y = 0; y < this->Height(); y += _stride)
   {
-    for (x = 0; x < this->Width(); ++x)
+    for (unsigned int x = 0; x < this->Width(); x += _stride)
     {
-      pixel = this->Pixel(x, y);
+      math::Color pixel = this->Pixel(x, y);
       rsum += pixel.R();
       gsum += pixel.G();
       bsum += pixel.B();
+      ++count;
     }
   }
 
-  rsum /= (this->Width() * this->Height());
-  gsum /= (this->Width() * this->Height());
-  bsum /= (this->Width() * this->Height());
+  rsum /= count;
+  gsum /= count;
+  bsum /= count;
 
   return math::Color(rsum, gsum, bsum);
 }
 
 //////////////////////////////////////////////////
 math::Color Image::MaxColor() const
+{
+  return this->MaxColor(1u);
+}
+
+//////////////////////////////////////////////////
+math::Color Image::MaxColor(unsigned int _stride) const
 {
   math::Color maxClr;
 
   if (!this->Valid())
     return maxClr;
 
+  _stride = std::max(_stride, 1u);
   maxClr.Set(0, 0, 0, 0);
-  for (unsigned int y = 0; y < this->Height(); y++)
+
+  pixelkernels::Grid grid;
+  if (pixelGrid(this->View(), _stride, grid) && grid.channels != 2u)
   {
-    for (unsigned int x = 0; x < this->Width(); x++)
+    unsigned int x, y;
+    if (pixelkernels::BrightestPixel(grid, x, y))
+      maxClr = this->Pixel(x, y);
+    return maxClr;
+  }
+
+  for (unsigned int y = 0; y < this->Height(); y += _stride)
+  {
+    for (unsigned int x = 0; x < this->Width(); x += _stride)
     {
       math::Color clr = this->Pixel(x, y);
       if (clr.R() + clr.G() + clr.B() > maxClr.R() + maxClr.G() + maxClr.B())
@@ -826,6 +800,113 @@ math::Color Image::MaxColor() const
   return maxClr;
 }
 
+//////////////////////////////////////////////////
+math::Color Image::MinColor(unsigned int _stride) const
+{
+  math::Color minClr;
+
+  if (!this->Valid())
+    return minClr;
+
+  _stride = std::max(_stride, 1u);
+
+  pixelkernels::Grid grid;
+  if (pixelGrid(this->View(), _stride, grid) && grid.channels != 2u)
+  {
+    unsigned int x, y;
+    if (pixelkernels::DarkestPixel(grid, x, y))
+      minClr = this->Pixel(x, y);
+    return minClr;
+  }
+
+  bool found = false;
+  for (unsigned int y = 0; y < this->Height(); y += _stride)
+  {
+    for (unsigned int x = 0; x < this->Width(); x += _stride)
+    {
+      math::Color clr = this->Pixel(x, y);
+      if (!found ||
+          clr.R() + clr.G() + clr.B() < minClr.R() + minClr.G() + minClr.B())
+      {
+        minClr = clr;
+        found = true;
+      }
+    }
+  }
+
+  return minClr;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::size_t> Image::Histogram(Channel _channel,
+    unsigned int _bins, unsigned int _stride) const
+{
+  std::vector<std::size_t> bins;
+  if (!this->Valid() || _bins == 0u)
+    return bins;
+
+  _stride = std::max(_stride, 1u);
+  bins.resize(_bins, 0u);
+
+  const PixelView view = this->View();
+  const unsigned int channels = view.Channels();
+  unsigned int channel = static_cast<unsigned int>(_channel);
+  if (_channel == Channel::ALPHA)
+  {
+    // Images without alpha are opaque
+    if (channels % 2u != 0u)
+    {
+      const std::size_t count =
+          static_cast<std::size_t>((view.Width() + _stride - 1u) / _stride) *
+          ((view.Height() + _stride - 1u) / _stride);
+      bins.back() = count;
+      return bins;
+    }
+    channel = channels - 1u;
+  }
+  else if (channels < 3u)
+  {
+    channel = 0u;
+  }
+
+  pixelkernels::Grid grid;
+  if (pixelGrid(view, _stride, grid))
+  {
+    pixelkernels::Histogram(grid, channel, bins);
+    return bins;
+  }
+
+  if (view.ChannelStride() != sizeof(float))
+  {
+    gzerr << "Image: Unsupported bits per channel ["
+          << view.ChannelStride() * 8 << "] \n";
+    return {};
+  }
+
+  // Rows are read like Pixel() does, from the bottom
+  for (unsigned int y = 0; y < view.Height(); y += _stride)
+  {
+    for (unsigned int x = 0; x < view.Width(); x += _stride)
+    {
+      const float value = reinterpret_cast<const float *>(
+          view.PixelData(x, view.Height() - 1u - y))[channel];
+      // NaN and negative values go in the first bin
+      std::size_t bin = 0u;
+      if (value >= 1.0f)
+      {
+        bin = _bins - 1u;
+      }
+      else if (value > 0.0f)
+      {
+        bin = std::min<std::size_t>(_bins - 1u,
+            static_cast<std::size_t>(value * _bins));
+      }
+      ++bins[bin];
+    }
+  }
+  return bins;
+}
+
 //////////////////////////////////////////////////
 void Image::Rescale(int _width, int _height)
 {
@@ -965,8 +1046,8 @@ std::vector<unsigned char> Image::ChannelData(Channel _channel) const
     return this->Data();
   }
 
-  if ((ch == 1 && _channel != Channel::RED) ||
-      (ch == 3 && _channel == Channel::ALPHA))
+  const int ch_i = static_cast<int>(_channel);
+  if (ch_i >= ch)
   {
     gzerr << "Failed to extract channel data for input channel: "
           << static_cast<int>(_channel) << std::endl;
@@ -975,28 +1056,21 @@ std::vector<unsigned char> Image::ChannelData(Channel _channel) const
   std::vector<unsigned char> data;
   data.resize(Width() * Height());
 
-  int ch_i = static_cast<int>(_channel);
-
-  for (size_t i = 0; i < Width() * Height(); i++)
+  const std::size_t count = data.size();
+  switch (bpc)
   {
-    switch (bpc)
-    {
-    case 8: {
-      auto * pixel = reinterpret_cast<const uint8_t *>(bitmap) + i * ch;
-      data[i] = pixel[ch_i];
-      break;
-    }
-    case 16: {
-      auto * pixel = reinterpret_cast<const uint16_t *>(bitmap) + i * ch;
-      data[i] = pixel[ch_i] >> 8;
-      break;
-    }
-    case 32: {
-      auto * pixel = reinterpret_cast<const float *>(bitmap) + i * ch;
-      data[i] = static_cast<unsigned char>(pixel[ch_i] * 255.0f);
-      break;
-    }
-    }
+  case 8:
+    pixelkernels::ExtractChannel(static_cast<const uint8_t *>(bitmap), ch,
+        ch_i, data.data(), count);
+    break;
+  case 16:
+    pixelkernels::ExtractChannel(static_cast<const uint16_t *>(bitmap), ch,
+        ch_i, data.data(), count);
+    break;
+  case 32:
+    pixelkernels::ExtractChannel(static_cast<const float *>(bitmap), ch,
+        ch_i, data.data(), count);
+    break;
   }
   return data;
 }
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <filesystem>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/ImageCache.hh"
+#include "gz/common/Util.hh"
+
+using namespace gz;
+using namespace common;
+
+using ImagePtr = std::shared_ptr<const Image>;
+
+/// \brief Private data for ImageCache
+class gz::common::ImageCache::Implementation
+{
+  /// \brief An image in the cache
+  public: struct Entry
+  {
+    /// \brief The image
+    ImagePtr image;
+
+    /// \brief Modification time of the file when it was decoded
+    std::filesystem::file_time_type modified;
+
+    /// \brief Memory used by the pixels of the image
+    std::size_t bytes = 0u;
+
+    /// \brief Position of the key in lru
+    std::list<std::string>::iterator position;
+  };
+
+  /// \brief Move an image to the front of the eviction order. The mutex
+  /// must be locked.
+  /// \param[in] _entry Entry of the image
+  public: void Touch(Entry &_entry)
+  {
+    this->lru.splice(this->lru.begin(), this->lru, _entry.position);
+  }
+
+  /// \brief Remove an image from the cache. The mutex must be locked.
+  /// \param[in] _iter Iterator to the entry of the image
+  public: void Forget(std::unordered_map<std::string, Entry>::iterator _iter)
+  {
+    this->stats.residentBytes -= _iter->second.bytes;
+    --this->stats.residentCount;
+    this->lru.erase(_iter->second.position);
+    this->entries.erase(_iter);
+  }
+
+  /// \brief Remove the least recently used images, skipping the ones held
+  /// outside of the cache, until their memory use is within the budget.
+  /// The mutex must be locked.
+  public: void Evict()
+  {
+    if (this->memoryBudget == 0u)
+      return;
+
+    std::vector<std::string> evicted;
+    std::size_t bytes = this->stats.residentBytes;
+    for (auto iter = this->lru.rbegin();
+         iter != this->lru.rend() && bytes > this->memoryBudget; ++iter)
+    {
+      // Images are only copied from the map with the mutex locked, so an
+      // image that only the map holds can not gain a user here
+      const Entry &entry = this->entries[*iter];
+      if (entry.image.use_count() > 1)
+        continue;
+      bytes -= entry.bytes;
+      evicted.push_back(*iter);
+    }
+
+    for (const std::string &key : evicted)
+    {
+      this->Forget(this->entries.find(key));
+      ++this->stats.evictions;
+    }
+  }
+
+  /// \brief Protects all the members
+  public: mutable std::mutex mutex;
+
+  /// \brief Images, indexed by resolved path and pixel format
+  public: std::unordered_map<std::string, Entry> entries;
+
+  /// \brief Images being decoded, indexed like entries. Threads that load
+  /// an image which is in this map wait for its result instead of decoding
+  /// it again.
+  public: std::unordered_map<std::string, std::shared_future<ImagePtr>>
+          loading;
+
+  /// \brief Keys of the images, most recently used first
+  public: std::list<std::string> lru;
+
+  /// \brief Memory budget in bytes, 0 for no limit
+  public: std::size_t memoryBudget = ImageCache::DefaultMemoryBudget;
+
+  /// \brief Load counters and resident memory
+  public: ImageCache::Statistics stats;
+};
+
+namespace
+{
+/// \brief Get the memory used by the pixels of an image
+/// \param[in] _image The image
+/// \return Size in bytes
+std::size_t ImageBytes(const Image &_image)
+{
+  return static_cast<std::size_t>(_image.Pitch()) * _image.Height();
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+ImageCache::ImageCache()
+: dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+ImageCache *ImageCache::Instance()
+{
+  static ImageCache cache;
+  return &cache;
+}
+
+//////////////////////////////////////////////////
+ImagePtr ImageCache::Load(const std::string &_filename,
+    std::optional<Image::PixelFormatType> _format)
+{
+  // Resolve the file like Image::Load, so that different names of the same
+  // file share one image
+  std::string path = _filename;
+  if (!exists(path))
+    path = common::findFile(_filename);
+  if (path.empty() || !exists(path))
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      ++this->dataPtr->stats.misses;
+    }
+    gzerr << "Unable to open image file[" << _filename
+          << "], check your GZ_RESOURCE_PATH settings.\n";
+    return nullptr;
+  }
+
+  std::error_code ec;
+  const std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+  if (!ec)
+    path = absolute.lexically_normal().string();
+  const std::filesystem::file_time_type modified =
+      std::filesystem::last_write_time(path, ec);
+
+  const std::string key = path + '\n' +
+      (_format ? std::to_string(static_cast<int>(*_format)) : "native");
+
+  // Return the image if it is decoded, wait for it if another thread is
+  // decoding it, or reserve it so that other threads wait for this one
+  std::promise<ImagePtr> promise;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->entries.find(key);
+    if (iter != this->dataPtr->entries.end())
+    {
+      if (iter->second.modified == modified)
+      {
+        ++this->dataPtr->stats.hits;
+        this->dataPtr->Touch(iter->second);
+        return iter->second.image;
+      }
+      // The file changed since it was decoded
+      this->dataPtr->Forget(iter);
+    }
+
+    auto loadingIter = this->dataPtr->loading.find(key);
+    if (loadingIter != this->dataPtr->loading.end())
+    {
+      ++this->dataPtr->stats.hits;
+      std::shared_future<ImagePtr> result = loadingIter->second;
+      lock.unlock();
+      return result.get();
+    }
+    ++this->dataPtr->stats.misses;
+    this->dataPtr->loading.emplace(key, promise.get_future().share());
+  }
+
+  auto image = std::make_shared<Image>();
+  ImagePtr result;
+  if (image->Load(path, _format) == 0 && image->Valid())
+    result = std::move(image);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->loading.erase(key);
+    // Failed loads are not cached, the file may be fixed later
+    if (result)
+    {
+      this->dataPtr->lru.push_front(key);
+      Implementation::Entry &entry = this->dataPtr->entries[key];
+      entry.image = result;
+      entry.modified = modified;
+      entry.bytes = ImageBytes(*result);
+      entry.position = this->dataPtr->lru.begin();
+      this->dataPtr->stats.residentBytes += entry.bytes;
+      ++this->dataPtr->stats.residentCount;
+      this->dataPtr->Evict();
+    }
+  }
+  promise.set_value(result);
+  return result;
+}
+
+//////////////////////////////////////////////////
+void ImageCache::SetMemoryBudget(std::size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->memoryBudget = _bytes;
+  this->dataPtr->Evict();
+}
+
+//////////////////////////////////////////////////
+std::size_t ImageCache::MemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->memoryBudget;
+}
+
+//////////////////////////////////////////////////
+ImageCache::Statistics ImageCache::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+
+//////////////////////////////////////////////////
+void ImageCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.clear();
+  this->dataPtr->lru.clear();
+  this->dataPtr->stats.residentCount = 0u;
+  this->dataPtr->stats.residentBytes = 0u;
+}
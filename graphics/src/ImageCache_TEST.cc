@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Image.hh"
+#include "gz/common/ImageCache.hh"
+#include "gz/common/TempDirectory.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+class ImageCacheTest : public common::testing::AutoLogFixture { };
+
+const std::string kPng =  // NOLINT(*)
+    common::testing::TestFile("data", "red_blue_colors.png");
+const std::string kJpeg =  // NOLINT(*)
+    common::testing::TestFile("data", "gazebo_logo.jpeg");
+
+/////////////////////////////////////////////////
+TEST_F(ImageCacheTest, Load)
+{
+  ImageCache cache;
+  auto image = cache.Load(kPng);
+  ASSERT_NE(nullptr, image);
+  EXPECT_TRUE(image->Valid());
+  EXPECT_EQ(Image::RGBA_INT8, image->PixelFormat());
+
+  // Other names of the same file share the image
+  EXPECT_EQ(image, cache.Load(kPng));
+  EXPECT_EQ(image, cache.Load(common::joinPaths(
+      common::testing::TestFile("data"), "..", "data", "red_blue_colors.png")));
+
+  // Other formats are decoded separately
+  auto rgba = cache.Load(kJpeg, Image::RGBA_INT8);
+  ASSERT_NE(nullptr, rgba);
+  EXPECT_EQ(Image::RGBA_INT8, rgba->PixelFormat());
+  auto native = cache.Load(kJpeg);
+  ASSERT_NE(nullptr, native);
+  EXPECT_NE(rgba, native);
+  EXPECT_EQ(Image::RGB_INT8, native->PixelFormat());
+
+  // Failed loads are not cached
+  EXPECT_EQ(nullptr, cache.Load(common::testing::TestFile("data",
+      "missing.png")));
+  EXPECT_EQ(nullptr, cache.Load(kPng, Image::R_FLOAT32));
+
+  ImageCache::Statistics stats = cache.Stats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(5u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(3u, stats.residentCount);
+  EXPECT_EQ(static_cast<std::size_t>(image->Pitch()) * image->Height() +
+      static_cast<std::size_t>(rgba->Pitch()) * rgba->Height() +
+      static_cast<std::size_t>(native->Pitch()) * native->Height(),
+      stats.residentBytes);
+
+  // Cleared images stay valid
+  cache.Clear();
+  EXPECT_EQ(0u, cache.Stats().residentCount);
+  EXPECT_EQ(0u, cache.Stats().residentBytes);
+  EXPECT_TRUE(image->Valid());
+  EXPECT_NE(image, cache.Load(kPng));
+
+  EXPECT_EQ(ImageCache::Instance(), ImageCache::Instance());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageCacheTest, ModifiedFile)
+{
+  TempDirectory temp("image_cache", "gz_common", true);
+  ASSERT_TRUE(temp.Valid());
+  const std::string path = common::joinPaths(temp.Path(), "image.png");
+  ASSERT_TRUE(common::copyFile(kPng, path));
+
+  ImageCache cache;
+  auto image = cache.Load(path);
+  ASSERT_NE(nullptr, image);
+  EXPECT_EQ(image, cache.Load(path));
+
+  // A file that changed is decoded again, and replaces the old image
+  std::filesystem::last_write_time(path,
+      std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+  auto modified = cache.Load(path);
+  ASSERT_NE(nullptr, modified);
+  EXPECT_NE(image, modified);
+  EXPECT_EQ(modified, cache.Load(path));
+  EXPECT_EQ(1u, cache.Stats().residentCount);
+  EXPECT_EQ(2u, cache.Stats().misses);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageCacheTest, MemoryBudget)
+{
+  ImageCache cache;
+  EXPECT_EQ(ImageCache::DefaultMemoryBudget, cache.MemoryBudget());
+  EXPECT_LT(0u, cache.MemoryBudget());
+  cache.SetMemoryBudget(1u);
+  EXPECT_EQ(1u, cache.MemoryBudget());
+
+  // Images that are held elsewhere are kept
+  auto png = cache.Load(kPng);
+  auto jpeg = cache.Load(kJpeg);
+  ASSERT_NE(nullptr, png);
+  ASSERT_NE(nullptr, jpeg);
+  EXPECT_EQ(2u, cache.Stats().residentCount);
+  EXPECT_EQ(0u, cache.Stats().evictions);
+
+  // The least recently used image goes first
+  png.reset();
+  jpeg.reset();
+  cache.SetMemoryBudget(cache.Stats().residentBytes - 1u);
+  EXPECT_EQ(1u, cache.Stats().residentCount);
+  EXPECT_EQ(1u, cache.Stats().evictions);
+  cache.Load(kJpeg);
+  EXPECT_EQ(1u, cache.Stats().hits);
+
+  cache.SetMemoryBudget(1u);
+  EXPECT_EQ(0u, cache.Stats().residentCount);
+  EXPECT_EQ(0u, cache.Stats().residentBytes);
+  EXPECT_EQ(2u, cache.Stats().evictions);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageCacheTest, Threads)
+{
+  // Concurrent loads of the same file decode it once
+  ImageCache cache;
+  std::vector<std::shared_ptr<const Image>> images(8u);
+  std::vector<std::thread> threads;
+  for (auto &image : images)
+    threads.emplace_back([&cache, &image]() { image = cache.Load(kJpeg); });
+  for (auto &thread : threads)
+    thread.join();
+
+  ASSERT_NE(nullptr, images[0]);
+  for (const auto &image : images)
+    EXPECT_EQ(images[0], image);
+  EXPECT_EQ(1u, cache.Stats().misses);
+  EXPECT_EQ(7u, cache.Stats().hits);
+}
@@ -14,9 +14,12 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -39,6 +42,10 @@ const std::string kTestDataRGB16 =  // NOLINT(*)
     common::testing::TestFile("data", "rgb_16bit.png");
 const std::string kTestDataRGBA16 =  // NOLINT(*)
     common::testing::TestFile("data", "rgba_16bit.png");
+const std::string kTestDataGray8bit =  // NOLINT(*)
+    common::testing::TestFile("data", "grayscale_8bit.png");
+const std::string kTestDataGray16bit =  // NOLINT(*)
+    common::testing::TestFile("data", "grayscale_16bit.png");
 
 const auto kWidth = 121u;
 const auto kHeight = 81u;
@@ -989,6 +996,128 @@ TEST_F(ImageTest, ChannelData16bit)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, View)
+{
+  common::Image invalid;
+  EXPECT_FALSE(invalid.View().Valid());
+  EXPECT_FALSE(invalid.MutableView().Valid());
+  EXPECT_EQ(0u, invalid.View().ByteSize());
+
+  common::Image img(kTestData);
+  const common::Image::PixelView view = img.View();
+  ASSERT_TRUE(view.Valid());
+  EXPECT_EQ(img.Width(), view.Width());
+  EXPECT_EQ(img.Height(), view.Height());
+  EXPECT_EQ(static_cast<std::size_t>(img.Pitch()), view.Pitch());
+  EXPECT_EQ(4u, view.Channels());
+  EXPECT_EQ(1u, view.ChannelStride());
+  EXPECT_EQ(4u, view.PixelStride());
+  EXPECT_EQ(common::Image::RGBA_INT8, view.Format());
+
+  // The view reads the bitmap that Data copies
+  const std::vector<unsigned char> data = img.Data();
+  ASSERT_EQ(data.size(), view.ByteSize());
+  EXPECT_EQ(0, std::memcmp(data.data(), view.Data(), data.size()));
+
+  // Rows of a view start at the top, rows of Pixel at the bottom
+  const unsigned char *pixel = view.PixelData(85u, view.Height() - 1u);
+  EXPECT_EQ(img.Pixel(85u, 0u), math::Color(pixel[0] / 255.0f,
+      pixel[1] / 255.0f, pixel[2] / 255.0f, pixel[3] / 255.0f));
+
+  // Pixels can be modified in place
+  common::Image::MutablePixelView mutableView = img.MutableView();
+  EXPECT_EQ(view.Data(), mutableView.Data());
+  unsigned char *first = mutableView.PixelData(0u, view.Height() - 1u);
+  first[0] = 0u;
+  first[1] = 255u;
+  first[2] = 0u;
+  EXPECT_EQ(math::Color::Green, img.Pixel(0u, 0u));
+  const common::Image::PixelView readOnly = mutableView;
+  EXPECT_EQ(255u, readOnly.Row(view.Height() - 1u)[1]);
+
+  common::Image img16(kTestDataRGB16);
+  const common::Image::PixelView view16 = img16.View();
+  EXPECT_EQ(3u, view16.Channels());
+  EXPECT_EQ(2u, view16.ChannelStride());
+  EXPECT_EQ(6u, view16.PixelStride());
+  EXPECT_EQ(common::Image::RGB_INT16, view16.Format());
+  EXPECT_EQ(view16.Data() + view16.Pitch(), view16.Row(1u));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Statistics)
+{
+  common::Image invalid;
+  EXPECT_EQ(math::Color(), invalid.MinColor());
+  EXPECT_TRUE(invalid.Histogram(common::Image::Channel::RED).empty());
+
+  for (const std::string &file : {kTestData, kTestDataGazeboJpeg,
+       kTestDataRGB16, kTestDataRGBA16, kTestDataGray8bit,
+       kTestDataGray16bit})
+  {
+    common::Image img(file);
+    ASSERT_TRUE(img.Valid()) << file;
+    const unsigned int bits = img.BPP() /
+        static_cast<unsigned int>(img.View().Channels());
+
+    for (unsigned int stride : {1u, 2u, 5u})
+    {
+      // Read the pixels like the statistics used to
+      double sums[3] = {0.0, 0.0, 0.0};
+      std::size_t count = 0u;
+      math::Color maxClr(0, 0, 0, 0);
+      math::Color minClr;
+      std::vector<std::size_t> bins(16u, 0u);
+      for (unsigned int y = 0u; y < img.Height(); y += stride)
+      {
+        for (unsigned int x = 0u; x < img.Width(); x += stride)
+        {
+          const math::Color clr = img.Pixel(x, y);
+          sums[0] += clr.R();
+          sums[1] += clr.G();
+          sums[2] += clr.B();
+          const float sum = clr.R() + clr.G() + clr.B();
+          if (sum > maxClr.R() + maxClr.G() + maxClr.B())
+            maxClr = clr;
+          if (count == 0u || sum < minClr.R() + minClr.G() + minClr.B())
+            minClr = clr;
+          const double value = std::round(clr.G() * ((1 << bits) - 1));
+          ++bins[static_cast<std::size_t>(value) * 16u >> bits];
+          ++count;
+        }
+      }
+
+      const math::Color avgClr = img.AvgColor(stride);
+      EXPECT_NEAR(sums[0] / count, avgClr.R(), 1e-6) << file;
+      EXPECT_NEAR(sums[1] / count, avgClr.G(), 1e-6) << file;
+      EXPECT_NEAR(sums[2] / count, avgClr.B(), 1e-6) << file;
+      EXPECT_EQ(maxClr, img.MaxColor(stride)) << file;
+      EXPECT_EQ(minClr, img.MinColor(stride)) << file;
+      EXPECT_EQ(bins, img.Histogram(common::Image::Channel::GREEN, 16u,
+          stride)) << file;
+    }
+
+    EXPECT_EQ(img.AvgColor(1u), img.AvgColor());
+    EXPECT_EQ(img.MaxColor(1u), img.MaxColor());
+    // A stride of 0 reads every pixel
+    EXPECT_EQ(img.MaxColor(), img.MaxColor(0u));
+  }
+
+  // 256 bins count every value of an 8 bit channel, opaque images have all
+  // their alpha in the last bin
+  common::Image img(kTestDataGray8bit);
+  const std::vector<unsigned char> data = img.Data();
+  std::vector<std::size_t> values(256u, 0u);
+  for (const unsigned char value : data)
+    ++values[value];
+  EXPECT_EQ(values, img.Histogram(common::Image::Channel::BLUE));
+  const std::vector<std::size_t> alpha =
+      img.Histogram(common::Image::Channel::ALPHA, 4u);
+  EXPECT_EQ((std::vector<std::size_t>{0u, 0u, 0u, data.size()}), alpha);
+  EXPECT_TRUE(img.Histogram(common::Image::Channel::RED, 0u).empty());
+}
+
 using string_int2 = std::tuple<const char *, unsigned int, unsigned int>;
 
 class ImagePerformanceTest : public ImageTest,
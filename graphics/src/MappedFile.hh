@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_MAPPEDFILE_HH_
+#define GZ_COMMON_MAPPEDFILE_HH_
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <vector>
+#endif
+
+#include <cstddef>
+#include <string>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Read-only view of a whole file, memory mapped where available
+    class MappedFile
+    {
+      /// \brief Constructor
+      /// \param[in] _path File to map
+      public: explicit MappedFile(const std::string &_path)
+      {
+#ifndef _WIN32
+        const int fd = ::open(_path.c_str(), O_RDONLY);
+        if (fd < 0)
+          return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0)
+        {
+          this->size = static_cast<std::size_t>(st.st_size);
+          if (this->size == 0u)
+          {
+            this->valid = true;
+          }
+          else
+          {
+            void *addr = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE,
+                fd, 0);
+            if (addr != MAP_FAILED)
+            {
+              this->data = static_cast<const char *>(addr);
+              this->valid = true;
+            }
+          }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(_path, std::ios::binary | std::ios::ate);
+        if (!file)
+          return;
+        this->buffer.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(this->buffer.data(), this->buffer.size()))
+          return;
+        this->data = this->buffer.data();
+        this->size = this->buffer.size();
+        this->valid = true;
+#endif
+      }
+
+      /// \brief Destructor
+      public: ~MappedFile()
+      {
+#ifndef _WIN32
+        if (this->data)
+          ::munmap(const_cast<char *>(this->data), this->size);
+#endif
+      }
+
+      /// \brief Copying would unmap twice
+      public: MappedFile(const MappedFile &) = delete;
+
+      /// \brief Copying would unmap twice
+      public: MappedFile &operator=(const MappedFile &) = delete;
+
+      /// \brief Contents of the file, 8-byte aligned
+      public: const char *data = nullptr;
+
+      /// \brief Size of the file in bytes
+      public: std::size_t size = 0u;
+
+      /// \brief True if the file was read
+      public: bool valid = false;
+
+#ifdef _WIN32
+      /// \brief Contents of the file
+      private: std::vector<char> buffer;
+#endif
+    };
+  }
+}
+#endif
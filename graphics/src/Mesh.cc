@@ -17,11 +17,14 @@
 
 #include <string>
 #include <algorithm>
+#include <unordered_set>
 
 #include "gz/math/Helpers.hh"
 
 #include "gz/common/Console.hh"
+#include "gz/common/Image.hh"
 #include "gz/common/Material.hh"
+#include "gz/common/Pbr.hh"
 #include "gz/common/Skeleton.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/Mesh.hh"
@@ -377,6 +380,13 @@ void Mesh::Translate(const gz::math::Vector3d &_vec)
     submesh->Translate(_vec);
 }
 
+//////////////////////////////////////////////////
+void Mesh::Transform(const gz::math::Matrix4d &_transform)
+{
+  for (auto &submesh : this->dataPtr->submeshes)
+    submesh->Transform(_transform);
+}
+
 //////////////////////////////////////////////////
 void Mesh::AABB(gz::math::Vector3d &_center,
                 gz::math::Vector3d &_minXYZ,
@@ -439,3 +449,38 @@ gz::math::Vector3d Mesh::Centroid() const
 
   return moment / volume;
 }
+
+//////////////////////////////////////////////////
+std::size_t Mesh::MemorySize() const
+{
+  std::size_t size = 0u;
+  for (const std::shared_ptr<SubMesh> &submesh : this->dataPtr->submeshes)
+    size += submesh->MemorySize();
+
+  // Materials can share images
+  std::unordered_set<const Image *> images;
+  auto addImage = [&](const std::shared_ptr<const Image> &_image)
+  {
+    if (_image && images.insert(_image.get()).second)
+    {
+      size += static_cast<std::size_t>(_image->Height()) *
+          static_cast<std::size_t>(_image->Pitch());
+    }
+  };
+  for (const MaterialPtr &material : this->dataPtr->materials)
+  {
+    if (!material)
+      continue;
+    addImage(material->TextureData());
+    const Pbr *pbr = material->PbrMaterial();
+    if (pbr)
+    {
+      addImage(pbr->NormalMapData());
+      addImage(pbr->RoughnessMapData());
+      addImage(pbr->MetalnessMapData());
+      addImage(pbr->EmissiveMapData());
+      addImage(pbr->LightMapData());
+    }
+  }
+  return size;
+}
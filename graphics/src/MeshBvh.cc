@@ -0,0 +1,886 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshBvh.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "Parallel.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief Number of bins used to evaluate the surface area heuristic.
+constexpr unsigned int kBinCount = 16u;
+
+/// \brief Largest number of triangles in a leaf.
+constexpr unsigned int kMaxLeafSize = 4u;
+
+/// \brief Cost of traversing a node relative to intersecting a triangle.
+constexpr double kTraversalCost = 1.0;
+
+/// \brief Smallest number of triangles built on worker threads.
+constexpr std::size_t kParallelThreshold = 1u << 15;
+
+/// \brief Smallest subtree built as a single task.
+constexpr std::size_t kMinTaskSize = 1u << 12;
+
+/// \brief Axis aligned bounds stored as plain arrays.
+struct Bounds
+{
+  std::array<double, 3> lo = {std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+  std::array<double, 3> hi = {std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::lowest()};
+
+  void Grow(const math::Vector3d &_p)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      this->lo[k] = std::min(this->lo[k], _p[k]);
+      this->hi[k] = std::max(this->hi[k], _p[k]);
+    }
+  }
+
+  void Grow(const Bounds &_b)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      this->lo[k] = std::min(this->lo[k], _b.lo[k]);
+      this->hi[k] = std::max(this->hi[k], _b.hi[k]);
+    }
+  }
+
+  double HalfArea() const
+  {
+    if (this->hi[0] < this->lo[0])
+      return 0.0;
+    const double dx = this->hi[0] - this->lo[0];
+    const double dy = this->hi[1] - this->lo[1];
+    const double dz = this->hi[2] - this->lo[2];
+    return dx * dy + dy * dz + dz * dx;
+  }
+};
+
+/// \brief Flattened hierarchy node. Interior nodes store the index of
+/// their first child, the second one follows it. Leaves store a range of
+/// triangles.
+struct Node
+{
+  Bounds bounds;
+
+  /// \brief First child for interior nodes, first triangle for leaves.
+  uint32_t first = 0u;
+
+  /// \brief Number of triangles, 0 for interior nodes.
+  uint32_t count = 0u;
+};
+
+/// \brief Triangle vertices.
+struct Triangle
+{
+  math::Vector3d v0;
+  math::Vector3d v1;
+  math::Vector3d v2;
+};
+
+/// \brief Range of triangles that still has to be split into a subtree
+/// rooted at a given node.
+struct BuildTask
+{
+  uint32_t node;
+  uint32_t begin;
+  uint32_t end;
+  uint32_t depth;
+};
+
+/// \brief Top-down builder shared by the serial and parallel paths.
+/// Triangle bounds and centroids are read only, and concurrent subtree
+/// builds work on disjoint ranges of the triangle order.
+class Builder
+{
+  public: explicit Builder(const std::vector<Triangle> &_triangles)
+  {
+    this->boxes.resize(_triangles.size());
+    this->centroids.resize(_triangles.size());
+    this->order.resize(_triangles.size());
+    for (std::size_t i = 0u; i < _triangles.size(); ++i)
+    {
+      this->boxes[i].Grow(_triangles[i].v0);
+      this->boxes[i].Grow(_triangles[i].v1);
+      this->boxes[i].Grow(_triangles[i].v2);
+      this->centroids[i] =
+          (_triangles[i].v0 + _triangles[i].v1 + _triangles[i].v2) / 3.0;
+      this->order[i] = static_cast<uint32_t>(i);
+    }
+  }
+
+  /// \brief Build the subtree of _task into _nodes. Ranges that are not
+  /// larger than _deferSize are appended to _deferred instead of being
+  /// split, unless _deferred is null.
+  /// \return Depth of the deepest node created.
+  public: uint32_t Build(std::vector<Node> &_nodes, const BuildTask &_task,
+      std::vector<BuildTask> *_deferred, std::size_t _deferSize)
+  {
+    uint32_t maxDepth = _task.depth;
+    std::vector<BuildTask> stack{_task};
+    while (!stack.empty())
+    {
+      const BuildTask task = stack.back();
+      stack.pop_back();
+      maxDepth = std::max(maxDepth, task.depth);
+
+      Bounds bounds;
+      Bounds centroidBounds;
+      for (uint32_t i = task.begin; i < task.end; ++i)
+      {
+        bounds.Grow(this->boxes[this->order[i]]);
+        centroidBounds.Grow(this->centroids[this->order[i]]);
+      }
+      _nodes[task.node].bounds = bounds;
+
+      if (_deferred && task.node != _task.node &&
+          task.end - task.begin <= _deferSize)
+      {
+        _deferred->push_back(task);
+        continue;
+      }
+
+      uint32_t mid = 0u;
+      if (!this->Split(task.begin, task.end, bounds, centroidBounds, mid))
+      {
+        _nodes[task.node].first = task.begin;
+        _nodes[task.node].count = task.end - task.begin;
+        continue;
+      }
+
+      const uint32_t left = static_cast<uint32_t>(_nodes.size());
+      _nodes.resize(_nodes.size() + 2);
+      _nodes[task.node].first = left;
+      _nodes[task.node].count = 0u;
+      stack.push_back({left + 1, mid, task.end, task.depth + 1});
+      stack.push_back({left, task.begin, mid, task.depth + 1});
+    }
+    return maxDepth;
+  }
+
+  /// \brief Choose where to split a range of triangles with the binned
+  /// surface area heuristic, and partition the range.
+  /// \param[out] _mid First triangle of the second half.
+  /// \return False if the range should become a leaf.
+  private: bool Split(uint32_t _begin, uint32_t _end, const Bounds &_bounds,
+      const Bounds &_centroidBounds, uint32_t &_mid)
+  {
+    const uint32_t count = _end - _begin;
+    if (count <= 1u)
+      return false;
+
+    int bestAxis = -1;
+    unsigned int bestBin = 0u;
+    double bestCost = std::numeric_limits<double>::max();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double extent =
+          _centroidBounds.hi[axis] - _centroidBounds.lo[axis];
+      if (extent <= 0.0)
+        continue;
+      const double scale = kBinCount / extent;
+
+      std::array<Bounds, kBinCount> binBounds;
+      std::array<uint32_t, kBinCount> binCounts{};
+      for (uint32_t i = _begin; i < _end; ++i)
+      {
+        const uint32_t t = this->order[i];
+        const unsigned int bin = this->BinOf(t, axis,
+            _centroidBounds.lo[axis], scale);
+        binBounds[bin].Grow(this->boxes[t]);
+        ++binCounts[bin];
+      }
+
+      // Sweep from the right to get the cost of every right half
+      std::array<double, kBinCount> rightCost{};
+      Bounds right;
+      uint32_t rightCount = 0u;
+      for (unsigned int b = kBinCount - 1; b > 0u; --b)
+      {
+        right.Grow(binBounds[b]);
+        rightCount += binCounts[b];
+        rightCost[b] = right.HalfArea() * rightCount;
+      }
+
+      Bounds left;
+      uint32_t leftCount = 0u;
+      for (unsigned int b = 0u; b + 1 < kBinCount; ++b)
+      {
+        left.Grow(binBounds[b]);
+        leftCount += binCounts[b];
+        if (leftCount == 0u || leftCount == count)
+          continue;
+        const double cost = left.HalfArea() * leftCount + rightCost[b + 1];
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestBin = b;
+        }
+      }
+    }
+
+    if (bestAxis >= 0)
+    {
+      const double area = _bounds.HalfArea();
+      const double splitCost = area > 0.0 ?
+          kTraversalCost + bestCost / area : kTraversalCost;
+      if (count <= kMaxLeafSize && splitCost >= count)
+        return false;
+
+      const double lo = _centroidBounds.lo[bestAxis];
+      const double scale =
+          kBinCount / (_centroidBounds.hi[bestAxis] - lo);
+      auto it = std::partition(this->order.begin() + _begin,
+          this->order.begin() + _end,
+          [&](uint32_t _t)
+          {
+            return this->BinOf(_t, bestAxis, lo, scale) <= bestBin;
+          });
+      _mid = static_cast<uint32_t>(it - this->order.begin());
+      if (_mid != _begin && _mid != _end)
+        return true;
+    }
+
+    // All centroids are at the same place, split in the middle
+    if (count <= kMaxLeafSize)
+      return false;
+    _mid = _begin + count / 2;
+    return true;
+  }
+
+  /// \brief Bin of the centroid of a triangle along an axis.
+  private: unsigned int BinOf(uint32_t _t, int _axis, double _lo,
+      double _scale) const
+  {
+    const double f = (this->centroids[_t][_axis] - _lo) * _scale;
+    return std::min(static_cast<unsigned int>(std::max(f, 0.0)),
+        kBinCount - 1);
+  }
+
+  /// \brief Bounds of every triangle.
+  public: std::vector<Bounds> boxes;
+
+  /// \brief Centroid of every triangle.
+  public: std::vector<math::Vector3d> centroids;
+
+  /// \brief Triangle order, leaves reference contiguous ranges of it.
+  public: std::vector<uint32_t> order;
+};
+
+/// \brief Small stack for tree traversal that only allocates for very
+/// deep trees.
+class TraversalStack
+{
+  public: explicit TraversalStack(uint32_t _depth)
+  {
+    if (_depth + 2 > this->local.size())
+    {
+      this->heap.resize(_depth + 2);
+      this->data = this->heap.data();
+    }
+  }
+
+  public: void Push(uint32_t _node)
+  {
+    this->data[this->size++] = _node;
+  }
+
+  public: uint32_t Pop()
+  {
+    return this->data[--this->size];
+  }
+
+  public: bool Empty() const
+  {
+    return this->size == 0u;
+  }
+
+  private: std::array<uint32_t, 64> local;
+  private: std::vector<uint32_t> heap;
+  private: uint32_t *data = local.data();
+  private: uint32_t size = 0u;
+};
+
+/// \brief Distance along a ray to the entry point of a box.
+/// \return Infinity if the ray misses the box within _tMax.
+double RayBoxEntry(const Bounds &_b, const std::array<double, 3> &_origin,
+    const std::array<double, 3> &_invDir, double _tMax)
+{
+  // Slab test written without branches so the three axes can be
+  // evaluated with vector instructions.
+  std::array<double, 3> tNear;
+  std::array<double, 3> tFar;
+  for (int k = 0; k < 3; ++k)
+  {
+    const double t0 = (_b.lo[k] - _origin[k]) * _invDir[k];
+    const double t1 = (_b.hi[k] - _origin[k]) * _invDir[k];
+    tNear[k] = std::min(t0, t1);
+    tFar[k] = std::max(t0, t1);
+  }
+  const double entry = std::max(std::max(tNear[0], tNear[1]),
+      std::max(tNear[2], 0.0));
+  const double exit = std::min(std::min(tFar[0], tFar[1]),
+      std::min(tFar[2], _tMax));
+  return entry <= exit ? entry : std::numeric_limits<double>::infinity();
+}
+
+/// \brief Moller-Trumbore ray triangle intersection, hitting both sides.
+/// \return Distance along the ray, or infinity if there is no hit.
+double RayTriangle(const math::Vector3d &_origin, const math::Vector3d &_dir,
+    const Triangle &_tri)
+{
+  const math::Vector3d e1 = _tri.v1 - _tri.v0;
+  const math::Vector3d e2 = _tri.v2 - _tri.v0;
+  const math::Vector3d p = _dir.Cross(e2);
+  const double det = e1.Dot(p);
+  if (det == 0.0 || !std::isfinite(det))
+    return std::numeric_limits<double>::infinity();
+  const double invDet = 1.0 / det;
+  const math::Vector3d s = _origin - _tri.v0;
+  const double u = s.Dot(p) * invDet;
+  if (u < 0.0 || u > 1.0)
+    return std::numeric_limits<double>::infinity();
+  const math::Vector3d q = s.Cross(e1);
+  const double v = _dir.Dot(q) * invDet;
+  if (v < 0.0 || u + v > 1.0)
+    return std::numeric_limits<double>::infinity();
+  const double t = e2.Dot(q) * invDet;
+  return t >= 0.0 ? t : std::numeric_limits<double>::infinity();
+}
+
+/// \brief Squared distance from a point to a box.
+double PointBoxDistanceSq(const Bounds &_b, const math::Vector3d &_p)
+{
+  double d = 0.0;
+  for (int k = 0; k < 3; ++k)
+  {
+    const double v = std::max(std::max(_b.lo[k] - _p[k], 0.0),
+        _p[k] - _b.hi[k]);
+    d += v * v;
+  }
+  return d;
+}
+
+/// \brief Closest point on a triangle, from Ericson, Real-Time Collision
+/// Detection, 5.1.5.
+math::Vector3d ClosestPointOnTriangle(const math::Vector3d &_p,
+    const Triangle &_tri)
+{
+  const math::Vector3d &a = _tri.v0;
+  const math::Vector3d &b = _tri.v1;
+  const math::Vector3d &c = _tri.v2;
+  const math::Vector3d ab = b - a;
+  const math::Vector3d ac = c - a;
+  const math::Vector3d ap = _p - a;
+  const double d1 = ab.Dot(ap);
+  const double d2 = ac.Dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return a;
+
+  const math::Vector3d bp = _p - b;
+  const double d3 = ab.Dot(bp);
+  const double d4 = ac.Dot(bp);
+  if (d3 >= 0.0 && d4 <= d3)
+    return b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return a + ab * (d1 / (d1 - d3));
+
+  const math::Vector3d cp = _p - c;
+  const double d5 = ab.Dot(cp);
+  const double d6 = ac.Dot(cp);
+  if (d6 >= 0.0 && d5 <= d6)
+    return c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return a + ac * (d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+  const double denom = va + vb + vc;
+  if (denom <= 0.0)
+  {
+    // Degenerate triangle, fall back to its vertices
+    const double da = (a - _p).SquaredLength();
+    const double db = (b - _p).SquaredLength();
+    const double dc = (c - _p).SquaredLength();
+    return da <= db && da <= dc ? a : (db <= dc ? b : c);
+  }
+  const double v = vb / denom;
+  const double w = vc / denom;
+  return a + ab * v + ac * w;
+}
+
+/// \brief Separating axis test between a triangle and a box, from
+/// Akenine-Moller, Fast 3D Triangle-Box Overlap Testing.
+bool TriangleBoxOverlap(const Triangle &_tri, const math::Vector3d &_center,
+    const math::Vector3d &_half)
+{
+  const math::Vector3d v[3] = {_tri.v0 - _center, _tri.v1 - _center,
+      _tri.v2 - _center};
+
+  // Box face normals
+  for (int k = 0; k < 3; ++k)
+  {
+    const double lo = std::min(std::min(v[0][k], v[1][k]), v[2][k]);
+    const double hi = std::max(std::max(v[0][k], v[1][k]), v[2][k]);
+    if (lo > _half[k] || hi < -_half[k])
+      return false;
+  }
+
+  // Triangle normal
+  const math::Vector3d e[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+  const math::Vector3d normal = e[0].Cross(e[1]);
+  const double r = _half.X() * std::abs(normal.X()) +
+      _half.Y() * std::abs(normal.Y()) + _half.Z() * std::abs(normal.Z());
+  if (std::abs(normal.Dot(v[0])) > r)
+    return false;
+
+  // Cross products of the edges and the box axes
+  const math::Vector3d axes[3] = {math::Vector3d::UnitX,
+      math::Vector3d::UnitY, math::Vector3d::UnitZ};
+  for (const auto &edge : e)
+  {
+    for (const auto &boxAxis : axes)
+    {
+      const math::Vector3d axis = boxAxis.Cross(edge);
+      const double p0 = axis.Dot(v[0]);
+      const double p1 = axis.Dot(v[1]);
+      const double p2 = axis.Dot(v[2]);
+      const double radius = _half.X() * std::abs(axis.X()) +
+          _half.Y() * std::abs(axis.Y()) + _half.Z() * std::abs(axis.Z());
+      if (std::min(std::min(p0, p1), p2) > radius ||
+          std::max(std::max(p0, p1), p2) < -radius)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// \brief Append the triangles of a submesh.
+/// \return False if the submesh is not made of triangles or has invalid
+/// indices.
+bool AppendSubMesh(const SubMesh &_subMesh, unsigned int _subMeshIndex,
+    std::vector<Triangle> &_triangles, std::vector<MeshBvh::TriangleId> &_ids)
+{
+  if (_subMesh.SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+    return false;
+  if (!_subMesh.HasValidIndices())
+  {
+    gzerr << "Submesh [" << _subMesh.Name() << "] has invalid indices, "
+          << "unable to add it to the bounding volume hierarchy" << std::endl;
+    return false;
+  }
+
+  const math::Vector3d *vertices = _subMesh.VertexPtr();
+  const SubMesh::IndexView indices = _subMesh.Indices();
+  const unsigned int triangleCount = _subMesh.IndexCount() / 3;
+  _triangles.reserve(_triangles.size() + triangleCount);
+  _ids.reserve(_ids.size() + triangleCount);
+  for (unsigned int t = 0u; t < triangleCount; ++t)
+  {
+    _triangles.push_back({vertices[indices[3 * t]],
+        vertices[indices[3 * t + 1]], vertices[indices[3 * t + 2]]});
+    _ids.push_back({_subMeshIndex, t});
+  }
+  return true;
+}
+}  // namespace
+
+/// \brief Private data for the MeshBvh class
+class gz::common::MeshBvh::Implementation
+{
+  /// \brief Build the hierarchy from a list of triangles.
+  /// \param[in] _triangles Triangles in source order.
+  /// \param[in] _ids Triangle ids in source order.
+  /// \param[in] _parallel True to build subtrees on worker threads.
+  public: void Build(std::vector<Triangle> &&_triangles,
+              std::vector<TriangleId> &&_ids, bool _parallel);
+
+  /// \brief Flattened nodes, the root is the first node.
+  public: std::vector<Node> nodes;
+
+  /// \brief Triangles in leaf order.
+  public: std::vector<Triangle> triangles;
+
+  /// \brief Triangle ids in leaf order.
+  public: std::vector<TriangleId> ids;
+
+  /// \brief Depth of the deepest node.
+  public: uint32_t depth = 0u;
+};
+
+//////////////////////////////////////////////////
+void MeshBvh::Implementation::Build(std::vector<Triangle> &&_triangles,
+    std::vector<TriangleId> &&_ids, bool _parallel)
+{
+  this->nodes.clear();
+  this->triangles.clear();
+  this->ids.clear();
+  this->depth = 0u;
+  if (_triangles.empty())
+    return;
+
+  Builder builder(_triangles);
+  // Every split adds two nodes, and leaves hold at least one triangle
+  this->nodes.reserve(2 * _triangles.size());
+  this->nodes.resize(1);
+
+  const BuildTask root{0u, 0u, static_cast<uint32_t>(_triangles.size()), 0u};
+  if (!_parallel || _triangles.size() < kParallelThreshold)
+  {
+    this->depth = builder.Build(this->nodes, root, nullptr, 0u);
+  }
+  else
+  {
+    // Split the top of the tree serially until the ranges are small enough
+    // to keep every worker busy, then build those subtrees concurrently
+    const std::size_t workers = parallel::Concurrency();
+    const std::size_t deferSize = std::max(kMinTaskSize,
+        _triangles.size() / (4 * workers));
+    std::vector<BuildTask> deferred;
+    this->depth = builder.Build(this->nodes, root, &deferred, deferSize);
+
+    std::vector<std::vector<Node>> subtrees(deferred.size());
+    std::vector<uint32_t> depths(deferred.size(), 0u);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(deferred.size());
+    for (std::size_t i = 0u; i < deferred.size(); ++i)
+    {
+      tasks.push_back([&builder, &deferred, &subtrees, &depths, i]()
+          {
+            BuildTask task = deferred[i];
+            task.node = 0u;
+            subtrees[i].resize(1);
+            depths[i] = builder.Build(subtrees[i], task, nullptr, 0u);
+          });
+    }
+    parallel::Run(tasks);
+
+    // Attach every subtree to its placeholder node
+    for (std::size_t i = 0u; i < deferred.size(); ++i)
+    {
+      std::vector<Node> &subtree = subtrees[i];
+      const uint32_t base = static_cast<uint32_t>(this->nodes.size()) - 1u;
+      for (Node &node : subtree)
+      {
+        if (node.count == 0u)
+          node.first += base;
+      }
+      this->nodes[deferred[i].node] = subtree[0];
+      this->nodes.insert(this->nodes.end(), subtree.begin() + 1,
+          subtree.end());
+      this->depth = std::max(this->depth, depths[i]);
+    }
+  }
+
+  this->triangles.reserve(_triangles.size());
+  this->ids.reserve(_ids.size());
+  for (uint32_t t : builder.order)
+  {
+    this->triangles.push_back(_triangles[t]);
+    this->ids.push_back(_ids[t]);
+  }
+  this->nodes.shrink_to_fit();
+}
+
+//////////////////////////////////////////////////
+MeshBvh::MeshBvh()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+bool MeshBvh::Build(const SubMesh &_subMesh, bool _parallel)
+{
+  std::vector<Triangle> triangles;
+  std::vector<TriangleId> ids;
+  if (!AppendSubMesh(_subMesh, 0u, triangles, ids))
+  {
+    this->Clear();
+    return false;
+  }
+  this->dataPtr->Build(std::move(triangles), std::move(ids), _parallel);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MeshBvh::Build(const Mesh &_mesh, bool _parallel)
+{
+  std::vector<Triangle> triangles;
+  std::vector<TriangleId> ids;
+  bool added = false;
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (subMesh)
+      added = AppendSubMesh(*subMesh, i, triangles, ids) || added;
+  }
+  this->dataPtr->Build(std::move(triangles), std::move(ids), _parallel);
+  return added;
+}
+
+//////////////////////////////////////////////////
+void MeshBvh::Clear()
+{
+  this->dataPtr->nodes.clear();
+  this->dataPtr->triangles.clear();
+  this->dataPtr->ids.clear();
+  this->dataPtr->depth = 0u;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshBvh::TriangleCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->triangles.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshBvh::NodeCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->nodes.size());
+}
+
+//////////////////////////////////////////////////
+math::AxisAlignedBox MeshBvh::Bounds() const
+{
+  if (this->dataPtr->nodes.empty())
+    return math::AxisAlignedBox();
+  const auto &b = this->dataPtr->nodes[0].bounds;
+  return math::AxisAlignedBox(math::Vector3d(b.lo[0], b.lo[1], b.lo[2]),
+      math::Vector3d(b.hi[0], b.hi[1], b.hi[2]));
+}
+
+//////////////////////////////////////////////////
+std::optional<MeshBvh::RayHit> MeshBvh::Raycast(
+    const math::Vector3d &_origin, const math::Vector3d &_direction,
+    double _maxDistance) const
+{
+  const double length = _direction.Length();
+  if (this->dataPtr->nodes.empty() || length <= 0.0 || !(_maxDistance >= 0.0))
+    return std::nullopt;
+
+  const math::Vector3d dir = _direction / length;
+  const std::array<double, 3> origin = {_origin.X(), _origin.Y(),
+      _origin.Z()};
+  std::array<double, 3> invDir;
+  for (int k = 0; k < 3; ++k)
+  {
+    // Avoid 0 * inf in the slab test for rays parallel to an axis
+    const double d = std::abs(dir[k]) > 1e-300 ? dir[k] :
+        std::copysign(1e-300, dir[k]);
+    invDir[k] = 1.0 / d;
+  }
+
+  const auto &nodes = this->dataPtr->nodes;
+  double best = _maxDistance;
+  uint32_t bestTriangle = std::numeric_limits<uint32_t>::max();
+  if (!std::isfinite(RayBoxEntry(nodes[0].bounds, origin, invDir, best)))
+    return std::nullopt;
+
+  TraversalStack stack(this->dataPtr->depth);
+  stack.Push(0u);
+  while (!stack.Empty())
+  {
+    const Node &node = nodes[stack.Pop()];
+    if (node.count > 0u)
+    {
+      for (uint32_t t = node.first; t < node.first + node.count; ++t)
+      {
+        const double dist =
+            RayTriangle(_origin, dir, this->dataPtr->triangles[t]);
+        if (dist <= best)
+        {
+          best = dist;
+          bestTriangle = t;
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearest child first
+    uint32_t near = node.first;
+    uint32_t far = node.first + 1;
+    double tNear = RayBoxEntry(nodes[near].bounds, origin, invDir, best);
+    double tFar = RayBoxEntry(nodes[far].bounds, origin, invDir, best);
+    if (tFar < tNear)
+    {
+      std::swap(near, far);
+      std::swap(tNear, tFar);
+    }
+    if (std::isfinite(tFar))
+      stack.Push(far);
+    if (std::isfinite(tNear))
+      stack.Push(near);
+  }
+
+  if (bestTriangle == std::numeric_limits<uint32_t>::max())
+    return std::nullopt;
+
+  const Triangle &tri = this->dataPtr->triangles[bestTriangle];
+  RayHit hit;
+  hit.id = this->dataPtr->ids[bestTriangle];
+  hit.distance = best;
+  hit.point = _origin + dir * best;
+  hit.normal = (tri.v1 - tri.v0).Cross(tri.v2 - tri.v0).Normalize();
+  return hit;
+}
+
+//////////////////////////////////////////////////
+std::optional<MeshBvh::PointHit> MeshBvh::ClosestPoint(
+    const math::Vector3d &_point, double _maxDistance) const
+{
+  const auto &nodes = this->dataPtr->nodes;
+  if (nodes.empty() || !(_maxDistance >= 0.0))
+    return std::nullopt;
+
+  double bestSq = std::isfinite(_maxDistance) ?
+      _maxDistance * _maxDistance : std::numeric_limits<double>::infinity();
+  uint32_t bestTriangle = std::numeric_limits<uint32_t>::max();
+  math::Vector3d bestPoint;
+  if (PointBoxDistanceSq(nodes[0].bounds, _point) > bestSq)
+    return std::nullopt;
+
+  TraversalStack stack(this->dataPtr->depth);
+  stack.Push(0u);
+  while (!stack.Empty())
+  {
+    const Node &node = nodes[stack.Pop()];
+    if (PointBoxDistanceSq(node.bounds, _point) > bestSq)
+      continue;
+
+    if (node.count > 0u)
+    {
+      for (uint32_t t = node.first; t < node.first + node.count; ++t)
+      {
+        const math::Vector3d p =
+            ClosestPointOnTriangle(_point, this->dataPtr->triangles[t]);
+        const double distSq = (p - _point).SquaredLength();
+        if (distSq <= bestSq)
+        {
+          bestSq = distSq;
+          bestTriangle = t;
+          bestPoint = p;
+        }
+      }
+      continue;
+    }
+
+    uint32_t near = node.first;
+    uint32_t far = node.first + 1;
+    double dNear = PointBoxDistanceSq(nodes[near].bounds, _point);
+    double dFar = PointBoxDistanceSq(nodes[far].bounds, _point);
+    if (dFar < dNear)
+    {
+      std::swap(near, far);
+      std::swap(dNear, dFar);
+    }
+    if (dFar <= bestSq)
+      stack.Push(far);
+    if (dNear <= bestSq)
+      stack.Push(near);
+  }
+
+  if (bestTriangle == std::numeric_limits<uint32_t>::max())
+    return std::nullopt;
+
+  PointHit hit;
+  hit.id = this->dataPtr->ids[bestTriangle];
+  hit.distance = std::sqrt(bestSq);
+  hit.point = bestPoint;
+  return hit;
+}
+
+//////////////////////////////////////////////////
+std::vector<MeshBvh::TriangleId> MeshBvh::Overlap(
+    const math::AxisAlignedBox &_box) const
+{
+  std::vector<TriangleId> result;
+  const auto &nodes = this->dataPtr->nodes;
+  if (nodes.empty())
+    return result;
+
+  const math::Vector3d boxMin = _box.Min();
+  const math::Vector3d boxMax = _box.Max();
+  if (boxMin.X() > boxMax.X() || boxMin.Y() > boxMax.Y() ||
+      boxMin.Z() > boxMax.Z())
+  {
+    return result;
+  }
+  const math::Vector3d center = (boxMin + boxMax) * 0.5;
+  const math::Vector3d half = (boxMax - boxMin) * 0.5;
+
+  auto overlaps = [&](const ::Bounds &_b)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      if (_b.lo[k] > boxMax[k] || _b.hi[k] < boxMin[k])
+        return false;
+    }
+    return true;
+  };
+
+  if (!overlaps(nodes[0].bounds))
+    return result;
+
+  TraversalStack stack(this->dataPtr->depth);
+  stack.Push(0u);
+  while (!stack.Empty())
+  {
+    const Node &node = nodes[stack.Pop()];
+    if (node.count > 0u)
+    {
+      for (uint32_t t = node.first; t < node.first + node.count; ++t)
+      {
+        if (TriangleBoxOverlap(this->dataPtr->triangles[t], center, half))
+          result.push_back(this->dataPtr->ids[t]);
+      }
+      continue;
+    }
+    if (overlaps(nodes[node.first + 1].bounds))
+      stack.Push(node.first + 1);
+    if (overlaps(nodes[node.first].bounds))
+      stack.Push(node.first);
+  }
+  return result;
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshBvh.hh"
+#include "gz/common/MeshManager.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class MeshBvh : public common::testing::AutoLogFixture { };
+
+namespace
+{
+/// \brief Brute force ray cast against every triangle of a submesh.
+double BruteForceRaycast(const common::SubMesh &_subMesh,
+    const math::Vector3d &_origin, const math::Vector3d &_dir)
+{
+  double best = std::numeric_limits<double>::infinity();
+  for (unsigned int i = 0; i + 2 < _subMesh.IndexCount(); i += 3)
+  {
+    const math::Vector3d v0 = _subMesh.Vertex(_subMesh.Index(i));
+    const math::Vector3d e1 = _subMesh.Vertex(_subMesh.Index(i + 1)) - v0;
+    const math::Vector3d e2 = _subMesh.Vertex(_subMesh.Index(i + 2)) - v0;
+    const math::Vector3d p = _dir.Cross(e2);
+    const double det = e1.Dot(p);
+    if (std::abs(det) < 1e-12)
+      continue;
+    const math::Vector3d s = _origin - v0;
+    const double u = s.Dot(p) / det;
+    const math::Vector3d q = s.Cross(e1);
+    const double v = _dir.Dot(q) / det;
+    const double t = e2.Dot(q) / det;
+    if (u >= 0 && v >= 0 && u + v <= 1 && t >= 0)
+      best = std::min(best, t);
+  }
+  return best;
+}
+
+/// \brief Deterministic pseudo random direction.
+math::Vector3d Direction(unsigned int _i)
+{
+  const double phi = _i * 2.399963;
+  const double z = 1.0 - 2.0 * ((_i % 97) + 0.5) / 97.0;
+  const double r = std::sqrt(1.0 - z * z);
+  return math::Vector3d(r * std::cos(phi), r * std::sin(phi), z);
+}
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBvh, Empty)
+{
+  common::MeshBvh bvh;
+  EXPECT_EQ(0u, bvh.TriangleCount());
+  EXPECT_EQ(0u, bvh.NodeCount());
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d::Zero, math::Vector3d::UnitX));
+  EXPECT_FALSE(bvh.ClosestPoint(math::Vector3d::Zero));
+  EXPECT_TRUE(bvh.Overlap(math::AxisAlignedBox(
+      math::Vector3d(-1, -1, -1), math::Vector3d(1, 1, 1))).empty());
+
+  // Only triangles are supported
+  common::SubMesh lines("lines");
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  lines.AddVertex(0, 0, 0);
+  lines.AddVertex(1, 0, 0);
+  lines.AddIndex(0);
+  lines.AddIndex(1);
+  EXPECT_FALSE(bvh.Build(lines));
+
+  // Invalid indices
+  common::SubMesh invalid("invalid");
+  invalid.AddVertex(0, 0, 0);
+  invalid.AddIndex(0);
+  invalid.AddIndex(1);
+  invalid.AddIndex(2);
+  EXPECT_FALSE(bvh.Build(invalid));
+  EXPECT_EQ(0u, bvh.TriangleCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBvh, Box)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateBox("bvh_box", math::Vector3d(2, 4, 6), math::Vector2d(1, 1));
+  const common::Mesh *mesh = mgr->MeshByName("bvh_box");
+  ASSERT_NE(nullptr, mesh);
+  auto subMesh = mesh->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  common::MeshBvh bvh;
+  ASSERT_TRUE(bvh.Build(*subMesh));
+  EXPECT_EQ(12u, bvh.TriangleCount());
+  EXPECT_GT(bvh.NodeCount(), 0u);
+  EXPECT_EQ(math::Vector3d(-1, -2, -3), bvh.Bounds().Min());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), bvh.Bounds().Max());
+
+  // Ray along an axis, from outside
+  auto hit = bvh.Raycast(math::Vector3d(-10, 0.1, 0.2),
+      math::Vector3d(2, 0, 0));
+  ASSERT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(9.0, hit->distance);
+  EXPECT_EQ(math::Vector3d(-1, 0.1, 0.2), hit->point);
+  EXPECT_EQ(0u, hit->id.subMesh);
+  EXPECT_LT(hit->id.triangle, 12u);
+  EXPECT_NEAR(1.0, std::abs(hit->normal.X()), 1e-12);
+
+  // From inside
+  hit = bvh.Raycast(math::Vector3d::Zero, math::Vector3d(0, 0, -1));
+  ASSERT_TRUE(hit);
+  EXPECT_DOUBLE_EQ(3.0, hit->distance);
+
+  // Too short, pointing away and missing
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d(-10, 0, 0),
+      math::Vector3d::UnitX, 8.0));
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d(-10, 0, 0),
+      -math::Vector3d::UnitX));
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d(-10, 5, 0),
+      math::Vector3d::UnitX));
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d(-10, 0, 0),
+      math::Vector3d::Zero));
+
+  // Closest point
+  auto closest = bvh.ClosestPoint(math::Vector3d(0, 0, 10));
+  ASSERT_TRUE(closest);
+  EXPECT_DOUBLE_EQ(7.0, closest->distance);
+  EXPECT_EQ(math::Vector3d(0, 0, 3), closest->point);
+  closest = bvh.ClosestPoint(math::Vector3d(0.5, 0, 0));
+  ASSERT_TRUE(closest);
+  EXPECT_DOUBLE_EQ(0.5, closest->distance);
+  EXPECT_EQ(math::Vector3d(1, 0, 0), closest->point);
+  closest = bvh.ClosestPoint(math::Vector3d(3, 4, 3));
+  ASSERT_TRUE(closest);
+  EXPECT_EQ(math::Vector3d(1, 2, 3), closest->point);
+  EXPECT_FALSE(bvh.ClosestPoint(math::Vector3d(0, 0, 10), 6.5));
+
+  // Overlap with the +Z face only
+  auto ids = bvh.Overlap(math::AxisAlignedBox(
+      math::Vector3d(-0.5, -0.5, 2.5), math::Vector3d(0.5, 0.5, 3.5)));
+  EXPECT_EQ(2u, ids.size());
+  for (const auto &id : ids)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      EXPECT_DOUBLE_EQ(3.0,
+          subMesh->Vertex(subMesh->Index(3 * id.triangle + k)).Z());
+    }
+  }
+
+  // Box inside the mesh does not touch any triangle
+  EXPECT_TRUE(bvh.Overlap(math::AxisAlignedBox(
+      math::Vector3d(-0.5, -0.5, -0.5), math::Vector3d(0.5, 0.5, 0.5)))
+      .empty());
+
+  // Box around the mesh contains all of them
+  EXPECT_EQ(12u, bvh.Overlap(math::AxisAlignedBox(
+      math::Vector3d(-5, -5, -5), math::Vector3d(5, 5, 5))).size());
+
+  bvh.Clear();
+  EXPECT_EQ(0u, bvh.TriangleCount());
+  EXPECT_FALSE(bvh.Raycast(math::Vector3d(-10, 0, 0),
+      math::Vector3d::UnitX));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBvh, BruteForce)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("bvh_sphere", 1.0, 40, 40);
+  const common::Mesh *mesh = mgr->MeshByName("bvh_sphere");
+  ASSERT_NE(nullptr, mesh);
+  auto subMesh = mesh->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  common::MeshBvh bvh;
+  ASSERT_TRUE(bvh.Build(*subMesh));
+  EXPECT_EQ(subMesh->IndexCount() / 3, bvh.TriangleCount());
+
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    const math::Vector3d origin = Direction(i) * 3.0;
+    const math::Vector3d dir = (Direction(i + 1000) * 0.5 - origin)
+        .Normalize();
+    const double expected = BruteForceRaycast(*subMesh, origin, dir);
+    auto hit = bvh.Raycast(origin, dir);
+    ASSERT_EQ(std::isfinite(expected), hit.has_value()) << i;
+    if (hit)
+    {
+      EXPECT_NEAR(expected, hit->distance, 1e-9) << i;
+      EXPECT_NEAR(1.0, hit->point.Length(), 0.01) << i;
+    }
+
+    // Brute force closest point by sampling the vertices: the closest
+    // point can never be further than the closest vertex
+    const math::Vector3d point = Direction(i + 500) * (0.5 + 0.01 * i);
+    double closestVertex = std::numeric_limits<double>::infinity();
+    for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+    {
+      closestVertex = std::min(closestVertex,
+          (subMesh->Vertex(v) - point).Length());
+    }
+    auto closest = bvh.ClosestPoint(point);
+    ASSERT_TRUE(closest);
+    EXPECT_LE(closest->distance, closestVertex + 1e-12);
+    EXPECT_NEAR(std::abs(point.Length() - 1.0), closest->distance, 0.01);
+    EXPECT_NEAR(closest->distance, (closest->point - point).Length(), 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBvh, Mesh)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateBox("bvh_mesh_box", math::Vector3d(1, 1, 1),
+      math::Vector2d(1, 1));
+  const common::Mesh *box = mgr->MeshByName("bvh_mesh_box");
+  ASSERT_NE(nullptr, box);
+  auto subMesh = box->SubMeshByIndex(0).lock();
+
+  common::Mesh mesh;
+  common::SubMesh lines("lines");
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  lines.AddVertex(0, 0, 0);
+  lines.AddVertex(1, 0, 0);
+  lines.AddIndex(0);
+  lines.AddIndex(1);
+  mesh.AddSubMesh(lines);
+  common::SubMesh first(*subMesh);
+  mesh.AddSubMesh(first);
+  common::SubMesh second(*subMesh);
+  second.Translate(math::Vector3d(5, 0, 0));
+  mesh.AddSubMesh(second);
+
+  common::MeshBvh bvh;
+  ASSERT_TRUE(bvh.Build(mesh));
+  EXPECT_EQ(24u, bvh.TriangleCount());
+
+  auto hit = bvh.Raycast(math::Vector3d(10, 0, 0), -math::Vector3d::UnitX);
+  ASSERT_TRUE(hit);
+  EXPECT_EQ(2u, hit->id.subMesh);
+  EXPECT_DOUBLE_EQ(4.5, hit->distance);
+
+  hit = bvh.Raycast(math::Vector3d(-10, 0, 0), math::Vector3d::UnitX);
+  ASSERT_TRUE(hit);
+  EXPECT_EQ(1u, hit->id.subMesh);
+  EXPECT_DOUBLE_EQ(9.5, hit->distance);
+
+  auto closest = bvh.ClosestPoint(math::Vector3d(3.5, 0, 0));
+  ASSERT_TRUE(closest);
+  EXPECT_EQ(2u, closest->id.subMesh);
+  EXPECT_DOUBLE_EQ(1.0, closest->distance);
+
+  auto ids = bvh.Overlap(math::AxisAlignedBox(
+      math::Vector3d(4, -1, -1), math::Vector3d(6, 1, 1)));
+  EXPECT_EQ(12u, ids.size());
+  for (const auto &id : ids)
+    EXPECT_EQ(2u, id.subMesh);
+
+  // A mesh without triangles
+  common::Mesh linesOnly;
+  linesOnly.AddSubMesh(lines);
+  EXPECT_FALSE(bvh.Build(linesOnly));
+  EXPECT_EQ(0u, bvh.TriangleCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshBvh, Parallel)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("bvh_large_sphere", 1.0, 200, 200);
+  const common::Mesh *mesh = mgr->MeshByName("bvh_large_sphere");
+  ASSERT_NE(nullptr, mesh);
+  auto subMesh = mesh->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  common::MeshBvh serial;
+  ASSERT_TRUE(serial.Build(*subMesh));
+  common::MeshBvh parallel;
+  ASSERT_TRUE(parallel.Build(*subMesh, true));
+  EXPECT_EQ(serial.TriangleCount(), parallel.TriangleCount());
+  EXPECT_EQ(serial.Bounds().Min(), parallel.Bounds().Min());
+  EXPECT_EQ(serial.Bounds().Max(), parallel.Bounds().Max());
+
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    const math::Vector3d origin = Direction(i) * 3.0;
+    const math::Vector3d dir = -origin;
+    auto a = serial.Raycast(origin, dir);
+    auto b = parallel.Raycast(origin, dir);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    EXPECT_DOUBLE_EQ(a->distance, b->distance);
+    EXPECT_NEAR(2.0, a->distance, 1e-3);
+
+    const math::Vector3d point = Direction(i + 100) * 0.3;
+    auto c = serial.ClosestPoint(point);
+    auto d = parallel.ClosestPoint(point);
+    ASSERT_TRUE(c);
+    ASSERT_TRUE(d);
+    EXPECT_DOUBLE_EQ(c->distance, d->distance);
+  }
+
+  const math::AxisAlignedBox box(math::Vector3d(0.5, -0.2, -0.2),
+      math::Vector3d(1.5, 0.2, 0.2));
+  auto a = serial.Overlap(box);
+  auto b = parallel.Overlap(box);
+  EXPECT_FALSE(a.empty());
+  auto less = [](const common::MeshBvh::TriangleId &_a,
+      const common::MeshBvh::TriangleId &_b)
+  {
+    return _a.triangle < _b.triangle;
+  };
+  std::sort(a.begin(), a.end(), less);
+  std::sort(b.begin(), b.end(), less);
+  ASSERT_EQ(a.size(), b.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_EQ(a[i].triangle, b[i].triangle);
+}
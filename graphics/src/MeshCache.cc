@@ -0,0 +1,1093 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Matrix4.hh>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Image.hh"
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/NodeAnimation.hh"
+#include "gz/common/NodeTransform.hh"
+#include "gz/common/Pbr.hh"
+#include "gz/common/Skeleton.hh"
+#include "gz/common/SkeletonAnimation.hh"
+#include "gz/common/SkeletonNode.hh"
+#include "gz/common/SubMesh.hh"
+#include "gz/common/Util.hh"
+
+#include "MappedFile.hh"
+#include "MeshCache.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  /// \brief First bytes of a cache file
+  constexpr char kMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', 0, 0};
+
+  /// \brief Version of the format, increased on every change
+  constexpr uint32_t kVersion = 2u;
+
+  /// \brief Written in native byte order, to reject files written on a
+  /// machine with another byte order
+  constexpr uint32_t kByteOrder = 0x01020304u;
+
+  /// \brief Extension of the cache files
+  constexpr char kExtension[] = ".gzmesh";
+
+  static_assert(sizeof(math::Vector3d) == 3 * sizeof(double),
+      "Vertices are written as arrays of doubles");
+
+  /// \brief Get the id of this process, which names the temporary files
+  /// of processes sharing a cache directory apart
+  /// \return The process id
+  long ProcessId()
+  {
+#ifdef _WIN32
+    return static_cast<long>(_getpid());
+#else
+    return static_cast<long>(getpid());
+#endif
+  }
+
+  /// \brief Appends values to a buffer
+  class Writer
+  {
+    /// \brief Constructor
+    /// \param[in] _buffer Buffer to append to
+    public: explicit Writer(std::vector<char> &_buffer)
+      : buffer(_buffer)
+    {
+    }
+
+    /// \brief Append the bytes of a value
+    /// \param[in] _value Value to append
+    public: template<typename T>
+    void Pod(const T &_value)
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      this->Bytes(&_value, sizeof(T));
+    }
+
+    /// \brief Append raw bytes
+    /// \param[in] _data Bytes to append
+    /// \param[in] _size Number of bytes
+    public: void Bytes(const void *_data, std::size_t _size)
+    {
+      const char *data = static_cast<const char *>(_data);
+      this->buffer.insert(this->buffer.end(), data, data + _size);
+    }
+
+    /// \brief Append a string, preceded by its length
+    /// \param[in] _value String to append
+    public: void String(const std::string &_value)
+    {
+      this->Pod<uint64_t>(_value.size());
+      this->Bytes(_value.data(), _value.size());
+    }
+
+    /// \brief Pad the buffer to a multiple of 8 bytes
+    public: void Align()
+    {
+      this->buffer.resize((this->buffer.size() + 7u) & ~std::size_t{7u}, 0);
+    }
+
+    /// \brief Append an array, preceded by its length and aligned to 8
+    /// bytes
+    /// \param[in] _data First element
+    /// \param[in] _count Number of elements
+    public: template<typename T>
+    void Array(const T *_data, std::size_t _count)
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      this->Pod<uint64_t>(_count);
+      this->Align();
+      if (_count > 0u)
+        this->Bytes(_data, _count * sizeof(T));
+    }
+
+    /// \brief Append a matrix, row by row
+    /// \param[in] _matrix Matrix to append
+    public: void Matrix(const math::Matrix4d &_matrix)
+    {
+      for (unsigned int i = 0; i < 4; ++i)
+        for (unsigned int j = 0; j < 4; ++j)
+          this->Pod(_matrix(i, j));
+    }
+
+    /// \brief Append a color
+    /// \param[in] _color Color to append
+    public: void Color(const math::Color &_color)
+    {
+      this->Pod(_color.R());
+      this->Pod(_color.G());
+      this->Pod(_color.B());
+      this->Pod(_color.A());
+    }
+
+    /// \brief Buffer to append to
+    private: std::vector<char> &buffer;
+  };
+
+  /// \brief Reads values written by Writer. Reading past the end clears
+  /// the ok flag and returns default values.
+  class Reader
+  {
+    /// \brief Constructor
+    /// \param[in] _data Data to read, 8-byte aligned
+    /// \param[in] _size Size of _data in bytes
+    public: Reader(const char *_data, std::size_t _size)
+      : data(_data), size(_size)
+    {
+    }
+
+    /// \brief Read a value
+    /// \return The value
+    public: template<typename T>
+    T Pod()
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      T value{};
+      if (!this->ok || this->size - this->pos < sizeof(T))
+      {
+        this->ok = false;
+        return value;
+      }
+      std::memcpy(&value, this->data + this->pos, sizeof(T));
+      this->pos += sizeof(T);
+      return value;
+    }
+
+    /// \brief Read a string
+    /// \return The string
+    public: std::string String()
+    {
+      const uint64_t length = this->Pod<uint64_t>();
+      if (!this->ok || this->size - this->pos < length)
+      {
+        this->ok = false;
+        return std::string();
+      }
+      std::string value(this->data + this->pos, length);
+      this->pos += length;
+      return value;
+    }
+
+    /// \brief Skip the padding to the next multiple of 8 bytes
+    public: void Align()
+    {
+      const std::size_t aligned = (this->pos + 7u) & ~std::size_t{7u};
+      if (aligned > this->size)
+        this->ok = false;
+      else
+        this->pos = aligned;
+    }
+
+    /// \brief Read an array in place
+    /// \param[out] _count Number of elements
+    /// \return First element, pointing into the data
+    public: template<typename T>
+    const T *Array(std::size_t &_count)
+    {
+      _count = static_cast<std::size_t>(this->Pod<uint64_t>());
+      this->Align();
+      if (!this->ok || _count > (this->size - this->pos) / sizeof(T))
+      {
+        this->ok = false;
+        _count = 0u;
+        return nullptr;
+      }
+      const T *values = reinterpret_cast<const T *>(this->data + this->pos);
+      this->pos += _count * sizeof(T);
+      return values;
+    }
+
+    /// \brief Read a matrix
+    /// \return The matrix
+    public: math::Matrix4d Matrix()
+    {
+      math::Matrix4d matrix;
+      for (unsigned int i = 0; i < 4; ++i)
+        for (unsigned int j = 0; j < 4; ++j)
+          matrix(i, j) = this->Pod<double>();
+      return matrix;
+    }
+
+    /// \brief Read a color
+    /// \return The color
+    public: math::Color Color()
+    {
+      const float r = this->Pod<float>();
+      const float g = this->Pod<float>();
+      const float b = this->Pod<float>();
+      const float a = this->Pod<float>();
+      return math::Color(r, g, b, a);
+    }
+
+    /// \brief Check that a count read from the data is plausible, to
+    /// reject corrupt counts before allocating. Clears the ok flag if it
+    /// is not.
+    /// \param[in] _count Number of elements
+    /// \param[in] _minSize Minimum size of an element in bytes
+    /// \return True if the remaining data can hold _count elements
+    public: bool Fits(uint64_t _count, std::size_t _minSize)
+    {
+      if (this->ok && _count > (this->size - this->pos) / _minSize)
+        this->ok = false;
+      return this->ok;
+    }
+
+    /// \brief Offset of the next value
+    public: std::size_t Position() const
+    {
+      return this->pos;
+    }
+
+    /// \brief False once a read failed
+    public: bool ok = true;
+
+    /// \brief Data to read
+    private: const char *data;
+
+    /// \brief Size of the data
+    private: std::size_t size;
+
+    /// \brief Offset of the next value
+    private: std::size_t pos = 0u;
+  };
+
+  /// \brief Version of a source file stored in a cache file
+  struct SourceStamp
+  {
+    /// \brief Size in bytes
+    uint64_t size = 0u;
+
+    /// \brief Modification time, in file clock ticks
+    int64_t time = 0;
+  };
+
+  /// \brief Get the size and modification time of a file
+  /// \param[in] _path The file
+  /// \param[out] _stamp Size and modification time
+  /// \return False if the file can not be read
+  bool Stamp(const std::string &_path, SourceStamp &_stamp)
+  {
+    std::error_code ec;
+    const auto size = fs::file_size(_path, ec);
+    if (ec)
+      return false;
+    const auto time = fs::last_write_time(_path, ec);
+    if (ec)
+      return false;
+    _stamp.size = size;
+    _stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+  }
+
+  /// \brief Hash the contents of a file
+  /// \param[in] _path The file
+  /// \param[out] _hash Hash of the contents
+  /// \return False if the file can not be read
+  bool ContentHash(const std::string &_path, uint64_t &_hash)
+  {
+    MappedFile file(_path);
+    if (!file.valid)
+      return false;
+    _hash = hash64(std::string_view(file.data, file.size));
+    return true;
+  }
+
+  /// \brief Write an optional image. Only 8-bit formats are supported.
+  /// \param[in] _writer Destination
+  /// \param[in] _image Image, may be null
+  /// \return False if the image format is not supported
+  bool WriteImage(Writer &_writer, const std::shared_ptr<const Image> &_image)
+  {
+    if (!_image || !_image->Valid())
+    {
+      _writer.Pod<uint8_t>(0u);
+      return true;
+    }
+    const Image::PixelFormatType format = _image->PixelFormat();
+    if (format != Image::L_INT8 && format != Image::RGB_INT8 &&
+        format != Image::RGBA_INT8)
+    {
+      return false;
+    }
+    _writer.Pod<uint8_t>(1u);
+    _writer.Pod<uint32_t>(static_cast<uint32_t>(format));
+    _writer.Pod<uint32_t>(_image->Width());
+    _writer.Pod<uint32_t>(_image->Height());
+    const Image::PixelView view = _image->View();
+    _writer.Array(view.Data(), view.ByteSize());
+    return true;
+  }
+
+  /// \brief Read an optional image
+  /// \param[in] _reader Source
+  /// \return The image, null if none was written
+  std::shared_ptr<const Image> ReadImage(Reader &_reader)
+  {
+    if (_reader.Pod<uint8_t>() == 0u)
+      return nullptr;
+    const auto format =
+        static_cast<Image::PixelFormatType>(_reader.Pod<uint32_t>());
+    const uint32_t width = _reader.Pod<uint32_t>();
+    const uint32_t height = _reader.Pod<uint32_t>();
+    std::size_t count = 0u;
+    const unsigned char *data = _reader.Array<unsigned char>(count);
+    const std::size_t channels = format == Image::L_INT8 ? 1u :
+        format == Image::RGB_INT8 ? 3u : format == Image::RGBA_INT8 ? 4u : 0u;
+    if (!_reader.ok || channels == 0u ||
+        count != std::size_t{width} * height * channels)
+    {
+      _reader.ok = false;
+      return nullptr;
+    }
+    auto image = std::make_shared<Image>();
+    image->SetFromData(data, width, height, format);
+    return image;
+  }
+
+  /// \brief Write a material
+  /// \param[in] _writer Destination
+  /// \param[in] _material Material to write
+  /// \return False if the material has an image that can not be written
+  bool WriteMaterial(Writer &_writer, const Material &_material)
+  {
+    _writer.String(_material.TextureImage());
+    if (!WriteImage(_writer, _material.TextureData()))
+      return false;
+    _writer.Color(_material.Ambient());
+    _writer.Color(_material.Diffuse());
+    _writer.Color(_material.Specular());
+    _writer.Color(_material.Emissive());
+    _writer.Pod(_material.Transparency());
+    _writer.Pod<uint8_t>(_material.TextureAlphaEnabled());
+    _writer.Pod(_material.AlphaThreshold());
+    _writer.Pod<uint8_t>(_material.TwoSidedEnabled());
+    _writer.Pod(_material.RenderOrder());
+    _writer.Pod(_material.Shininess());
+    double srcFactor = 0.0;
+    double dstFactor = 0.0;
+    _material.BlendFactors(srcFactor, dstFactor);
+    _writer.Pod(srcFactor);
+    _writer.Pod(dstFactor);
+    _writer.Pod<int32_t>(_material.Blend());
+    _writer.Pod<int32_t>(_material.Shade());
+    _writer.Pod(_material.PointSize());
+    _writer.Pod<uint8_t>(_material.DepthWrite());
+    _writer.Pod<uint8_t>(_material.Lighting());
+
+    const Pbr *pbr = _material.PbrMaterial();
+    _writer.Pod<uint8_t>(pbr != nullptr);
+    if (!pbr)
+      return true;
+    _writer.Pod<int32_t>(static_cast<int32_t>(pbr->Type()));
+    _writer.String(pbr->AlbedoMap());
+    _writer.String(pbr->NormalMap());
+    _writer.Pod<int32_t>(static_cast<int32_t>(pbr->NormalMapType()));
+    _writer.String(pbr->EnvironmentMap());
+    _writer.String(pbr->AmbientOcclusionMap());
+    _writer.String(pbr->RoughnessMap());
+    _writer.String(pbr->MetalnessMap());
+    _writer.String(pbr->EmissiveMap());
+    _writer.String(pbr->LightMap());
+    _writer.Pod<uint32_t>(pbr->LightMapTexCoordSet());
+    _writer.String(pbr->GlossinessMap());
+    _writer.String(pbr->SpecularMap());
+    _writer.Pod(pbr->Metalness());
+    _writer.Pod(pbr->Roughness());
+    _writer.Pod(pbr->Glossiness());
+    return WriteImage(_writer, pbr->NormalMapData()) &&
+        WriteImage(_writer, pbr->RoughnessMapData()) &&
+        WriteImage(_writer, pbr->MetalnessMapData()) &&
+        WriteImage(_writer, pbr->EmissiveMapData()) &&
+        WriteImage(_writer, pbr->LightMapData());
+  }
+
+  /// \brief Read a material
+  /// \param[in] _reader Source
+  /// \return The material
+  MaterialPtr ReadMaterial(Reader &_reader)
+  {
+    auto material = std::make_shared<Material>();
+    const std::string texture = _reader.String();
+    const std::shared_ptr<const Image> textureData = ReadImage(_reader);
+    if (textureData)
+      material->SetTextureImage(texture, textureData);
+    else if (!texture.empty())
+      material->SetTextureImage(texture, std::shared_ptr<const Image>());
+    material->SetAmbient(_reader.Color());
+    material->SetDiffuse(_reader.Color());
+    material->SetSpecular(_reader.Color());
+    material->SetEmissive(_reader.Color());
+    material->SetTransparency(_reader.Pod<double>());
+    const bool alphaEnabled = _reader.Pod<uint8_t>() != 0u;
+    const double alphaThreshold = _reader.Pod<double>();
+    const bool twoSided = _reader.Pod<uint8_t>() != 0u;
+    material->SetAlphaFromTexture(alphaEnabled, alphaThreshold, twoSided);
+    material->SetRenderOrder(_reader.Pod<float>());
+    material->SetShininess(_reader.Pod<double>());
+    const double srcFactor = _reader.Pod<double>();
+    const double dstFactor = _reader.Pod<double>();
+    material->SetBlendFactors(srcFactor, dstFactor);
+    const int32_t blend = _reader.Pod<int32_t>();
+    const int32_t shade = _reader.Pod<int32_t>();
+    if (blend < Material::BLEND_MODE_BEGIN ||
+        blend >= Material::BLEND_MODE_END ||
+        shade < Material::SHADE_MODE_BEGIN ||
+        shade >= Material::SHADE_MODE_END)
+    {
+      _reader.ok = false;
+      return material;
+    }
+    material->SetBlend(static_cast<Material::BlendMode>(blend));
+    material->SetShade(static_cast<Material::ShadeMode>(shade));
+    material->SetPointSize(_reader.Pod<double>());
+    material->SetDepthWrite(_reader.Pod<uint8_t>() != 0u);
+    material->SetLighting(_reader.Pod<uint8_t>() != 0u);
+
+    if (_reader.Pod<uint8_t>() == 0u)
+      return material;
+    Pbr pbr;
+    pbr.SetType(static_cast<PbrType>(_reader.Pod<int32_t>()));
+    pbr.SetAlbedoMap(_reader.String());
+    const std::string normalMap = _reader.String();
+    const auto normalSpace =
+        static_cast<NormalMapSpace>(_reader.Pod<int32_t>());
+    pbr.SetEnvironmentMap(_reader.String());
+    pbr.SetAmbientOcclusionMap(_reader.String());
+    const std::string roughnessMap = _reader.String();
+    const std::string metalnessMap = _reader.String();
+    const std::string emissiveMap = _reader.String();
+    const std::string lightMap = _reader.String();
+    const uint32_t lightMapSet = _reader.Pod<uint32_t>();
+    pbr.SetGlossinessMap(_reader.String());
+    pbr.SetSpecularMap(_reader.String());
+    pbr.SetMetalness(_reader.Pod<double>());
+    pbr.SetRoughness(_reader.Pod<double>());
+    pbr.SetGlossiness(_reader.Pod<double>());
+    pbr.SetNormalMap(normalMap, normalSpace, ReadImage(_reader));
+    pbr.SetRoughnessMap(roughnessMap, ReadImage(_reader));
+    pbr.SetMetalnessMap(metalnessMap, ReadImage(_reader));
+    pbr.SetEmissiveMap(emissiveMap, ReadImage(_reader));
+    pbr.SetLightMap(lightMap, lightMapSet, ReadImage(_reader));
+    material->SetPbrMaterial(pbr);
+    return material;
+  }
+
+  /// \brief Write a submesh
+  /// \param[in] _writer Destination
+  /// \param[in] _subMesh Submesh to write
+  void WriteSubMesh(Writer &_writer, const SubMesh &_subMesh)
+  {
+    _writer.String(_subMesh.Name());
+    _writer.Pod<int32_t>(_subMesh.SubMeshPrimitiveType());
+    const std::optional<unsigned int> materialIndex =
+        _subMesh.GetMaterialIndex();
+    _writer.Pod<uint8_t>(materialIndex.has_value());
+    _writer.Pod<uint32_t>(materialIndex.value_or(0u));
+
+    _writer.Array(reinterpret_cast<const double *>(_subMesh.VertexPtr()),
+        3u * _subMesh.VertexCount());
+
+    std::vector<double> values(3u * _subMesh.NormalCount());
+    for (unsigned int i = 0; i < _subMesh.NormalCount(); ++i)
+    {
+      const math::Vector3d normal = _subMesh.Normal(i);
+      values[3 * i] = normal.X();
+      values[3 * i + 1] = normal.Y();
+      values[3 * i + 2] = normal.Z();
+    }
+    _writer.Array(values.data(), values.size());
+
+    _writer.Pod<uint32_t>(_subMesh.TexCoordSetCount());
+    for (unsigned int s = 0; s < _subMesh.TexCoordSetCount(); ++s)
+    {
+      const unsigned int count = _subMesh.TexCoordCountBySet(s);
+      values.resize(2u * count);
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        const math::Vector2d uv = _subMesh.TexCoordBySet(i, s);
+        values[2 * i] = uv.X();
+        values[2 * i + 1] = uv.Y();
+      }
+      _writer.Array(values.data(), values.size());
+    }
+
+    const SubMesh::IndexView indices = _subMesh.Indices();
+    _writer.Pod<uint8_t>(indices.Format() == SubMesh::IndexFormat::UINT16);
+    if (indices.Format() == SubMesh::IndexFormat::UINT16)
+      _writer.Array(indices.Data16(), indices.Count());
+    else
+      _writer.Array(indices.Data32(), indices.Count());
+
+    std::vector<uint32_t> assignments(3u * _subMesh.NodeAssignmentsCount());
+    for (unsigned int i = 0; i < _subMesh.NodeAssignmentsCount(); ++i)
+    {
+      const NodeAssignment assignment = _subMesh.NodeAssignmentByIndex(i);
+      assignments[3 * i] = assignment.vertexIndex;
+      assignments[3 * i + 1] = assignment.nodeIndex;
+      std::memcpy(&assignments[3 * i + 2], &assignment.weight,
+          sizeof(float));
+    }
+    _writer.Array(assignments.data(), assignments.size());
+  }
+
+  /// \brief Read a submesh
+  /// \param[in] _reader Source
+  /// \return The submesh
+  std::unique_ptr<SubMesh> ReadSubMesh(Reader &_reader)
+  {
+    auto subMesh = std::make_unique<SubMesh>(_reader.String());
+    const int32_t type = _reader.Pod<int32_t>();
+    if (type < SubMesh::POINTS || type > SubMesh::TRISTRIPS)
+    {
+      _reader.ok = false;
+      return subMesh;
+    }
+    subMesh->SetPrimitiveType(static_cast<SubMesh::PrimitiveType>(type));
+    const bool hasMaterial = _reader.Pod<uint8_t>() != 0u;
+    const uint32_t materialIndex = _reader.Pod<uint32_t>();
+    if (hasMaterial)
+      subMesh->SetMaterialIndex(materialIndex);
+
+    std::size_t count = 0u;
+    // A failed read returns no values
+    const double *values = _reader.Array<double>(count);
+    subMesh->AddVertices(values, count / 3u);
+    values = _reader.Array<double>(count);
+    subMesh->AddNormals(values, count / 3u);
+
+    const uint32_t setCount = _reader.Pod<uint32_t>();
+    for (uint32_t s = 0; s < setCount && _reader.ok; ++s)
+    {
+      values = _reader.Array<double>(count);
+      if (count > 0u)
+        subMesh->AddTexCoordsBySet(values, count / 2u, s);
+    }
+
+    if (_reader.Pod<uint8_t>() != 0u)
+    {
+      const uint16_t *indices = _reader.Array<uint16_t>(count);
+      std::vector<unsigned int> wide(count);
+      for (std::size_t i = 0; i < wide.size(); ++i)
+      {
+        wide[i] = indices[i] == std::numeric_limits<uint16_t>::max() ?
+            SubMesh::PrimitiveRestartIndex : indices[i];
+      }
+      subMesh->AddIndices(wide.data(), wide.size());
+    }
+    else
+    {
+      static_assert(std::is_same<uint32_t, unsigned int>::value,
+          "32 bit indices must be unsigned int");
+      const uint32_t *indices = _reader.Array<uint32_t>(count);
+      subMesh->AddIndices(indices, count);
+    }
+
+    const uint32_t *assignments = _reader.Array<uint32_t>(count);
+    for (std::size_t i = 0; i + 2 < count; i += 3)
+    {
+      float weight = 0.0f;
+      std::memcpy(&weight, &assignments[i + 2], sizeof(float));
+      subMesh->AddNodeAssignment(assignments[i], assignments[i + 1], weight);
+    }
+    return subMesh;
+  }
+
+  /// \brief Write a skeleton
+  /// \param[in] _writer Destination
+  /// \param[in] _skeleton Skeleton to write
+  void WriteSkeleton(Writer &_writer, const Skeleton &_skeleton)
+  {
+    // Nodes in handle order, which lists parents before their children
+    // and children in order
+    _writer.Pod<uint64_t>(_skeleton.NodeCount());
+    for (const auto &[handle, node] : _skeleton.Nodes())
+    {
+      const SkeletonNode *parent = node->Parent();
+      _writer.Pod<uint32_t>(parent ? parent->Handle() : handle);
+      _writer.String(node->Name());
+      _writer.String(node->Id());
+      _writer.Pod<uint8_t>(node->IsJoint());
+      _writer.Matrix(node->InitialTransform());
+      _writer.Matrix(node->Transform());
+      _writer.Pod<uint8_t>(node->HasInvBindTransform());
+      _writer.Matrix(node->InverseBindTransform());
+      const std::vector<NodeTransform> transforms = node->RawTransforms();
+      _writer.Pod<uint64_t>(transforms.size());
+      for (const auto &transform : transforms)
+      {
+        _writer.Pod<int32_t>(transform.Type());
+        _writer.String(transform.SID());
+        _writer.Matrix(transform.Get());
+      }
+    }
+    _writer.Matrix(_skeleton.BindShapeTransform());
+
+    _writer.Pod<uint32_t>(_skeleton.NumVertAttached());
+    for (unsigned int v = 0; v < _skeleton.NumVertAttached(); ++v)
+    {
+      _writer.Pod<uint32_t>(_skeleton.VertNodeWeightCount(v));
+      for (unsigned int i = 0; i < _skeleton.VertNodeWeightCount(v); ++i)
+      {
+        const auto weight = _skeleton.VertNodeWeight(v, i);
+        _writer.String(weight.first);
+        _writer.Pod(weight.second);
+      }
+    }
+
+    _writer.Pod<uint32_t>(_skeleton.AnimationCount());
+    for (unsigned int a = 0; a < _skeleton.AnimationCount(); ++a)
+    {
+      const SkeletonAnimation *animation = _skeleton.Animation(a);
+      _writer.String(animation->Name());
+      _writer.Pod<uint32_t>(animation->NodeCount());
+      for (unsigned int n = 0; n < animation->NodeCount(); ++n)
+      {
+        const NodeAnimation *nodeAnimation =
+            animation->NodeAnimationByIndex(n);
+        _writer.String(nodeAnimation->Name());
+        _writer.Pod<uint32_t>(nodeAnimation->FrameCount());
+        for (unsigned int f = 0; f < nodeAnimation->FrameCount(); ++f)
+        {
+          const auto frame = nodeAnimation->KeyFrame(f);
+          _writer.Pod(frame.first);
+          _writer.Matrix(frame.second);
+        }
+      }
+    }
+  }
+
+  /// \brief Read a skeleton
+  /// \param[in] _reader Source
+  /// \return The skeleton
+  SkeletonPtr ReadSkeleton(Reader &_reader)
+  {
+    auto skeleton = std::make_shared<Skeleton>();
+    const uint64_t nodeCount = _reader.Pod<uint64_t>();
+    if (!_reader.Fits(nodeCount, sizeof(uint32_t)))
+      return skeleton;
+    std::vector<SkeletonNode *> nodes;
+    nodes.reserve(nodeCount);
+    for (uint64_t i = 0; i < nodeCount && _reader.ok; ++i)
+    {
+      const uint32_t parentHandle = _reader.Pod<uint32_t>();
+      if (i > 0 && parentHandle >= i)
+      {
+        _reader.ok = false;
+        break;
+      }
+      SkeletonNode *parent = i == 0 ? nullptr : nodes[parentHandle];
+      const std::string name = _reader.String();
+      const std::string id = _reader.String();
+      const bool joint = _reader.Pod<uint8_t>() != 0u;
+      auto *node = new SkeletonNode(parent, name, id,
+          joint ? SkeletonNode::JOINT : SkeletonNode::NODE);
+      nodes.push_back(node);
+      node->SetInitialTransform(_reader.Matrix());
+      node->SetTransform(_reader.Matrix(), false);
+      const bool hasInverseBind = _reader.Pod<uint8_t>() != 0u;
+      const math::Matrix4d inverseBind = _reader.Matrix();
+      if (hasInverseBind)
+        node->SetInverseBindTransform(inverseBind);
+      const uint64_t transformCount = _reader.Pod<uint64_t>();
+      for (uint64_t t = 0; t < transformCount && _reader.ok; ++t)
+      {
+        const auto type = static_cast<NodeTransformType>(
+            _reader.Pod<int32_t>());
+        const std::string sid = _reader.String();
+        node->AddRawTransform(NodeTransform(_reader.Matrix(), sid, type));
+      }
+    }
+    // Every node is a descendant of the first one, so the skeleton owns
+    // all the nodes read so far
+    if (!nodes.empty())
+      skeleton->RootNode(nodes.front());
+    skeleton->SetBindShapeTransform(_reader.Matrix());
+
+    const uint32_t vertexCount = _reader.Pod<uint32_t>();
+    if (!_reader.Fits(vertexCount, sizeof(uint32_t)))
+      return skeleton;
+    skeleton->SetNumVertAttached(vertexCount);
+    for (uint32_t v = 0; v < vertexCount && _reader.ok; ++v)
+    {
+      const uint32_t weightCount = _reader.Pod<uint32_t>();
+      for (uint32_t i = 0; i < weightCount && _reader.ok; ++i)
+      {
+        const std::string node = _reader.String();
+        skeleton->AddVertNodeWeight(v, node, _reader.Pod<double>());
+      }
+    }
+
+    const uint32_t animationCount = _reader.Pod<uint32_t>();
+    for (uint32_t a = 0; a < animationCount && _reader.ok; ++a)
+    {
+      auto *animation = new SkeletonAnimation(_reader.String());
+      skeleton->AddAnimation(animation);
+      const uint32_t animatedCount = _reader.Pod<uint32_t>();
+      for (uint32_t n = 0; n < animatedCount && _reader.ok; ++n)
+      {
+        const std::string node = _reader.String();
+        const uint32_t frameCount = _reader.Pod<uint32_t>();
+        for (uint32_t f = 0; f < frameCount && _reader.ok; ++f)
+        {
+          const double time = _reader.Pod<double>();
+          animation->AddKeyFrame(node, time, _reader.Matrix());
+        }
+      }
+    }
+    return skeleton;
+  }
+
+  /// \brief Write a mesh
+  /// \param[in] _writer Destination
+  /// \param[in] _mesh Mesh to write
+  /// \return False if the mesh can not be represented
+  bool WriteMesh(Writer &_writer, const Mesh &_mesh)
+  {
+    _writer.String(_mesh.Name());
+    _writer.String(_mesh.Path());
+
+    _writer.Pod<uint32_t>(_mesh.MaterialCount());
+    for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+    {
+      const MaterialPtr material = _mesh.MaterialByIndex(i);
+      _writer.Pod<uint8_t>(material != nullptr);
+      if (material && !WriteMaterial(_writer, *material))
+        return false;
+    }
+
+    _writer.Pod<uint32_t>(_mesh.SubMeshCount());
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+      WriteSubMesh(_writer, *_mesh.SubMeshByIndex(i).lock());
+
+    const SkeletonPtr skeleton = _mesh.MeshSkeleton();
+    _writer.Pod<uint8_t>(skeleton != nullptr);
+    if (skeleton)
+      WriteSkeleton(_writer, *skeleton);
+    return true;
+  }
+}
+
+/// \brief Private data for MeshCache
+class gz::common::MeshCache::Implementation
+{
+  /// \brief Write a cache file, then trim the directory
+  /// \param[in] _file Cache file to write
+  /// \param[in] _buffer Contents of the file
+  /// \return True if the file was written
+  public: bool Write(const std::string &_file,
+              const std::vector<char> &_buffer) const;
+
+  /// \brief List the cache files
+  /// \return Path, size and modification time of each file
+  public: std::vector<std::tuple<fs::path, std::uintmax_t,
+              fs::file_time_type>> Files() const;
+
+  /// \brief Directory of the cache files
+  public: std::string directory;
+
+  /// \brief Size limit in bytes
+  public: std::uintmax_t maxSize = 0u;
+};
+
+//////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_directory, std::uintmax_t _maxSize)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->directory = _directory;
+  this->dataPtr->maxSize = _maxSize;
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::Directory() const
+{
+  return this->dataPtr->directory;
+}
+
+//////////////////////////////////////////////////
+std::uintmax_t MeshCache::MaxSize() const
+{
+  return this->dataPtr->maxSize;
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::CacheFile(const std::string &_source,
+    const std::string &_variant) const
+{
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+      static_cast<unsigned long long>(hash64(_source + '\0' + _variant)));
+  return (fs::path(this->dataPtr->directory) /
+      (std::string(name) + kExtension)).string();
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_source,
+    const std::string &_variant) const
+{
+  SourceStamp stamp;
+  if (!Stamp(_source, stamp))
+    return nullptr;
+
+  const std::string cacheFile = this->CacheFile(_source, _variant);
+  MappedFile file(cacheFile);
+  if (!file.valid || file.size < sizeof(kMagic) ||
+      std::memcmp(file.data, kMagic, sizeof(kMagic)) != 0)
+  {
+    return nullptr;
+  }
+
+  Reader reader(file.data, file.size);
+  for (std::size_t i = 0; i < sizeof(kMagic); ++i)
+    reader.Pod<char>();
+  if (reader.Pod<uint32_t>() != kVersion ||
+      reader.Pod<uint32_t>() != kByteOrder)
+  {
+    return nullptr;
+  }
+  const uint64_t sourceSize = reader.Pod<uint64_t>();
+  const int64_t sourceTime = reader.Pod<int64_t>();
+  const uint64_t sourceHash = reader.Pod<uint64_t>();
+  const std::string sourcePath = reader.String();
+  const std::string variant = reader.String();
+  reader.Align();
+  if (!reader.ok || sourcePath != _source || variant != _variant ||
+      sourceSize != stamp.size)
+  {
+    return nullptr;
+  }
+
+  // A touched but unchanged file is still valid
+  uint64_t hash = 0u;
+  if (sourceTime != stamp.time &&
+      (!ContentHash(_source, hash) || hash != sourceHash))
+  {
+    return nullptr;
+  }
+
+  std::unique_ptr<Mesh> mesh = Deserialize(file.data + reader.Position(),
+      file.size - reader.Position());
+  if (!mesh)
+  {
+    gzwarn << "Ignoring corrupt mesh cache file [" << cacheFile << "]\n";
+    return nullptr;
+  }
+
+  // Mark the file as recently used
+  std::error_code ec;
+  fs::last_write_time(cacheFile, fs::file_time_type::clock::now(), ec);
+  return mesh.release();
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Save(const Mesh &_mesh, const std::string &_source,
+    const std::string &_variant) const
+{
+  SourceStamp stamp;
+  uint64_t hash = 0u;
+  if (!Stamp(_source, stamp) || !ContentHash(_source, hash))
+    return false;
+
+  std::vector<char> buffer;
+  Writer writer(buffer);
+  writer.Bytes(kMagic, sizeof(kMagic));
+  writer.Pod(kVersion);
+  writer.Pod(kByteOrder);
+  writer.Pod(stamp.size);
+  writer.Pod(stamp.time);
+  writer.Pod(hash);
+  writer.String(_source);
+  writer.String(_variant);
+  writer.Align();
+  if (!WriteMesh(writer, _mesh))
+    return false;
+
+  if (!this->dataPtr->Write(this->CacheFile(_source, _variant), buffer))
+    return false;
+  this->Trim();
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::uintmax_t MeshCache::Size() const
+{
+  std::uintmax_t size = 0u;
+  for (const auto &file : this->dataPtr->Files())
+    size += std::get<1>(file);
+  return size;
+}
+
+//////////////////////////////////////////////////
+void MeshCache::Trim() const
+{
+  auto files = this->dataPtr->Files();
+  std::uintmax_t size = 0u;
+  for (const auto &file : files)
+    size += std::get<1>(file);
+  if (size <= this->dataPtr->maxSize)
+    return;
+
+  // Oldest first
+  std::sort(files.begin(), files.end(),
+      [](const auto &_a, const auto &_b)
+      {
+        return std::get<2>(_a) < std::get<2>(_b);
+      });
+  for (const auto &file : files)
+  {
+    if (size <= this->dataPtr->maxSize)
+      break;
+    std::error_code ec;
+    if (fs::remove(std::get<0>(file), ec))
+      size -= std::get<1>(file);
+  }
+}
+
+//////////////////////////////////////////////////
+void MeshCache::Clear() const
+{
+  for (const auto &file : this->dataPtr->Files())
+  {
+    std::error_code ec;
+    fs::remove(std::get<0>(file), ec);
+  }
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Serialize(const Mesh &_mesh, std::vector<char> &_buffer)
+{
+  _buffer.clear();
+  Writer writer(_buffer);
+  return WriteMesh(writer, _mesh);
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<Mesh> MeshCache::Deserialize(const char *_data,
+    std::size_t _size)
+{
+  Reader reader(_data, _size);
+  auto mesh = std::make_unique<Mesh>();
+  mesh->SetName(reader.String());
+  mesh->SetPath(reader.String());
+
+  const uint32_t materialCount = reader.Pod<uint32_t>();
+  for (uint32_t i = 0; i < materialCount && reader.ok; ++i)
+  {
+    if (reader.Pod<uint8_t>() != 0u)
+      mesh->AddMaterial(ReadMaterial(reader));
+    else
+      mesh->AddMaterial(nullptr);
+  }
+
+  const uint32_t subMeshCount = reader.Pod<uint32_t>();
+  for (uint32_t i = 0; i < subMeshCount && reader.ok; ++i)
+    mesh->AddSubMesh(ReadSubMesh(reader));
+
+  if (reader.ok && reader.Pod<uint8_t>() != 0u)
+    mesh->SetSkeleton(ReadSkeleton(reader));
+
+  if (!reader.ok)
+    return nullptr;
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Implementation::Write(const std::string &_file,
+    const std::vector<char> &_buffer) const
+{
+  std::error_code ec;
+  fs::create_directories(this->directory, ec);
+
+  // Write to a file unique to this thread and process, then rename it over
+  // the cache file, so readers never see a partial file
+  static std::atomic<uint64_t> counter{0u};
+  const std::string temp = _file + "." + std::to_string(ProcessId()) + "." +
+      std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+      + "." + std::to_string(counter++) + ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out.write(_buffer.data(),
+        static_cast<std::streamsize>(_buffer.size())))
+    {
+      out.close();
+      fs::remove(temp, ec);
+      return false;
+    }
+  }
+  fs::rename(temp, _file, ec);
+  if (ec)
+  {
+    gzwarn << "Unable to write mesh cache file [" << _file << "]: "
+           << ec.message() << "\n";
+    fs::remove(temp, ec);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::tuple<fs::path, std::uintmax_t, fs::file_time_type>>
+MeshCache::Implementation::Files() const
+{
+  std::vector<std::tuple<fs::path, std::uintmax_t, fs::file_time_type>> files;
+  std::error_code ec;
+  for (fs::directory_iterator it(this->directory, ec), end;
+       !ec && it != end; it.increment(ec))
+  {
+    if (it->path().extension() != kExtension)
+      continue;
+    std::error_code entryEc;
+    const auto size = it->file_size(entryEc);
+    const auto time = it->last_write_time(entryEc);
+    if (!entryEc)
+      files.emplace_back(it->path(), size, time);
+  }
+  return files;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_MESHCACHE_HH_
+#define GZ_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/common/graphics/Export.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \brief Directory of meshes stored in a binary format, used by
+    /// MeshManager to skip parsing files it has loaded before.
+    ///
+    /// Each source file has one cache file per variant, named after a hash
+    /// of its path and the variant. The variant identifies the loader and
+    /// the load settings, since they give different meshes for the same
+    /// file. A cache file holds the path, variant, modification time, size
+    /// and content hash of the source, followed by the mesh: submeshes,
+    /// materials, embedded textures, skeleton and animations. Arrays are
+    /// 8-byte aligned so the file is read through a memory map. A cache
+    /// file is used if the path, variant and size match and either the
+    /// modification time or the content hash match.
+    ///
+    /// Files are written atomically, so several processes can share a
+    /// directory. Once the directory grows over its size limit, the least
+    /// recently used files are removed.
+    class GZ_COMMON_GRAPHICS_VISIBLE MeshCache
+    {
+      /// \brief Constructor
+      /// \param[in] _directory Directory of the cache files, created if
+      /// needed
+      /// \param[in] _maxSize Size limit of the cache files, in bytes
+      public: MeshCache(const std::string &_directory,
+                  std::uintmax_t _maxSize);
+
+      /// \brief Get the directory of the cache files
+      /// \return The directory
+      public: std::string Directory() const;
+
+      /// \brief Get the size limit of the cache files
+      /// \return Size limit in bytes
+      public: std::uintmax_t MaxSize() const;
+
+      /// \brief Get the path of the cache file of a source file
+      /// \param[in] _source Path of the source file
+      /// \param[in] _variant Loader and load settings of the mesh
+      /// \return Path of the cache file, which may not exist
+      public: std::string CacheFile(const std::string &_source,
+                  const std::string &_variant = "") const;
+
+      /// \brief Load the cached copy of a mesh
+      /// \param[in] _source Path of the file the mesh was loaded from
+      /// \param[in] _variant Loader and load settings of the mesh
+      /// \return A new mesh, or nullptr if there is no valid cache file for
+      /// the current version of _source and _variant
+      public: Mesh *Load(const std::string &_source,
+                  const std::string &_variant = "") const;
+
+      /// \brief Store a mesh. Meshes that the format can not represent,
+      /// such as embedded textures with more than 8 bits per channel, are
+      /// not stored.
+      /// \param[in] _mesh Mesh loaded from _source
+      /// \param[in] _source Path of the file the mesh was loaded from
+      /// \param[in] _variant Loader and load settings of the mesh
+      /// \return True if the mesh was stored
+      public: bool Save(const Mesh &_mesh, const std::string &_source,
+                  const std::string &_variant = "") const;
+
+      /// \brief Get the total size of the cache files
+      /// \return Size in bytes
+      public: std::uintmax_t Size() const;
+
+      /// \brief Remove the least recently used cache files until the total
+      /// size is within the limit
+      public: void Trim() const;
+
+      /// \brief Remove all the cache files
+      public: void Clear() const;
+
+      /// \brief Serialize a mesh
+      /// \param[in] _mesh Mesh to serialize
+      /// \param[out] _buffer The serialized mesh
+      /// \return False if the mesh can not be represented
+      public: static bool Serialize(const Mesh &_mesh,
+                  std::vector<char> &_buffer);
+
+      /// \brief Deserialize a mesh
+      /// \param[in] _data Serialized mesh, 8-byte aligned
+      /// \param[in] _size Size of _data in bytes
+      /// \return A new mesh, or nullptr if _data is not a valid mesh
+      public: static std::unique_ptr<Mesh> Deserialize(const char *_data,
+                  std::size_t _size);
+
+      /// \brief Private data pointer
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
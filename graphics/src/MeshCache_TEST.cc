@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/common/Image.hh"
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/NodeAnimation.hh"
+#include "gz/common/Pbr.hh"
+#include "gz/common/Skeleton.hh"
+#include "gz/common/SkeletonAnimation.hh"
+#include "gz/common/SkeletonNode.hh"
+#include "gz/common/SubMesh.hh"
+#include "gz/common/TempDirectory.hh"
+
+#include "MeshCache.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+class MeshCacheTest : public common::testing::AutoLogFixture
+{
+  protected: void SetUp() override
+  {
+    common::testing::AutoLogFixture::SetUp();
+    this->temp = std::make_unique<TempDirectory>(
+        "mesh_cache", "gz_common", true);
+    ASSERT_TRUE(this->temp->Valid());
+  }
+
+  /// \brief Write a source file
+  /// \param[in] _name Name of the file in the temporary directory
+  /// \param[in] _content Content of the file
+  /// \return Path of the file
+  protected: std::string WriteSource(const std::string &_name,
+                 const std::string &_content)
+  {
+    const std::string path =
+        (std::filesystem::path(this->temp->Path()) / _name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << _content;
+    return path;
+  }
+
+  /// \brief Temporary directory of the cache and source files
+  protected: std::unique_ptr<TempDirectory> temp;
+};
+
+/////////////////////////////////////////////////
+/// \brief Create a mesh that uses every part of the format
+std::unique_ptr<Mesh> CreateMesh()
+{
+  auto mesh = std::make_unique<Mesh>();
+  mesh->SetName("cached");
+  mesh->SetPath("/models/cached");
+
+  auto image = std::make_shared<Image>();
+  const std::vector<unsigned char> pixels =
+      {255, 0, 0, 0, 255, 0, 0, 0, 255, 10, 20, 30};
+  image->SetFromData(pixels.data(), 2, 2, Image::RGB_INT8);
+  auto material = std::make_shared<Material>();
+  material->SetTextureImage("albedo.png", image);
+  material->SetDiffuse(math::Color(0.1f, 0.2f, 0.3f, 0.4f));
+  material->SetTransparency(0.25);
+  material->SetAlphaFromTexture(true, 0.3, false);
+  material->SetBlend(Material::MODULATE);
+  material->SetShade(Material::PHONG);
+  material->SetLighting(false);
+  Pbr pbr;
+  pbr.SetType(PbrType::METAL);
+  pbr.SetNormalMap("normal.png", NormalMapSpace::OBJECT, image);
+  pbr.SetLightMap("light.png", 1u);
+  pbr.SetRoughness(0.7);
+  material->SetPbrMaterial(pbr);
+  mesh->AddMaterial(material);
+
+  SubMesh strip("strip");
+  strip.SetPrimitiveType(SubMesh::TRISTRIPS);
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    strip.AddVertex(i, 2.0 * i, -1.0);
+    strip.AddNormal(0, 0, 1);
+    strip.AddTexCoordBySet(0.25 * i, 0.5, 0);
+    strip.AddTexCoordBySet(0.5, 0.25 * i, 1);
+  }
+  strip.AddIndex(0);
+  strip.AddIndex(1);
+  strip.AddIndex(2);
+  strip.AddPrimitiveRestart();
+  strip.AddIndex(1);
+  strip.AddIndex(2);
+  strip.AddIndex(3);
+  strip.AddNodeAssignment(1, 2, 0.75f);
+  strip.SetMaterialIndex(0);
+  mesh->AddSubMesh(strip);
+
+  SubMesh points("points");
+  points.SetPrimitiveType(SubMesh::POINTS);
+  points.AddVertex(1, 2, 3);
+  points.AddIndex(70000);
+  mesh->AddSubMesh(points);
+
+  auto *root = new SkeletonNode(nullptr, "root", "root_id");
+  auto *child = new SkeletonNode(root, "child", "child_id",
+      SkeletonNode::JOINT);
+  new SkeletonNode(root, "other", "other_id", SkeletonNode::JOINT);
+  root->SetInitialTransform(math::Matrix4d(math::Pose3d(1, 0, 0, 0, 0, 0)));
+  child->SetInitialTransform(math::Matrix4d(math::Pose3d(0, 1, 0, 0, 0, 0)));
+  child->SetInverseBindTransform(
+      math::Matrix4d(math::Pose3d(0, 0, -2, 0, 0, 0)));
+  child->AddRawTransform(NodeTransform(
+      math::Matrix4d(math::Pose3d(0, 1, 0, 0, 0, 0)), "translate",
+      NodeTransformType::TRANSLATE));
+  auto skeleton = std::make_shared<Skeleton>(root);
+  skeleton->SetNumVertAttached(4);
+  skeleton->AddVertNodeWeight(1, "child", 0.75);
+  skeleton->AddVertNodeWeight(1, "other", 0.25);
+  auto *animation = new SkeletonAnimation("wave");
+  animation->AddKeyFrame("child", 0.0, math::Pose3d(0, 1, 0, 0, 0, 0));
+  animation->AddKeyFrame("child", 1.5, math::Pose3d(0, 2, 0, 0, 0, 1));
+  animation->AddKeyFrame("other", 1.0, math::Pose3d(3, 0, 0, 0, 0, 0));
+  skeleton->AddAnimation(animation);
+  mesh->SetSkeleton(skeleton);
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, Serialize)
+{
+  std::unique_ptr<Mesh> mesh = CreateMesh();
+  std::vector<char> buffer;
+  ASSERT_TRUE(MeshCache::Serialize(*mesh, buffer));
+  ASSERT_FALSE(buffer.empty());
+  std::unique_ptr<Mesh> copy =
+      MeshCache::Deserialize(buffer.data(), buffer.size());
+  ASSERT_NE(nullptr, copy);
+  EXPECT_EQ("cached", copy->Name());
+  EXPECT_EQ("/models/cached", copy->Path());
+
+  // Materials
+  ASSERT_EQ(1u, copy->MaterialCount());
+  MaterialPtr material = copy->MaterialByIndex(0);
+  EXPECT_EQ("albedo.png", material->TextureImage());
+  ASSERT_NE(nullptr, material->TextureData());
+  EXPECT_EQ(2u, material->TextureData()->Width());
+  EXPECT_EQ(Image::RGB_INT8, material->TextureData()->PixelFormat());
+  EXPECT_EQ(mesh->MaterialByIndex(0)->TextureData()->Data(),
+      material->TextureData()->Data());
+  EXPECT_EQ(math::Color(0.1f, 0.2f, 0.3f, 0.4f), material->Diffuse());
+  EXPECT_DOUBLE_EQ(0.25, material->Transparency());
+  EXPECT_TRUE(material->TextureAlphaEnabled());
+  EXPECT_DOUBLE_EQ(0.3, material->AlphaThreshold());
+  EXPECT_FALSE(material->TwoSidedEnabled());
+  EXPECT_EQ(Material::MODULATE, material->Blend());
+  EXPECT_EQ(Material::PHONG, material->Shade());
+  EXPECT_FALSE(material->Lighting());
+  ASSERT_NE(nullptr, material->PbrMaterial());
+  EXPECT_EQ(PbrType::METAL, material->PbrMaterial()->Type());
+  EXPECT_EQ("normal.png", material->PbrMaterial()->NormalMap());
+  EXPECT_EQ("light.png", material->PbrMaterial()->LightMap());
+  EXPECT_DOUBLE_EQ(0.7, material->PbrMaterial()->Roughness());
+  EXPECT_EQ(NormalMapSpace::OBJECT, material->PbrMaterial()->NormalMapType());
+  EXPECT_NE(nullptr, material->PbrMaterial()->NormalMapData());
+  EXPECT_EQ(1u, material->PbrMaterial()->LightMapTexCoordSet());
+
+  // Submeshes
+  ASSERT_EQ(2u, copy->SubMeshCount());
+  auto strip = copy->SubMeshByIndex(0).lock();
+  auto original = mesh->SubMeshByIndex(0).lock();
+  EXPECT_EQ("strip", strip->Name());
+  EXPECT_EQ(SubMesh::TRISTRIPS, strip->SubMeshPrimitiveType());
+  ASSERT_TRUE(strip->GetMaterialIndex());
+  EXPECT_EQ(0u, *strip->GetMaterialIndex());
+  ASSERT_EQ(4u, strip->VertexCount());
+  ASSERT_EQ(4u, strip->NormalCount());
+  ASSERT_EQ(2u, strip->TexCoordSetCount());
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(original->Vertex(i), strip->Vertex(i));
+    EXPECT_EQ(original->Normal(i), strip->Normal(i));
+    EXPECT_EQ(original->TexCoordBySet(i, 1), strip->TexCoordBySet(i, 1));
+  }
+  EXPECT_EQ(SubMesh::IndexFormat::UINT16, strip->IndexBufferFormat());
+  EXPECT_TRUE(strip->HasPrimitiveRestart());
+  ASSERT_EQ(7u, strip->IndexCount());
+  for (unsigned int i = 0; i < 7; ++i)
+    EXPECT_EQ(original->Index(i), strip->Index(i));
+  ASSERT_EQ(1u, strip->NodeAssignmentsCount());
+  EXPECT_EQ(2u, strip->NodeAssignmentByIndex(0).nodeIndex);
+  EXPECT_FLOAT_EQ(0.75f, strip->NodeAssignmentByIndex(0).weight);
+  EXPECT_EQ(original->Min(), strip->Min());
+  EXPECT_DOUBLE_EQ(original->Volume(), strip->Volume());
+
+  auto points = copy->SubMeshByIndex(1).lock();
+  EXPECT_FALSE(points->GetMaterialIndex());
+  EXPECT_EQ(SubMesh::IndexFormat::UINT32, points->IndexBufferFormat());
+  EXPECT_EQ(70000, points->Index(0));
+
+  // Skeleton
+  SkeletonPtr skeleton = copy->MeshSkeleton();
+  ASSERT_NE(nullptr, skeleton);
+  ASSERT_EQ(3u, skeleton->NodeCount());
+  EXPECT_EQ(mesh->MeshSkeleton()->JointCount(), skeleton->JointCount());
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    SkeletonNode *expected = mesh->MeshSkeleton()->NodeByHandle(i);
+    SkeletonNode *node = skeleton->NodeByHandle(i);
+    EXPECT_EQ(expected->Name(), node->Name());
+    EXPECT_EQ(expected->Id(), node->Id());
+    EXPECT_EQ(expected->ModelTransform(), node->ModelTransform());
+    EXPECT_EQ(expected->InitialTransform(), node->InitialTransform());
+    EXPECT_EQ(expected->HasInvBindTransform(), node->HasInvBindTransform());
+  }
+  SkeletonNode *child = skeleton->NodeByName("child");
+  EXPECT_EQ(skeleton->RootNode(), child->Parent());
+  EXPECT_EQ(math::Matrix4d(math::Pose3d(0, 0, -2, 0, 0, 0)),
+      child->InverseBindTransform());
+  ASSERT_EQ(1u, child->RawTransformCount());
+  EXPECT_EQ("translate", child->RawTransform(0).SID());
+  EXPECT_EQ(NodeTransformType::TRANSLATE, child->RawTransform(0).Type());
+  EXPECT_EQ(4u, skeleton->NumVertAttached());
+  ASSERT_EQ(2u, skeleton->VertNodeWeightCount(1));
+  EXPECT_EQ("other", skeleton->VertNodeWeight(1, 1).first);
+  EXPECT_DOUBLE_EQ(0.25, skeleton->VertNodeWeight(1, 1).second);
+  ASSERT_EQ(1u, skeleton->AnimationCount());
+  SkeletonAnimation *animation = skeleton->Animation(0);
+  EXPECT_EQ("wave", animation->Name());
+  EXPECT_EQ(2u, animation->NodeCount());
+  EXPECT_DOUBLE_EQ(1.5, animation->Length());
+  ASSERT_NE(nullptr, animation->NodeAnimationByName("child"));
+  EXPECT_EQ(2u, animation->NodeAnimationByName("child")->FrameCount());
+  EXPECT_EQ(mesh->MeshSkeleton()->Animation(0)->NodePoseAt("child", 0.7),
+      animation->NodePoseAt("child", 0.7));
+
+  // Truncated data is rejected
+  for (std::size_t size : {std::size_t{0u}, buffer.size() / 2,
+       buffer.size() - 1})
+  {
+    EXPECT_EQ(nullptr,
+        MeshCache::Deserialize(buffer.data(), size));
+  }
+
+  // Images with 16 bits per channel are not supported
+  auto deep = std::make_shared<Material>();
+  Pbr pbr;
+  auto image = std::make_shared<Image>(
+      common::testing::TestFile("data", "rgb_16bit.png"));
+  ASSERT_EQ(Image::RGB_INT16, image->PixelFormat());
+  pbr.SetRoughnessMap("rgb_16bit.png", image);
+  deep->SetPbrMaterial(pbr);
+  mesh->AddMaterial(deep);
+  EXPECT_FALSE(MeshCache::Serialize(*mesh, buffer));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, SaveLoad)
+{
+  const std::string dir =
+      (std::filesystem::path(this->temp->Path()) / "cache").string();
+  MeshCache cache(dir, 1024u * 1024u);
+  EXPECT_EQ(dir, cache.Directory());
+  EXPECT_EQ(1024u * 1024u, cache.MaxSize());
+  EXPECT_EQ(0u, cache.Size());
+
+  const std::string source = this->WriteSource("a.dae", "first");
+  EXPECT_EQ(nullptr, cache.Load(source));
+  EXPECT_EQ(nullptr, cache.Load(source + ".missing"));
+
+  std::unique_ptr<Mesh> mesh = CreateMesh();
+  ASSERT_TRUE(cache.Save(*mesh, source));
+  EXPECT_TRUE(std::filesystem::exists(cache.CacheFile(source)));
+  EXPECT_NE(cache.CacheFile(source), cache.CacheFile(source + "b"));
+  EXPECT_GT(cache.Size(), 0u);
+
+  std::unique_ptr<Mesh> loaded(cache.Load(source));
+  ASSERT_NE(nullptr, loaded);
+  EXPECT_EQ(2u, loaded->SubMeshCount());
+  EXPECT_EQ(mesh->VertexCount(), loaded->VertexCount());
+  EXPECT_NE(nullptr, loaded->MeshSkeleton());
+
+  // Meshes of other loaders or load settings have their own files
+  EXPECT_EQ(nullptr, cache.Load(source, "assimp"));
+  EXPECT_NE(cache.CacheFile(source), cache.CacheFile(source, "assimp"));
+  ASSERT_TRUE(cache.Save(*CreateMesh(), source, "assimp"));
+  std::unique_ptr<Mesh> variant(cache.Load(source, "assimp"));
+  ASSERT_NE(nullptr, variant);
+  EXPECT_EQ(mesh->VertexCount(), variant->VertexCount());
+  EXPECT_EQ(nullptr, cache.Load(source, "assimp#fast"));
+  EXPECT_NE(nullptr, std::unique_ptr<Mesh>(cache.Load(source)));
+
+  // A new modification time with the same content is still valid
+  std::filesystem::last_write_time(source,
+      std::filesystem::last_write_time(source) + std::chrono::hours(1));
+  loaded.reset(cache.Load(source));
+  EXPECT_NE(nullptr, loaded);
+
+  // Changed content is not
+  this->WriteSource("a.dae", "second");
+  EXPECT_EQ(nullptr, cache.Load(source));
+  this->WriteSource("a.dae", "secon");
+  std::filesystem::last_write_time(source,
+      std::filesystem::last_write_time(source) + std::chrono::hours(2));
+  EXPECT_EQ(nullptr, cache.Load(source));
+
+  // Corrupt files are ignored
+  {
+    ASSERT_TRUE(cache.Save(*mesh, source));
+    std::filesystem::resize_file(cache.CacheFile(source),
+        std::filesystem::file_size(cache.CacheFile(source)) - 8u);
+  }
+  EXPECT_EQ(nullptr, cache.Load(source));
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_FALSE(std::filesystem::exists(cache.CacheFile(source)));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, Trim)
+{
+  const std::string dir =
+      (std::filesystem::path(this->temp->Path()) / "cache").string();
+  std::unique_ptr<Mesh> mesh = CreateMesh();
+  std::vector<char> buffer;
+  ASSERT_TRUE(MeshCache::Serialize(*mesh, buffer));
+
+  // Room for two meshes
+  MeshCache cache(dir, 2u * buffer.size() + 1024u);
+  const std::string a = this->WriteSource("a.obj", "a");
+  const std::string b = this->WriteSource("b.obj", "b");
+  const std::string c = this->WriteSource("c.obj", "c");
+  ASSERT_TRUE(cache.Save(*mesh, a));
+  ASSERT_TRUE(cache.Save(*mesh, b));
+
+  // Make a the most recently used
+  std::filesystem::last_write_time(cache.CacheFile(b),
+      std::filesystem::last_write_time(cache.CacheFile(a)) -
+      std::chrono::hours(1));
+  std::unique_ptr<Mesh> loaded(cache.Load(a));
+  EXPECT_NE(nullptr, loaded);
+
+  ASSERT_TRUE(cache.Save(*mesh, c));
+  EXPECT_LE(cache.Size(), cache.MaxSize());
+  EXPECT_TRUE(std::filesystem::exists(cache.CacheFile(a)));
+  EXPECT_FALSE(std::filesystem::exists(cache.CacheFile(b)));
+  EXPECT_TRUE(std::filesystem::exists(cache.CacheFile(c)));
+}
@@ -0,0 +1,821 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <type_traits>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Util.hh"
+
+#include "MeshKernels.hh"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GZ_MESH_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GZ_MESH_KERNELS_AVX2
+#else
+#define GZ_MESH_KERNELS_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace gz;
+using namespace common;
+using namespace meshkernels;
+
+// The kernels see arrays of vectors as flat arrays of doubles
+static_assert(sizeof(math::Vector3d) == 3 * sizeof(double),
+    "Vector3d must be three packed doubles");
+static_assert(std::is_standard_layout<math::Vector3d>::value,
+    "Vector3d must have a standard layout");
+
+namespace
+{
+/// \brief Check if the CPU and OS support AVX2
+/// \return True if AVX2 instructions can be used
+bool CpuHasAvx2()
+{
+#if defined(GZ_MESH_KERNELS_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+#else
+  return false;
+#endif
+}
+
+/// \brief Find the best supported instruction set, capped by the
+/// GZ_MESH_SIMD environment variable
+/// \return Instruction set to use
+Isa DetectIsa()
+{
+  Isa best = Isa::SCALAR;
+#if defined(GZ_MESH_KERNELS_X86)
+  // SSE2 is part of x86-64
+  best = CpuHasAvx2() ? Isa::AVX2 : Isa::SSE2;
+#endif
+
+  std::string simdEnv;
+  if (!common::env("GZ_MESH_SIMD", simdEnv) || simdEnv.empty())
+    return best;
+
+  Isa requested = best;
+  if (simdEnv == "scalar")
+    requested = Isa::SCALAR;
+  else if (simdEnv == "sse2")
+    requested = Isa::SSE2;
+  else if (simdEnv == "avx2")
+    requested = Isa::AVX2;
+  else
+    gzwarn << "Unknown GZ_MESH_SIMD value [" << simdEnv << "], expected "
+           << "scalar, sse2 or avx2." << std::endl;
+  return std::min(best, requested);
+}
+
+/// \brief Get the storage of the active instruction set
+/// \return Active instruction set, detected on first use
+std::atomic<int> &IsaStorage()
+{
+  static std::atomic<int> isa{static_cast<int>(DetectIsa())};
+  return isa;
+}
+
+//////////////////////////////////////////////////
+// Scalar kernels
+
+/// \brief Translate or scale a flat xyz array
+/// \param[in,out] _p Flat xyz array
+/// \param[in] _n Number of doubles
+/// \param[in] _v Offset or factor per axis
+/// \param[in] _scale True to multiply, false to add
+void ApplyScalar(double *_p, std::size_t _n, const double _v[3],
+    bool _scale)
+{
+  for (std::size_t i = 0; i + 3 <= _n; i += 3)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+      _p[i + j] = _scale ? _p[i + j] * _v[j] : _p[i + j] + _v[j];
+  }
+}
+
+/// \brief Apply a 3x4 affine transform to a flat xyz array
+/// \param[in,out] _p Flat xyz array
+/// \param[in] _count Number of points
+/// \param[in] _m Row major 3x4 matrix
+void TransformScalar(double *_p, std::size_t _count, const double _m[12])
+{
+  for (std::size_t i = 0; i < _count; ++i, _p += 3)
+  {
+    const double x = _p[0];
+    const double y = _p[1];
+    const double z = _p[2];
+    for (std::size_t r = 0; r < 3; ++r)
+      _p[r] = _m[4*r] * x + _m[4*r+1] * y + _m[4*r+2] * z + _m[4*r+3];
+  }
+}
+
+/// \brief Convert floats to doubles
+/// \param[in] _src Floats to convert
+/// \param[in] _n Number of floats
+/// \param[out] _dst Converted values
+void WidenScalar(const float *_src, std::size_t _n, double *_dst)
+{
+  for (std::size_t i = 0; i < _n; ++i)
+    _dst[i] = static_cast<double>(_src[i]);
+}
+
+/// \brief Lower and raise bounds to contain a flat xyz array
+/// \param[in] _p Flat xyz array
+/// \param[in] _n Number of doubles, a multiple of three
+/// \param[in,out] _min Minimum corner
+/// \param[in,out] _max Maximum corner
+void BoundsScalar(const double *_p, std::size_t _n, double _min[3],
+    double _max[3])
+{
+  for (std::size_t i = 0; i < _n; i += 3)
+  {
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      _min[j] = std::min(_min[j], _p[i + j]);
+      _max[j] = std::max(_max[j], _p[i + j]);
+    }
+  }
+}
+
+/// \brief Fold the lanes of vector bounds into scalar bounds
+/// \param[in] _lo Minimum lanes, a repeating x y z pattern
+/// \param[in] _hi Maximum lanes, a repeating x y z pattern
+/// \param[in] _n Number of lanes, a multiple of three
+/// \param[in,out] _min Minimum corner
+/// \param[in,out] _max Maximum corner
+void ReduceBounds(const double *_lo, const double *_hi, std::size_t _n,
+    double _min[3], double _max[3])
+{
+  for (std::size_t i = 0; i < _n; ++i)
+  {
+    _min[i % 3] = std::min(_min[i % 3], _lo[i]);
+    _max[i % 3] = std::max(_max[i % 3], _hi[i]);
+  }
+}
+
+/// \brief Accumulate the signed volume and moment of one triangle
+/// \param[in] _points Vertices
+/// \param[in] _a First index
+/// \param[in] _b Second index
+/// \param[in] _c Third index
+/// \param[in,out] _volume Signed volume sum
+/// \param[in,out] _moment Moment sum
+void AccumulateTriangle(const math::Vector3d *_points, std::size_t _a,
+    std::size_t _b, std::size_t _c, double &_volume, math::Vector3d &_moment)
+{
+  const math::Vector3d &v1 = _points[_a];
+  const math::Vector3d &v2 = _points[_b];
+  const math::Vector3d &v3 = _points[_c];
+  const double v = v1.Cross(v2).Dot(v3) / 6.0;
+  _volume += v;
+  _moment += v * (v1 + v2 + v3) / 4.0;
+}
+
+/// \brief Sum the mass properties of a triangle list
+/// \param[in] _points Vertices
+/// \param[in] _indices Triangle indices
+/// \param[in] _begin First index to process
+/// \param[in] _count Number of indices
+/// \param[in,out] _volume Signed volume sum
+/// \param[in,out] _moment Moment sum
+template<typename T>
+void MassScalar(const math::Vector3d *_points, const T *_indices,
+    std::size_t _begin, std::size_t _count, double &_volume,
+    math::Vector3d &_moment)
+{
+  for (std::size_t i = _begin; i + 3 <= _count; i += 3)
+  {
+    AccumulateTriangle(_points, _indices[i], _indices[i + 1],
+        _indices[i + 2], _volume, _moment);
+  }
+}
+
+#if defined(GZ_MESH_KERNELS_X86)
+//////////////////////////////////////////////////
+// SSE2 kernels
+
+/// \copydoc ApplyScalar
+void ApplySse2(double *_p, std::size_t _n, const double _v[3], bool _scale)
+{
+  // Three registers hold the repeating x y z pattern of 2 points
+  const double pattern[6] = {_v[0], _v[1], _v[2], _v[0], _v[1], _v[2]};
+  const __m128d a = _mm_loadu_pd(pattern);
+  const __m128d b = _mm_loadu_pd(pattern + 2);
+  const __m128d c = _mm_loadu_pd(pattern + 4);
+  std::size_t i = 0;
+  if (_scale)
+  {
+    for (; i + 6 <= _n; i += 6)
+    {
+      _mm_storeu_pd(_p + i, _mm_mul_pd(_mm_loadu_pd(_p + i), a));
+      _mm_storeu_pd(_p + i + 2, _mm_mul_pd(_mm_loadu_pd(_p + i + 2), b));
+      _mm_storeu_pd(_p + i + 4, _mm_mul_pd(_mm_loadu_pd(_p + i + 4), c));
+    }
+  }
+  else
+  {
+    for (; i + 6 <= _n; i += 6)
+    {
+      _mm_storeu_pd(_p + i, _mm_add_pd(_mm_loadu_pd(_p + i), a));
+      _mm_storeu_pd(_p + i + 2, _mm_add_pd(_mm_loadu_pd(_p + i + 2), b));
+      _mm_storeu_pd(_p + i + 4, _mm_add_pd(_mm_loadu_pd(_p + i + 4), c));
+    }
+  }
+  ApplyScalar(_p + i, _n - i, _v, _scale);
+}
+
+/// \copydoc TransformScalar
+void TransformSse2(double *_p, std::size_t _count, const double _m[12])
+{
+  // X and Y rows in the vector lanes, Z row in the low lane only
+  const __m128d c0 = _mm_set_pd(_m[4], _m[0]);
+  const __m128d c1 = _mm_set_pd(_m[5], _m[1]);
+  const __m128d c2 = _mm_set_pd(_m[6], _m[2]);
+  const __m128d c3 = _mm_set_pd(_m[7], _m[3]);
+  const __m128d z0 = _mm_set_sd(_m[8]);
+  const __m128d z1 = _mm_set_sd(_m[9]);
+  const __m128d z2 = _mm_set_sd(_m[10]);
+  const __m128d z3 = _mm_set_sd(_m[11]);
+  for (std::size_t i = 0; i < _count; ++i, _p += 3)
+  {
+    const __m128d x = _mm_set1_pd(_p[0]);
+    const __m128d y = _mm_set1_pd(_p[1]);
+    const __m128d z = _mm_set1_pd(_p[2]);
+    const __m128d xy = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+        _mm_mul_pd(c0, x), _mm_mul_pd(c1, y)), _mm_mul_pd(c2, z)), c3);
+    const __m128d zz = _mm_add_sd(_mm_add_sd(_mm_add_sd(
+        _mm_mul_sd(z0, x), _mm_mul_sd(z1, y)), _mm_mul_sd(z2, z)), z3);
+    _mm_storeu_pd(_p, xy);
+    _mm_store_sd(_p + 2, zz);
+  }
+}
+
+/// \copydoc WidenScalar
+void WidenSse2(const float *_src, std::size_t _n, double *_dst)
+{
+  std::size_t i = 0;
+  for (; i + 4 <= _n; i += 4)
+  {
+    const __m128 f = _mm_loadu_ps(_src + i);
+    _mm_storeu_pd(_dst + i, _mm_cvtps_pd(f));
+    _mm_storeu_pd(_dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(f, f)));
+  }
+  WidenScalar(_src + i, _n - i, _dst + i);
+}
+
+/// \copydoc BoundsScalar
+void BoundsSse2(const double *_p, std::size_t _n, double _min[3],
+    double _max[3])
+{
+  const double pattern[6] = {_min[0], _min[1], _min[2],
+                             _min[0], _min[1], _min[2]};
+  const double patternMax[6] = {_max[0], _max[1], _max[2],
+                                _max[0], _max[1], _max[2]};
+  __m128d lo0 = _mm_loadu_pd(pattern);
+  __m128d lo1 = _mm_loadu_pd(pattern + 2);
+  __m128d lo2 = _mm_loadu_pd(pattern + 4);
+  __m128d hi0 = _mm_loadu_pd(patternMax);
+  __m128d hi1 = _mm_loadu_pd(patternMax + 2);
+  __m128d hi2 = _mm_loadu_pd(patternMax + 4);
+  std::size_t i = 0;
+  for (; i + 6 <= _n; i += 6)
+  {
+    const __m128d a = _mm_loadu_pd(_p + i);
+    const __m128d b = _mm_loadu_pd(_p + i + 2);
+    const __m128d c = _mm_loadu_pd(_p + i + 4);
+    lo0 = _mm_min_pd(lo0, a);
+    lo1 = _mm_min_pd(lo1, b);
+    lo2 = _mm_min_pd(lo2, c);
+    hi0 = _mm_max_pd(hi0, a);
+    hi1 = _mm_max_pd(hi1, b);
+    hi2 = _mm_max_pd(hi2, c);
+  }
+
+  double lo[6];
+  double hi[6];
+  _mm_storeu_pd(lo, lo0);
+  _mm_storeu_pd(lo + 2, lo1);
+  _mm_storeu_pd(lo + 4, lo2);
+  _mm_storeu_pd(hi, hi0);
+  _mm_storeu_pd(hi + 2, hi1);
+  _mm_storeu_pd(hi + 4, hi2);
+  ReduceBounds(lo, hi, 6, _min, _max);
+  BoundsScalar(_p + i, _n - i, _min, _max);
+}
+
+/// \copydoc MassScalar
+template<typename T>
+void MassSse2(const math::Vector3d *_points, const T *_indices,
+    std::size_t _count, double &_volume, math::Vector3d &_moment)
+{
+  const double *p = reinterpret_cast<const double *>(_points);
+  const __m128d sixth = _mm_set1_pd(6.0);
+  const __m128d quarter = _mm_set1_pd(4.0);
+  __m128d volume = _mm_setzero_pd();
+  __m128d mx = _mm_setzero_pd();
+  __m128d my = _mm_setzero_pd();
+  __m128d mz = _mm_setzero_pd();
+
+  // Two triangles per iteration, one in each lane
+  std::size_t i = 0;
+  for (; i + 6 <= _count; i += 6)
+  {
+    const double *a1 = p + 3 * static_cast<std::size_t>(_indices[i]);
+    const double *a2 = p + 3 * static_cast<std::size_t>(_indices[i + 1]);
+    const double *a3 = p + 3 * static_cast<std::size_t>(_indices[i + 2]);
+    const double *b1 = p + 3 * static_cast<std::size_t>(_indices[i + 3]);
+    const double *b2 = p + 3 * static_cast<std::size_t>(_indices[i + 4]);
+    const double *b3 = p + 3 * static_cast<std::size_t>(_indices[i + 5]);
+    const __m128d x1 = _mm_set_pd(b1[0], a1[0]);
+    const __m128d y1 = _mm_set_pd(b1[1], a1[1]);
+    const __m128d z1 = _mm_set_pd(b1[2], a1[2]);
+    const __m128d x2 = _mm_set_pd(b2[0], a2[0]);
+    const __m128d y2 = _mm_set_pd(b2[1], a2[1]);
+    const __m128d z2 = _mm_set_pd(b2[2], a2[2]);
+    const __m128d x3 = _mm_set_pd(b3[0], a3[0]);
+    const __m128d y3 = _mm_set_pd(b3[1], a3[1]);
+    const __m128d z3 = _mm_set_pd(b3[2], a3[2]);
+
+    const __m128d cx = _mm_sub_pd(_mm_mul_pd(y1, z2), _mm_mul_pd(z1, y2));
+    const __m128d cy = _mm_sub_pd(_mm_mul_pd(z1, x2), _mm_mul_pd(x1, z2));
+    const __m128d cz = _mm_sub_pd(_mm_mul_pd(x1, y2), _mm_mul_pd(y1, x2));
+    const __m128d v = _mm_div_pd(_mm_add_pd(_mm_add_pd(
+        _mm_mul_pd(cx, x3), _mm_mul_pd(cy, y3)), _mm_mul_pd(cz, z3)), sixth);
+    volume = _mm_add_pd(volume, v);
+    mx = _mm_add_pd(mx, _mm_div_pd(_mm_mul_pd(v,
+        _mm_add_pd(_mm_add_pd(x1, x2), x3)), quarter));
+    my = _mm_add_pd(my, _mm_div_pd(_mm_mul_pd(v,
+        _mm_add_pd(_mm_add_pd(y1, y2), y3)), quarter));
+    mz = _mm_add_pd(mz, _mm_div_pd(_mm_mul_pd(v,
+        _mm_add_pd(_mm_add_pd(z1, z2), z3)), quarter));
+  }
+
+  double lanes[8];
+  _mm_storeu_pd(lanes, volume);
+  _mm_storeu_pd(lanes + 2, mx);
+  _mm_storeu_pd(lanes + 4, my);
+  _mm_storeu_pd(lanes + 6, mz);
+  _volume += lanes[0] + lanes[1];
+  _moment += math::Vector3d(lanes[2] + lanes[3], lanes[4] + lanes[5],
+      lanes[6] + lanes[7]);
+  MassScalar(_points, _indices, i, _count, _volume, _moment);
+}
+
+//////////////////////////////////////////////////
+// AVX2 kernels
+
+/// \copydoc ApplyScalar
+GZ_MESH_KERNELS_AVX2
+void ApplyAvx2(double *_p, std::size_t _n, const double _v[3], bool _scale)
+{
+  // Three registers hold the repeating x y z pattern of 4 points
+  double pattern[12];
+  for (std::size_t j = 0; j < 12; ++j)
+    pattern[j] = _v[j % 3];
+  const __m256d a = _mm256_loadu_pd(pattern);
+  const __m256d b = _mm256_loadu_pd(pattern + 4);
+  const __m256d c = _mm256_loadu_pd(pattern + 8);
+  std::size_t i = 0;
+  if (_scale)
+  {
+    for (; i + 12 <= _n; i += 12)
+    {
+      _mm256_storeu_pd(_p + i, _mm256_mul_pd(_mm256_loadu_pd(_p + i), a));
+      _mm256_storeu_pd(_p + i + 4,
+          _mm256_mul_pd(_mm256_loadu_pd(_p + i + 4), b));
+      _mm256_storeu_pd(_p + i + 8,
+          _mm256_mul_pd(_mm256_loadu_pd(_p + i + 8), c));
+    }
+  }
+  else
+  {
+    for (; i + 12 <= _n; i += 12)
+    {
+      _mm256_storeu_pd(_p + i, _mm256_add_pd(_mm256_loadu_pd(_p + i), a));
+      _mm256_storeu_pd(_p + i + 4,
+          _mm256_add_pd(_mm256_loadu_pd(_p + i + 4), b));
+      _mm256_storeu_pd(_p + i + 8,
+          _mm256_add_pd(_mm256_loadu_pd(_p + i + 8), c));
+    }
+  }
+  ApplyScalar(_p + i, _n - i, _v, _scale);
+}
+
+/// \copydoc TransformScalar
+GZ_MESH_KERNELS_AVX2
+void TransformAvx2(double *_p, std::size_t _count, const double _m[12])
+{
+  // One point per iteration. The fourth lane carries the unchanged X of
+  // the next point so that full width stores can be used, and the X is
+  // kept in a register so no load waits for the previous store.
+  const __m256d c0 = _mm256_set_pd(0.0, _m[8], _m[4], _m[0]);
+  const __m256d c1 = _mm256_set_pd(0.0, _m[9], _m[5], _m[1]);
+  const __m256d c2 = _mm256_set_pd(0.0, _m[10], _m[6], _m[2]);
+  const __m256d c3 = _mm256_set_pd(0.0, _m[11], _m[7], _m[3]);
+  if (_count == 0)
+    return;
+  std::size_t i = 0;
+  __m256d x = _mm256_broadcast_sd(_p);
+  for (; i + 1 < _count; ++i, _p += 3)
+  {
+    const __m256d y = _mm256_broadcast_sd(_p + 1);
+    const __m256d z = _mm256_broadcast_sd(_p + 2);
+    const __m256d nextX = _mm256_broadcast_sd(_p + 3);
+    const __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(
+        _mm256_mul_pd(c0, x), _mm256_mul_pd(c1, y)), _mm256_mul_pd(c2, z)),
+        c3);
+    _mm256_storeu_pd(_p, _mm256_blend_pd(r, nextX, 0x8));
+    x = nextX;
+  }
+  TransformScalar(_p, _count - i, _m);
+}
+
+/// \copydoc WidenScalar
+GZ_MESH_KERNELS_AVX2
+void WidenAvx2(const float *_src, std::size_t _n, double *_dst)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= _n; i += 8)
+  {
+    _mm256_storeu_pd(_dst + i, _mm256_cvtps_pd(_mm_loadu_ps(_src + i)));
+    _mm256_storeu_pd(_dst + i + 4,
+        _mm256_cvtps_pd(_mm_loadu_ps(_src + i + 4)));
+  }
+  WidenScalar(_src + i, _n - i, _dst + i);
+}
+
+/// \copydoc BoundsScalar
+GZ_MESH_KERNELS_AVX2
+void BoundsAvx2(const double *_p, std::size_t _n, double _min[3],
+    double _max[3])
+{
+  double pattern[12];
+  double patternMax[12];
+  for (std::size_t j = 0; j < 12; ++j)
+  {
+    pattern[j] = _min[j % 3];
+    patternMax[j] = _max[j % 3];
+  }
+  __m256d lo0 = _mm256_loadu_pd(pattern);
+  __m256d lo1 = _mm256_loadu_pd(pattern + 4);
+  __m256d lo2 = _mm256_loadu_pd(pattern + 8);
+  __m256d hi0 = _mm256_loadu_pd(patternMax);
+  __m256d hi1 = _mm256_loadu_pd(patternMax + 4);
+  __m256d hi2 = _mm256_loadu_pd(patternMax + 8);
+  std::size_t i = 0;
+  for (; i + 12 <= _n; i += 12)
+  {
+    const __m256d a = _mm256_loadu_pd(_p + i);
+    const __m256d b = _mm256_loadu_pd(_p + i + 4);
+    const __m256d c = _mm256_loadu_pd(_p + i + 8);
+    lo0 = _mm256_min_pd(lo0, a);
+    lo1 = _mm256_min_pd(lo1, b);
+    lo2 = _mm256_min_pd(lo2, c);
+    hi0 = _mm256_max_pd(hi0, a);
+    hi1 = _mm256_max_pd(hi1, b);
+    hi2 = _mm256_max_pd(hi2, c);
+  }
+
+  _mm256_storeu_pd(pattern, lo0);
+  _mm256_storeu_pd(pattern + 4, lo1);
+  _mm256_storeu_pd(pattern + 8, lo2);
+  _mm256_storeu_pd(patternMax, hi0);
+  _mm256_storeu_pd(patternMax + 4, hi1);
+  _mm256_storeu_pd(patternMax + 8, hi2);
+  ReduceBounds(pattern, patternMax, 12, _min, _max);
+  BoundsScalar(_p + i, _n - i, _min, _max);
+}
+
+/// \brief Load the offsets of one vertex of four consecutive triangles
+/// \param[in] _indices Index of the vertex in the first triangle
+/// \return Offsets of the vertices from the start of the array, in doubles
+template<typename T>
+GZ_MESH_KERNELS_AVX2
+__m256i TriangleOffsets(const T *_indices)
+{
+  const __m128i indices = _mm_set_epi32(
+      static_cast<int>(_indices[9]), static_cast<int>(_indices[6]),
+      static_cast<int>(_indices[3]), static_cast<int>(_indices[0]));
+  // 64-bit offsets do not overflow for any unsigned int index
+  return _mm256_mul_epu32(_mm256_cvtepu32_epi64(indices),
+      _mm256_set1_epi64x(3));
+}
+
+/// \copydoc MassScalar
+template<typename T>
+GZ_MESH_KERNELS_AVX2
+void MassAvx2(const math::Vector3d *_points, const T *_indices,
+    std::size_t _count, double &_volume, math::Vector3d &_moment)
+{
+  const double *p = reinterpret_cast<const double *>(_points);
+  const __m256d sixth = _mm256_set1_pd(6.0);
+  const __m256d quarter = _mm256_set1_pd(4.0);
+  __m256d volume = _mm256_setzero_pd();
+  __m256d mx = _mm256_setzero_pd();
+  __m256d my = _mm256_setzero_pd();
+  __m256d mz = _mm256_setzero_pd();
+
+  // Four triangles per iteration, one in each lane
+  std::size_t i = 0;
+  for (; i + 12 <= _count; i += 12)
+  {
+    const __m256i o1 = TriangleOffsets(_indices + i);
+    const __m256i o2 = TriangleOffsets(_indices + i + 1);
+    const __m256i o3 = TriangleOffsets(_indices + i + 2);
+    const __m256d x1 = _mm256_i64gather_pd(p, o1, 8);
+    const __m256d y1 = _mm256_i64gather_pd(p + 1, o1, 8);
+    const __m256d z1 = _mm256_i64gather_pd(p + 2, o1, 8);
+    const __m256d x2 = _mm256_i64gather_pd(p, o2, 8);
+    const __m256d y2 = _mm256_i64gather_pd(p + 1, o2, 8);
+    const __m256d z2 = _mm256_i64gather_pd(p + 2, o2, 8);
+    const __m256d x3 = _mm256_i64gather_pd(p, o3, 8);
+    const __m256d y3 = _mm256_i64gather_pd(p + 1, o3, 8);
+    const __m256d z3 = _mm256_i64gather_pd(p + 2, o3, 8);
+
+    const __m256d cx = _mm256_sub_pd(_mm256_mul_pd(y1, z2),
+        _mm256_mul_pd(z1, y2));
+    const __m256d cy = _mm256_sub_pd(_mm256_mul_pd(z1, x2),
+        _mm256_mul_pd(x1, z2));
+    const __m256d cz = _mm256_sub_pd(_mm256_mul_pd(x1, y2),
+        _mm256_mul_pd(y1, x2));
+    const __m256d v = _mm256_div_pd(_mm256_add_pd(_mm256_add_pd(
+        _mm256_mul_pd(cx, x3), _mm256_mul_pd(cy, y3)),
+        _mm256_mul_pd(cz, z3)), sixth);
+    volume = _mm256_add_pd(volume, v);
+    mx = _mm256_add_pd(mx, _mm256_div_pd(_mm256_mul_pd(v,
+        _mm256_add_pd(_mm256_add_pd(x1, x2), x3)), quarter));
+    my = _mm256_add_pd(my, _mm256_div_pd(_mm256_mul_pd(v,
+        _mm256_add_pd(_mm256_add_pd(y1, y2), y3)), quarter));
+    mz = _mm256_add_pd(mz, _mm256_div_pd(_mm256_mul_pd(v,
+        _mm256_add_pd(_mm256_add_pd(z1, z2), z3)), quarter));
+  }
+
+  double lanes[16];
+  _mm256_storeu_pd(lanes, volume);
+  _mm256_storeu_pd(lanes + 4, mx);
+  _mm256_storeu_pd(lanes + 8, my);
+  _mm256_storeu_pd(lanes + 12, mz);
+  double sums[4];
+  for (std::size_t j = 0; j < 4; ++j)
+  {
+    const double *l = lanes + 4 * j;
+    sums[j] = (l[0] + l[1]) + (l[2] + l[3]);
+  }
+  _volume += sums[0];
+  _moment += math::Vector3d(sums[1], sums[2], sums[3]);
+  MassScalar(_points, _indices, i, _count, _volume, _moment);
+}
+#endif
+
+/// \brief Dispatch a translation or scale
+/// \param[in,out] _points Points to update
+/// \param[in] _count Number of points
+/// \param[in] _v Offset or factor
+/// \param[in] _scale True to multiply, false to add
+void Apply(math::Vector3d *_points, std::size_t _count,
+    const math::Vector3d &_v, bool _scale)
+{
+  double *p = reinterpret_cast<double *>(_points);
+  const double v[3] = {_v.X(), _v.Y(), _v.Z()};
+  switch (ActiveIsa())
+  {
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::AVX2:
+      ApplyAvx2(p, 3 * _count, v, _scale);
+      return;
+    case Isa::SSE2:
+      ApplySse2(p, 3 * _count, v, _scale);
+      return;
+#endif
+    default:
+      ApplyScalar(p, 3 * _count, v, _scale);
+  }
+}
+
+/// \brief Dispatch a float to double conversion
+/// \param[in] _src Floats to convert
+/// \param[in] _n Number of floats
+/// \param[out] _dst Converted values
+void WidenPacked(const float *_src, std::size_t _n, double *_dst)
+{
+  switch (ActiveIsa())
+  {
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::AVX2:
+      WidenAvx2(_src, _n, _dst);
+      return;
+    case Isa::SSE2:
+      WidenSse2(_src, _n, _dst);
+      return;
+#endif
+    default:
+      WidenScalar(_src, _n, _dst);
+  }
+}
+
+/// \brief Dispatch a mass properties computation
+/// \param[in] _points Vertices
+/// \param[in] _indices Triangle indices
+/// \param[in] _count Number of indices
+/// \param[out] _volume Signed volume sum
+/// \param[out] _moment Moment sum
+template<typename T>
+void Mass(const math::Vector3d *_points, const T *_indices,
+    std::size_t _count, double &_volume, math::Vector3d &_moment)
+{
+  _volume = 0.0;
+  _moment = math::Vector3d::Zero;
+  switch (ActiveIsa())
+  {
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::AVX2:
+      MassAvx2(_points, _indices, _count, _volume, _moment);
+      return;
+    case Isa::SSE2:
+      MassSse2(_points, _indices, _count, _volume, _moment);
+      return;
+#endif
+    default:
+      MassScalar(_points, _indices, 0u, _count, _volume, _moment);
+  }
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+Isa meshkernels::ActiveIsa()
+{
+  return static_cast<Isa>(IsaStorage().load(std::memory_order_relaxed));
+}
+
+//////////////////////////////////////////////////
+bool meshkernels::IsaSupported(Isa _isa)
+{
+  switch (_isa)
+  {
+    case Isa::SCALAR:
+      return true;
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::SSE2:
+      return true;
+    case Isa::AVX2:
+      return CpuHasAvx2();
+#endif
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool meshkernels::SetActiveIsa(Isa _isa)
+{
+  if (!IsaSupported(_isa))
+    return false;
+  IsaStorage().store(static_cast<int>(_isa), std::memory_order_relaxed);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const char *meshkernels::IsaName(Isa _isa)
+{
+  switch (_isa)
+  {
+    case Isa::SSE2:
+      return "sse2";
+    case Isa::AVX2:
+      return "avx2";
+    default:
+      return "scalar";
+  }
+}
+
+//////////////////////////////////////////////////
+void meshkernels::Translate(math::Vector3d *_points, std::size_t _count,
+    const math::Vector3d &_offset)
+{
+  Apply(_points, _count, _offset, false);
+}
+
+//////////////////////////////////////////////////
+void meshkernels::Scale(math::Vector3d *_points, std::size_t _count,
+    const math::Vector3d &_factor)
+{
+  Apply(_points, _count, _factor, true);
+}
+
+//////////////////////////////////////////////////
+void meshkernels::Transform(math::Vector3d *_points, std::size_t _count,
+    const math::Matrix4d &_matrix)
+{
+  double m[12];
+  for (std::size_t r = 0; r < 3; ++r)
+  {
+    for (std::size_t c = 0; c < 4; ++c)
+      m[4 * r + c] = _matrix(r, c);
+  }
+
+  double *p = reinterpret_cast<double *>(_points);
+  switch (ActiveIsa())
+  {
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::AVX2:
+      TransformAvx2(p, _count, m);
+      return;
+    case Isa::SSE2:
+      TransformSse2(p, _count, m);
+      return;
+#endif
+    default:
+      TransformScalar(p, _count, m);
+  }
+}
+
+//////////////////////////////////////////////////
+void meshkernels::Bounds(const math::Vector3d *_points, std::size_t _count,
+    math::Vector3d &_min, math::Vector3d &_max)
+{
+  const double *p = reinterpret_cast<const double *>(_points);
+  double min[3] = {_min.X(), _min.Y(), _min.Z()};
+  double max[3] = {_max.X(), _max.Y(), _max.Z()};
+  switch (ActiveIsa())
+  {
+#if defined(GZ_MESH_KERNELS_X86)
+    case Isa::AVX2:
+      BoundsAvx2(p, 3 * _count, min, max);
+      break;
+    case Isa::SSE2:
+      BoundsSse2(p, 3 * _count, min, max);
+      break;
+#endif
+    default:
+      BoundsScalar(p, 3 * _count, min, max);
+  }
+  _min.Set(min[0], min[1], min[2]);
+  _max.Set(max[0], max[1], max[2]);
+}
+
+//////////////////////////////////////////////////
+void meshkernels::Widen(const float *_src, std::size_t _srcStride,
+    std::size_t _components, std::size_t _count, double *_dst)
+{
+  if (_srcStride == _components)
+  {
+    WidenPacked(_src, _components * _count, _dst);
+    return;
+  }
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    WidenScalar(_src + i * _srcStride, _components,
+        _dst + i * _components);
+  }
+}
+
+//////////////////////////////////////////////////
+void meshkernels::MassProperties(const math::Vector3d *_points,
+    const uint16_t *_indices, std::size_t _indexCount,
+    double &_signedVolume, math::Vector3d &_moment)
+{
+  Mass(_points, _indices, _indexCount, _signedVolume, _moment);
+}
+
+//////////////////////////////////////////////////
+void meshkernels::MassProperties(const math::Vector3d *_points,
+    const unsigned int *_indices, std::size_t _indexCount,
+    double &_signedVolume, math::Vector3d &_moment)
+{
+  Mass(_points, _indices, _indexCount, _signedVolume, _moment);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_MESHKERNELS_HH_
+#define GZ_COMMON_MESHKERNELS_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <gz/math/Matrix4.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/common/graphics/Export.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Bulk operations on vertex and index arrays, used by SubMesh.
+    ///
+    /// Every kernel has a scalar version and, on x86-64, SSE2 and AVX2
+    /// versions. The instruction set is chosen at runtime from what the
+    /// CPU supports, and can be capped with the GZ_MESH_SIMD environment
+    /// variable set to "scalar", "sse2" or "avx2". Transforms and bounds
+    /// give the same result with every instruction set; the mass
+    /// properties sum in a different order and can differ in the last
+    /// bits.
+    namespace meshkernels
+    {
+      /// \brief Instruction sets the kernels can use.
+      enum class Isa
+      {
+        /// \brief Plain C++.
+        SCALAR = 0,
+
+        /// \brief 128-bit SSE2.
+        SSE2 = 1,
+
+        /// \brief 256-bit AVX2.
+        AVX2 = 2
+      };
+
+      /// \brief Get the instruction set used by the kernels.
+      /// \return The active instruction set.
+      GZ_COMMON_GRAPHICS_VISIBLE Isa ActiveIsa();
+
+      /// \brief Check if the CPU supports an instruction set.
+      /// \param[in] _isa Instruction set to check.
+      /// \return True if the kernels can use _isa.
+      GZ_COMMON_GRAPHICS_VISIBLE bool IsaSupported(Isa _isa);
+
+      /// \brief Set the instruction set used by the kernels.
+      /// \param[in] _isa Instruction set to use.
+      /// \return False if the CPU does not support _isa, in which case the
+      /// active instruction set is unchanged.
+      GZ_COMMON_GRAPHICS_VISIBLE bool SetActiveIsa(Isa _isa);
+
+      /// \brief Get the name of an instruction set.
+      /// \param[in] _isa The instruction set.
+      /// \return "scalar", "sse2" or "avx2".
+      GZ_COMMON_GRAPHICS_VISIBLE const char *IsaName(Isa _isa);
+
+      /// \brief Add a vector to every point of an array.
+      /// \param[in,out] _points Points to translate.
+      /// \param[in] _count Number of points.
+      /// \param[in] _offset Translation.
+      GZ_COMMON_GRAPHICS_VISIBLE void Translate(math::Vector3d *_points,
+          std::size_t _count, const math::Vector3d &_offset);
+
+      /// \brief Multiply every point of an array componentwise.
+      /// \param[in,out] _points Points to scale.
+      /// \param[in] _count Number of points.
+      /// \param[in] _factor Scale factor of each axis.
+      GZ_COMMON_GRAPHICS_VISIBLE void Scale(math::Vector3d *_points,
+          std::size_t _count, const math::Vector3d &_factor);
+
+      /// \brief Apply an affine transform to every point of an array. The
+      /// bottom row of the matrix is ignored.
+      /// \param[in,out] _points Points to transform.
+      /// \param[in] _count Number of points.
+      /// \param[in] _matrix Affine transform.
+      GZ_COMMON_GRAPHICS_VISIBLE void Transform(math::Vector3d *_points,
+          std::size_t _count, const math::Matrix4d &_matrix);
+
+      /// \brief Compute the axis aligned bounds of an array of points.
+      /// \param[in] _points Points to bound.
+      /// \param[in] _count Number of points.
+      /// \param[in,out] _min Minimum corner, lowered to contain the points.
+      /// \param[in,out] _max Maximum corner, raised to contain the points.
+      GZ_COMMON_GRAPHICS_VISIBLE void Bounds(const math::Vector3d *_points,
+          std::size_t _count, math::Vector3d &_min, math::Vector3d &_max);
+
+      /// \brief Convert an array of single precision vectors, such as the
+      /// buffers of a model loader, to packed double precision vectors.
+      /// \param[in] _src First component of the first vector.
+      /// \param[in] _srcStride Number of floats from one vector to the
+      /// next, at least _components.
+      /// \param[in] _components Number of components of each vector.
+      /// \param[in] _count Number of vectors.
+      /// \param[out] _dst Array of _components * _count doubles.
+      GZ_COMMON_GRAPHICS_VISIBLE void Widen(const float *_src,
+          std::size_t _srcStride, std::size_t _components,
+          std::size_t _count, double *_dst);
+
+      /// \brief Sum the signed volumes and first moments of the
+      /// tetrahedra formed by the origin and each triangle of a list.
+      /// \param[in] _points Vertices of the triangles.
+      /// \param[in] _indices Three indices per triangle, all valid.
+      /// \param[in] _indexCount Number of indices, a multiple of three.
+      /// \param[out] _signedVolume Sum of the signed volumes.
+      /// \param[out] _moment Sum of the volumes times the tetrahedron
+      /// centroids.
+      GZ_COMMON_GRAPHICS_VISIBLE void MassProperties(
+          const math::Vector3d *_points, const uint16_t *_indices,
+          std::size_t _indexCount, double &_signedVolume,
+          math::Vector3d &_moment);
+
+      /// \copydoc MassProperties
+      GZ_COMMON_GRAPHICS_VISIBLE void MassProperties(
+          const math::Vector3d *_points, const unsigned int *_indices,
+          std::size_t _indexCount, double &_signedVolume,
+          math::Vector3d &_moment);
+    }
+  }
+}
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MeshKernels.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+using namespace common;
+
+class MeshKernels : public common::testing::AutoLogFixture
+{
+  protected: void SetUp() override
+  {
+    common::testing::AutoLogFixture::SetUp();
+    this->previousIsa = meshkernels::ActiveIsa();
+  }
+
+  protected: void TearDown() override
+  {
+    meshkernels::SetActiveIsa(this->previousIsa);
+    common::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Instruction set active before the test
+  protected: meshkernels::Isa previousIsa = meshkernels::Isa::SCALAR;
+};
+
+/// \brief Instruction sets to compare with the scalar kernels
+static const meshkernels::Isa kIsas[] =
+    {meshkernels::Isa::SSE2, meshkernels::Isa::AVX2};
+
+/////////////////////////////////////////////////
+TEST_F(MeshKernels, Isa)
+{
+  EXPECT_TRUE(meshkernels::IsaSupported(meshkernels::ActiveIsa()));
+  EXPECT_TRUE(meshkernels::IsaSupported(meshkernels::Isa::SCALAR));
+  EXPECT_TRUE(meshkernels::SetActiveIsa(meshkernels::Isa::SCALAR));
+  EXPECT_EQ(meshkernels::Isa::SCALAR, meshkernels::ActiveIsa());
+  EXPECT_EQ(std::string("scalar"), meshkernels::IsaName(
+      meshkernels::Isa::SCALAR));
+  EXPECT_EQ(std::string("sse2"), meshkernels::IsaName(
+      meshkernels::Isa::SSE2));
+  EXPECT_EQ(std::string("avx2"), meshkernels::IsaName(
+      meshkernels::Isa::AVX2));
+
+  for (const auto isa : kIsas)
+  {
+    EXPECT_EQ(meshkernels::IsaSupported(isa),
+        meshkernels::SetActiveIsa(isa));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshKernels, Transforms)
+{
+  // Sizes that leave a tail for every vector width
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-100.0, 100.0);
+  for (const std::size_t count : {0u, 1u, 3u, 5u, 1001u})
+  {
+    std::vector<math::Vector3d> points(count);
+    for (auto &p : points)
+      p.Set(dist(gen), dist(gen), dist(gen));
+
+    const math::Vector3d offset(1.5, -2.25, 1e3);
+    const math::Vector3d factor(-0.5, 3.0, 1e-3);
+    const math::Matrix4d matrix(
+        0.0, -2.0, 0.0, 1.0,
+        1.5, 0.0, 0.0, -4.0,
+        0.0, 0.0, 3.0, 0.5,
+        0.0, 0.0, 0.0, 1.0);
+
+    meshkernels::SetActiveIsa(meshkernels::Isa::SCALAR);
+    auto translated = points;
+    meshkernels::Translate(translated.data(), count, offset);
+    auto scaled = points;
+    meshkernels::Scale(scaled.data(), count, factor);
+    auto transformed = points;
+    meshkernels::Transform(transformed.data(), count, matrix);
+    math::Vector3d min(math::MAX_D, math::MAX_D, math::MAX_D);
+    math::Vector3d max = -min;
+    meshkernels::Bounds(points.data(), count, min, max);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(points[i] + offset, translated[i]);
+      EXPECT_EQ(points[i] * factor, scaled[i]);
+      EXPECT_DOUBLE_EQ(-2.0 * points[i].Y() + 1.0, transformed[i].X());
+      EXPECT_DOUBLE_EQ(1.5 * points[i].X() - 4.0, transformed[i].Y());
+      EXPECT_DOUBLE_EQ(3.0 * points[i].Z() + 0.5, transformed[i].Z());
+      EXPECT_LE(min.X(), points[i].X());
+      EXPECT_GE(max.Z(), points[i].Z());
+    }
+
+    // Every instruction set gives the same result as the scalar kernels
+    for (const auto isa : kIsas)
+    {
+      if (!meshkernels::SetActiveIsa(isa))
+        continue;
+      auto other = points;
+      meshkernels::Translate(other.data(), count, offset);
+      EXPECT_EQ(translated, other) << meshkernels::IsaName(isa);
+      other = points;
+      meshkernels::Scale(other.data(), count, factor);
+      EXPECT_EQ(scaled, other) << meshkernels::IsaName(isa);
+      other = points;
+      meshkernels::Transform(other.data(), count, matrix);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        EXPECT_DOUBLE_EQ(transformed[i].X(), other[i].X());
+        EXPECT_DOUBLE_EQ(transformed[i].Y(), other[i].Y());
+        EXPECT_DOUBLE_EQ(transformed[i].Z(), other[i].Z());
+      }
+      math::Vector3d otherMin(math::MAX_D, math::MAX_D, math::MAX_D);
+      math::Vector3d otherMax = -otherMin;
+      meshkernels::Bounds(points.data(), count, otherMin, otherMax);
+      EXPECT_EQ(min, otherMin) << meshkernels::IsaName(isa);
+      EXPECT_EQ(max, otherMax) << meshkernels::IsaName(isa);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshKernels, MassProperties)
+{
+  // Random triangle soup, with a count that leaves a tail for every width
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  std::vector<math::Vector3d> points(500);
+  for (auto &p : points)
+    p.Set(dist(gen), dist(gen), dist(gen));
+  std::uniform_int_distribution<unsigned int> pick(0u, 499u);
+  std::vector<unsigned int> indices(3 * 103);
+  for (auto &index : indices)
+    index = pick(gen);
+  const std::vector<uint16_t> indices16(indices.begin(), indices.end());
+
+  meshkernels::SetActiveIsa(meshkernels::Isa::SCALAR);
+  double volume = 1.0;
+  math::Vector3d moment(1, 1, 1);
+  meshkernels::MassProperties(points.data(), indices.data(), indices.size(),
+      volume, moment);
+
+  // Reference sum
+  double expectedVolume = 0.0;
+  math::Vector3d expectedMoment;
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+  {
+    const auto &v1 = points[indices[i]];
+    const auto &v2 = points[indices[i + 1]];
+    const auto &v3 = points[indices[i + 2]];
+    const double v = v1.Cross(v2).Dot(v3) / 6.0;
+    expectedVolume += v;
+    expectedMoment += v * (v1 + v2 + v3) / 4.0;
+  }
+  EXPECT_DOUBLE_EQ(expectedVolume, volume);
+  EXPECT_EQ(expectedMoment, moment);
+
+  // Other instruction sets and index widths sum in a different order
+  const double tol = 1e-9 * std::abs(expectedVolume) + 1e-9;
+  for (const auto isa : {meshkernels::Isa::SCALAR, meshkernels::Isa::SSE2,
+                         meshkernels::Isa::AVX2})
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+    double otherVolume = 0.0;
+    math::Vector3d otherMoment;
+    meshkernels::MassProperties(points.data(), indices.data(),
+        indices.size(), otherVolume, otherMoment);
+    EXPECT_NEAR(expectedVolume, otherVolume, tol) << meshkernels::IsaName(isa);
+    EXPECT_NEAR(expectedMoment.X(), otherMoment.X(), 1e3 * tol);
+    EXPECT_NEAR(expectedMoment.Y(), otherMoment.Y(), 1e3 * tol);
+    EXPECT_NEAR(expectedMoment.Z(), otherMoment.Z(), 1e3 * tol);
+
+    meshkernels::MassProperties(points.data(), indices16.data(),
+        indices16.size(), otherVolume, otherMoment);
+    EXPECT_NEAR(expectedVolume, otherVolume, tol) << meshkernels::IsaName(isa);
+    EXPECT_NEAR(expectedMoment.Z(), otherMoment.Z(), 1e3 * tol);
+
+    // No triangles
+    meshkernels::MassProperties(points.data(), indices.data(), 0u,
+        otherVolume, otherMoment);
+    EXPECT_DOUBLE_EQ(0.0, otherVolume);
+    EXPECT_EQ(math::Vector3d::Zero, otherMoment);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshKernels, Widen)
+{
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+  std::vector<float> values(4u * 1001u);
+  for (auto &v : values)
+    v = dist(gen);
+
+  for (const auto isa : {meshkernels::Isa::SCALAR, meshkernels::Isa::SSE2,
+                         meshkernels::Isa::AVX2})
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+
+    // Packed and strided vectors, with counts that leave a tail for every
+    // vector width
+    for (const std::size_t count : {0u, 1u, 3u, 5u, 1001u})
+    {
+      for (const std::size_t components : {2u, 3u})
+      {
+        for (const std::size_t stride : {components, std::size_t(4u)})
+        {
+          std::vector<double> widened(components * count, 0.0);
+          meshkernels::Widen(values.data(), stride, components, count,
+              widened.data());
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            for (std::size_t j = 0; j < components; ++j)
+            {
+              ASSERT_EQ(static_cast<double>(values[i * stride + j]),
+                  widened[i * components + j]) << meshkernels::IsaName(isa);
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -17,13 +17,22 @@
 
 #include <sys/stat.h>
 
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 // Suppress warnings for VHACD
@@ -45,16 +54,166 @@
 #include "gz/common/AssimpLoader.hh"
 #include "gz/common/ColladaLoader.hh"
 #include "gz/common/ColladaExporter.hh"
+#include "gz/common/OBJExporter.hh"
 #include "gz/common/OBJLoader.hh"
+#include "gz/common/STLExporter.hh"
 #include "gz/common/STLLoader.hh"
 #include "gz/common/Timer.hh"
 #include "gz/common/Util.hh"
 #include "gz/common/config.hh"
 
 #include "gz/common/MeshManager.hh"
+#include "gz/common/MeshSimplification.hh"
+#include "gz/common/QuantizedMesh.hh"
 #include "gz/common/DelaunayTriangulation.hh"
 
+#include "MeshCache.hh"
+#include "Parallel.hh"
+
 using namespace gz::common;
+namespace fs = std::filesystem;
+
+namespace
+{
+  /// \brief Hash the contents of a file
+  /// \param[in] _path Path of the file
+  /// \param[in] _prefix Data hashed before the contents, so that equal
+  /// files loaded with different settings have different hashes
+  /// \param[out] _hash Hash of the prefix and the contents
+  /// \return False if the file can not be read
+  bool HashFile(const std::string &_path, const std::string &_prefix,
+      uint64_t &_hash)
+  {
+    std::ifstream file(_path, std::ios::binary | std::ios::ate);
+    if (!file)
+      return false;
+    const auto size = static_cast<std::size_t>(file.tellg());
+    std::string contents(_prefix.size() + size, '\0');
+    contents.replace(0, _prefix.size(), _prefix);
+    file.seekg(0);
+    if (!file.read(contents.data() + _prefix.size(), size))
+      return false;
+    _hash = hash64(contents);
+    return true;
+  }
+
+  /// \brief Get the variant of the cache files of meshes loaded by a
+  /// loader. The native loaders and assimp give different meshes for the
+  /// same file, and so do the assimp post-processing passes.
+  /// \param[in] _loader The loader
+  /// \param[in] _profile Assimp post-processing passes
+  /// \return The variant
+  std::string CacheVariant(const MeshLoader *_loader,
+      AssimpPostProcess _profile)
+  {
+    if (dynamic_cast<const AssimpLoader *>(_loader) == nullptr)
+      return "native";
+    if (_profile == AssimpPostProcess::FAST)
+      return "assimp#fast";
+    if (_profile == AssimpPostProcess::OPTIMIZE)
+      return "assimp#optimize";
+    return "assimp";
+  }
+
+  /// \brief Calls a function when it goes out of scope
+  class ScopeExit
+  {
+    /// \brief Constructor
+    /// \param[in] _func Function to call
+    public: explicit ScopeExit(std::function<void()> _func)
+            : func(std::move(_func))
+    {
+    }
+
+    /// \brief Destructor, calls the function
+    public: ~ScopeExit()
+    {
+      this->func();
+    }
+
+    /// \brief Function to call
+    private: std::function<void()> func;
+  };
+
+  /// \brief Get the data hashed before the contents of a file to find
+  /// the mesh it can share. Meshes are only shared between files loaded
+  /// with the same settings. Files in formats that can reference materials
+  /// and textures by relative paths, all but STL, are only shared within
+  /// one directory, since their paths resolve to other files elsewhere.
+  /// \param[in] _path Path of the file
+  /// \param[in] _extension Lower case extension of the file
+  /// \param[in] _settings Suffix of the mesh key for the load settings
+  /// \return Data to hash before the contents
+  std::string ContentPrefix(const std::string &_path,
+      const std::string &_extension, const std::string &_settings)
+  {
+    std::string prefix = _settings;
+    if (_extension != "stl" && _extension != "stlb" && _extension != "stla")
+    {
+      // Symbolic links to the directory share meshes
+      std::error_code ec;
+      fs::path dir = fs::path(_path).parent_path();
+      const fs::path canonical = fs::weakly_canonical(dir, ec);
+      prefix += (ec ? dir : canonical).string();
+    }
+    prefix.push_back('\0');
+    return prefix;
+  }
+
+  /// \brief Get the key a mesh loaded from a file with the given settings
+  /// is stored under. Meshes are named after the file whatever the
+  /// settings, but the ones loaded with settings other than the defaults
+  /// are stored under the file name followed by a null character and the
+  /// settings that differ, so that loads with different settings do not
+  /// share a mesh. Paths cannot contain null characters, so these keys
+  /// never collide with the name of a mesh.
+  /// \param[in] _filename Name of the file
+  /// \param[in] _decodeTextures True if textures are decoded
+  /// \param[in] _profile Assimp post-processing passes
+  /// \return Key of the mesh
+  std::string LoadKey(const std::string &_filename, bool _decodeTextures,
+      AssimpPostProcess _profile)
+  {
+    std::string key = _filename;
+    if (_decodeTextures && _profile == AssimpPostProcess::DEFAULT)
+      return key;
+
+    key.push_back('\0');
+    if (!_decodeTextures)
+      key += "no_textures";
+    if (_profile == AssimpPostProcess::FAST)
+      key += "#fast";
+    else if (_profile == AssimpPostProcess::OPTIMIZE)
+      key += "#optimize";
+    return key;
+  }
+
+  /// \brief Get the keys a mesh loaded from a file can be stored under,
+  /// one for each combination of settings, the default settings first.
+  /// \param[in] _filename Name of the file
+  /// \return Keys of the mesh
+  std::vector<std::string> LoadKeys(const std::string &_filename)
+  {
+    std::vector<std::string> keys;
+    for (bool decodeTextures : {true, false})
+    {
+      for (AssimpPostProcess profile : {AssimpPostProcess::DEFAULT,
+           AssimpPostProcess::FAST, AssimpPostProcess::OPTIMIZE})
+      {
+        keys.push_back(LoadKey(_filename, decodeTextures, profile));
+      }
+    }
+    return keys;
+  }
+
+  /// \brief Get the name of a mesh from the key it is stored under
+  /// \param[in] _key Key of the mesh
+  /// \return Name of the mesh
+  std::string KeyName(const std::string &_key)
+  {
+    return _key.substr(0, _key.find('\0'));
+  }
+}
 
 class gz::common::MeshManager::Implementation
 {
@@ -63,32 +222,482 @@ class gz::common::MeshManager::Implementation
 #pragma warning(push)
 #pragma warning(disable: 4251)
 #endif
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader colladaLoader;
+  /// \brief Create a loader for a mesh file. Loaders keep state while
+  /// parsing, so every load uses its own loader.
+  /// \param[in] _extension Lower case extension of the file
+  /// \param[in] _decodeTextures True if textures are decoded into images
+  /// \param[in] _profile Assimp post-processing passes
+  /// \return The loader, nullptr if the format is not supported
+  public: std::unique_ptr<MeshLoader> CreateLoader(
+              const std::string &_extension, bool _decodeTextures,
+              AssimpPostProcess _profile) const
+  {
+    auto assimpLoader = [_decodeTextures, _profile]()
+    {
+      auto loader = std::make_unique<AssimpLoader>();
+      loader->SetTextureDecoding(_decodeTextures);
+      loader->SetPostProcessProfile(_profile);
+      return loader;
+    };
+
+    // Assimp is used for all the formats if GZ_MESH_FORCE_ASSIMP is set
+    if (this->forceAssimp)
+      return assimpLoader();
+    if (_extension == "stl" || _extension == "stlb" || _extension == "stla")
+      return std::make_unique<STLLoader>();
+    if (_extension == "dae")
+      return std::make_unique<ColladaLoader>();
+    if (_extension == "obj")
+      return std::make_unique<OBJLoader>();
+    if (_extension == "gltf" || _extension == "glb" || _extension == "fbx")
+      return assimpLoader();
+    return nullptr;
+  }
+
+  /// \brief Counts an asynchronous load until Finish is called once the
+  /// load ran, or until it is destroyed if the pool dropped the load. The
+  /// pool may keep the functor of a load, and so this object, alive long
+  /// after it ran.
+  public: class AsyncLoad
+  {
+    /// \brief Constructor, counts the load
+    /// \param[in] _impl Implementation of the manager
+    public: explicit AsyncLoad(Implementation &_impl)
+            : impl(_impl)
+    {
+      std::lock_guard<std::mutex> lock(this->impl.asyncMutex);
+      ++this->impl.asyncLoads;
+    }
+
+    /// \brief Destructor, ends the count if Finish was not called
+    public: ~AsyncLoad()
+    {
+      this->Finish();
+    }
+
+    /// \brief End the count of the load. Only the first call has an
+    /// effect, later ones do not access the manager.
+    public: void Finish()
+    {
+      if (this->finished.exchange(true))
+        return;
+      std::lock_guard<std::mutex> lock(this->impl.asyncMutex);
+      if (--this->impl.asyncLoads == 0u)
+        this->impl.asyncDone.notify_all();
+    }
+
+    /// \brief Implementation of the manager
+    private: Implementation &impl;
+
+    /// \brief True once the count ended
+    private: std::atomic<bool> finished{false};
+  };
 
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter colladaExporter;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader stlLoader;
+  /// \brief 3D mesh exporter for binary STL files
+  public: STLExporter stlExporter;
+
+  /// \brief 3D mesh exporter for OBJ files
+  public: OBJExporter objExporter;
+
+  /// \brief Mark a mesh loaded from a file as the most recently used.
+  /// The mutex must be locked.
+  /// \param[in] _name Name of the mesh
+  public: void Touch(const std::string &_name)
+  {
+    auto iter = this->resident.find(_name);
+    if (iter != this->resident.end())
+      this->lru.splice(this->lru.begin(), this->lru, iter->second.position);
+  }
+
+  /// \brief Get the name of the mesh that a name refers to. The mutex
+  /// must be locked.
+  /// \param[in] _name Name of a mesh or alias
+  /// \return Name of the mesh
+  public: const std::string &Resolve(const std::string &_name) const
+  {
+    auto iter = this->aliases.find(_name);
+    return iter == this->aliases.end() ? _name : iter->second;
+  }
+
+  /// \brief Remove the content hash of a mesh and the aliases that refer
+  /// to it. The mutex must be locked.
+  /// \param[in] _name Name of the mesh
+  public: void Unlink(const std::string &_name)
+  {
+    auto hashIter = this->contentHashes.find(_name);
+    if (hashIter == this->contentHashes.end())
+      return;
+    this->contentNames.erase(hashIter->second);
+    this->contentHashes.erase(hashIter);
+    for (auto iter = this->aliases.begin(); iter != this->aliases.end();)
+    {
+      if (iter->second == _name)
+        iter = this->aliases.erase(iter);
+      else
+        ++iter;
+    }
+  }
+
+  /// \brief Find the mesh loaded from a file with the same contents as
+  /// the file being loaded, waiting for it if it is being loaded. If there
+  /// is none, the contents are registered under _name.
+  /// \param[in] _name Name of the mesh being loaded
+  /// \param[in] _hash Hash of the file contents
+  /// \return The mesh to share, or nullptr if _name has to be parsed
+  public: MeshPtr Share(const std::string &_name, uint64_t _hash)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      auto contentIter = this->contentNames.find(_hash);
+      if (contentIter == this->contentNames.end())
+      {
+        this->contentNames.emplace(_hash, _name);
+        this->contentHashes[_name] = _hash;
+        return nullptr;
+      }
+
+      const std::string canonical = contentIter->second;
+      auto meshIter = this->meshes.find(canonical);
+      MeshPtr mesh = meshIter != this->meshes.end() ?
+          meshIter->second : this->Restore(canonical);
+      if (mesh)
+      {
+        this->aliases[_name] = canonical;
+        ++this->stats.deduplicated;
+        this->Touch(canonical);
+        return mesh;
+      }
+
+      auto loadingIter = this->loading.find(canonical);
+      if (loadingIter == this->loading.end())
+      {
+        this->Unlink(canonical);
+        continue;
+      }
+
+      // The loading thread removes the contents if it fails, look again
+      // once it is done
+      std::shared_future<MeshPtr> result = loadingIter->second;
+      lock.unlock();
+      result.wait();
+      lock.lock();
+    }
+  }
+
+  /// \brief Check whether a primitive mesh needs to be generated. If a
+  /// mesh with the same name exists, nothing needs to be done.
+  /// \param[in] _name Name of the new mesh
+  /// \return True if the mesh exists or the name is empty, false if it has
+  /// to be generated
+  public: bool PrimitiveExists(const std::string &_name)
+  {
+    if (_name.empty())
+    {
+      gzerr << "Valid mesh name required." << std::endl;
+      return true;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->Exists(_name);
+  }
+
+  /// \brief Register a generated primitive mesh. The geometry is
+  /// generated outside of the lock, so primitives can be created
+  /// concurrently.
+  /// \param[in] _name Name of the mesh
+  /// \param[in] _mesh The mesh
+  public: void AddPrimitive(const std::string &_name, MeshPtr _mesh)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    // Another thread may have created a mesh with the same name
+    if (!this->Exists(_name))
+      this->meshes.emplace(_name, std::move(_mesh));
+  }
+
+  /// \brief Stop tracking a mesh loaded from a file, once it is removed:
+  /// its memory, content hash and aliases. The mutex must be locked.
+  /// \param[in] _name Name of the mesh
+  public: void Forget(const std::string &_name)
+  {
+    this->Unlink(_name);
+    this->Release(_name);
+  }
+
+  /// \brief Start tracking the memory of a mesh loaded from a file. The
+  /// mutex must be locked.
+  /// \param[in] _name Name of the mesh
+  /// \param[in] _mesh The mesh
+  public: void Reside(const std::string &_name, const Mesh &_mesh)
+  {
+    auto &residency = this->resident[_name];
+    this->lru.push_front(_name);
+    residency.position = this->lru.begin();
+    residency.bytes = _mesh.MemorySize();
+    this->stats.residentBytes += residency.bytes;
+    ++this->stats.residentCount;
+  }
+
+  /// \brief Stop tracking the memory of a mesh loaded from a file. The
+  /// mutex must be locked.
+  /// \param[in] _name Name of the mesh
+  /// \return True if the mesh was tracked
+  public: bool Release(const std::string &_name)
+  {
+    auto iter = this->resident.find(_name);
+    if (iter == this->resident.end())
+      return false;
+    this->stats.residentBytes -= iter->second.bytes;
+    --this->stats.residentCount;
+    this->lru.erase(iter->second.position);
+    this->resident.erase(iter);
+    return true;
+  }
+
+  /// \brief Check whether a mesh is stored under a key, full precision or
+  /// quantized. The mutex must be locked.
+  /// \param[in] _key Key of the mesh, not an alias
+  /// \return True if the mesh is stored
+  public: bool Stored(const std::string &_key) const
+  {
+    return this->meshes.find(_key) != this->meshes.end() ||
+        this->quantized.find(_key) != this->quantized.end();
+  }
+
+  /// \brief Get the key of the mesh that a name refers to. A file loaded
+  /// with several settings refers to the mesh loaded with the current
+  /// settings, or else to the first one found, starting with the default
+  /// settings. The mutex must be locked.
+  /// \param[in] _name Name of a mesh or alias
+  /// \return Key of the mesh, or the resolved name if there is none
+  public: std::string Lookup(const std::string &_name) const
+  {
+    std::string key = this->Resolve(
+        LoadKey(_name, this->decodeTextures, this->profile));
+    if (this->Stored(key))
+      return key;
+
+    for (const std::string &loadKey : LoadKeys(_name))
+    {
+      key = this->Resolve(loadKey);
+      if (this->Stored(key))
+        return key;
+    }
+    return this->Resolve(_name);
+  }
+
+  /// \brief Get the stored mesh that a mesh refers to. Meshes loaded from
+  /// the same file with different settings share their name, the one that
+  /// is _mesh is preferred. The mutex must be locked.
+  /// \param[in] _mesh The mesh
+  /// \return The stored mesh, or nullptr if there is no mesh with the name
+  public: MeshPtr Managed(const Mesh *_mesh) const
+  {
+    for (const std::string &key : LoadKeys(_mesh->Name()))
+    {
+      auto iter = this->meshes.find(this->Resolve(key));
+      if (iter != this->meshes.end() && iter->second.get() == _mesh)
+        return iter->second;
+    }
 
-  /// \brief 3D mesh loader for OBJ files
-  public: OBJLoader objLoader;
+    auto iter = this->meshes.find(this->Lookup(_mesh->Name()));
+    return iter == this->meshes.end() ? nullptr : iter->second;
+  }
+
+  /// \brief Check whether a name refers to a mesh, full precision or
+  /// quantized. The mutex must be locked.
+  /// \param[in] _name Name of a mesh or alias
+  /// \return True if the mesh exists
+  public: bool Exists(const std::string &_name) const
+  {
+    return this->Stored(this->Lookup(_name));
+  }
+
+  /// \brief Remove the mesh or alias stored under a key. The mutex must
+  /// be locked.
+  /// \param[in] _key Key of the mesh or alias
+  /// \return True if a mesh or alias was removed
+  public: bool Remove(const std::string &_key)
+  {
+    // Removing an alias leaves the mesh it refers to
+    if (this->aliases.erase(_key) > 0u)
+      return true;
 
-  /// \brief 3D mesh loader for Assimp assets (others)
-  public: AssimpLoader assimpLoader;
+    const bool wasQuantized = this->quantized.erase(_key) > 0u;
+    auto iter = this->meshes.find(_key);
+    if (iter != this->meshes.end())
+    {
+      this->meshes.erase(iter);
+      this->lods.erase(_key);
+      this->Forget(_key);
+      return true;
+    }
+
+    if (wasQuantized)
+    {
+      this->lods.erase(_key);
+      this->Unlink(_key);
+    }
+    return wasQuantized;
+  }
+
+  /// \brief Register a quantized mesh again as a full precision mesh. If
+  /// handles to the mesh it was quantized from are still held, that mesh
+  /// is registered, otherwise the quantized mesh is decoded. The mutex
+  /// must be locked.
+  /// \param[in] _name Name of the mesh, not an alias
+  /// \return The mesh, or nullptr if the mesh is not quantized
+  public: MeshPtr Restore(const std::string &_name)
+  {
+    auto iter = this->quantized.find(_name);
+    if (iter == this->quantized.end())
+      return nullptr;
+
+    MeshPtr mesh = iter->second.source.lock();
+    if (!mesh)
+      mesh = iter->second.mesh->Decode();
+    if (iter->second.resident)
+      this->Reside(_name, *mesh);
+    this->quantized.erase(iter);
+    this->meshes.emplace(_name, mesh);
+    return mesh;
+  }
+
+  /// \brief Remove the least recently used meshes loaded from files,
+  /// skipping the ones with handles held outside of the manager, until
+  /// their memory use is within the budget. The mutex must be locked.
+  public: void Evict()
+  {
+    if (this->memoryBudget == 0u)
+      return;
+
+    std::vector<std::string> evicted;
+    std::size_t bytes = this->stats.residentBytes;
+    for (auto iter = this->lru.rbegin();
+         iter != this->lru.rend() && bytes > this->memoryBudget; ++iter)
+    {
+      // Handles are only copied from the map with the mutex locked, so a
+      // mesh that only the map holds can not gain a handle here
+      auto meshIter = this->meshes.find(*iter);
+      if (meshIter != this->meshes.end() && meshIter->second.use_count() > 1)
+        continue;
+      bytes -= this->resident[*iter].bytes;
+      evicted.push_back(*iter);
+    }
+
+    for (const std::string &name : evicted)
+    {
+      this->meshes.erase(name);
+      this->lods.erase(name);
+      this->Forget(name);
+      ++this->stats.evictions;
+    }
+  }
+
+  /// \brief A quantized mesh and the mesh it was quantized from
+  public: struct Quantized
+  {
+    /// \brief The quantized mesh
+    std::unique_ptr<QuantizedMesh> mesh;
+
+    /// \brief The full precision mesh, alive while handles to it are held
+    /// outside of the manager
+    std::weak_ptr<Mesh> source;
+
+    /// \brief True if the mesh was loaded from a file and counts toward
+    /// the memory budget once decoded
+    bool resident = false;
+  };
+
+  /// \brief Position in the eviction order and memory use of a mesh
+  /// loaded from a file
+  public: struct Residency
+  {
+    /// \brief Position of the mesh name in lru
+    std::list<std::string>::iterator position;
+
+    /// \brief Memory used by the mesh, from Mesh::MemorySize
+    std::size_t bytes = 0u;
+  };
 
   /// \brief Dictionary of meshes, indexed by name
-  public: std::unordered_map<std::string, Mesh*> meshes;
+  public: std::unordered_map<std::string, MeshPtr> meshes;
+
+  /// \brief Meshes being loaded, indexed by name. Threads that load a mesh
+  /// which is in this map wait for its result instead of loading it again.
+  public: std::unordered_map<std::string,
+          std::shared_future<MeshPtr>> loading;
+
+  /// \brief Names of the meshes loaded from files, most recently used
+  /// first
+  public: std::list<std::string> lru;
+
+  /// \brief Residency of the meshes loaded from files, indexed by name
+  public: std::unordered_map<std::string, Residency> resident;
+
+  /// \brief Memory budget of the meshes loaded from files in bytes, 0 for
+  /// no limit
+  public: std::size_t memoryBudget = 0u;
+
+  /// \brief Load counters and resident memory
+  public: MeshManager::Statistics stats;
+
+  /// \brief True if files with identical contents share one mesh
+  public: bool deduplicate = false;
+
+  /// \brief True if loaders decode textures into images
+  public: bool decodeTextures = true;
+
+  /// \brief Post-processing passes of the assimp loaders
+  public: AssimpPostProcess profile = AssimpPostProcess::DEFAULT;
+
+  /// \brief Names of the meshes loaded from files while deduplication is
+  /// enabled, indexed by the hash of the file contents
+  public: std::unordered_map<uint64_t, std::string> contentNames;
+
+  /// \brief Hash of the file contents of the meshes in contentNames,
+  /// indexed by name
+  public: std::unordered_map<std::string, uint64_t> contentHashes;
+
+  /// \brief Names of files with the same contents as a loaded mesh,
+  /// mapped to the name of that mesh
+  public: std::unordered_map<std::string, std::string> aliases;
+
+  /// \brief Simplified levels of detail of meshes, indexed by the name of
+  /// the original mesh. The first entry is level 1.
+  public: std::unordered_map<std::string,
+          std::vector<std::unique_ptr<Mesh>>> lods;
+
+  /// \brief Quantized meshes, indexed by name. A mesh is either in this
+  /// map or in meshes. Aliases and content hashes of quantized meshes are
+  /// kept, loads of their files decode them.
+  public: std::unordered_map<std::string, Quantized> quantized;
 
   /// \brief supported file extensions for meshes
   public: std::unordered_set<std::string> fileExtensions;
 
   /// \brief Mutex to protect the mesh map
-  public: std::mutex mutex;
+  public: mutable std::mutex mutex;
 
   /// \brief True if assimp is used for loading all supported mesh formats
-  public: bool forceAssimp;
+  public: std::atomic<bool> forceAssimp{false};
+
+  /// \brief Binary cache of loaded meshes, null if disabled. Loads copy
+  /// the pointer under the mutex, so the cache can be changed while they
+  /// run.
+  public: std::shared_ptr<MeshCache> cache;
+
+  /// \brief Number of asynchronous loads that have not finished
+  public: std::size_t asyncLoads = 0u;
+
+  /// \brief Mutex to protect asyncLoads
+  public: std::mutex asyncMutex;
+
+  /// \brief Signaled when asyncLoads drops to 0
+  public: std::condition_variable asyncDone;
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -131,14 +740,25 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  for (auto iter = this->dataPtr->meshes.begin();
-      iter != this->dataPtr->meshes.end(); ++iter)
-    delete iter->second;
+  // Wait for the pending asynchronous loads first
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->asyncMutex);
+    this->dataPtr->asyncDone.wait(lock,
+        [this]() { return this->dataPtr->asyncLoads == 0u; });
+  }
+
   this->dataPtr->meshes.clear();
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::Load(const std::string &_filename)
+{
+  return this->LoadShared(_filename).get();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const Mesh> MeshManager::LoadShared(
+    const std::string &_filename)
 {
   if (!this->IsValidFilename(_filename))
   {
@@ -146,68 +766,277 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  // Return the mesh if it is loaded, wait for it if another thread is
+  // loading it, or reserve it so that other threads wait for this one.
+  // The mutex is only held while looking up the entries, distinct meshes
+  // load concurrently.
+  std::promise<MeshPtr> promise;
+  std::shared_ptr<MeshCache> cache;
+  bool deduplicate = false;
+  bool decodeTextures = true;
+  AssimpPostProcess profile = AssimpPostProcess::DEFAULT;
+  std::string key;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+    cache = this->dataPtr->cache;
+    deduplicate = this->dataPtr->deduplicate;
+    decodeTextures = this->dataPtr->decodeTextures;
+    profile = this->dataPtr->profile;
+    key = LoadKey(_filename, decodeTextures, profile);
+
+    auto iter = this->dataPtr->meshes.find(this->dataPtr->Resolve(key));
+    // A mesh with decoded textures also serves loads that skip them
+    if (iter == this->dataPtr->meshes.end() && !decodeTextures)
+    {
+      iter = this->dataPtr->meshes.find(
+          this->dataPtr->Resolve(LoadKey(_filename, true, profile)));
+    }
+    if (iter != this->dataPtr->meshes.end())
+    {
+      ++this->dataPtr->stats.hits;
+      this->dataPtr->Touch(iter->first);
+      return iter->second;
+    }
 
-  std::string extension;
+    // A quantized mesh is decoded instead of loading the file again
+    MeshPtr restored = this->dataPtr->Restore(this->dataPtr->Resolve(key));
+    if (restored)
+    {
+      ++this->dataPtr->stats.hits;
+      this->dataPtr->Evict();
+      return restored;
+    }
 
-  if (this->HasMesh(_filename))
-  {
-    return this->dataPtr->meshes[_filename];
+    auto loadingIter = this->dataPtr->loading.find(key);
+    if (loadingIter != this->dataPtr->loading.end())
+    {
+      ++this->dataPtr->stats.hits;
+      std::shared_future<MeshPtr> result = loadingIter->second;
+      lock.unlock();
+      return result.get();
+    }
+    ++this->dataPtr->stats.misses;
+    this->dataPtr->loading.emplace(key, promise.get_future().share());
   }
 
+  // If the load throws, the entry is removed and the threads waiting for
+  // it get no mesh, so that later loads try again
+  bool finished = false;
+  ScopeExit cleanup([this, &finished, &key, &promise]()
+      {
+        if (finished)
+          return;
+        {
+          std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+          this->dataPtr->Unlink(key);
+          this->dataPtr->loading.erase(key);
+        }
+        promise.set_value(nullptr);
+      });
+
+  MeshPtr mesh;
+  bool shared = false;
+  uint64_t hash = 0u;
   std::string fullname = common::findFile(_filename);
 
   if (!fullname.empty())
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
+    std::string extension =
+        fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
     this->SetAssimpEnvs();
-    if (this->dataPtr->forceAssimp)
+    std::unique_ptr<MeshLoader> loader =
+        this->dataPtr->CreateLoader(extension, decodeTextures, profile);
+    const std::string variant = CacheVariant(loader.get(), profile);
+    if (!loader)
     {
-      loader = &this->dataPtr->assimpLoader;
+      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
     }
-    else
+    else if (deduplicate &&
+        HashFile(fullname, ContentPrefix(fullname, extension,
+            key.substr(_filename.size())), hash) &&
+        (mesh = this->dataPtr->Share(key, hash)) != nullptr)
     {
-      if (extension == "stl" || extension == "stlb" || extension == "stla")
-          loader = &this->dataPtr->stlLoader;
-      else if (extension == "dae")
-        loader = &this->dataPtr->colladaLoader;
-      else if (extension == "obj")
-        loader = &this->dataPtr->objLoader;
-      else if (extension == "gltf" || extension == "glb" || extension == "fbx")
-        loader = &this->dataPtr->assimpLoader;
-      else
-      {
-        gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-        return nullptr;
-      }
+      shared = true;
     }
-    // This mutex prevents two threads from loading the same mesh at the
-    // same time.
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-    if (!this->HasMesh(_filename))
+    else if (cache && (mesh.reset(cache->Load(fullname, variant)), mesh))
     {
-      if ((mesh = loader->Load(fullname)) != nullptr)
-      {
-        mesh->SetName(_filename);
-        this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-      }
-      else
-        gzerr << "Unable to load mesh[" << fullname << "]\n";
+      mesh->SetName(_filename);
+    }
+    else if (mesh.reset(loader->Load(fullname)), mesh)
+    {
+      // Meshes without their images would be incomplete for later loads
+      if (cache && decodeTextures)
+        cache->Save(*mesh, fullname, variant);
+      mesh->SetName(_filename);
     }
     else
     {
-      mesh = this->dataPtr->meshes[_filename];
+      gzerr << "Unable to load mesh[" << fullname << "]\n";
     }
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!mesh)
+    {
+      this->dataPtr->Unlink(key);
+    }
+    else if (!shared && this->dataPtr->meshes.emplace(key, mesh).second)
+    {
+      this->dataPtr->Reside(key, *mesh);
+      this->dataPtr->Evict();
+    }
+    this->dataPtr->loading.erase(key);
+  }
+  promise.set_value(mesh);
+  finished = true;
+
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetMemoryBudget(std::size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->memoryBudget = _bytes;
+  this->dataPtr->Evict();
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshManager::MemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->memoryBudget;
+}
+
+//////////////////////////////////////////////////
+MeshManager::Statistics MeshManager::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetContentDeduplication(bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->deduplicate = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::ContentDeduplication() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->deduplicate;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetTextureDecoding(bool _enabled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->decodeTextures = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::TextureDecoding() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->decodeTextures;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetPostProcessProfile(AssimpPostProcess _profile)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->profile = _profile;
+}
+
+//////////////////////////////////////////////////
+AssimpPostProcess MeshManager::PostProcessProfile() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->profile;
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CanonicalName(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return KeyName(this->dataPtr->Lookup(_name));
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCacheDirectory(const std::string &_path,
+    std::uintmax_t _maxSize)
+{
+  std::shared_ptr<MeshCache> cache;
+  if (!_path.empty())
+    cache = std::make_shared<MeshCache>(_path, _maxSize);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cache = cache;
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CacheDirectory() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->cache ? this->dataPtr->cache->Directory() : "";
+}
+
+//////////////////////////////////////////////////
+std::future<const Mesh *> MeshManager::LoadAsync(
+    const std::string &_filename)
+{
+  auto task = std::make_shared<std::packaged_task<const Mesh *()>>(
+      [this, _filename]()
+      {
+        return this->Load(_filename);
+      });
+  std::future<const Mesh *> result = task->get_future();
+  // A pool thread waiting for work queued behind it could block the pool
+  if (parallel::OnPoolThread())
+  {
+    (*task)();
+    return result;
+  }
+  auto load = std::make_shared<Implementation::AsyncLoad>(*this->dataPtr);
+  parallel::Post([task, load]()
+      {
+        (*task)();
+        load->Finish();
+      });
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<const Mesh *> MeshManager::LoadBatch(
+    const std::vector<std::string> &_filenames)
+{
+  std::vector<const Mesh *> meshes(_filenames.size(), nullptr);
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(_filenames.size());
+  for (std::size_t i = 0u; i < _filenames.size(); ++i)
+  {
+    tasks.push_back([this, &_filenames, &meshes, i]()
+        {
+          meshes[i] = this->Load(_filenames[i]);
+        });
+  }
+  parallel::Run(tasks);
+  return meshes;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::CreateBatch(
+    const std::vector<std::function<void()>> &_creators)
+{
+  parallel::Run(_creators);
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -216,6 +1045,14 @@ void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
   {
     this->dataPtr->colladaExporter.Export(_mesh, _filename, _exportTextures);
   }
+  else if (_extension == "stl")
+  {
+    this->dataPtr->stlExporter.Export(_mesh, _filename, _exportTextures);
+  }
+  else if (_extension == "obj")
+  {
+    this->dataPtr->objExporter.Export(_mesh, _filename, _exportTextures);
+  }
   else
   {
     gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
@@ -242,23 +1079,28 @@ void MeshManager::MeshAABB(const Mesh *_mesh,
     gz::math::Vector3d &_center,
     gz::math::Vector3d &_minXYZ, gz::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->AABB(_center, _minXYZ, _maxXYZ);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  MeshPtr mesh = this->dataPtr->Managed(_mesh);
+  if (mesh)
+    mesh->AABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const gz::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->GenSphericalTexCoord(_center);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  MeshPtr mesh = this->dataPtr->Managed(_mesh);
+  if (mesh)
+    mesh->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()] = _mesh;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->Exists(_mesh->Name()))
+    this->dataPtr->meshes.emplace(_mesh->Name(), MeshPtr(_mesh));
 }
 
 //////////////////////////////////////////////////
@@ -270,7 +1112,8 @@ Mesh *MeshManager::CreateMesh(const std::string &_name)
     return nullptr;
   }
 
-  if (this->HasMesh(_name))
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->Exists(_name))
   {
     gzerr << "Mesh [" << _name << "] already exists." << std::endl;
     return nullptr;
@@ -278,18 +1121,30 @@ Mesh *MeshManager::CreateMesh(const std::string &_name)
 
   Mesh *newMesh = new Mesh();
   newMesh->SetName(_name);
-  this->dataPtr->meshes[_name] = newMesh;
+  this->dataPtr->meshes.emplace(_name, MeshPtr(newMesh));
   return newMesh;
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::MeshByName(const std::string &_name) const
 {
-  auto iter = this->dataPtr->meshes.find(_name);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(this->dataPtr->Lookup(_name));
 
   if (iter != this->dataPtr->meshes.end())
-    return iter->second;
+    return iter->second.get();
+
+  return nullptr;
+}
 
+//////////////////////////////////////////////////
+std::shared_ptr<const Mesh> MeshManager::SharedMeshByName(
+    const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(this->dataPtr->Lookup(_name));
+  if (iter != this->dataPtr->meshes.end())
+    return iter->second;
   return nullptr;
 }
 
@@ -297,11 +1152,16 @@ const Mesh *MeshManager::MeshByName(const std::string &_name) const
 void MeshManager::RemoveAll()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (auto m : this->dataPtr->meshes)
-  {
-    delete m.second;
-  }
   this->dataPtr->meshes.clear();
+  this->dataPtr->lods.clear();
+  this->dataPtr->quantized.clear();
+  this->dataPtr->lru.clear();
+  this->dataPtr->resident.clear();
+  this->dataPtr->stats.residentCount = 0u;
+  this->dataPtr->stats.residentBytes = 0u;
+  this->dataPtr->contentNames.clear();
+  this->dataPtr->contentHashes.clear();
+  this->dataPtr->aliases.clear();
 }
 
 //////////////////////////////////////////////////
@@ -309,15 +1169,150 @@ bool MeshManager::RemoveMesh(const std::string &_name)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  auto iter = this->dataPtr->meshes.find(_name);
-  if (iter != this->dataPtr->meshes.end())
+  // The meshes loaded from a file with any settings are removed
+  bool removed = false;
+  for (const std::string &key : LoadKeys(_name))
+    removed = this->dataPtr->Remove(key) || removed;
+  return removed;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::GenerateLods(const std::string &_name,
+    const std::vector<double> &_ratios, double _maxError)
+{
+  // The mesh is simplified without holding the mutex, the handle keeps it
+  // alive if it is removed in the meantime
+  MeshPtr mesh;
+  std::string key;
   {
-    delete iter->second;
-    this->dataPtr->meshes.erase(iter);
-    return true;
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    key = this->dataPtr->Lookup(_name);
+    auto iter = this->dataPtr->meshes.find(key);
+    if (iter == this->dataPtr->meshes.end())
+    {
+      gzerr << "Unable to generate LODs, mesh [" << _name << "] not found"
+            << std::endl;
+      return 0u;
+    }
+    mesh = iter->second;
   }
 
-  return false;
+  std::vector<std::unique_ptr<Mesh>> lods;
+  unsigned int indexCount = mesh->IndexCount();
+  for (double ratio : _ratios)
+  {
+    // Every level is simplified from the original mesh so that errors do
+    // not accumulate along the chain
+    auto lod = SimplifyMesh(*mesh, ratio, _maxError);
+    if (lod->IndexCount() >= indexCount)
+      break;
+    indexCount = lod->IndexCount();
+    lod->SetName(_name + "_lod" + std::to_string(lods.size() + 1));
+    lods.push_back(std::move(lod));
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(key);
+  if (iter == this->dataPtr->meshes.end() || iter->second != mesh)
+  {
+    gzwarn << "Mesh [" << _name << "] was removed while generating its "
+           << "LODs, the LODs are discarded" << std::endl;
+    return 0u;
+  }
+
+  const unsigned int count = static_cast<unsigned int>(lods.size());
+  this->dataPtr->lods[key] = std::move(lods);
+  return count;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::LodCount(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const std::string key = this->dataPtr->Lookup(_name);
+  if (!this->dataPtr->Stored(key))
+    return 0u;
+
+  auto iter = this->dataPtr->lods.find(key);
+  if (iter == this->dataPtr->lods.end())
+    return 1u;
+  return static_cast<unsigned int>(iter->second.size()) + 1u;
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManager::MeshLod(const std::string &_name,
+    unsigned int _level) const
+{
+  if (_level == 0u)
+    return this->MeshByName(_name);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->lods.find(this->dataPtr->Lookup(_name));
+  if (iter == this->dataPtr->lods.end() || _level > iter->second.size())
+    return nullptr;
+  return iter->second[_level - 1].get();
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::QuantizeMesh(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  const std::string name = this->dataPtr->Lookup(_name);
+  auto iter = this->dataPtr->meshes.find(name);
+  if (iter == this->dataPtr->meshes.end())
+  {
+    gzerr << "Unable to quantize mesh [" << _name << "], mesh not found"
+          << std::endl;
+    return false;
+  }
+
+  Implementation::Quantized &entry = this->dataPtr->quantized[name];
+  entry.mesh = std::make_unique<QuantizedMesh>(*iter->second);
+  entry.source = iter->second;
+  entry.resident = this->dataPtr->Release(name);
+  this->dataPtr->meshes.erase(iter);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const QuantizedMesh *MeshManager::QuantizedMeshByName(
+    const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->quantized.find(this->dataPtr->Lookup(_name));
+  if (iter == this->dataPtr->quantized.end())
+    return nullptr;
+  return iter->second.mesh.get();
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManager::DecodeMesh(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  MeshPtr mesh = this->dataPtr->Restore(this->dataPtr->Lookup(_name));
+  if (!mesh)
+  {
+    gzerr << "Unable to decode mesh [" << _name << "], mesh is not "
+          << "quantized" << std::endl;
+    return nullptr;
+  }
+  this->dataPtr->Evict();
+  return mesh.get();
+}
+
+//////////////////////////////////////////////////
+std::size_t MeshManager::MeshMemorySaved(const std::string &_name) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->quantized.find(this->dataPtr->Lookup(_name));
+  if (iter == this->dataPtr->quantized.end())
+    return 0u;
+  const QuantizedMesh &mesh = *iter->second.mesh;
+  if (mesh.SourceMemorySize() < mesh.MemorySize())
+    return 0u;
+  return mesh.SourceMemorySize() - mesh.MemorySize();
 }
 
 //////////////////////////////////////////////////
@@ -326,19 +1321,16 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
-  auto iter = this->dataPtr->meshes.find(_name);
-
-  return iter != this->dataPtr->meshes.end();
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Exists(_name);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::CreateSphere(const std::string &name, float radius,
     int rings, int segments)
 {
-  if (this->HasMesh(name))
-  {
+  if (this->dataPtr->PrimitiveExists(name))
     return;
-  }
 
   int ring, seg;
   float deltaSegAngle = (2.0 * GZ_PI / segments);
@@ -348,7 +1340,6 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -389,6 +1380,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -409,14 +1401,11 @@ void MeshManager::CreatePlane(const std::string &_name,
     const gz::math::Vector2d &_segments,
     const gz::math::Vector2d &_uvTile)
 {
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -486,6 +1475,7 @@ void MeshManager::CreatePlane(const std::string &_name,
       static_cast<int>(_segments.X() + 1),
       static_cast<int>(_segments.Y() + 1), false);
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -495,14 +1485,11 @@ void MeshManager::CreateBox(const std::string &_name,
 {
   int i, k;
 
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -588,6 +1575,7 @@ void MeshManager::CreateBox(const std::string &_name,
   for (i = 0; i < 36; ++i)
     subMesh.AddIndex(ind[i]);
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -617,10 +1605,8 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
@@ -798,7 +1784,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   }
 
   mesh->AddSubMesh(subMesh);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 #endif
   return;
 }
@@ -808,14 +1794,11 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 {
   int i, k;
 
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -898,6 +1881,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -906,14 +1890,11 @@ void MeshManager::CreateEllipsoid(const std::string &_name,
                                   const unsigned int _rings,
                                   const unsigned int _segments)
 {
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -977,6 +1958,7 @@ void MeshManager::CreateEllipsoid(const std::string &_name,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -986,14 +1968,11 @@ void MeshManager::CreateCapsule(const std::string &_name,
                                 const unsigned int _rings,
                                 const unsigned int _segments)
 {
-  if (this->HasMesh(_name))
-  {
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -1136,6 +2115,7 @@ void MeshManager::CreateCapsule(const std::string &_name,
   }
 
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1147,14 +2127,11 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
   int ring, seg;
   float deltaSegAngle = (2.0 * GZ_PI / segments);
 
-  if (this->HasMesh(name))
-  {
+  if (this->dataPtr->PrimitiveExists(name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -1253,6 +2230,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->AddPrimitive(name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1264,14 +2242,11 @@ void MeshManager::CreateCone(const std::string &name, float radius,
   unsigned int i, j;
   int ring, seg;
 
-  if (this->HasMesh(name))
-  {
+  if (this->dataPtr->PrimitiveExists(name))
     return;
-  }
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -1363,6 +2338,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->AddPrimitive(name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1383,12 +2359,11 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   radius = _outerRadius;
 
-  if (this->HasMesh(_name))
+  if (this->dataPtr->PrimitiveExists(_name))
     return;
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
   SubMesh subMesh;
 
   // Generate the group of rings for the outsides of the cylinder
@@ -1530,6 +2505,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->AddPrimitive(_name, MeshPtr(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1661,12 +2637,10 @@ void MeshManager::SetAssimpEnvs()
 {
   std::string forceAssimpEnv;
   common::env("GZ_MESH_FORCE_ASSIMP", forceAssimpEnv);
-  this->dataPtr->forceAssimp = false;
-  if (forceAssimpEnv == "true")
-  {
+  const bool forceAssimp = forceAssimpEnv == "true";
+  if (forceAssimp)
     gzmsg << "Using assimp to load all mesh formats"  << std::endl;
-    this->dataPtr->forceAssimp = true;
-  }
+  this->dataPtr->forceAssimp = forceAssimp;
 }
 
 //////////////////////////////////////////////////
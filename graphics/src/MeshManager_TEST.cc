@@ -17,12 +17,29 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/Filesystem.hh"
 #include "gz/common/Material.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/Skeleton.hh"
 #include "gz/common/SkeletonAnimation.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/MeshManager.hh"
+#include "gz/common/QuantizedMesh.hh"
+#include "gz/common/TempDirectory.hh"
+
+#include "Parallel.hh"
 
 #include "gz/common/testing/AutoLogFixture.hh"
 #include "gz/common/testing/TestPaths.hh"
@@ -504,6 +521,216 @@ TEST_F(MeshManager, CreateMesh)
   EXPECT_EQ(meshName, verifyMesh->Name());
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreatePrimitives)
+{
+  auto *mgr = common::MeshManager::Instance();
+
+  // Primitives with the same parameters have their own geometry
+  mgr->CreateSphere("primitive_sphere_a", 0.5f, 16, 16);
+  mgr->CreateSphere("primitive_sphere_b", 0.5f, 16, 16);
+  mgr->CreateSphere("primitive_sphere_c", 0.25f, 16, 16);
+  const common::Mesh *a = mgr->MeshByName("primitive_sphere_a");
+  const common::Mesh *b = mgr->MeshByName("primitive_sphere_b");
+  const common::Mesh *c = mgr->MeshByName("primitive_sphere_c");
+  ASSERT_NE(nullptr, a);
+  ASSERT_NE(nullptr, b);
+  ASSERT_NE(nullptr, c);
+  EXPECT_NE(a, b);
+  EXPECT_EQ("primitive_sphere_b", b->Name());
+  ASSERT_EQ(a->SubMeshCount(), b->SubMeshCount());
+  ASSERT_EQ(a->VertexCount(), b->VertexCount());
+  auto subA = a->SubMeshByIndex(0).lock();
+  auto subB = b->SubMeshByIndex(0).lock();
+  EXPECT_NE(subA, subB);
+  for (unsigned int i = 0; i < subA->VertexCount(); ++i)
+    EXPECT_EQ(subA->Vertex(i), subB->Vertex(i));
+  EXPECT_EQ(subA->IndexCount(), subB->IndexCount());
+  EXPECT_EQ(subA->TexCoordCount(), subB->TexCoordCount());
+  EXPECT_EQ(a->VertexCount(), c->VertexCount());
+  EXPECT_NEAR(2.0 * c->Max().Y(), a->Max().Y(), 1e-6);
+
+  // Creating an existing name keeps the mesh
+  mgr->CreateSphere("primitive_sphere_a", 1.0f, 8, 8);
+  EXPECT_EQ(a, mgr->MeshByName("primitive_sphere_a"));
+
+  // Batched creation
+  std::vector<std::function<void()>> creators;
+  for (int i = 0; i < 50; ++i)
+  {
+    const std::string name = "primitive_batch_" + std::to_string(i);
+    if (i % 2)
+    {
+      creators.push_back([mgr, name]()
+          { mgr->CreateBox(name, math::Vector3d(1, 2, 3),
+                           math::Vector2d(1, 1)); });
+    }
+    else
+    {
+      creators.push_back([mgr, name, i]()
+          { mgr->CreateCylinder(name, 0.1f * (i % 4 + 1), 1.0f, 1, 16); });
+    }
+  }
+  mgr->CreateBatch(creators);
+  for (int i = 0; i < 50; ++i)
+  {
+    const common::Mesh *mesh =
+        mgr->MeshByName("primitive_batch_" + std::to_string(i));
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_LT(0u, mesh->VertexCount());
+  }
+  EXPECT_EQ(math::Vector3d(0.5, 1, 1.5),
+      mgr->MeshByName("primitive_batch_1")->Max());
+
+  // Batches run inline when nested, instead of waiting on the pool
+  std::vector<std::function<void()>> outer;
+  for (int i = 0; i < 4; ++i)
+  {
+    outer.push_back([mgr, i]()
+        {
+          const std::string name = "primitive_nested_" + std::to_string(i);
+          mgr->CreateBatch({
+              [mgr, name]() { mgr->CreateSphere(name + "_a", 1.0f, 8, 8); },
+              [mgr, name]() { mgr->CreateSphere(name + "_b", 2.0f, 8, 8); }});
+        });
+  }
+  mgr->CreateBatch(outer);
+  for (int i = 0; i < 4; ++i)
+  {
+    const std::string name = "primitive_nested_" + std::to_string(i);
+    EXPECT_TRUE(mgr->HasMesh(name + "_a"));
+    EXPECT_TRUE(mgr->HasMesh(name + "_b"));
+  }
+
+  // An empty name is an error
+  mgr->CreateSphere("", 0.5f, 16, 16);
+  EXPECT_FALSE(mgr->HasMesh(""));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, GenerateLods)
+{
+  auto *mgr = common::MeshManager::Instance();
+  EXPECT_EQ(0u, mgr->LodCount("lod_sphere"));
+  EXPECT_EQ(0u, mgr->GenerateLods("lod_sphere"));
+
+  mgr->CreateSphere("lod_sphere", 1.0, 32, 32);
+  const common::Mesh *sphere = mgr->MeshByName("lod_sphere");
+  ASSERT_NE(nullptr, sphere);
+  EXPECT_EQ(1u, mgr->LodCount("lod_sphere"));
+  EXPECT_EQ(sphere, mgr->MeshLod("lod_sphere", 0));
+  EXPECT_EQ(nullptr, mgr->MeshLod("lod_sphere", 1));
+
+  EXPECT_EQ(3u, mgr->GenerateLods("lod_sphere"));
+  EXPECT_EQ(4u, mgr->LodCount("lod_sphere"));
+  EXPECT_EQ(nullptr, mgr->MeshLod("lod_sphere", 4));
+
+  unsigned int indexCount = sphere->IndexCount();
+  for (unsigned int i = 1; i < mgr->LodCount("lod_sphere"); ++i)
+  {
+    const common::Mesh *lod = mgr->MeshLod("lod_sphere", i);
+    ASSERT_NE(nullptr, lod);
+    EXPECT_EQ("lod_sphere_lod" + std::to_string(i), lod->Name());
+    EXPECT_LT(lod->IndexCount(), indexCount);
+    EXPECT_TRUE(sphere->Max().Equal(lod->Max(), 0.1));
+    EXPECT_TRUE(sphere->Min().Equal(lod->Min(), 0.1));
+    indexCount = lod->IndexCount();
+  }
+  // The LOD meshes are not registered by name
+  EXPECT_FALSE(mgr->HasMesh("lod_sphere_lod1"));
+
+  // Regenerating replaces the chain
+  EXPECT_EQ(1u, mgr->GenerateLods("lod_sphere", {0.5}));
+  EXPECT_EQ(2u, mgr->LodCount("lod_sphere"));
+
+  // A box cannot be simplified without changing its shape
+  mgr->CreateBox("lod_box", math::Vector3d(1, 1, 1), math::Vector2d(1, 1));
+  EXPECT_EQ(0u, mgr->GenerateLods("lod_box", {0.5}, 1e-6));
+  EXPECT_EQ(1u, mgr->LodCount("lod_box"));
+  EXPECT_TRUE(mgr->RemoveMesh("lod_box"));
+
+  EXPECT_TRUE(mgr->RemoveMesh("lod_sphere"));
+  EXPECT_EQ(0u, mgr->LodCount("lod_sphere"));
+  EXPECT_EQ(nullptr, mgr->MeshLod("lod_sphere", 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, QuantizeMesh)
+{
+  auto mgr = common::MeshManager::Instance();
+  EXPECT_FALSE(mgr->QuantizeMesh("quantize_missing"));
+  EXPECT_EQ(nullptr, mgr->DecodeMesh("quantize_missing"));
+  EXPECT_EQ(0u, mgr->MeshMemorySaved("quantize_missing"));
+
+  mgr->CreateSphere("quantize_sphere", 1.0, 16, 16);
+  const common::Mesh *sphere = mgr->MeshByName("quantize_sphere");
+  ASSERT_NE(nullptr, sphere);
+  const unsigned int indexCount = sphere->IndexCount();
+  EXPECT_EQ(nullptr, mgr->QuantizedMeshByName("quantize_sphere"));
+  EXPECT_EQ(0u, mgr->MeshMemorySaved("quantize_sphere"));
+
+  EXPECT_TRUE(mgr->QuantizeMesh("quantize_sphere"));
+  EXPECT_TRUE(mgr->HasMesh("quantize_sphere"));
+  EXPECT_EQ(nullptr, mgr->MeshByName("quantize_sphere"));
+  const common::QuantizedMesh *quantized =
+      mgr->QuantizedMeshByName("quantize_sphere");
+  ASSERT_NE(nullptr, quantized);
+  EXPECT_EQ(1u, quantized->SubMeshCount());
+  EXPECT_EQ(quantized->SourceMemorySize() - quantized->MemorySize(),
+      mgr->MeshMemorySaved("quantize_sphere"));
+  EXPECT_GT(mgr->MeshMemorySaved("quantize_sphere"), 0u);
+
+  sphere = mgr->DecodeMesh("quantize_sphere");
+  ASSERT_NE(nullptr, sphere);
+  EXPECT_EQ(sphere, mgr->MeshByName("quantize_sphere"));
+  EXPECT_EQ(indexCount, sphere->IndexCount());
+  EXPECT_EQ(nullptr, mgr->QuantizedMeshByName("quantize_sphere"));
+  EXPECT_EQ(0u, mgr->MeshMemorySaved("quantize_sphere"));
+
+  // The name of a quantized mesh stays in use
+  EXPECT_TRUE(mgr->QuantizeMesh("quantize_sphere"));
+  EXPECT_EQ(nullptr, mgr->CreateMesh("quantize_sphere"));
+  mgr->CreateSphere("quantize_sphere", 2.0, 16, 16);
+  EXPECT_EQ(nullptr, mgr->MeshByName("quantize_sphere"));
+
+  // Quantized meshes can be removed
+  EXPECT_TRUE(mgr->RemoveMesh("quantize_sphere"));
+  EXPECT_EQ(nullptr, mgr->QuantizedMeshByName("quantize_sphere"));
+  EXPECT_FALSE(mgr->RemoveMesh("quantize_sphere"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, QuantizeLoadedMesh)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+
+  // Handles keep the quantized mesh alive, and decoding registers it again
+  std::shared_ptr<const common::Mesh> handle = mgr->LoadShared(cube);
+  ASSERT_NE(nullptr, handle);
+  EXPECT_EQ(1u, mgr->Stats().residentCount);
+  EXPECT_TRUE(mgr->QuantizeMesh(cube));
+  EXPECT_EQ(0u, mgr->Stats().residentCount);
+  EXPECT_EQ(nullptr, mgr->MeshByName(cube));
+  EXPECT_EQ(handle.get(), mgr->DecodeMesh(cube));
+  EXPECT_EQ(1u, mgr->Stats().residentCount);
+  handle.reset();
+
+  // Loading the file of a quantized mesh decodes it instead of parsing
+  // the file again
+  const common::Mesh *mesh = mgr->MeshByName(cube);
+  ASSERT_NE(nullptr, mesh);
+  const unsigned int vertexCount = mesh->VertexCount();
+  EXPECT_TRUE(mgr->QuantizeMesh(cube));
+  const uint64_t misses = mgr->Stats().misses;
+  mesh = mgr->Load(cube);
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(misses, mgr->Stats().misses);
+  EXPECT_EQ(vertexCount, mesh->VertexCount());
+  EXPECT_EQ(nullptr, mgr->QuantizedMeshByName(cube));
+  EXPECT_EQ(nullptr, mgr->DecodeMesh(cube));
+}
+
 /////////////////////////////////////////////////
 TEST_P(MeshManagerLoad, LoadBox)
 {
@@ -526,6 +753,371 @@ TEST_P(MeshManagerLoad, LoadBox)
   EXPECT_STREQ("Cube", mesh->SubMeshByIndex(0).lock()->Name().c_str());
 }
 
+/////////////////////////////////////////////////
+TEST_P(MeshManagerLoad, LoadBatch)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string box = common::testing::TestFile("data", "box.dae");
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  const std::string obj = common::testing::TestFile("data", "box.obj");
+  const std::string missing = common::testing::TestFile("data",
+      "missing.dae");
+
+  // Duplicates are loaded once and share the mesh
+  std::vector<const common::Mesh *> meshes =
+      mgr->LoadBatch({box, cube, obj, box, cube, missing});
+  ASSERT_EQ(6u, meshes.size());
+  ASSERT_NE(nullptr, meshes[0]);
+  ASSERT_NE(nullptr, meshes[1]);
+  ASSERT_NE(nullptr, meshes[2]);
+  EXPECT_EQ(meshes[0], meshes[3]);
+  EXPECT_EQ(meshes[1], meshes[4]);
+  EXPECT_EQ(nullptr, meshes[5]);
+  EXPECT_EQ(box, meshes[0]->Name());
+  EXPECT_EQ(24u, meshes[0]->VertexCount());
+  EXPECT_EQ(meshes[0], mgr->MeshByName(box));
+  EXPECT_EQ(meshes[1], mgr->MeshByName(cube));
+  EXPECT_FALSE(mgr->HasMesh(missing));
+
+  // Loaded meshes are returned right away
+  std::future<const common::Mesh *> future = mgr->LoadAsync(obj);
+  EXPECT_EQ(meshes[2], future.get());
+  EXPECT_TRUE(mgr->LoadBatch({}).empty());
+
+  // Concurrent loads of the same file give the same mesh
+  EXPECT_TRUE(mgr->RemoveMesh(box));
+  std::vector<std::future<const common::Mesh *>> futures;
+  for (int i = 0; i < 8; ++i)
+    futures.push_back(mgr->LoadAsync(box));
+  const common::Mesh *mesh = futures[0].get();
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(24u, mesh->VertexCount());
+  for (std::size_t i = 1; i < futures.size(); ++i)
+    EXPECT_EQ(mesh, futures[i].get());
+  EXPECT_EQ(mesh, mgr->Load(box));
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshManagerLoad, AccessDuringLoadBatch)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string box = common::testing::TestFile("data", "box.dae");
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  const std::string obj = common::testing::TestFile("data", "box.obj");
+
+  // The accessors run while the batch adds meshes to the map. Run under
+  // ThreadSanitizer to catch unsynchronized access.
+  std::atomic<bool> done{false};
+  std::thread reader([&]()
+  {
+    unsigned int i = 0u;
+    while (!done)
+    {
+      const common::Mesh *mesh = mgr->MeshByName(box);
+      if (mesh)
+      {
+        EXPECT_EQ(box, mesh->Name());
+      }
+      mgr->HasMesh(cube);
+      const std::string name = "access_mesh_" + std::to_string(i++ % 16u);
+      if (!mgr->HasMesh(name))
+        mgr->CreateMesh(name);
+    }
+  });
+
+  std::vector<const common::Mesh *> meshes;
+  for (int i = 0; i < 4; ++i)
+  {
+    mgr->RemoveMesh(box);
+    mgr->RemoveMesh(cube);
+    mgr->RemoveMesh(obj);
+    meshes = mgr->LoadBatch({box, cube, obj});
+  }
+  done = true;
+  reader.join();
+
+  ASSERT_EQ(3u, meshes.size());
+  EXPECT_EQ(meshes[0], mgr->MeshByName(box));
+  EXPECT_EQ(meshes[1], mgr->MeshByName(cube));
+  EXPECT_EQ(meshes[2], mgr->MeshByName(obj));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, DestroyAfterLoadAsync)
+{
+  // The pool outlives a manager created after it, and keeps the last task
+  // each of its threads ran. The manager must not wait for those tasks
+  // when it is destroyed at exit. The child process runs the test from
+  // the start, so the pool is created first.
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  EXPECT_EXIT(
+      {
+        common::parallel::Run({[]() {}, []() {}});
+        auto *mgr = common::MeshManager::Instance();
+        if (mgr->LoadAsync(cube).get() == nullptr)
+          std::exit(1);
+        std::exit(0);
+      }, ::testing::ExitedWithCode(0), "");
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadBatchLargeDuplicates)
+{
+  // A binary STL file large enough to be decoded and welded on several
+  // threads. Threads of the pool that wait for the thread loading it must
+  // not keep that thread from splitting its work.
+  common::TempDirectory temp("mesh_batch", "gz_common", true);
+  const std::string path = common::joinPaths(temp.Path(), "strip.stl");
+  const uint32_t faceCount = 250000u;
+  {
+    std::string content(84u + 50u * faceCount, '\0');
+    std::memcpy(&content[80], &faceCount, sizeof(faceCount));
+    for (uint32_t face = 0u; face < faceCount; ++face)
+    {
+      const float x = static_cast<float>(face);
+      const float values[12] = {0.0f, 0.0f, 1.0f,
+          x, 0.0f, 0.0f, x + 1.0f, 0.0f, 0.0f, x, 1.0f, 0.0f};
+      std::memcpy(&content[84u + 50u * face], values, sizeof(values));
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << content;
+  }
+
+  auto *mgr = common::MeshManager::Instance();
+  std::vector<const common::Mesh *> meshes =
+      mgr->LoadBatch(std::vector<std::string>(8u, path));
+  ASSERT_EQ(8u, meshes.size());
+  ASSERT_NE(nullptr, meshes[0]);
+  EXPECT_EQ(3u * faceCount, meshes[0]->IndexCount());
+  for (const common::Mesh *mesh : meshes)
+    EXPECT_EQ(meshes[0], mesh);
+  EXPECT_TRUE(mgr->RemoveMesh(path));
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshManagerLoad, Cache)
+{
+  auto *mgr = common::MeshManager::Instance();
+  common::TempDirectory temp("mesh_cache", "gz_common", true);
+  const std::string dir = common::joinPaths(temp.Path(), "cache");
+  EXPECT_TRUE(mgr->CacheDirectory().empty());
+  mgr->SetCacheDirectory(dir);
+  EXPECT_EQ(dir, mgr->CacheDirectory());
+
+  // The first load parses the files and stores them in the cache
+  const std::string box = common::testing::TestFile("data", "box.dae");
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  const common::Mesh *parsedBox = mgr->Load(box);
+  const common::Mesh *parsedCube = mgr->Load(cube);
+  ASSERT_NE(nullptr, parsedBox);
+  ASSERT_NE(nullptr, parsedCube);
+  const unsigned int boxVertices = parsedBox->VertexCount();
+  const unsigned int boxMaterials = parsedBox->MaterialCount();
+  const math::Vector3d cubeMax = parsedCube->Max();
+  std::size_t files = 0u;
+  for (const auto &entry : std::filesystem::directory_iterator(dir))
+    files += entry.path().extension() == ".gzmesh";
+  EXPECT_EQ(2u, files);
+
+  // Later loads read the cache
+  EXPECT_TRUE(mgr->RemoveMesh(box));
+  EXPECT_TRUE(mgr->RemoveMesh(cube));
+  const common::Mesh *cachedBox = mgr->Load(box);
+  const common::Mesh *cachedCube = mgr->Load(cube);
+  ASSERT_NE(nullptr, cachedBox);
+  ASSERT_NE(nullptr, cachedCube);
+  EXPECT_EQ(box, cachedBox->Name());
+  EXPECT_EQ(boxVertices, cachedBox->VertexCount());
+  EXPECT_EQ(boxMaterials, cachedBox->MaterialCount());
+  EXPECT_EQ(cube, cachedCube->Name());
+  EXPECT_EQ(cubeMax, cachedCube->Max());
+
+  mgr->SetCacheDirectory("");
+  EXPECT_TRUE(mgr->CacheDirectory().empty());
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshManagerLoad, MemoryBudget)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string box = common::testing::TestFile("data", "box.obj");
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  mgr->RemoveMesh(box);
+  mgr->RemoveMesh(cube);
+  EXPECT_EQ(0u, mgr->MemoryBudget());
+  const auto before = mgr->Stats();
+
+  // Loading a file again is a hit and shares the mesh
+  std::shared_ptr<const common::Mesh> boxMesh = mgr->LoadShared(box);
+  ASSERT_NE(nullptr, boxMesh);
+  EXPECT_EQ(boxMesh.get(), mgr->Load(box));
+  EXPECT_EQ(boxMesh, mgr->SharedMeshByName(box));
+  std::shared_ptr<const common::Mesh> cubeMesh = mgr->LoadShared(cube);
+  ASSERT_NE(nullptr, cubeMesh);
+
+  auto stats = mgr->Stats();
+  EXPECT_EQ(before.misses + 2u, stats.misses);
+  EXPECT_EQ(before.hits + 1u, stats.hits);
+  EXPECT_EQ(before.residentCount + 2u, stats.residentCount);
+  EXPECT_EQ(before.residentBytes + boxMesh->MemorySize() +
+      cubeMesh->MemorySize(), stats.residentBytes);
+
+  // Meshes with handles are not evicted
+  mgr->SetMemoryBudget(1u);
+  EXPECT_EQ(1u, mgr->MemoryBudget());
+  EXPECT_TRUE(mgr->HasMesh(box));
+  EXPECT_TRUE(mgr->HasMesh(cube));
+
+  // Once its handle is released, a mesh is evicted on the next check
+  cubeMesh.reset();
+  mgr->SetMemoryBudget(1u);
+  EXPECT_FALSE(mgr->HasMesh(cube));
+  EXPECT_TRUE(mgr->HasMesh(box));
+  stats = mgr->Stats();
+  EXPECT_LE(before.evictions + 1u, stats.evictions);
+  EXPECT_EQ(nullptr, mgr->SharedMeshByName(cube));
+
+  // A handle keeps its mesh alive after the manager removes it
+  EXPECT_TRUE(mgr->RemoveMesh(box));
+  EXPECT_FALSE(mgr->HasMesh(box));
+  EXPECT_LT(0u, boxMesh->VertexCount());
+
+  mgr->SetMemoryBudget(0u);
+  EXPECT_EQ(0u, mgr->MemoryBudget());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadSettings)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+
+  // Meshes loaded without textures are not returned to loads that decode
+  // them, but they are named after the file
+  mgr->SetTextureDecoding(false);
+  const common::Mesh *geometry = mgr->Load(cube);
+  ASSERT_NE(nullptr, geometry);
+  EXPECT_EQ(cube, geometry->Name());
+  EXPECT_EQ(geometry, mgr->MeshByName(cube));
+  EXPECT_TRUE(mgr->HasMesh(cube));
+  EXPECT_EQ(cube, mgr->CanonicalName(cube));
+
+  mgr->SetTextureDecoding(true);
+  const common::Mesh *full = mgr->Load(cube);
+  ASSERT_NE(nullptr, full);
+  EXPECT_NE(geometry, full);
+  EXPECT_EQ(cube, full->Name());
+
+  // The file name refers to the mesh loaded with the current settings
+  EXPECT_EQ(full, mgr->MeshByName(cube));
+  mgr->SetTextureDecoding(false);
+  EXPECT_EQ(geometry, mgr->MeshByName(cube));
+  mgr->SetTextureDecoding(true);
+
+  // Neither are meshes processed with other assimp passes
+  mgr->SetPostProcessProfile(common::AssimpPostProcess::FAST);
+  const common::Mesh *fast = mgr->Load(cube);
+  ASSERT_NE(nullptr, fast);
+  EXPECT_NE(full, fast);
+  EXPECT_EQ(cube, fast->Name());
+  EXPECT_EQ(fast, mgr->MeshByName(cube));
+  mgr->SetPostProcessProfile(common::AssimpPostProcess::DEFAULT);
+  EXPECT_EQ(full, mgr->Load(cube));
+  EXPECT_EQ(full, mgr->MeshByName(cube));
+
+  // Removing the file removes the meshes loaded with every setting
+  EXPECT_TRUE(mgr->RemoveMesh(cube));
+  EXPECT_FALSE(mgr->HasMesh(cube));
+  mgr->SetPostProcessProfile(common::AssimpPostProcess::FAST);
+  EXPECT_EQ(nullptr, mgr->MeshByName(cube));
+  mgr->SetPostProcessProfile(common::AssimpPostProcess::DEFAULT);
+
+  // Loads without textures use the mesh with textures if it is loaded
+  full = mgr->Load(cube);
+  ASSERT_NE(nullptr, full);
+  mgr->SetTextureDecoding(false);
+  EXPECT_EQ(full, mgr->Load(cube));
+  mgr->SetTextureDecoding(true);
+  EXPECT_TRUE(mgr->RemoveMesh(cube));
+  EXPECT_FALSE(mgr->HasMesh(cube));
+}
+
+/////////////////////////////////////////////////
+TEST_P(MeshManagerLoad, ContentDeduplication)
+{
+  auto *mgr = common::MeshManager::Instance();
+  common::TempDirectory temp("mesh_dedup", "gz_common", true);
+  const std::string cube = common::testing::TestFile("data", "cube.stl");
+  const std::string first = common::joinPaths(temp.Path(), "first.stl");
+  const std::string second = common::joinPaths(temp.Path(), "second.stl");
+  ASSERT_TRUE(common::copyFile(cube, first));
+  ASSERT_TRUE(common::copyFile(cube, second));
+
+  // Without deduplication every file has its own mesh
+  EXPECT_FALSE(mgr->ContentDeduplication());
+  const common::Mesh *firstMesh = mgr->Load(first);
+  ASSERT_NE(nullptr, firstMesh);
+  EXPECT_NE(firstMesh, mgr->Load(second));
+  EXPECT_TRUE(mgr->RemoveMesh(first));
+  EXPECT_TRUE(mgr->RemoveMesh(second));
+
+  // With deduplication the second file is an alias of the first one
+  mgr->SetContentDeduplication(true);
+  EXPECT_TRUE(mgr->ContentDeduplication());
+  const auto before = mgr->Stats();
+  firstMesh = mgr->Load(first);
+  ASSERT_NE(nullptr, firstMesh);
+  EXPECT_EQ(firstMesh, mgr->Load(second));
+  EXPECT_EQ(before.deduplicated + 1u, mgr->Stats().deduplicated);
+  EXPECT_EQ(before.misses + 2u, mgr->Stats().misses);
+  EXPECT_EQ(first, mgr->CanonicalName(second));
+  EXPECT_EQ(first, mgr->CanonicalName(first));
+  EXPECT_EQ(first, firstMesh->Name());
+  EXPECT_TRUE(mgr->HasMesh(second));
+  EXPECT_EQ(firstMesh, mgr->MeshByName(second));
+
+  // Later loads of the alias are hits
+  EXPECT_EQ(firstMesh, mgr->Load(second));
+  EXPECT_EQ(before.hits + 1u, mgr->Stats().hits);
+
+  // Removing the alias keeps the mesh, removing the mesh drops its aliases
+  EXPECT_TRUE(mgr->RemoveMesh(second));
+  EXPECT_FALSE(mgr->HasMesh(second));
+  EXPECT_TRUE(mgr->HasMesh(first));
+  EXPECT_EQ(firstMesh, mgr->Load(second));
+  EXPECT_TRUE(mgr->RemoveMesh(first));
+  EXPECT_FALSE(mgr->HasMesh(first));
+  EXPECT_FALSE(mgr->HasMesh(second));
+  EXPECT_EQ(second, mgr->CanonicalName(second));
+
+  // Files that reference materials by relative paths are only shared
+  // within one directory
+  const std::string obj = common::testing::TestFile("data", "box.obj");
+  const std::string mtl = common::testing::TestFile("data", "box.mtl");
+  const std::string dirA = common::joinPaths(temp.Path(), "a");
+  const std::string dirB = common::joinPaths(temp.Path(), "b");
+  ASSERT_TRUE(common::createDirectories(dirA));
+  ASSERT_TRUE(common::createDirectories(dirB));
+  const std::string objA = common::joinPaths(dirA, "box.obj");
+  const std::string objA2 = common::joinPaths(dirA, "box2.obj");
+  const std::string objB = common::joinPaths(dirB, "box.obj");
+  ASSERT_TRUE(common::copyFile(obj, objA));
+  ASSERT_TRUE(common::copyFile(obj, objA2));
+  ASSERT_TRUE(common::copyFile(obj, objB));
+  ASSERT_TRUE(common::copyFile(mtl, common::joinPaths(dirA, "box.mtl")));
+  ASSERT_TRUE(common::copyFile(mtl, common::joinPaths(dirB, "box.mtl")));
+  const common::Mesh *objMesh = mgr->Load(objA);
+  ASSERT_NE(nullptr, objMesh);
+  EXPECT_EQ(objMesh, mgr->Load(objA2));
+  const common::Mesh *otherMesh = mgr->Load(objB);
+  ASSERT_NE(nullptr, otherMesh);
+  EXPECT_NE(objMesh, otherMesh);
+  EXPECT_EQ(objB, mgr->CanonicalName(objB));
+
+  mgr->SetContentDeduplication(false);
+}
+
 /////////////////////////////////////////////////
 TEST_P(MeshManagerLoad, ShareVertices)
 {
@@ -0,0 +1,977 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshSimplification.hh"
+#include "gz/common/SubMesh.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief Cosine of the largest angle (30 degrees) between the normals of
+/// two vertex copies that are welded before simplifying.
+constexpr double kWeldNormalCos = 0.8660254037844386;
+
+/// \brief Tolerance used to compare texture coordinates when welding.
+constexpr double kWeldTexCoordTol = 1e-6;
+
+/// \brief Weight of the quadrics that keep borders and seams in place,
+/// relative to the squared length of the edge.
+constexpr double kBoundaryWeight = 10.0;
+
+/// \brief A collapse is rejected if it rotates a triangle normal by more
+/// than acos(kFlipCos).
+constexpr double kFlipCos = 0.2;
+
+/// \brief Collapses whose error is above this factor times the error of
+/// the collapse that would reach the target count are postponed to the
+/// next pass, so that cheap collapses get priority.
+constexpr double kPassErrorFactor = 1.5;
+
+/// \brief Symmetric 4x4 error quadric, stored as its 10 unique
+/// coefficients, together with the total weight of its planes.
+struct Quadric
+{
+  double a2 = 0, b2 = 0, c2 = 0, ab = 0, ac = 0, bc = 0;
+  double ad = 0, bd = 0, cd = 0, d2 = 0;
+  double weight = 0;
+
+  /// \brief Add the plane n.p + d = 0 with the given weight.
+  void AddPlane(const math::Vector3d &_n, double _d, double _w)
+  {
+    const double a = _n.X();
+    const double b = _n.Y();
+    const double c = _n.Z();
+    this->a2 += _w * a * a;
+    this->b2 += _w * b * b;
+    this->c2 += _w * c * c;
+    this->ab += _w * a * b;
+    this->ac += _w * a * c;
+    this->bc += _w * b * c;
+    this->ad += _w * a * _d;
+    this->bd += _w * b * _d;
+    this->cd += _w * c * _d;
+    this->d2 += _w * _d * _d;
+    this->weight += _w;
+  }
+
+  Quadric &operator+=(const Quadric &_q)
+  {
+    this->a2 += _q.a2;
+    this->b2 += _q.b2;
+    this->c2 += _q.c2;
+    this->ab += _q.ab;
+    this->ac += _q.ac;
+    this->bc += _q.bc;
+    this->ad += _q.ad;
+    this->bd += _q.bd;
+    this->cd += _q.cd;
+    this->d2 += _q.d2;
+    this->weight += _q.weight;
+    return *this;
+  }
+
+  /// \brief Weighted sum of squared distances of a point to the planes,
+  /// without normalization.
+  double Evaluate(const math::Vector3d &_p) const
+  {
+    const double x = _p.X();
+    const double y = _p.Y();
+    const double z = _p.Z();
+    return this->a2 * x * x + this->b2 * y * y + this->c2 * z * z +
+        2.0 * (this->ab * x * y + this->ac * x * z + this->bc * y * z +
+               this->ad * x + this->bd * y + this->cd * z) + this->d2;
+  }
+};
+
+/// \brief Mean squared distance of a point to the planes of two quadrics.
+double CombinedError(const Quadric &_q1, const Quadric &_q2,
+    const math::Vector3d &_p)
+{
+  const double weight = _q1.weight + _q2.weight;
+  if (weight <= 0.0)
+    return 0.0;
+  return std::max(0.0, _q1.Evaluate(_p) + _q2.Evaluate(_p)) / weight;
+}
+
+/// \brief Tolerance used to weld positions, relative to the largest
+/// extent of the submesh. Generated meshes such as spheres duplicate their
+/// seam vertices with round-off differences.
+constexpr double kWeldPositionTol = 1e-6;
+
+/// \brief Quantized position used to weld vertices.
+struct PositionKey
+{
+  int64_t x;
+  int64_t y;
+  int64_t z;
+
+  bool operator==(const PositionKey &_other) const
+  {
+    return this->x == _other.x && this->y == _other.y && this->z == _other.z;
+  }
+};
+
+/// \brief Hash for PositionKey.
+struct PositionKeyHash
+{
+  std::size_t operator()(const PositionKey &_key) const
+  {
+    std::hash<int64_t> hasher;
+    std::size_t seed = hasher(_key.x);
+    seed ^= hasher(_key.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= hasher(_key.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+/// \brief How a welded position can move during simplification.
+enum class VertexKind
+{
+  /// \brief Interior vertex, can collapse along any edge.
+  MANIFOLD,
+  /// \brief Vertex on an open border, can only collapse along it.
+  BORDER,
+  /// \brief Vertex on an attribute seam, can only collapse along it.
+  SEAM,
+  /// \brief Vertex that is never collapsed.
+  LOCKED
+};
+
+/// \brief Classification of an edge between two welded positions.
+struct EdgeInfo
+{
+  /// \brief The edge has a single adjacent triangle.
+  bool border = false;
+
+  /// \brief The two triangles sharing the edge use different copies of
+  /// its lower (first) and higher (second) position. An edge that is a
+  /// seam only at one end, such as an edge to the pole of a UV sphere,
+  /// does not restrict the other end.
+  bool seam[2] = {false, false};
+};
+
+/// \brief Candidate half-edge collapse.
+struct Collapse
+{
+  unsigned int from;
+  unsigned int to;
+  double error;
+};
+
+/// \brief Key of the undirected edge between two welded positions.
+uint64_t EdgeKey(unsigned int _a, unsigned int _b)
+{
+  if (_a > _b)
+    std::swap(_a, _b);
+  return (static_cast<uint64_t>(_a) << 32) | _b;
+}
+
+/// \brief Working state of the simplification of a single submesh.
+/// Triangles reference vertex copies ("attribute vertices"), each of which
+/// belongs to a welded position. Collapses are performed on positions and
+/// carried over to the attribute vertices.
+class Simplifier
+{
+  /// \brief Constructor.
+  /// \param[in] _subMesh Triangle submesh with valid indices.
+  public: explicit Simplifier(const SubMesh &_subMesh)
+    : subMesh(_subMesh)
+  {
+  }
+
+  /// \brief Run the simplification.
+  /// \param[in] _target Target triangle count.
+  /// \param[in] _maxError Maximum error in submesh units.
+  /// \return The simplified submesh.
+  public: SubMesh Run(std::size_t _target, double _maxError)
+  {
+    this->Weld();
+    this->Classify();
+    this->ComputeQuadrics();
+
+    double maxErrorSq = std::numeric_limits<double>::infinity();
+    if (std::isfinite(_maxError))
+    {
+      const double maxError = std::max(0.0, _maxError) / this->scale;
+      maxErrorSq = maxError * maxError;
+    }
+
+    while (this->indices.size() / 3 > _target)
+    {
+      if (this->Pass(_target, maxErrorSq) == 0u)
+        break;
+    }
+
+    return this->Output();
+  }
+
+  /// \brief Weld vertex copies with identical positions and compatible
+  /// attributes, then weld positions.
+  private: void Weld()
+  {
+    const unsigned int vertexCount = this->subMesh.VertexCount();
+    const math::Vector3d *vertices = this->subMesh.VertexPtr();
+
+    this->hasNormals = this->subMesh.NormalCount() == vertexCount;
+    for (unsigned int s = 0u; s < this->subMesh.TexCoordSetCount(); ++s)
+    {
+      if (this->subMesh.TexCoordCountBySet(s) == vertexCount)
+        this->texCoordSets.push_back(s);
+    }
+
+    this->posOf.resize(vertexCount);
+    this->attrRep.resize(vertexCount);
+    if (this->hasNormals)
+      this->normals.resize(vertexCount, math::Vector3d::Zero);
+
+    // Work in a normalized frame so that welding tolerances and quadric
+    // errors do not depend on the magnitude of the coordinates
+    math::Vector3d minPos(std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::max());
+    math::Vector3d maxPos = -minPos;
+    for (unsigned int v = 0u; v < vertexCount; ++v)
+    {
+      minPos.Min(vertices[v]);
+      maxPos.Max(vertices[v]);
+    }
+    if (vertexCount > 0u)
+    {
+      const math::Vector3d extent = maxPos - minPos;
+      this->scale = std::max(extent.X(), std::max(extent.Y(), extent.Z()));
+      if (this->scale <= 0.0)
+        this->scale = 1.0;
+    }
+
+    std::unordered_map<PositionKey, unsigned int, PositionKeyHash> posMap;
+    std::vector<std::vector<unsigned int>> repsOfPos;
+    for (unsigned int v = 0u; v < vertexCount; ++v)
+    {
+      const math::Vector3d p = (vertices[v] - minPos) / this->scale;
+      PositionKey key{std::llround(p.X() / kWeldPositionTol),
+          std::llround(p.Y() / kWeldPositionTol),
+          std::llround(p.Z() / kWeldPositionTol)};
+      auto inserted = posMap.emplace(key,
+          static_cast<unsigned int>(this->positions.size()));
+      const unsigned int pos = inserted.first->second;
+      if (inserted.second)
+      {
+        this->positions.push_back(p);
+        repsOfPos.emplace_back();
+      }
+      this->posOf[v] = pos;
+
+      // Find an existing copy at this position with the same attributes
+      unsigned int rep = v;
+      const math::Vector3d normal = this->hasNormals ?
+          this->subMesh.Normal(v) : math::Vector3d::Zero;
+      for (unsigned int candidate : repsOfPos[pos])
+      {
+        if (this->hasNormals &&
+            normal.Dot(this->subMesh.Normal(candidate)) <
+            kWeldNormalCos * normal.Length() *
+            this->subMesh.Normal(candidate).Length())
+        {
+          continue;
+        }
+        bool sameTexCoords = true;
+        for (unsigned int s : this->texCoordSets)
+        {
+          if (!this->subMesh.TexCoordBySet(v, s).Equal(
+                this->subMesh.TexCoordBySet(candidate, s), kWeldTexCoordTol))
+          {
+            sameTexCoords = false;
+            break;
+          }
+        }
+        if (sameTexCoords)
+        {
+          rep = candidate;
+          break;
+        }
+      }
+      if (rep == v)
+        repsOfPos[pos].push_back(v);
+      this->attrRep[v] = rep;
+      if (this->hasNormals)
+        this->normals[rep] += normal;
+    }
+
+    if (this->hasNormals)
+    {
+      for (unsigned int v = 0u; v < vertexCount; ++v)
+      {
+        if (this->attrRep[v] == v)
+          this->normals[v].Normalize();
+      }
+    }
+
+    const SubMesh::IndexView srcIndices = this->subMesh.Indices();
+    const unsigned int indexCount = this->subMesh.IndexCount();
+    this->indices.reserve(indexCount);
+    for (unsigned int i = 0u; i + 2 < indexCount; i += 3)
+    {
+      const unsigned int a = this->attrRep[srcIndices[i]];
+      const unsigned int b = this->attrRep[srcIndices[i + 1]];
+      const unsigned int c = this->attrRep[srcIndices[i + 2]];
+      if (this->posOf[a] == this->posOf[b] ||
+          this->posOf[b] == this->posOf[c] ||
+          this->posOf[c] == this->posOf[a])
+      {
+        continue;
+      }
+      this->indices.push_back(a);
+      this->indices.push_back(b);
+      this->indices.push_back(c);
+    }
+  }
+
+  /// \brief Classify edges and vertices.
+  private: void Classify()
+  {
+    struct EdgeRecord
+    {
+      unsigned int count = 0u;
+      unsigned int from = 0u;
+      unsigned int to = 0u;
+      bool seamFrom = false;
+      bool seamTo = false;
+      bool nonManifold = false;
+    };
+    std::unordered_map<uint64_t, EdgeRecord> records;
+    records.reserve(this->indices.size());
+
+    for (std::size_t i = 0u; i < this->indices.size(); i += 3)
+    {
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int a = this->indices[i + k];
+        const unsigned int b = this->indices[i + (k + 1) % 3];
+        EdgeRecord &edge =
+            records[EdgeKey(this->posOf[a], this->posOf[b])];
+        if (edge.count == 0u)
+        {
+          edge.from = a;
+          edge.to = b;
+        }
+        else if (edge.count == 1u &&
+            this->posOf[edge.from] == this->posOf[b] &&
+            this->posOf[edge.to] == this->posOf[a])
+        {
+          edge.seamFrom = edge.from != b;
+          edge.seamTo = edge.to != a;
+        }
+        else
+        {
+          edge.nonManifold = true;
+        }
+        ++edge.count;
+      }
+    }
+
+    std::vector<unsigned int> borderCount(this->positions.size(), 0u);
+    std::vector<unsigned int> seamCount(this->positions.size(), 0u);
+    std::vector<bool> nonManifold(this->positions.size(), false);
+    for (const auto &[key, edge] : records)
+    {
+      const unsigned int pa = static_cast<unsigned int>(key >> 32);
+      const unsigned int pb = static_cast<unsigned int>(key & 0xffffffffu);
+      if (edge.nonManifold)
+      {
+        nonManifold[pa] = true;
+        nonManifold[pb] = true;
+      }
+      else if (edge.count == 1u)
+      {
+        ++borderCount[pa];
+        ++borderCount[pb];
+        this->edges[key].border = true;
+      }
+      else if (edge.seamFrom || edge.seamTo)
+      {
+        // pa is the lower position of the key
+        const bool fromIsLow = this->posOf[edge.from] == pa;
+        EdgeInfo &info = this->edges[key];
+        info.seam[0] = fromIsLow ? edge.seamFrom : edge.seamTo;
+        info.seam[1] = fromIsLow ? edge.seamTo : edge.seamFrom;
+        seamCount[pa] += info.seam[0] ? 1u : 0u;
+        seamCount[pb] += info.seam[1] ? 1u : 0u;
+      }
+    }
+
+    this->kinds.resize(this->positions.size(), VertexKind::MANIFOLD);
+    for (std::size_t p = 0u; p < this->positions.size(); ++p)
+    {
+      if (nonManifold[p] || (borderCount[p] > 0u && seamCount[p] > 0u))
+        this->kinds[p] = VertexKind::LOCKED;
+      else if (borderCount[p] > 0u)
+      {
+        this->kinds[p] = borderCount[p] == 2u ?
+            VertexKind::BORDER : VertexKind::LOCKED;
+      }
+      else if (seamCount[p] > 0u)
+      {
+        this->kinds[p] = seamCount[p] == 2u ?
+            VertexKind::SEAM : VertexKind::LOCKED;
+      }
+    }
+  }
+
+  /// \brief Accumulate the face and boundary quadrics of every position.
+  private: void ComputeQuadrics()
+  {
+    this->quadrics.resize(this->positions.size());
+    for (std::size_t i = 0u; i < this->indices.size(); i += 3)
+    {
+      const unsigned int p[3] = {this->posOf[this->indices[i]],
+          this->posOf[this->indices[i + 1]],
+          this->posOf[this->indices[i + 2]]};
+      const math::Vector3d &p0 = this->positions[p[0]];
+      math::Vector3d normal =
+          (this->positions[p[1]] - p0).Cross(this->positions[p[2]] - p0);
+      const double doubleArea = normal.Length();
+      if (doubleArea <= 0.0)
+        continue;
+      normal /= doubleArea;
+
+      Quadric face;
+      face.AddPlane(normal, -normal.Dot(p0), doubleArea * 0.5);
+      for (unsigned int k = 0u; k < 3u; ++k)
+        this->quadrics[p[k]] += face;
+
+      // Planes perpendicular to the face through border and seam edges
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int pa = p[k];
+        const unsigned int pb = p[(k + 1) % 3];
+        auto info = this->edges.find(EdgeKey(pa, pb));
+        if (info == this->edges.end())
+          continue;
+        const math::Vector3d edge =
+            this->positions[pb] - this->positions[pa];
+        math::Vector3d edgeNormal = edge.Cross(normal);
+        if (edgeNormal.Length() <= 0.0)
+          continue;
+        edgeNormal.Normalize();
+        Quadric boundary;
+        boundary.AddPlane(edgeNormal,
+            -edgeNormal.Dot(this->positions[pa]),
+            edge.SquaredLength() * kBoundaryWeight);
+        this->quadrics[pa] += boundary;
+        this->quadrics[pb] += boundary;
+      }
+    }
+  }
+
+  /// \brief Whether the edge between two positions is a border.
+  private: bool IsBorder(unsigned int _pa, unsigned int _pb) const
+  {
+    auto it = this->edges.find(EdgeKey(_pa, _pb));
+    return it != this->edges.end() && it->second.border;
+  }
+
+  /// \brief Whether the edge between two positions is a seam at _p.
+  private: bool IsSeamAt(unsigned int _p, unsigned int _q) const
+  {
+    auto it = this->edges.find(EdgeKey(_p, _q));
+    return it != this->edges.end() && it->second.seam[_p < _q ? 0 : 1];
+  }
+
+  /// \brief Whether position _from may collapse onto _to.
+  private: bool CanCollapse(unsigned int _from, unsigned int _to) const
+  {
+    switch (this->kinds[_from])
+    {
+      case VertexKind::MANIFOLD:
+        return true;
+      case VertexKind::BORDER:
+        return this->IsBorder(_from, _to);
+      case VertexKind::SEAM:
+        return this->IsSeamAt(_from, _to);
+      case VertexKind::LOCKED:
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Build the position to triangle adjacency of the current
+  /// triangles.
+  private: void BuildAdjacency()
+  {
+    this->adjOffsets.assign(this->positions.size() + 1, 0u);
+    for (unsigned int index : this->indices)
+      ++this->adjOffsets[this->posOf[index] + 1];
+    for (std::size_t p = 0u; p < this->positions.size(); ++p)
+      this->adjOffsets[p + 1] += this->adjOffsets[p];
+
+    this->adjTriangles.resize(this->indices.size());
+    std::vector<unsigned int> fill(this->adjOffsets.begin(),
+        this->adjOffsets.end() - 1);
+    for (std::size_t i = 0u; i < this->indices.size(); ++i)
+    {
+      this->adjTriangles[fill[this->posOf[this->indices[i]]]++] =
+          static_cast<unsigned int>(i / 3);
+    }
+  }
+
+  /// \brief Position of corner _k of triangle _t.
+  private: unsigned int CornerPos(unsigned int _t, unsigned int _k) const
+  {
+    return this->posOf[this->indices[_t * 3 + _k]];
+  }
+
+  /// \brief Whether triangle _t references position _p.
+  private: bool HasPos(unsigned int _t, unsigned int _p) const
+  {
+    return this->CornerPos(_t, 0) == _p || this->CornerPos(_t, 1) == _p ||
+        this->CornerPos(_t, 2) == _p;
+  }
+
+  /// \brief Collect the positions adjacent to _p.
+  private: void Ring(unsigned int _p, std::vector<unsigned int> &_ring) const
+  {
+    _ring.clear();
+    for (unsigned int i = this->adjOffsets[_p];
+         i < this->adjOffsets[_p + 1]; ++i)
+    {
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int q = this->CornerPos(this->adjTriangles[i], k);
+        if (q != _p)
+          _ring.push_back(q);
+      }
+    }
+    std::sort(_ring.begin(), _ring.end());
+    _ring.erase(std::unique(_ring.begin(), _ring.end()), _ring.end());
+  }
+
+  /// \brief Link condition: the only positions adjacent to both ends of
+  /// the edge must be the apexes of the triangles sharing the edge.
+  /// Otherwise the collapse would create a non-manifold edge.
+  private: bool LinkConditionHolds(unsigned int _from, unsigned int _to)
+  {
+    this->Ring(_from, this->ringFrom);
+    this->Ring(_to, this->ringTo);
+
+    std::size_t edgeTriangles = 0u;
+    for (unsigned int i = this->adjOffsets[_from];
+         i < this->adjOffsets[_from + 1]; ++i)
+    {
+      if (this->HasPos(this->adjTriangles[i], _to))
+        ++edgeTriangles;
+    }
+
+    // Collapsing an edge of a closed tetrahedron leaves two coincident
+    // triangles
+    if (edgeTriangles == 2u && this->ringFrom.size() <= 3u &&
+        this->ringTo.size() <= 3u)
+    {
+      return false;
+    }
+
+    std::size_t common = 0u;
+    auto it = this->ringTo.begin();
+    for (unsigned int q : this->ringFrom)
+    {
+      it = std::lower_bound(it, this->ringTo.end(), q);
+      if (it != this->ringTo.end() && *it == q)
+        ++common;
+    }
+    return common == edgeTriangles;
+  }
+
+  /// \brief Whether moving _from onto _to flips or degenerates one of the
+  /// triangles that survive the collapse.
+  private: bool Flips(unsigned int _from, unsigned int _to) const
+  {
+    for (unsigned int i = this->adjOffsets[_from];
+         i < this->adjOffsets[_from + 1]; ++i)
+    {
+      const unsigned int t = this->adjTriangles[i];
+      if (this->HasPos(t, _to))
+        continue;
+
+      math::Vector3d before[3];
+      math::Vector3d after[3];
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int p = this->CornerPos(t, k);
+        before[k] = this->positions[p];
+        after[k] = this->positions[p == _from ? _to : p];
+      }
+      const math::Vector3d n0 =
+          (before[1] - before[0]).Cross(before[2] - before[0]);
+      const math::Vector3d n1 =
+          (after[1] - after[0]).Cross(after[2] - after[0]);
+      if (n0.Dot(n1) <= kFlipCos * n0.Length() * n1.Length())
+        return true;
+    }
+    return false;
+  }
+
+  /// \brief Match every vertex copy of position _from with the copy of _to
+  /// it shares a triangle with, and store the result in copyPairs.
+  /// \return False if a copy of _from has no single matching copy of _to.
+  private: bool MatchCopies(unsigned int _from, unsigned int _to)
+  {
+    this->copyPairs.clear();
+    for (unsigned int i = this->adjOffsets[_from];
+         i < this->adjOffsets[_from + 1]; ++i)
+    {
+      const unsigned int t = this->adjTriangles[i];
+      unsigned int u = 0u;
+      unsigned int w = 0u;
+      bool hasTo = false;
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int index = this->indices[t * 3 + k];
+        if (this->posOf[index] == _from)
+          u = index;
+        else if (this->posOf[index] == _to)
+        {
+          w = index;
+          hasTo = true;
+        }
+      }
+      if (!hasTo)
+        continue;
+      for (const auto &pair : this->copyPairs)
+      {
+        if (pair.first == u && pair.second != w)
+          return false;
+      }
+      this->copyPairs.emplace_back(u, w);
+    }
+
+    for (unsigned int i = this->adjOffsets[_from];
+         i < this->adjOffsets[_from + 1]; ++i)
+    {
+      const unsigned int t = this->adjTriangles[i];
+      for (unsigned int k = 0u; k < 3u; ++k)
+      {
+        const unsigned int index = this->indices[t * 3 + k];
+        if (this->posOf[index] != _from)
+          continue;
+        bool mapped = false;
+        for (const auto &pair : this->copyPairs)
+          mapped = mapped || pair.first == index;
+        if (!mapped)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Whether collapsing _from onto _to keeps the mesh manifold,
+  /// does not flip triangles and preserves attribute seams.
+  private: bool IsValidCollapse(unsigned int _from, unsigned int _to)
+  {
+    return this->LinkConditionHolds(_from, _to) &&
+        !this->Flips(_from, _to) && this->MatchCopies(_from, _to);
+  }
+
+  /// \brief Perform one pass of independent collapses.
+  /// \param[in] _target Target triangle count.
+  /// \param[in] _maxErrorSq Maximum squared error in normalized units.
+  /// \return Number of collapses performed.
+  private: std::size_t Pass(std::size_t _target, double _maxErrorSq)
+  {
+    this->BuildAdjacency();
+
+    // Cheapest valid collapse of every position. Collapses below only
+    // touch triangles that are not modified by other collapses of the same
+    // pass, so validity does not need to be checked again.
+    std::vector<Collapse> collapses;
+    std::vector<Collapse> options;
+    for (unsigned int p = 0u; p < this->positions.size(); ++p)
+    {
+      if (this->kinds[p] == VertexKind::LOCKED)
+        continue;
+      options.clear();
+      for (unsigned int i = this->adjOffsets[p];
+           i < this->adjOffsets[p + 1]; ++i)
+      {
+        for (unsigned int k = 0u; k < 3u; ++k)
+        {
+          const unsigned int q = this->CornerPos(this->adjTriangles[i], k);
+          if (q == p || !this->CanCollapse(p, q))
+            continue;
+          const double error = CombinedError(this->quadrics[p],
+              this->quadrics[q], this->positions[q]);
+          if (error <= _maxErrorSq)
+            options.push_back({p, q, error});
+        }
+      }
+      std::sort(options.begin(), options.end(),
+          [](const Collapse &_a, const Collapse &_b)
+          {
+            return _a.error < _b.error || (_a.error == _b.error &&
+                _a.to < _b.to);
+          });
+      for (std::size_t i = 0u; i < options.size(); ++i)
+      {
+        if (i > 0u && options[i].to == options[i - 1].to)
+          continue;
+        if (this->IsValidCollapse(p, options[i].to))
+        {
+          collapses.push_back(options[i]);
+          break;
+        }
+      }
+    }
+    if (collapses.empty())
+      return 0u;
+
+    std::sort(collapses.begin(), collapses.end(),
+        [](const Collapse &_a, const Collapse &_b)
+        {
+          return _a.error < _b.error || (_a.error == _b.error &&
+              _a.from < _b.from);
+        });
+
+    // Each collapse removes about two triangles
+    std::size_t triangleCount = this->indices.size() / 3;
+    const std::size_t goal = std::max<std::size_t>(
+        (triangleCount - _target) / 2, 1u);
+    const double errorLimit = kPassErrorFactor *
+        collapses[std::min(goal, collapses.size()) - 1].error;
+
+    this->remap.resize(this->attrRep.size());
+    std::iota(this->remap.begin(), this->remap.end(), 0u);
+    std::vector<bool> locked(this->positions.size(), false);
+
+    std::size_t performed = 0u;
+    for (const Collapse &c : collapses)
+    {
+      if (triangleCount <= _target)
+        break;
+      if (c.error > errorLimit && performed > 0u)
+        break;
+
+      // Skip collapses that touch triangles modified in this pass
+      bool touched = locked[c.from];
+      for (unsigned int i = this->adjOffsets[c.from];
+           !touched && i < this->adjOffsets[c.from + 1]; ++i)
+      {
+        const unsigned int t = this->adjTriangles[i];
+        for (unsigned int k = 0u; k < 3u; ++k)
+          touched = touched || locked[this->CornerPos(t, k)];
+      }
+      if (touched)
+        continue;
+
+      this->MatchCopies(c.from, c.to);
+      for (const auto &pair : this->copyPairs)
+        this->remap[pair.first] = pair.second;
+      this->quadrics[c.to] += this->quadrics[c.from];
+      for (unsigned int i = this->adjOffsets[c.from];
+           i < this->adjOffsets[c.from + 1]; ++i)
+      {
+        const unsigned int t = this->adjTriangles[i];
+        if (this->HasPos(t, c.to))
+          --triangleCount;
+        for (unsigned int k = 0u; k < 3u; ++k)
+          locked[this->CornerPos(t, k)] = true;
+      }
+      ++performed;
+    }
+
+    // Apply the collapses and drop the triangles that became degenerate
+    std::size_t out = 0u;
+    for (std::size_t i = 0u; i < this->indices.size(); i += 3)
+    {
+      const unsigned int a = this->remap[this->indices[i]];
+      const unsigned int b = this->remap[this->indices[i + 1]];
+      const unsigned int c = this->remap[this->indices[i + 2]];
+      if (this->posOf[a] == this->posOf[b] ||
+          this->posOf[b] == this->posOf[c] ||
+          this->posOf[c] == this->posOf[a])
+      {
+        continue;
+      }
+      this->indices[out++] = a;
+      this->indices[out++] = b;
+      this->indices[out++] = c;
+    }
+    this->indices.resize(out);
+
+    return performed;
+  }
+
+  /// \brief Create the output submesh from the remaining triangles.
+  private: SubMesh Output() const
+  {
+    SubMesh result;
+    result.SetName(this->subMesh.Name());
+    result.SetPrimitiveType(SubMesh::TRIANGLES);
+    if (this->subMesh.GetMaterialIndex())
+      result.SetMaterialIndex(*this->subMesh.GetMaterialIndex());
+
+    std::vector<int> newIndex(this->attrRep.size(), -1);
+    unsigned int count = 0u;
+    for (unsigned int index : this->indices)
+    {
+      if (newIndex[index] < 0)
+      {
+        newIndex[index] = static_cast<int>(count++);
+        result.AddVertex(this->subMesh.Vertex(index));
+        if (this->hasNormals)
+          result.AddNormal(this->normals[index]);
+        for (unsigned int s : this->texCoordSets)
+          result.AddTexCoordBySet(this->subMesh.TexCoordBySet(index, s), s);
+      }
+      result.AddIndex(static_cast<unsigned int>(newIndex[index]));
+    }
+
+    for (unsigned int i = 0u; i < this->subMesh.NodeAssignmentsCount(); ++i)
+    {
+      const NodeAssignment na = this->subMesh.NodeAssignmentByIndex(i);
+      if (na.vertexIndex < newIndex.size() && newIndex[na.vertexIndex] >= 0)
+      {
+        result.AddNodeAssignment(
+            static_cast<unsigned int>(newIndex[na.vertexIndex]),
+            na.nodeIndex, na.weight);
+      }
+    }
+
+    if (!this->hasNormals && this->subMesh.NormalCount() > 0u)
+      result.RecalculateNormals();
+
+    return result;
+  }
+
+  /// \brief Input submesh.
+  private: const SubMesh &subMesh;
+
+  /// \brief Normalized welded positions.
+  private: std::vector<math::Vector3d> positions;
+
+  /// \brief Scale of the normalized frame.
+  private: double scale = 1.0;
+
+  /// \brief Welded position of every input vertex.
+  private: std::vector<unsigned int> posOf;
+
+  /// \brief Vertex copy that represents every input vertex.
+  private: std::vector<unsigned int> attrRep;
+
+  /// \brief Averaged normal of every representative vertex copy.
+  private: std::vector<math::Vector3d> normals;
+
+  /// \brief Whether the input has one normal per vertex.
+  private: bool hasNormals = false;
+
+  /// \brief Texture coordinate sets with one entry per vertex.
+  private: std::vector<unsigned int> texCoordSets;
+
+  /// \brief Current triangles, referencing representative vertex copies.
+  private: std::vector<unsigned int> indices;
+
+  /// \brief Border and seam edges, keyed by EdgeKey.
+  private: std::unordered_map<uint64_t, EdgeInfo> edges;
+
+  /// \brief Kind of every welded position.
+  private: std::vector<VertexKind> kinds;
+
+  /// \brief Error quadric of every welded position.
+  private: std::vector<Quadric> quadrics;
+
+  /// \brief Offsets into adjTriangles for every welded position.
+  private: std::vector<unsigned int> adjOffsets;
+
+  /// \brief Triangles adjacent to every welded position.
+  private: std::vector<unsigned int> adjTriangles;
+
+  /// \brief Vertex copy remapping of the current pass.
+  private: std::vector<unsigned int> remap;
+
+  /// \brief Scratch buffers.
+  private: std::vector<unsigned int> ringFrom;
+  private: std::vector<unsigned int> ringTo;
+  private: std::vector<std::pair<unsigned int, unsigned int>> copyPairs;
+};
+}  // namespace
+
+//////////////////////////////////////////////////
+SubMesh gz::common::SimplifySubMesh(const SubMesh &_subMesh,
+    std::size_t _targetTriangleCount, double _maxError)
+{
+  if (_subMesh.SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+  {
+    gzwarn << "Only triangle submeshes can be simplified, submesh ["
+           << _subMesh.Name() << "] is returned unchanged" << std::endl;
+    return _subMesh;
+  }
+
+  if (!_subMesh.HasValidIndices() || _subMesh.IndexCount() % 3 != 0u)
+  {
+    gzwarn << "Submesh [" << _subMesh.Name() << "] has invalid indices and "
+           << "is returned unchanged" << std::endl;
+    return _subMesh;
+  }
+
+  if (_subMesh.IndexCount() / 3 <= _targetTriangleCount)
+    return _subMesh;
+
+  Simplifier simplifier(_subMesh);
+  return simplifier.Run(_targetTriangleCount, _maxError);
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<Mesh> gz::common::SimplifyMesh(const Mesh &_mesh,
+    double _ratio, double _maxError)
+{
+  const double ratio = std::clamp(_ratio, 0.0, 1.0);
+
+  auto mesh = std::make_unique<Mesh>();
+  mesh->SetName(_mesh.Name());
+  mesh->SetPath(_mesh.Path());
+  for (unsigned int i = 0u; i < _mesh.MaterialCount(); ++i)
+    mesh->AddMaterial(_mesh.MaterialByIndex(i));
+  if (_mesh.HasSkeleton())
+    mesh->SetSkeleton(_mesh.MeshSkeleton());
+
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (!subMesh)
+      continue;
+    const auto target = static_cast<std::size_t>(
+        std::llround((subMesh->IndexCount() / 3) * ratio));
+    mesh->AddSubMesh(SimplifySubMesh(*subMesh, target, _maxError));
+  }
+
+  return mesh;
+}
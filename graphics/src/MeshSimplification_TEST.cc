@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshManager.hh"
+#include "gz/common/MeshSimplification.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class MeshSimplification : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplification, Sphere)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("simplify_sphere", 1.0, 32, 32);
+  const common::Mesh *mesh = mgr->MeshByName("simplify_sphere");
+  ASSERT_NE(nullptr, mesh);
+  auto subMesh = mesh->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  const unsigned int triangleCount = subMesh->IndexCount() / 3;
+  const std::size_t target = triangleCount / 4;
+  common::SubMesh simplified = common::SimplifySubMesh(*subMesh, target);
+
+  EXPECT_EQ(common::SubMesh::TRIANGLES, simplified.SubMeshPrimitiveType());
+  EXPECT_TRUE(simplified.HasValidIndices());
+  EXPECT_EQ(0u, simplified.IndexCount() % 3);
+  EXPECT_LE(simplified.IndexCount() / 3, target);
+  EXPECT_GT(simplified.IndexCount(), 0u);
+  EXPECT_LT(simplified.VertexCount(), subMesh->VertexCount());
+  EXPECT_EQ(simplified.VertexCount(), simplified.NormalCount());
+  EXPECT_EQ(simplified.VertexCount(), simplified.TexCoordCount());
+
+  // The coarse sphere must still look like the original one
+  EXPECT_NEAR(subMesh->Volume(), simplified.Volume(),
+      0.1 * subMesh->Volume());
+  EXPECT_TRUE(subMesh->Max().Equal(simplified.Max(), 0.1));
+  EXPECT_TRUE(subMesh->Min().Equal(simplified.Min(), 0.1));
+  for (unsigned int i = 0; i < simplified.VertexCount(); ++i)
+    EXPECT_NEAR(1.0, simplified.Vertex(i).Length(), 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplification, MaxError)
+{
+  // 10 x 10 grid on the XY plane with texture coordinates that follow the
+  // positions
+  const unsigned int segments = 10;
+  common::SubMesh grid("grid");
+  for (unsigned int y = 0; y <= segments; ++y)
+  {
+    for (unsigned int x = 0; x <= segments; ++x)
+    {
+      const double u = static_cast<double>(x) / segments;
+      const double v = static_cast<double>(y) / segments;
+      grid.AddVertex(2.0 * u - 1.0, 2.0 * v - 1.0, 0.0);
+      grid.AddNormal(math::Vector3d::UnitZ);
+      grid.AddTexCoord(u, v);
+    }
+  }
+  for (unsigned int y = 0; y < segments; ++y)
+  {
+    for (unsigned int x = 0; x < segments; ++x)
+    {
+      const unsigned int i = y * (segments + 1) + x;
+      grid.AddIndex(i);
+      grid.AddIndex(i + 1);
+      grid.AddIndex(i + segments + 2);
+      grid.AddIndex(i);
+      grid.AddIndex(i + segments + 2);
+      grid.AddIndex(i + segments + 1);
+    }
+  }
+  EXPECT_EQ(200u, grid.IndexCount() / 3);
+
+  // A flat grid can be simplified without error, but its outline has to
+  // be preserved.
+  common::SubMesh simplified = common::SimplifySubMesh(grid, 0, 1e-6);
+  EXPECT_TRUE(simplified.HasValidIndices());
+  EXPECT_LT(simplified.IndexCount() / 3, 50u);
+  EXPECT_GT(simplified.IndexCount(), 0u);
+  EXPECT_EQ(grid.Max(), simplified.Max());
+  EXPECT_EQ(grid.Min(), simplified.Min());
+
+  double area = 0;
+  for (unsigned int i = 0; i + 2 < simplified.IndexCount(); i += 3)
+  {
+    const math::Vector3d v0 = simplified.Vertex(simplified.Index(i));
+    const math::Vector3d v1 = simplified.Vertex(simplified.Index(i + 1));
+    const math::Vector3d v2 = simplified.Vertex(simplified.Index(i + 2));
+    const math::Vector3d n = (v1 - v0).Cross(v2 - v0);
+    // No triangle is flipped
+    EXPECT_GT(n.Z(), 0.0);
+    area += 0.5 * n.Length();
+  }
+  EXPECT_NEAR(4.0, area, 1e-6);
+
+  // Vertices never move, so they keep their texture coordinates
+  for (unsigned int i = 0; i < simplified.VertexCount(); ++i)
+  {
+    const math::Vector3d v = simplified.Vertex(i);
+    const math::Vector2d uv = simplified.TexCoord(i);
+    EXPECT_NEAR(v.X() + 1.0, uv.X() * 2.0, 1e-6);
+    EXPECT_NEAR(v.Y() + 1.0, uv.Y() * 2.0, 1e-6);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplification, Unchanged)
+{
+  common::SubMesh lines("lines");
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  lines.AddVertex(0, 0, 0);
+  lines.AddVertex(1, 0, 0);
+  lines.AddIndex(0);
+  lines.AddIndex(1);
+  common::SubMesh result = common::SimplifySubMesh(lines, 0);
+  EXPECT_EQ(common::SubMesh::LINES, result.SubMeshPrimitiveType());
+  EXPECT_EQ(2u, result.IndexCount());
+
+  common::SubMesh triangle("triangle");
+  triangle.AddVertex(0, 0, 0);
+  triangle.AddVertex(1, 0, 0);
+  triangle.AddVertex(0, 1, 0);
+  triangle.AddIndex(0);
+  triangle.AddIndex(1);
+  triangle.AddIndex(2);
+  triangle.SetMaterialIndex(3);
+  result = common::SimplifySubMesh(triangle, 1);
+  EXPECT_EQ(3u, result.IndexCount());
+  EXPECT_EQ("triangle", result.Name());
+  ASSERT_TRUE(result.GetMaterialIndex());
+  EXPECT_EQ(3u, *result.GetMaterialIndex());
+
+  // Invalid indices
+  triangle.AddIndex(7);
+  triangle.AddIndex(8);
+  triangle.AddIndex(9);
+  result = common::SimplifySubMesh(triangle, 0);
+  EXPECT_EQ(6u, result.IndexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplification, SimplifyMesh)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("simplify_mesh_sphere", 0.5, 16, 16);
+  const common::Mesh *sphere = mgr->MeshByName("simplify_mesh_sphere");
+  ASSERT_NE(nullptr, sphere);
+
+  common::Mesh mesh;
+  mesh.SetName("two_spheres");
+  auto material = std::make_shared<common::Material>();
+  mesh.AddMaterial(material);
+  auto subMesh = sphere->SubMeshByIndex(0).lock();
+  common::SubMesh first(*subMesh);
+  first.SetMaterialIndex(0);
+  // Bind every vertex of the first submesh to a skeleton node
+  for (unsigned int i = 0; i < first.VertexCount(); ++i)
+    first.AddNodeAssignment(i, 1, 1.0f);
+  mesh.AddSubMesh(first);
+  common::SubMesh second(*subMesh);
+  second.Translate(math::Vector3d(2, 0, 0));
+  mesh.AddSubMesh(second);
+
+  std::unique_ptr<common::Mesh> simplified = common::SimplifyMesh(mesh, 0.5);
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_EQ("two_spheres", simplified->Name());
+  ASSERT_EQ(1u, simplified->MaterialCount());
+  EXPECT_EQ(material, simplified->MaterialByIndex(0));
+  ASSERT_EQ(2u, simplified->SubMeshCount());
+  EXPECT_LE(simplified->IndexCount(), mesh.IndexCount() / 2);
+
+  auto simplifiedFirst = simplified->SubMeshByIndex(0).lock();
+  ASSERT_TRUE(simplifiedFirst->GetMaterialIndex());
+  EXPECT_EQ(0u, *simplifiedFirst->GetMaterialIndex());
+  EXPECT_EQ(simplifiedFirst->VertexCount(),
+      simplifiedFirst->NodeAssignmentsCount());
+  for (unsigned int i = 0; i < simplifiedFirst->NodeAssignmentsCount(); ++i)
+  {
+    EXPECT_LT(simplifiedFirst->NodeAssignmentByIndex(i).vertexIndex,
+        simplifiedFirst->VertexCount());
+  }
+
+  auto simplifiedSecond = simplified->SubMeshByIndex(1).lock();
+  EXPECT_FALSE(simplifiedSecond->GetMaterialIndex());
+  EXPECT_NEAR(2.0, simplifiedSecond->Centroid().X(), 0.05);
+
+  // Ratio of 1 keeps everything
+  simplified = common::SimplifyMesh(mesh, 1.0);
+  EXPECT_EQ(mesh.IndexCount(), simplified->IndexCount());
+}
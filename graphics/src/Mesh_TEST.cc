@@ -155,7 +155,7 @@ TEST_F(MeshTest, Mesh)
   EXPECT_TRUE(math::equal(vertices[1], submesh.lock()->Vertex(0).Y()));
   EXPECT_TRUE(math::equal(vertices[2], submesh.lock()->Vertex(0).Z()));
   EXPECT_EQ(indices[0], submesh.lock()->Index(0));
-  EXPECT_EQ(indices[0], submesh.lock()->IndexPtr()[0]);
+  EXPECT_EQ(indices[0], static_cast<int>(submesh.lock()->Indices()[0]));
 
   delete [] vertices;
   delete [] indices;
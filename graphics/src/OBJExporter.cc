@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <string>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/OBJExporter.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "FileWriter.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Write an OBJ or MTL statement with three numbers
+/// \param[in] _writer File to write to
+/// \param[in] _keyword Keyword of the statement, followed by a space
+/// \param[in] _x First number
+/// \param[in] _y Second number
+/// \param[in] _z Third number
+template<typename T>
+void WriteTriple(FileWriter &_writer, const char *_keyword,
+    T _x, T _y, T _z)
+{
+  _writer.Write(_keyword);
+  _writer.Write(_x);
+  _writer.Write(" ");
+  _writer.Write(_y);
+  _writer.Write(" ");
+  _writer.Write(_z);
+  _writer.Write("\n");
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a color statement of an MTL file
+/// \param[in] _writer File to write to
+/// \param[in] _keyword Keyword of the statement, followed by a space
+/// \param[in] _color Color to write, without alpha
+void WriteColor(FileWriter &_writer, const char *_keyword,
+    const math::Color &_color)
+{
+  WriteTriple(_writer, _keyword, _color.R(), _color.G(), _color.B());
+}
+}  // namespace
+
+/// \brief Private data for the OBJExporter class
+class gz::common::OBJExporter::Implementation
+{
+  /// \brief Write the materials of a mesh to an MTL file
+  /// \param[in] _mesh Mesh to export
+  /// \param[in] _filename Path of the MTL file
+  /// \param[in] _textureDir Directory to copy textures to, empty to
+  /// reference them where they are
+  /// \return True if the file was written
+  public: bool ExportMaterials(const Mesh &_mesh,
+              const std::string &_filename,
+              const std::string &_textureDir) const;
+
+  /// \brief Write the geometry of a mesh to an OBJ file
+  /// \param[in] _mesh Mesh to export
+  /// \param[in] _filename Path of the OBJ file
+  /// \param[in] _mtlName Name of the MTL file, empty if there is none
+  /// \return True if the file was written
+  public: bool ExportGeometry(const Mesh &_mesh,
+              const std::string &_filename,
+              const std::string &_mtlName) const;
+};
+
+//////////////////////////////////////////////////
+OBJExporter::OBJExporter()
+: MeshExporter(), dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+OBJExporter::~OBJExporter()
+{
+}
+
+//////////////////////////////////////////////////
+void OBJExporter::Export(const Mesh *_mesh, const std::string &_filename,
+    bool _exportTextures)
+{
+  if (!_mesh)
+  {
+    gzerr << "Unable to export a null mesh to OBJ\n";
+    return;
+  }
+
+  // File name and path, laid out like ColladaExporter
+  const std::string unixFilename = copyToUnixPath(_filename);
+  const std::size_t beginFilename = unixFilename.rfind('/') + 1u;
+  const std::string path = unixFilename.substr(0u, beginFilename);
+  const std::string filename = unixFilename.substr(beginFilename);
+
+  std::string directory = path;
+  std::string textureDir;
+  if (_exportTextures)
+  {
+    directory = joinPaths(path, filename, "meshes");
+    textureDir = joinPaths(path, filename, "materials", "textures");
+    createDirectories(directory);
+  }
+
+  std::string mtlName;
+  if (_mesh->MaterialCount() > 0u)
+  {
+    mtlName = filename + ".mtl";
+    if (!this->dataPtr->ExportMaterials(*_mesh,
+          joinPaths(directory, mtlName), textureDir))
+    {
+      mtlName.clear();
+    }
+  }
+
+  this->dataPtr->ExportGeometry(*_mesh,
+      joinPaths(directory, filename + ".obj"), mtlName);
+}
+
+//////////////////////////////////////////////////
+bool OBJExporter::Implementation::ExportMaterials(const Mesh &_mesh,
+    const std::string &_filename, const std::string &_textureDir) const
+{
+  FileWriter writer(_filename, 1u << 16);
+  if (!writer.Valid())
+  {
+    gzerr << "Unable to create file[" << _filename << "]\n";
+    return false;
+  }
+
+  writer.Write("# Exported by gz-common\n");
+  for (unsigned int i = 0u; i < _mesh.MaterialCount(); ++i)
+  {
+    const MaterialPtr material = _mesh.MaterialByIndex(i);
+    writer.Write("\nnewmtl material_");
+    writer.Write(static_cast<uint64_t>(i));
+    writer.Write("\n");
+    if (!material)
+      continue;
+
+    WriteColor(writer, "Ka ", material->Ambient());
+    WriteColor(writer, "Kd ", material->Diffuse());
+    WriteColor(writer, "Ks ", material->Specular());
+    WriteColor(writer, "Ke ", material->Emissive());
+    writer.Write("Ns ");
+    writer.Write(material->Shininess());
+    writer.Write("\nd ");
+    writer.Write(1.0 - material->Transparency());
+    writer.Write("\n");
+
+    const std::string image = material->TextureImage();
+    if (image.empty())
+      continue;
+    std::string texture = image;
+    if (!_textureDir.empty())
+    {
+      const std::string name = basename(image);
+      createDirectories(_textureDir);
+      if (!copyFile(image, joinPaths(_textureDir, name)))
+        gzwarn << "Unable to copy texture[" << image << "]\n";
+      texture = "../materials/textures/" + name;
+    }
+    writer.Write("map_Kd ");
+    writer.Write(texture);
+    writer.Write("\n");
+  }
+
+  if (!writer.Close())
+  {
+    gzerr << "Unable to write file[" << _filename << "]\n";
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool OBJExporter::Implementation::ExportGeometry(const Mesh &_mesh,
+    const std::string &_filename, const std::string &_mtlName) const
+{
+  FileWriter writer(_filename);
+  if (!writer.Valid())
+  {
+    gzerr << "Unable to create file[" << _filename << "]\n";
+    return false;
+  }
+
+  writer.Write("# Exported by gz-common\n");
+  if (!_mtlName.empty())
+  {
+    writer.Write("mtllib ");
+    writer.Write(_mtlName);
+    writer.Write("\n");
+  }
+
+  // OBJ indices are 1-based and shared by every object of the file
+  uint64_t offset = 1u;
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (!subMesh)
+      continue;
+    if (subMesh->SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+    {
+      gzwarn << "Submesh[" << subMesh->Name() << "] is not made of "
+             << "triangles and is not exported to OBJ\n";
+      continue;
+    }
+
+    writer.Write("\no ");
+    if (subMesh->Name().empty())
+    {
+      writer.Write("submesh_");
+      writer.Write(static_cast<uint64_t>(i));
+    }
+    else
+    {
+      writer.Write(subMesh->Name());
+    }
+    writer.Write("\n");
+
+    const unsigned int vertexCount = subMesh->VertexCount();
+    const math::Vector3d *vertices = subMesh->VertexPtr();
+    for (unsigned int v = 0u; v < vertexCount; ++v)
+    {
+      WriteTriple(writer, "v ",
+          vertices[v].X(), vertices[v].Y(), vertices[v].Z());
+    }
+
+    // Normals and texture coordinates are only referenced by the faces if
+    // every vertex has one
+    const bool hasNormals = vertexCount > 0u &&
+        subMesh->NormalCount() == vertexCount;
+    const bool hasTexCoords = vertexCount > 0u &&
+        subMesh->TexCoordCount() == vertexCount;
+    if (hasNormals)
+    {
+      for (unsigned int v = 0u; v < vertexCount; ++v)
+      {
+        const math::Vector3d normal = subMesh->Normal(v);
+        WriteTriple(writer, "vn ", normal.X(), normal.Y(), normal.Z());
+      }
+    }
+    if (hasTexCoords)
+    {
+      for (unsigned int v = 0u; v < vertexCount; ++v)
+      {
+        // OBJ puts the origin of textures at the bottom
+        const math::Vector2d uv = subMesh->TexCoord(v);
+        writer.Write("vt ");
+        writer.Write(uv.X());
+        writer.Write(" ");
+        writer.Write(1.0 - uv.Y());
+        writer.Write("\n");
+      }
+    }
+
+    const auto materialIndex = subMesh->GetMaterialIndex();
+    if (!_mtlName.empty() && materialIndex &&
+        *materialIndex < _mesh.MaterialCount())
+    {
+      writer.Write("usemtl material_");
+      writer.Write(static_cast<uint64_t>(*materialIndex));
+      writer.Write("\n");
+    }
+
+    const SubMesh::IndexView indices = subMesh->Indices();
+    const uint64_t cornerCount = indices.Count() != 0u ?
+        indices.Count() : vertexCount;
+    for (uint64_t c = 0u; c + 2u < cornerCount; c += 3u)
+    {
+      writer.Write("f");
+      for (uint64_t k = c; k < c + 3u; ++k)
+      {
+        const uint64_t index = offset +
+            (indices.Count() != 0u ? indices[k] : k);
+        writer.Write(" ");
+        writer.Write(index);
+        if (hasTexCoords || hasNormals)
+        {
+          writer.Write("/");
+          if (hasTexCoords)
+            writer.Write(index);
+          if (hasNormals)
+          {
+            writer.Write("/");
+            writer.Write(index);
+          }
+        }
+      }
+      writer.Write("\n");
+    }
+
+    offset += vertexCount;
+  }
+
+  if (!writer.Close())
+  {
+    gzerr << "Unable to write file[" << _filename << "]\n";
+    return false;
+  }
+  return true;
+}
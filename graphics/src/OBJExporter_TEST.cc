@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/OBJExporter.hh"
+#include "gz/common/OBJLoader.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+
+class OBJExporter : public common::testing::AutoLogFixture
+{
+  /// \brief Setup the test fixture. This gets called by gtest.
+  public: void SetUp() override
+  {
+    this->common::testing::AutoLogFixture::SetUp();
+    this->pathOut = common::testing::TempPath();
+    common::createDirectories(this->pathOut);
+  }
+
+  /// \brief Path to temporary output (removed during TearDown)
+  public: std::string pathOut;
+};
+
+/////////////////////////////////////////////////
+TEST_F(OBJExporter, ExportBox)
+{
+  common::OBJLoader loader;
+  std::unique_ptr<common::Mesh> meshOriginal(
+      loader.Load(common::testing::TestFile("data", "box.obj")));
+  ASSERT_NE(nullptr, meshOriginal);
+
+  const auto filenameOut = common::joinPaths(this->pathOut, "box_exported");
+  common::OBJExporter exporter;
+  exporter.Export(meshOriginal.get(), filenameOut);
+  EXPECT_TRUE(common::exists(filenameOut + ".mtl"));
+
+  std::unique_ptr<common::Mesh> meshReloaded(
+      loader.Load(filenameOut + ".obj"));
+  ASSERT_NE(nullptr, meshReloaded);
+  ASSERT_EQ(meshOriginal->SubMeshCount(), meshReloaded->SubMeshCount());
+  ASSERT_EQ(meshOriginal->MaterialCount(), meshReloaded->MaterialCount());
+  EXPECT_EQ(meshOriginal->IndexCount(), meshReloaded->IndexCount());
+
+  auto original = meshOriginal->SubMeshByIndex(0u).lock();
+  auto reloaded = meshReloaded->SubMeshByIndex(0u).lock();
+  EXPECT_EQ(original->Name(), reloaded->Name());
+  ASSERT_EQ(original->IndexCount(), reloaded->IndexCount());
+  for (unsigned int i = 0u; i < original->IndexCount(); ++i)
+  {
+    const unsigned int o = static_cast<unsigned int>(original->Index(i));
+    const unsigned int r = static_cast<unsigned int>(reloaded->Index(i));
+    EXPECT_EQ(original->Vertex(o), reloaded->Vertex(r)) << i;
+    EXPECT_EQ(original->Normal(o), reloaded->Normal(r)) << i;
+  }
+
+  auto materialOriginal = meshOriginal->MaterialByIndex(0u);
+  auto materialReloaded = meshReloaded->MaterialByIndex(0u);
+  EXPECT_EQ(materialOriginal->Diffuse(), materialReloaded->Diffuse());
+  EXPECT_EQ(materialOriginal->Specular(), materialReloaded->Specular());
+  EXPECT_DOUBLE_EQ(materialOriginal->Shininess(),
+      materialReloaded->Shininess());
+  EXPECT_DOUBLE_EQ(materialOriginal->Transparency(),
+      materialReloaded->Transparency());
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJExporter, ExportTextures)
+{
+  // An indexed quad with texture coordinates and a textured material
+  common::Mesh mesh;
+  auto material = std::make_shared<common::Material>();
+  material->SetTextureImage(
+      common::testing::TestFile("data", "red_blue_colors.png"));
+  auto subMesh = mesh.AddSubMesh(
+      std::make_unique<common::SubMesh>()).lock();
+  subMesh->SetMaterialIndex(
+      static_cast<unsigned int>(mesh.AddMaterial(material)));
+  subMesh->AddVertex(0, 0, 0);
+  subMesh->AddVertex(1, 0, 0);
+  subMesh->AddVertex(1, 1, 0);
+  subMesh->AddVertex(0, 1, 0);
+  subMesh->AddTexCoord(0, 1);
+  subMesh->AddTexCoord(1, 1);
+  subMesh->AddTexCoord(1, 0);
+  subMesh->AddTexCoord(0, 0);
+  for (unsigned int index : {0u, 1u, 2u, 0u, 2u, 3u})
+    subMesh->AddIndex(index);
+
+  const auto filenameOut = common::joinPaths(this->pathOut, "quad");
+  common::OBJExporter exporter;
+  exporter.Export(&mesh, filenameOut, true);
+
+  const auto filenameOutExt = common::joinPaths(filenameOut, "meshes",
+      "quad.obj");
+  ASSERT_TRUE(common::exists(filenameOutExt));
+  EXPECT_TRUE(common::exists(common::joinPaths(filenameOut, "materials",
+      "textures", "red_blue_colors.png")));
+
+  common::OBJLoader loader;
+  std::unique_ptr<common::Mesh> meshReloaded(loader.Load(filenameOutExt));
+  ASSERT_NE(nullptr, meshReloaded);
+  ASSERT_EQ(1u, meshReloaded->SubMeshCount());
+  auto reloaded = meshReloaded->SubMeshByIndex(0u).lock();
+  EXPECT_EQ("submesh_0", reloaded->Name());
+  ASSERT_EQ(6u, reloaded->IndexCount());
+  EXPECT_EQ(0u, reloaded->NormalCount());
+  for (unsigned int i = 0u; i < subMesh->IndexCount(); ++i)
+  {
+    const unsigned int o = static_cast<unsigned int>(subMesh->Index(i));
+    const unsigned int r = static_cast<unsigned int>(reloaded->Index(i));
+    EXPECT_EQ(subMesh->Vertex(o), reloaded->Vertex(r)) << i;
+    EXPECT_EQ(subMesh->TexCoord(o), reloaded->TexCoord(r)) << i;
+  }
+
+  ASSERT_EQ(1u, meshReloaded->MaterialCount());
+  EXPECT_TRUE(common::exists(
+      meshReloaded->MaterialByIndex(0u)->TextureImage()));
+}
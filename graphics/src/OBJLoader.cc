@@ -15,7 +15,19 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 #include "gz/common/Console.hh"
 #include "gz/common/Filesystem.hh"
@@ -24,6 +36,9 @@
 #include "gz/common/SubMesh.hh"
 #include "gz/common/OBJLoader.hh"
 
+#include "MappedFile.hh"
+#include "Parallel.hh"
+
 #define GZ_COMMON_TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
 
@@ -35,6 +50,13 @@ namespace gz
     /// \brief OBJLoader private data
     class OBJLoader::Implementation
     {
+      /// \brief Load a file with the parallel parser
+      /// \param[in] _filename OBJ file to load
+      /// \return Pointer to a new Mesh, or nullptr on error
+      public: Mesh *LoadParallel(const std::string &_filename) const;
+
+      /// \brief True to parse files on several threads
+      public: bool parallelParsing = false;
     };
   }
 }
@@ -42,6 +64,586 @@ namespace gz
 using namespace gz;
 using namespace common;
 
+namespace
+{
+/// \brief Minimum number of bytes parsed by a thread
+constexpr std::size_t kMinChunkSize = 1u << 20;
+
+/// \brief Number of corners above which submeshes are built on several
+/// threads
+constexpr std::size_t kParallelCorners = 65536u;
+
+/// \brief Added to indices that are relative to the attributes read so far
+/// in a chunk, until the chunk's offset is known
+constexpr int64_t kRelative = int64_t(1) << 40;
+
+/////////////////////////////////////////////////
+/// \brief Position, texture coordinate and normal indices of a face
+/// corner. While a chunk is parsed, indices may be relative to the chunk,
+/// see kRelative. Afterwards they are 0-based indices into the whole file,
+/// or -1 if the corner has no such attribute.
+struct CornerIndex
+{
+  /// \brief Position index
+  int64_t v;
+
+  /// \brief Texture coordinate index
+  int64_t vt;
+
+  /// \brief Normal index
+  int64_t vn;
+};
+
+/////////////////////////////////////////////////
+/// \brief Hash of a resolved corner
+struct CornerIndexHash
+{
+  std::size_t operator()(const CornerIndex &_c) const
+  {
+    uint64_t h = static_cast<uint64_t>(_c.v);
+    h = h * 0x9e3779b97f4a7c15ull + static_cast<uint64_t>(_c.vt);
+    h = h * 0x9e3779b97f4a7c15ull + static_cast<uint64_t>(_c.vn);
+    // Mix the high bits into the low bits, which pick the slot
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Hash table from resolved corners to vertex indices, with open
+/// addressing so lookups do not allocate
+class CornerTable
+{
+  /// \brief Constructor
+  /// \param[in] _expected Expected number of distinct corners
+  public: explicit CornerTable(std::size_t _expected)
+  {
+    std::size_t capacity = 16u;
+    while (capacity < 2u * _expected)
+      capacity *= 2u;
+    this->Resize(capacity);
+  }
+
+  /// \brief Find a corner, or add it with the next vertex index
+  /// \param[in] _corner The corner
+  /// \param[out] _index Vertex index of the corner
+  /// \return True if the corner was added
+  public: bool Insert(const CornerIndex &_corner, unsigned int &_index)
+  {
+    std::size_t slot = CornerIndexHash()(_corner) & this->mask;
+    while (this->values[slot] != kEmpty)
+    {
+      const CornerIndex &key = this->keys[slot];
+      if (key.v == _corner.v && key.vt == _corner.vt && key.vn == _corner.vn)
+      {
+        _index = this->values[slot];
+        return false;
+      }
+      slot = (slot + 1u) & this->mask;
+    }
+
+    _index = static_cast<unsigned int>(this->count++);
+    this->keys[slot] = _corner;
+    this->values[slot] = _index;
+    if (2u * this->count > this->keys.size())
+      this->Resize(2u * this->keys.size());
+    return true;
+  }
+
+  /// \brief Change the number of slots, keeping the corners
+  /// \param[in] _capacity New number of slots, a power of 2
+  private: void Resize(std::size_t _capacity)
+  {
+    std::vector<CornerIndex> oldKeys(_capacity);
+    std::vector<unsigned int> oldValues(_capacity, kEmpty);
+    oldKeys.swap(this->keys);
+    oldValues.swap(this->values);
+    this->mask = _capacity - 1u;
+    for (std::size_t i = 0u; i < oldKeys.size(); ++i)
+    {
+      if (oldValues[i] == kEmpty)
+        continue;
+      std::size_t slot = CornerIndexHash()(oldKeys[i]) & this->mask;
+      while (this->values[slot] != kEmpty)
+        slot = (slot + 1u) & this->mask;
+      this->keys[slot] = oldKeys[i];
+      this->values[slot] = oldValues[i];
+    }
+  }
+
+  /// \brief Value of the slots that hold no corner
+  private: static constexpr unsigned int kEmpty = ~0u;
+
+  /// \brief Corners of the slots
+  private: std::vector<CornerIndex> keys;
+
+  /// \brief Vertex indices of the slots, kEmpty for free slots
+  private: std::vector<unsigned int> values;
+
+  /// \brief Number of slots minus 1
+  private: std::size_t mask = 0u;
+
+  /// \brief Number of corners in the table
+  private: std::size_t count = 0u;
+};
+
+/////////////////////////////////////////////////
+/// \brief Check if tinyobjloader's ear clipping splits a quad into the
+/// triangles (0, 1, 2) and (0, 2, 3), which it does when the first corner
+/// is an ear. The same projection and arithmetic are used so the result
+/// matches for warped quads too.
+/// \param[in] _positions Positions of the file, 3 values each
+/// \param[in] _corners The 4 corners of the quad
+/// \return True if the first corner is an ear
+bool FirstCornerIsEar(const std::vector<tinyobj::real_t> &_positions,
+    const CornerIndex *_corners)
+{
+  using real = tinyobj::real_t;
+  const real *p[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    if (_corners[i].v < 0)
+      return false;
+    p[i] = &_positions[3u * _corners[i].v];
+  }
+
+  // Project on the plane of the axes most perpendicular to the first corner
+  // that is not flat
+  std::size_t axes[2] = {1u, 2u};
+  for (int k = 0; k < 4; ++k)
+  {
+    const real *v0 = p[k];
+    const real *v1 = p[(k + 1) % 4];
+    const real *v2 = p[(k + 2) % 4];
+    const real e0x = v1[0] - v0[0];
+    const real e0y = v1[1] - v0[1];
+    const real e0z = v1[2] - v0[2];
+    const real e1x = v2[0] - v1[0];
+    const real e1y = v2[1] - v1[1];
+    const real e1z = v2[2] - v1[2];
+    const real cx = std::fabs(e0y * e1z - e0z * e1y);
+    const real cy = std::fabs(e0z * e1x - e0x * e1z);
+    const real cz = std::fabs(e0x * e1y - e0y * e1x);
+    const real epsilon = std::numeric_limits<real>::epsilon();
+    if (cx > epsilon || cy > epsilon || cz > epsilon)
+    {
+      if (!(cx > cy && cx > cz))
+      {
+        axes[0] = 0u;
+        if (cz > cx && cz > cy)
+          axes[1] = 1u;
+      }
+      break;
+    }
+  }
+
+  real area = 0;
+  for (int k = 0; k < 4; ++k)
+  {
+    const real *v0 = p[k];
+    const real *v1 = p[(k + 1) % 4];
+    area += (v0[axes[0]] * v1[axes[1]] - v0[axes[1]] * v1[axes[0]]) *
+        static_cast<real>(0.5);
+  }
+
+  real vx[3];
+  real vy[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    vx[k] = p[k][axes[0]];
+    vy[k] = p[k][axes[1]];
+  }
+  const real cross = (vx[1] - vx[0]) * (vy[2] - vy[1]) -
+      (vy[1] - vy[0]) * (vx[2] - vx[1]);
+  if (cross * area < static_cast<real>(0.0))
+    return false;
+  return !tinyobj::pnpoly(3, vx, vy, p[3][axes[0]], p[3][axes[1]]);
+}
+
+/////////////////////////////////////////////////
+/// \brief A statement, other than an attribute or a face, that changes how
+/// the following faces are grouped
+struct Statement
+{
+  /// \brief Kinds of statements
+  enum Kind {USEMTL, MTLLIB, GROUP, OBJECT};
+
+  /// \brief Kind of the statement
+  Kind kind;
+
+  /// \brief Argument of the statement: a name or a list of files
+  std::string name;
+
+  /// \brief Number of faces of the chunk before the statement
+  std::size_t faceCount;
+};
+
+/////////////////////////////////////////////////
+/// \brief What a thread read from a range of lines of the file
+struct Chunk
+{
+  /// \brief Positions, 3 values each
+  std::vector<tinyobj::real_t> positions;
+
+  /// \brief Texture coordinates, 2 values each
+  std::vector<tinyobj::real_t> texCoords;
+
+  /// \brief Normals, 3 values each
+  std::vector<tinyobj::real_t> normals;
+
+  /// \brief Corners of all the faces
+  std::vector<CornerIndex> corners;
+
+  /// \brief End of the corners of each face in corners
+  std::vector<std::size_t> faceEnds;
+
+  /// \brief Statements in the order they appear
+  std::vector<Statement> statements;
+
+  /// \brief Line of the chunk, starting at 1, with an invalid face. 0 if
+  /// the chunk was parsed.
+  std::size_t errorLine = 0u;
+};
+
+/////////////////////////////////////////////////
+/// \brief Faces of a chunk with the same shape and material
+struct Segment
+{
+  /// \brief Index of the chunk
+  std::size_t chunk;
+
+  /// \brief First face, in the faces of the chunk
+  std::size_t faceBegin;
+
+  /// \brief End of the faces, in the faces of the chunk
+  std::size_t faceEnd;
+
+  /// \brief Material id, -1 if none
+  int material;
+};
+
+/////////////////////////////////////////////////
+/// \brief A shape, which is an object or a group of the file
+struct Shape
+{
+  /// \brief Name of the shape
+  std::string name;
+
+  /// \brief Faces of the shape, in file order
+  std::vector<Segment> segments;
+};
+
+/////////////////////////////////////////////////
+/// \brief Check if a character separates tokens on a line
+/// \param[in] _c Character
+/// \return True for spaces, tabs and carriage returns
+bool IsSpace(char _c)
+{
+  return _c == ' ' || _c == '\t' || _c == '\r';
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove spaces at both ends of a string
+/// \param[in] _text Text
+/// \return Text without leading and trailing spaces
+std::string_view Trim(std::string_view _text)
+{
+  while (!_text.empty() && IsSpace(_text.front()))
+    _text.remove_prefix(1u);
+  while (!_text.empty() && IsSpace(_text.back()))
+    _text.remove_suffix(1u);
+  return _text;
+}
+
+/////////////////////////////////////////////////
+/// \brief Take the next whitespace separated token from a line
+/// \param[in,out] _line Rest of the line, advanced past the token
+/// \return The token, empty at the end of the line
+std::string_view NextToken(std::string_view &_line)
+{
+  std::size_t begin = 0u;
+  while (begin < _line.size() && IsSpace(_line[begin]))
+    ++begin;
+  std::size_t end = begin;
+  while (end < _line.size() && !IsSpace(_line[end]))
+    ++end;
+  const std::string_view token = _line.substr(begin, end - begin);
+  _line.remove_prefix(end);
+  return token;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a number with tinyobjloader's parser, which is not always
+/// correctly rounded. Reading the same values keeps the triangulation of
+/// nearly degenerate polygons the same as the serial loader.
+/// \param[in] _token Token holding the number
+/// \return The number, 0 if the token is not a number
+tinyobj::real_t ParseReal(std::string_view _token)
+{
+  double value = 0.0;
+  tinyobj::tryParseDouble(_token.data(), _token.data() + _token.size(),
+      &value);
+  return static_cast<tinyobj::real_t>(value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the numbers of an attribute line, like "v 1 2 3". Missing
+/// numbers are 0 and extra numbers are ignored.
+/// \param[in] _line Rest of the line, after the keyword
+/// \param[in] _count Number of values to read
+/// \param[out] _values Vector the values are appended to
+void ParseReals(std::string_view _line, int _count,
+    std::vector<tinyobj::real_t> &_values)
+{
+  for (int i = 0; i < _count; ++i)
+    _values.push_back(ParseReal(NextToken(_line)));
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse one index of a face corner
+/// \param[in] _text Text of the index, empty if the index is missing
+/// \param[in] _count Number of attributes read so far in the chunk
+/// \param[out] _index 0-based index, relative to the chunk if negative in
+/// the file, or -1 if missing
+/// \return False if the index is not a number or is 0
+bool ParseIndex(std::string_view _text, std::size_t _count, int64_t &_index)
+{
+  if (_text.empty())
+  {
+    _index = -1;
+    return true;
+  }
+  int value = 0;
+  const auto result = std::from_chars(_text.data(),
+      _text.data() + _text.size(), value);
+  if (result.ec != std::errc() || value == 0)
+    return false;
+  // Negative indices count back from the last attribute read, which is
+  // only known relative to the chunk for now
+  _index = value > 0 ? value - 1 :
+      kRelative + static_cast<int64_t>(_count) + value;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the corners of a face line
+/// \param[in] _line Rest of the line, after "f"
+/// \param[in,out] _chunk Chunk the face is added to
+/// \return False if an index is invalid
+bool ParseFace(std::string_view _line, Chunk &_chunk)
+{
+  for (std::string_view token = NextToken(_line); !token.empty();
+      token = NextToken(_line))
+  {
+    // v, v/vt, v//vn or v/vt/vn
+    std::string_view parts[3];
+    for (int i = 0; i < 3 && !token.empty(); ++i)
+    {
+      const std::size_t slash = token.find('/');
+      parts[i] = token.substr(0u, slash);
+      token = slash == std::string_view::npos ? std::string_view() :
+          token.substr(slash + 1u);
+    }
+
+    CornerIndex corner;
+    if (parts[0].empty() ||
+        !ParseIndex(parts[0], _chunk.positions.size() / 3u, corner.v) ||
+        !ParseIndex(parts[1], _chunk.texCoords.size() / 2u, corner.vt) ||
+        !ParseIndex(parts[2], _chunk.normals.size() / 3u, corner.vn))
+    {
+      return false;
+    }
+    _chunk.corners.push_back(corner);
+  }
+  _chunk.faceEnds.push_back(_chunk.corners.size());
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a line starts with a keyword followed by a space
+/// \param[in] _line The line
+/// \param[in] _keyword The keyword
+/// \return True if the line starts with the keyword
+bool StartsWith(std::string_view _line, std::string_view _keyword)
+{
+  return _line.size() > _keyword.size() &&
+      _line.compare(0u, _keyword.size(), _keyword) == 0 &&
+      IsSpace(_line[_keyword.size()]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a range of whole lines of an OBJ file
+/// \param[in] _begin Start of the first line
+/// \param[in] _end End of the last line
+/// \param[out] _chunk What was read
+void ParseChunk(const char *_begin, const char *_end, Chunk &_chunk)
+{
+  std::size_t lineNumber = 0u;
+  for (const char *line = _begin; line < _end;)
+  {
+    const char *newline = static_cast<const char *>(
+        std::memchr(line, '\n', static_cast<std::size_t>(_end - line)));
+    const char *lineEnd = newline ? newline : _end;
+    std::string_view text(line, static_cast<std::size_t>(lineEnd - line));
+    line = lineEnd + 1;
+    ++lineNumber;
+
+    while (!text.empty() && IsSpace(text.front()))
+      text.remove_prefix(1u);
+    if (text.empty() || text[0] == '#')
+      continue;
+
+    if (StartsWith(text, "v"))
+    {
+      ParseReals(text.substr(2u), 3, _chunk.positions);
+    }
+    else if (StartsWith(text, "vt"))
+    {
+      ParseReals(text.substr(3u), 2, _chunk.texCoords);
+    }
+    else if (StartsWith(text, "vn"))
+    {
+      ParseReals(text.substr(3u), 3, _chunk.normals);
+    }
+    else if (StartsWith(text, "f"))
+    {
+      if (!ParseFace(text.substr(2u), _chunk))
+      {
+        _chunk.errorLine = lineNumber;
+        return;
+      }
+    }
+    else if (StartsWith(text, "usemtl") || StartsWith(text, "mtllib"))
+    {
+      _chunk.statements.push_back({text[0] == 'u' ?
+          Statement::USEMTL : Statement::MTLLIB,
+          std::string(Trim(text.substr(7u))), _chunk.faceEnds.size()});
+    }
+    else if (StartsWith(text, "g"))
+    {
+      // Several group names are joined with spaces, like tinyobjloader does
+      std::string names;
+      std::string_view rest = text.substr(2u);
+      for (std::string_view token = NextToken(rest); !token.empty();
+          token = NextToken(rest))
+      {
+        if (!names.empty())
+          names += ' ';
+        names += token;
+      }
+      _chunk.statements.push_back(
+          {Statement::GROUP, names, _chunk.faceEnds.size()});
+    }
+    else if (StartsWith(text, "o"))
+    {
+      _chunk.statements.push_back({Statement::OBJECT,
+          std::string(Trim(text.substr(2u))), _chunk.faceEnds.size()});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a material of an OBJ file, or reuse the material created
+/// for the same name, and add it to a mesh
+/// \param[in] _m Material of the OBJ file
+/// \param[in] _path Directory of the OBJ file
+/// \param[in] _exportedByBlender True if the file was exported by Blender
+/// \param[in,out] _materialIds Materials created so far, by name
+/// \param[in,out] _mesh Mesh to add the material to
+/// \return Index of the material in the mesh
+int AddMaterial(const tinyobj::material_t &_m, const std::string &_path,
+    bool _exportedByBlender, std::map<std::string, Material *> &_materialIds,
+    Mesh &_mesh)
+{
+  Material *mat = nullptr;
+  if (_materialIds.find(_m.name) != _materialIds.end())
+  {
+    mat = _materialIds[_m.name];
+  }
+  else
+  {
+    // Create new material and pass it to mesh who will take ownership
+    // of the object
+    mat = new Material();
+    mat->SetAmbient(
+        math::Color(_m.ambient[0], _m.ambient[1], _m.ambient[2]));
+    mat->SetDiffuse(
+        math::Color(_m.diffuse[0], _m.diffuse[1], _m.diffuse[2]));
+    mat->SetSpecular(
+        math::Color(_m.specular[0], _m.specular[1], _m.specular[2]));
+    mat->SetEmissive(
+        math::Color(_m.emission[0], _m.emission[1], _m.emission[2]));
+    mat->SetShininess(_m.shininess);
+    mat->SetTransparency(1.0 - _m.dissolve);
+    if (!_m.diffuse_texname.empty())
+      mat->SetTextureImage(_m.diffuse_texname, _path.c_str());
+
+    // load PBR textures
+    // Some obj exporters put PBR maps in the standard textures
+    // while others have proper support for obj PBR extension
+    Pbr pbrMat;
+    // PBR shoved into standard textures
+    if (!_m.specular_texname.empty())
+      pbrMat.SetRoughnessMap(_m.specular_texname);
+
+    // check if obj is exported by blender
+    // blender obj exporter puts roughness map in specular highlight
+    // field and metalness map in reflection map field!
+    // see summary in https://developer.blender.org/D8868
+    // detailing the existing exporter issues
+    // todo(anyone) add a check for blender version to avoid this hack
+    // when blender fixes their exporter issue
+    if (!_m.specular_highlight_texname.empty() && _exportedByBlender)
+    {
+      pbrMat.SetRoughnessMap(_m.specular_highlight_texname);
+      if (!_m.reflection_texname.empty())
+        pbrMat.SetMetalnessMap(_m.reflection_texname);
+    }
+    else if (!_m.reflection_texname.empty())
+    {
+      pbrMat.SetEnvironmentMap(_m.reflection_texname);
+    }
+    if (!_m.bump_texname.empty())
+      pbrMat.SetNormalMap(_m.bump_texname);
+
+    // PBR extension - overrides standard materials
+    if (!_m.roughness_texname.empty())
+      pbrMat.SetRoughnessMap(_m.roughness_texname);
+    if (!_m.metallic_texname.empty())
+      pbrMat.SetMetalnessMap(_m.metallic_texname);
+    if (!_m.normal_texname.empty())
+      pbrMat.SetNormalMap(_m.normal_texname);
+    if (!_m.emissive_texname.empty())
+      pbrMat.SetEmissiveMap(_m.emissive_texname);
+
+    pbrMat.SetRoughness(_m.roughness);
+    pbrMat.SetMetalness(_m.metallic);
+
+    mat->SetPbrMaterial(pbrMat);
+
+    _materialIds[_m.name] = mat;
+  }
+  int matIndex = _mesh.IndexOfMaterial(mat);
+  if (matIndex < 0)
+    matIndex = _mesh.AddMaterial(MaterialPtr(mat));
+  return matIndex;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if the first line of a file mentions Blender, which puts
+/// PBR maps in the standard texture fields
+/// \param[in] _firstLine First line of the file
+/// \return True if the file was exported by Blender
+bool IsExportedByBlender(std::string _firstLine)
+{
+  std::transform(_firstLine.begin(), _firstLine.end(), _firstLine.begin(),
+      [](unsigned char c){ return std::tolower(c); });
+  return _firstLine.find("blender") != std::string::npos;
+}
+}  // namespace
+
 //////////////////////////////////////////////////
 OBJLoader::OBJLoader()
 : dataPtr(gz::utils::MakeImpl<Implementation>())
@@ -53,9 +655,24 @@ OBJLoader::~OBJLoader()
 {
 }
 
+//////////////////////////////////////////////////
+void OBJLoader::SetParallelParsing(bool _parallel)
+{
+  this->dataPtr->parallelParsing = _parallel;
+}
+
+//////////////////////////////////////////////////
+bool OBJLoader::ParallelParsing() const
+{
+  return this->dataPtr->parallelParsing;
+}
+
 //////////////////////////////////////////////////
 Mesh *OBJLoader::Load(const std::string &_filename)
 {
+  if (this->dataPtr->parallelParsing)
+    return this->dataPtr->LoadParallel(_filename);
+
   std::map<std::string, Material *> materialIds;
   std::string path = common::parentPath(_filename);
 
@@ -67,10 +684,7 @@ Mesh *OBJLoader::Load(const std::string &_filename)
   {
     std::string line;
     std::getline(infile, line);
-    std::transform(line.begin(), line.end(), line.begin(),
-        [](unsigned char c){ return std::tolower(c); });
-    if (line.find("blender") != std::string::npos)
-      exportedByBlender = true;
+    exportedByBlender = IsExportedByBlender(line);
   }
   infile.close();
 
@@ -121,81 +735,10 @@ Mesh *OBJLoader::Load(const std::string &_filename)
         subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
         subMeshMatId[id] = subMesh.get();
 
-        Material *mat = nullptr;
         if (id >= 0 && static_cast<size_t>(id) < materials.size())
         {
-          auto &m = materials[id];
-          if (materialIds.find(m.name) != materialIds.end())
-          {
-            mat = materialIds[m.name];
-          }
-          else
-          {
-            // Create new material and pass it to mesh who will take ownership
-            // of the object
-            mat = new Material();
-            mat->SetAmbient(
-                math::Color(m.ambient[0], m.ambient[1], m.ambient[2]));
-            mat->SetDiffuse(
-                math::Color(m.diffuse[0], m.diffuse[1], m.diffuse[2]));
-            mat->SetSpecular(
-                math::Color(m.specular[0], m.specular[1], m.specular[2]));
-            mat->SetEmissive(
-                math::Color(m.emission[0], m.emission[1], m.emission[2]));
-            mat->SetShininess(m.shininess);
-            mat->SetTransparency(1.0 - m.dissolve);
-            if (!m.diffuse_texname.empty())
-              mat->SetTextureImage(m.diffuse_texname, path.c_str());
-
-            // load PBR textures
-            // Some obj exporters put PBR maps in the standard textures
-            // while others have proper support for obj PBR extension
-            Pbr pbrMat;
-            // PBR shoved into standard textures
-            if (!m.specular_texname.empty())
-              pbrMat.SetRoughnessMap(m.specular_texname);
-
-            // check if obj is exported by blender
-            // blender obj exporter puts roughness map in specular highlight
-            // field and metalness map in reflection map field!
-            // see summary in https://developer.blender.org/D8868
-            // detailing the existing exporter issues
-            // todo(anyone) add a check for blender version to avoid this hack
-            // when blender fixes their exporter issue
-            if (!m.specular_highlight_texname.empty() && exportedByBlender)
-            {
-              pbrMat.SetRoughnessMap(m.specular_highlight_texname);
-              if (!m.reflection_texname.empty())
-                pbrMat.SetMetalnessMap(m.reflection_texname);
-            }
-            else if (!m.reflection_texname.empty())
-            {
-              pbrMat.SetEnvironmentMap(m.reflection_texname);
-            }
-            if (!m.bump_texname.empty())
-              pbrMat.SetNormalMap(m.bump_texname);
-
-            // PBR extension - overrides standard materials
-            if (!m.roughness_texname.empty())
-              pbrMat.SetRoughnessMap(m.roughness_texname);
-            if (!m.metallic_texname.empty())
-              pbrMat.SetMetalnessMap(m.metallic_texname);
-            if (!m.normal_texname.empty())
-              pbrMat.SetNormalMap(m.normal_texname);
-            if (!m.emissive_texname.empty())
-              pbrMat.SetEmissiveMap(m.emissive_texname);
-
-            pbrMat.SetRoughness(m.roughness);
-            pbrMat.SetMetalness(m.metallic);
-
-            mat->SetPbrMaterial(pbrMat);
-
-            materialIds[m.name] = mat;
-          }
-          int matIndex = mesh->IndexOfMaterial(mat);
-          if (matIndex < 0)
-            matIndex = mesh->AddMaterial(MaterialPtr(mat));
-          subMesh->SetMaterialIndex(matIndex);
+          subMesh->SetMaterialIndex(AddMaterial(materials[id], path,
+              exportedByBlender, materialIds, *mesh));
         }
         else
         {
@@ -253,3 +796,388 @@ Mesh *OBJLoader::Load(const std::string &_filename)
 
   return mesh;
 }
+
+//////////////////////////////////////////////////
+Mesh *OBJLoader::Implementation::LoadParallel(
+    const std::string &_filename) const
+{
+  MappedFile file(_filename);
+  if (!file.valid)
+  {
+    gzerr << "Cannot open file [" << _filename << "]" << std::endl;
+    gzerr << "Failed to load/parse " << _filename << std::endl;
+    return nullptr;
+  }
+  const std::string path = common::parentPath(_filename);
+  const char *data = file.data;
+  const char *dataEnd = file.data + file.size;
+
+  // check if obj is exported by blender
+  // blender shoves BR fields in standard textures
+  const char *firstLineEnd = static_cast<const char *>(
+      std::memchr(data, '\n', file.size));
+  const bool exportedByBlender = IsExportedByBlender(
+      std::string(data, firstLineEnd ? firstLineEnd : dataEnd));
+
+  // Split the file into ranges of whole lines, one per thread
+  const std::size_t workers = parallel::Concurrency();
+  const std::size_t chunkCount = std::max<std::size_t>(1u,
+      std::min(workers, file.size / kMinChunkSize));
+  std::vector<const char *> bounds(1u, data);
+  for (std::size_t c = 1u; c < chunkCount; ++c)
+  {
+    const char *target = std::max(bounds.back(), data + file.size * c /
+        chunkCount);
+    const char *newline = static_cast<const char *>(std::memchr(target, '\n',
+        static_cast<std::size_t>(dataEnd - target)));
+    bounds.push_back(newline ? newline + 1 : dataEnd);
+  }
+  bounds.push_back(dataEnd);
+
+  std::vector<Chunk> chunks(chunkCount);
+  auto forChunks = [&chunks](const auto &_func)
+  {
+    if (chunks.size() == 1u)
+    {
+      _func(0u);
+      return;
+    }
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks.size());
+    for (std::size_t c = 0u; c < chunks.size(); ++c)
+      tasks.push_back([&_func, c]() { _func(c); });
+    parallel::Run(tasks);
+  };
+  forChunks([&](std::size_t _c)
+      {
+        ParseChunk(bounds[_c], bounds[_c + 1u], chunks[_c]);
+      });
+
+  for (std::size_t c = 0u; c < chunks.size(); ++c)
+  {
+    if (chunks[c].errorLine != 0u)
+    {
+      const std::size_t line = chunks[c].errorLine +
+          static_cast<std::size_t>(std::count(data, bounds[c], '\n'));
+      gzerr << "Failed parse `f' line(e.g. zero value for face index. line "
+            << line << ".)" << std::endl;
+      gzerr << "Failed to load/parse " << _filename << std::endl;
+      return nullptr;
+    }
+  }
+
+  // Attributes of the whole file, and where each chunk's start
+  std::vector<tinyobj::real_t> positions;
+  std::vector<tinyobj::real_t> texCoords;
+  std::vector<tinyobj::real_t> normals;
+  std::vector<std::size_t> positionOffsets;
+  std::vector<std::size_t> texCoordOffsets;
+  std::vector<std::size_t> normalOffsets;
+  for (Chunk &chunk : chunks)
+  {
+    positionOffsets.push_back(positions.size() / 3u);
+    texCoordOffsets.push_back(texCoords.size() / 2u);
+    normalOffsets.push_back(normals.size() / 3u);
+    positions.insert(positions.end(), chunk.positions.begin(),
+        chunk.positions.end());
+    texCoords.insert(texCoords.end(), chunk.texCoords.begin(),
+        chunk.texCoords.end());
+    normals.insert(normals.end(), chunk.normals.begin(),
+        chunk.normals.end());
+    chunk.positions = {};
+    chunk.texCoords = {};
+    chunk.normals = {};
+  }
+
+  // Turn the corner indices into indices of the whole file. Indices out of
+  // range become -1, like missing ones.
+  forChunks([&](std::size_t _c)
+      {
+        auto resolve = [](int64_t &_index, std::size_t _offset,
+            std::size_t _count)
+        {
+          if (_index >= kRelative / 2)
+            _index += static_cast<int64_t>(_offset) - kRelative;
+          if (_index < 0 || _index >= static_cast<int64_t>(_count))
+            _index = -1;
+        };
+        for (CornerIndex &corner : chunks[_c].corners)
+        {
+          resolve(corner.v, positionOffsets[_c], positions.size() / 3u);
+          resolve(corner.vt, texCoordOffsets[_c], texCoords.size() / 2u);
+          resolve(corner.vn, normalOffsets[_c], normals.size() / 3u);
+        }
+      });
+
+  // Group the faces into shapes and materials like tinyobjloader does
+  std::string baseDir = path;
+#ifndef _WIN32
+  const char dirsep = '/';
+#else
+  const char dirsep = '\\';
+#endif
+  if (!baseDir.empty() && baseDir.back() != dirsep)
+    baseDir += dirsep;
+  tinyobj::MaterialFileReader readMaterials(baseDir);
+  std::vector<tinyobj::material_t> materials;
+  std::map<std::string, int> materialMap;
+  std::string warn;
+  std::string err;
+
+  std::vector<Shape> shapes(1u);
+  int material = -1;
+  for (std::size_t c = 0u; c < chunks.size(); ++c)
+  {
+    std::size_t faceBegin = 0u;
+    auto addFaces = [&](std::size_t _faceEnd)
+    {
+      if (_faceEnd > faceBegin)
+        shapes.back().segments.push_back({c, faceBegin, _faceEnd, material});
+      faceBegin = _faceEnd;
+    };
+
+    for (const Statement &statement : chunks[c].statements)
+    {
+      addFaces(statement.faceCount);
+      if (statement.kind == Statement::USEMTL)
+      {
+        auto it = materialMap.find(statement.name);
+        material = it == materialMap.end() ? -1 : it->second;
+      }
+      else if (statement.kind == Statement::MTLLIB)
+      {
+        // The first file that can be read is used
+        std::string_view names = statement.name;
+        bool found = false;
+        bool empty = true;
+        for (std::string_view name = NextToken(names);
+            !name.empty() && !found; name = NextToken(names))
+        {
+          empty = false;
+          found = readMaterials(std::string(name), &materials, &materialMap,
+              &warn, &err);
+        }
+        if (empty)
+          warn += "Looks like empty filename for mtllib. Use default "
+                  "material.\n";
+        else if (!found)
+          warn += "Failed to load material file(s). Use default material.\n";
+      }
+      else
+      {
+        // Groups and objects start a new shape
+        if (!shapes.back().segments.empty())
+          shapes.emplace_back();
+        shapes.back().name = statement.name;
+      }
+    }
+    addFaces(chunks[c].faceEnds.size());
+  }
+
+  if (!warn.empty())
+  {
+    gzwarn << warn << std::endl;
+  }
+
+  if (!err.empty())
+  {
+    gzerr << err << std::endl;
+  }
+
+  Mesh *mesh = new Mesh();
+  mesh->SetPath(path);
+
+  // obj mesh assigns a material id to each 'face' but Gazebo assigns a
+  // single material to each 'submesh', so each shape gets a submesh per
+  // material, in the order they appear
+  struct Job
+  {
+    const Shape *shape;
+    int material;
+    SubMesh *subMesh;
+    std::size_t cornerCount;
+  };
+  std::vector<Job> jobs;
+  std::size_t totalCorners = 0u;
+  std::map<std::string, Material *> materialIds;
+  for (const Shape &shape : shapes)
+  {
+    const std::size_t firstJob = jobs.size();
+    for (const Segment &segment : shape.segments)
+    {
+      const Chunk &chunk = chunks[segment.chunk];
+      const std::size_t cornerBegin = segment.faceBegin == 0u ? 0u :
+          chunk.faceEnds[segment.faceBegin - 1u];
+      const std::size_t cornerCount =
+          chunk.faceEnds[segment.faceEnd - 1u] - cornerBegin;
+      totalCorners += cornerCount;
+
+      auto job = std::find_if(jobs.begin() + firstJob, jobs.end(),
+          [&segment](const Job &_job)
+          {
+            return _job.material == segment.material;
+          });
+      if (job != jobs.end())
+      {
+        job->cornerCount += cornerCount;
+        continue;
+      }
+
+      // Faces with fewer than 3 corners are skipped, so a material only
+      // used by them gets no submesh
+      bool hasTriangle = false;
+      for (std::size_t f = segment.faceBegin;
+          f < segment.faceEnd && !hasTriangle; ++f)
+      {
+        const std::size_t begin = f == 0u ? 0u : chunk.faceEnds[f - 1u];
+        hasTriangle = chunk.faceEnds[f] - begin >= 3u;
+      }
+      if (!hasTriangle)
+        continue;
+
+      std::unique_ptr<SubMesh> subMesh(new SubMesh());
+      subMesh->SetName(shape.name);
+      subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
+      const int id = segment.material;
+      if (id >= 0 && static_cast<size_t>(id) < materials.size())
+      {
+        subMesh->SetMaterialIndex(AddMaterial(materials[id], path,
+            exportedByBlender, materialIds, *mesh));
+      }
+      else
+      {
+        gzwarn << "Missing material for shape[" << shape.name << "] "
+            << "in OBJ file[" << _filename << "]" << std::endl;
+      }
+      jobs.push_back({&shape, id, subMesh.get(), cornerCount});
+      mesh->AddSubMesh(std::move(subMesh));
+    }
+  }
+
+  // Fill the submeshes, merging corners with the same position, texture
+  // coordinate and normal indices into one vertex
+  const bool hasNormals = !normals.empty();
+  const bool hasTexCoords = !texCoords.empty();
+  std::atomic<std::size_t> invalidTriangles{0u};
+  auto fill = [&](const Job &_job)
+  {
+    SubMesh &subMesh = *_job.subMesh;
+    CornerTable vertexIndex(_job.cornerCount / 4u);
+    auto addCorner = [&](const CornerIndex &_c)
+    {
+      unsigned int index;
+      if (vertexIndex.Insert(_c, index))
+      {
+        const tinyobj::real_t *p = &positions[3u * _c.v];
+        subMesh.AddVertex(p[0], p[1], p[2]);
+        if (hasNormals)
+        {
+          math::Vector3d normal;
+          if (_c.vn >= 0)
+          {
+            const tinyobj::real_t *n = &normals[3u * _c.vn];
+            normal.Set(n[0], n[1], n[2]);
+            normal.Normalize();
+          }
+          subMesh.AddNormal(normal);
+        }
+        if (hasTexCoords)
+        {
+          math::Vector2d uv;
+          if (_c.vt >= 0)
+            uv.Set(texCoords[2u * _c.vt], texCoords[2u * _c.vt + 1u]);
+          subMesh.AddTexCoord(uv.X(), 1.0-uv.Y());
+        }
+      }
+      subMesh.AddIndex(index);
+    };
+    std::size_t invalid = 0u;
+    auto addTriangle = [&](const CornerIndex &_a, const CornerIndex &_b,
+        const CornerIndex &_c)
+    {
+      if (_a.v < 0 || _b.v < 0 || _c.v < 0)
+      {
+        ++invalid;
+        return;
+      }
+      addCorner(_a);
+      addCorner(_b);
+      addCorner(_c);
+    };
+
+    // Polygons are triangulated by tinyobjloader, one at a time
+    tinyobj::shape_t polygon;
+    std::vector<tinyobj::face_t> faces(1u);
+    std::vector<int> lines;
+    std::vector<tinyobj::tag_t> tags;
+    for (const Segment &segment : _job.shape->segments)
+    {
+      if (segment.material != _job.material)
+        continue;
+      const Chunk &chunk = chunks[segment.chunk];
+      for (std::size_t f = segment.faceBegin; f < segment.faceEnd; ++f)
+      {
+        const std::size_t begin = f == 0u ? 0u : chunk.faceEnds[f - 1u];
+        const std::size_t count = chunk.faceEnds[f] - begin;
+        const CornerIndex *corners = &chunk.corners[begin];
+        if (count == 3u)
+        {
+          addTriangle(corners[0], corners[1], corners[2]);
+          continue;
+        }
+        if (count < 3u)
+          continue;
+        if (count == 4u && FirstCornerIsEar(positions, corners))
+        {
+          addTriangle(corners[0], corners[1], corners[2]);
+          addTriangle(corners[0], corners[2], corners[3]);
+          continue;
+        }
+
+        faces[0].vertex_indices.clear();
+        for (std::size_t k = 0u; k < count; ++k)
+        {
+          faces[0].vertex_indices.emplace_back(static_cast<int>(corners[k].v),
+              static_cast<int>(corners[k].vt),
+              static_cast<int>(corners[k].vn));
+        }
+        polygon.mesh = tinyobj::mesh_t();
+        tinyobj::exportGroupsToShape(&polygon, faces, lines, tags,
+            _job.material, "", true, positions);
+        const auto &indices = polygon.mesh.indices;
+        for (std::size_t k = 0u; k + 2u < indices.size(); k += 3u)
+        {
+          auto corner = [&indices](std::size_t _k)
+          {
+            return CornerIndex{indices[_k].vertex_index,
+                indices[_k].texcoord_index, indices[_k].normal_index};
+          };
+          addTriangle(corner(k), corner(k + 1u), corner(k + 2u));
+        }
+      }
+    }
+    invalidTriangles += invalid;
+  };
+
+  if (jobs.size() > 1u && totalCorners >= kParallelCorners)
+  {
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(jobs.size());
+    for (const Job &job : jobs)
+      tasks.push_back([&fill, &job]() { fill(job); });
+    parallel::Run(tasks);
+  }
+  else
+  {
+    for (const Job &job : jobs)
+      fill(job);
+  }
+
+  if (invalidTriangles > 0u)
+  {
+    gzwarn << "Skipped " << invalidTriangles << " triangles with invalid "
+           << "vertex indices in OBJ file[" << _filename << "]" << std::endl;
+  }
+
+  return mesh;
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gz/common/Mesh.hh"
+#include "gz/common/OBJLoader.hh"
+#include "gz/common/SubMesh.hh"
+#include "gz/common/TempDirectory.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+class OBJLoaderTest : public common::testing::AutoLogFixture
+{
+  protected: void SetUp() override
+  {
+    common::testing::AutoLogFixture::SetUp();
+    this->temp = std::make_unique<TempDirectory>(
+        "obj_loader", "gz_common", true);
+    ASSERT_TRUE(this->temp->Valid());
+  }
+
+  /// \brief Write a file
+  /// \param[in] _name Name of the file in the temporary directory
+  /// \param[in] _content Content of the file
+  /// \return Path of the file
+  protected: std::string Write(const std::string &_name,
+                 const std::string &_content)
+  {
+    const std::string path =
+        (std::filesystem::path(this->temp->Path()) / _name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << _content;
+    return path;
+  }
+
+  /// \brief Temporary directory of the files
+  protected: std::unique_ptr<TempDirectory> temp;
+};
+
+/////////////////////////////////////////////////
+/// \brief Check that two meshes have the same submeshes, materials and
+/// triangles, regardless of how vertices are shared
+/// \param[in] _expected Mesh loaded with tinyobjloader
+/// \param[in] _actual Mesh loaded with the parallel parser
+static void ExpectSameMesh(const Mesh &_expected, const Mesh &_actual)
+{
+  ASSERT_EQ(_expected.SubMeshCount(), _actual.SubMeshCount());
+  ASSERT_EQ(_expected.MaterialCount(), _actual.MaterialCount());
+  for (unsigned int s = 0u; s < _expected.SubMeshCount(); ++s)
+  {
+    auto expected = _expected.SubMeshByIndex(s).lock();
+    auto actual = _actual.SubMeshByIndex(s).lock();
+    EXPECT_EQ(expected->Name(), actual->Name());
+    EXPECT_EQ(expected->GetMaterialIndex(), actual->GetMaterialIndex());
+    EXPECT_EQ(expected->NormalCount() > 0u, actual->NormalCount() > 0u);
+    EXPECT_EQ(expected->TexCoordCount() > 0u, actual->TexCoordCount() > 0u);
+    ASSERT_EQ(expected->IndexCount(), actual->IndexCount());
+    for (unsigned int i = 0u; i < expected->IndexCount(); ++i)
+    {
+      const unsigned int e = static_cast<unsigned int>(expected->Index(i));
+      const unsigned int a = static_cast<unsigned int>(actual->Index(i));
+      ASSERT_EQ(expected->Vertex(e), actual->Vertex(a)) << s << " " << i;
+      if (expected->NormalCount() > 0u)
+      {
+        ASSERT_EQ(expected->Normal(e), actual->Normal(a)) << s << " " << i;
+      }
+      if (expected->TexCoordCount() > 0u)
+      {
+        ASSERT_EQ(expected->TexCoord(e), actual->TexCoord(a))
+            << s << " " << i;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, ParallelParsing)
+{
+  common::OBJLoader loader;
+  EXPECT_FALSE(loader.ParallelParsing());
+
+  for (const std::string file :
+      {"box.obj", "cube_pbr.obj", "blender_pbr.obj", "invalid_material.obj"})
+  {
+    const std::string path = common::testing::TestFile("data", file);
+    loader.SetParallelParsing(false);
+    std::unique_ptr<Mesh> expected(loader.Load(path));
+    loader.SetParallelParsing(true);
+    EXPECT_TRUE(loader.ParallelParsing());
+    std::unique_ptr<Mesh> actual(loader.Load(path));
+    ASSERT_NE(nullptr, expected) << file;
+    ASSERT_NE(nullptr, actual) << file;
+    SCOPED_TRACE(file);
+    ExpectSameMesh(*expected, *actual);
+    EXPECT_LE(actual->VertexCount(), expected->VertexCount());
+  }
+
+  // Each face of the box has its own normal, so the 8 corners of the box
+  // become 24 vertices instead of one per face corner
+  std::unique_ptr<Mesh> box(loader.Load(
+      common::testing::TestFile("data", "box.obj")));
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(36u, box->IndexCount());
+  EXPECT_EQ(24u, box->VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, Statements)
+{
+  // Relative indices, polygons, groups, objects and material changes.
+  // Every corner has a texture coordinate and a normal, because
+  // tinyobjloader reads out of bounds otherwise.
+  const std::string mtl = this->Write("colors.mtl",
+      "newmtl red\nKd 1 0 0\n\nnewmtl green\nKd 0 1 0\n");
+  const std::string path = this->Write("statements.obj",
+      "# comment\r\n"
+      "mtllib colors.mtl\r\n"
+      "v 0 0 0\r\n"
+      "v 1 0 0\r\n"
+      "v 1 1 0\r\n"
+      "v 0 1 0\r\n"
+      "v 0.5 1.5 0\r\n"
+      "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+      "vn 0 0 2\n"
+      "g first part\n"
+      "usemtl red\n"
+      "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+      "usemtl green\n"
+      "f -5/-4/-1 -4/-3/-1 -3/-2/-1\n"
+      "usemtl red\n"
+      "f 4/4/1 3/3/1 5/3/1\n"
+      "o second\n"
+      "usemtl unknown\n"
+      "f 1/1/1 2/2/1 3/3/1 5/3/1 4/4/1\n"
+      "f 1/1/1 2/2/1\n");
+  common::OBJLoader loader;
+  loader.SetParallelParsing(false);
+  std::unique_ptr<Mesh> expected(loader.Load(path));
+  loader.SetParallelParsing(true);
+  std::unique_ptr<Mesh> actual(loader.Load(path));
+  ASSERT_NE(nullptr, expected);
+  ASSERT_NE(nullptr, actual);
+  ExpectSameMesh(*expected, *actual);
+
+  ASSERT_EQ(3u, actual->SubMeshCount());
+  EXPECT_EQ(2u, actual->MaterialCount());
+  auto red = actual->SubMeshByIndex(0u).lock();
+  EXPECT_EQ("first part", red->Name());
+  EXPECT_EQ(9u, red->IndexCount());
+  // The two triangles of the quad and the last triangle share corners
+  EXPECT_EQ(5u, red->VertexCount());
+  EXPECT_EQ(math::Vector3d(0, 0, 1), red->Normal(0u));
+  EXPECT_EQ("second", actual->SubMeshByIndex(2u).lock()->Name());
+  EXPECT_FALSE(actual->SubMeshByIndex(2u).lock()->GetMaterialIndex());
+  EXPECT_EQ(9u, actual->SubMeshByIndex(2u).lock()->IndexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, Large)
+{
+  // Enough text to be parsed in several chunks
+  const int side = 300;
+  std::ostringstream obj;
+  obj << "o grid\n";
+  for (int y = 0; y < side; ++y)
+  {
+    for (int x = 0; x < side; ++x)
+      obj << "v " << x * 0.01 << " " << y * 0.01 << " 0.125\n";
+  }
+  obj << "vn 0 0 1\n";
+  for (int y = 0; y + 1 < side; ++y)
+  {
+    for (int x = 0; x + 1 < side; ++x)
+    {
+      const int i = y * side + x + 1;
+      obj << "f " << i << "//1 " << i + 1 << "//1 " << i + side + 1 << "//1 "
+          << i + side << "//1\n";
+    }
+  }
+  const std::string path = this->Write("grid.obj", obj.str());
+
+  common::OBJLoader loader;
+  std::unique_ptr<Mesh> expected(loader.Load(path));
+  loader.SetParallelParsing(true);
+  std::unique_ptr<Mesh> actual(loader.Load(path));
+  ASSERT_NE(nullptr, expected);
+  ASSERT_NE(nullptr, actual);
+  ExpectSameMesh(*expected, *actual);
+  EXPECT_EQ(static_cast<unsigned int>(side * side), actual->VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, Invalid)
+{
+  common::OBJLoader loader;
+  loader.SetParallelParsing(true);
+  EXPECT_EQ(nullptr, loader.Load(
+      this->Write("zero.obj", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 0 1 2\n")));
+  EXPECT_EQ(nullptr, loader.Load(
+      (std::filesystem::path(this->temp->Path()) / "missing.obj").string()));
+
+  // Faces that use missing vertices are skipped
+  std::unique_ptr<Mesh> mesh(loader.Load(this->Write("range.obj",
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\nf 1 2 4\n")));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(3u, mesh->IndexCount());
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "gz/common/WorkerPool.hh"
+
+#include "Parallel.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief True on the threads of the pool
+thread_local bool tlsOnPool = false;
+
+/// \brief Get the shared pool
+/// \return The pool, created on first use
+WorkerPool &Pool()
+{
+  static WorkerPool pool;
+  return pool;
+}
+
+/// \brief Add a task to the pool, marking the thread that runs it
+/// \param[in] _task Task to run
+void Submit(std::function<void()> _task)
+{
+  Pool().AddWork([task = std::move(_task)]()
+      {
+        tlsOnPool = true;
+        task();
+      });
+}
+
+/// \brief Tasks of one call to Run, claimed in order by the calling
+/// thread and the pool
+struct Batch
+{
+  /// \brief Tasks to run, only read while some are unclaimed
+  const std::vector<std::function<void()>> *tasks = nullptr;
+
+  /// \brief Number of tasks
+  std::size_t count = 0u;
+
+  /// \brief Index of the next task to claim
+  std::atomic<std::size_t> next{0u};
+
+  /// \brief Number of tasks that finished
+  std::size_t finished = 0u;
+
+  /// \brief First exception thrown by a task
+  std::exception_ptr error;
+
+  /// \brief Mutex to protect finished and error
+  std::mutex mutex;
+
+  /// \brief Signaled when all the tasks finished
+  std::condition_variable done;
+};
+
+/// \brief Claim and run tasks of a batch until none are left
+/// \param[in] _batch The batch
+void Drain(Batch &_batch)
+{
+  for (std::size_t i = _batch.next++; i < _batch.count; i = _batch.next++)
+  {
+    std::exception_ptr error;
+    try
+    {
+      (*_batch.tasks)[i]();
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    // Notify with the lock held, the waiter owns the condition
+    std::lock_guard<std::mutex> lock(_batch.mutex);
+    if (error && !_batch.error)
+      _batch.error = error;
+    if (++_batch.finished == _batch.count)
+      _batch.done.notify_all();
+  }
+}
+}
+
+//////////////////////////////////////////////////
+std::size_t parallel::Concurrency()
+{
+  if (tlsOnPool)
+    return 1u;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//////////////////////////////////////////////////
+bool parallel::OnPoolThread()
+{
+  return tlsOnPool;
+}
+
+//////////////////////////////////////////////////
+void parallel::Run(const std::vector<std::function<void()>> &_tasks)
+{
+  if (_tasks.empty())
+    return;
+
+  // WorkerPool::WaitForResults waits for all the work of the pool, so
+  // every call counts its own tasks. The calling thread runs the tasks the
+  // pool has not started: threads of the pool may be blocked waiting for
+  // this one, and would never get to them. Threads of the pool run all
+  // the tasks of their calls themselves.
+  auto batch = std::make_shared<Batch>();
+  batch->tasks = &_tasks;
+  batch->count = _tasks.size();
+  if (!tlsOnPool)
+  {
+    for (std::size_t i = 1u; i < _tasks.size(); ++i)
+      Submit([batch]() { Drain(*batch); });
+  }
+
+  Drain(*batch);
+  {
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done.wait(lock,
+        [&batch]() { return batch->finished == batch->count; });
+  }
+  if (batch->error)
+    std::rethrow_exception(batch->error);
+}
+
+//////////////////////////////////////////////////
+void parallel::Post(std::function<void()> _task)
+{
+  Submit(std::move(_task));
+}
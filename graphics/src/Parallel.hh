@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_PARALLEL_HH_
+#define GZ_COMMON_PARALLEL_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "gz/common/graphics/Export.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Work shared by the loaders, the mesh manager and the image
+    /// kernels on one worker pool, created on first use with a thread per
+    /// core. Work started from a thread of the pool runs on that thread, so
+    /// nested calls neither add threads nor wait on each other.
+    namespace parallel
+    {
+      /// \brief Get the number of threads work can be split over.
+      /// \return The number of threads of the pool, or 1 when called from a
+      /// thread of the pool.
+      GZ_COMMON_GRAPHICS_VISIBLE std::size_t Concurrency();
+
+      /// \brief Check if the calling thread is a thread of the pool.
+      /// \return True on a thread of the pool.
+      GZ_COMMON_GRAPHICS_VISIBLE bool OnPoolThread();
+
+      /// \brief Run tasks and wait for them to finish. The calling thread
+      /// and the pool take the tasks in order, the calling thread only
+      /// waits once none are left to start, so it never waits for a pool
+      /// that is blocked. If the calling thread is a thread of the pool,
+      /// all of the tasks run on it in order. Every task runs even if
+      /// others throw, the first exception is rethrown once all of them
+      /// finished.
+      /// \param[in] _tasks Tasks to run.
+      GZ_COMMON_GRAPHICS_VISIBLE void Run(
+          const std::vector<std::function<void()>> &_tasks);
+
+      /// \brief Run a task on the pool without waiting for it.
+      /// \param[in] _task Task to run.
+      GZ_COMMON_GRAPHICS_VISIBLE void Post(std::function<void()> _task);
+
+      /// \brief Run a function over [0, _count) in one range per thread,
+      /// or in a single range on the calling thread if _count is below
+      /// _minCount.
+      /// \param[in] _count Number of items.
+      /// \param[in] _minCount Number of items from which the work is split.
+      /// \param[in] _func Function called with the first and last item of
+      /// each range.
+      template <typename Func>
+      void ForRanges(std::size_t _count, std::size_t _minCount,
+          const Func &_func)
+      {
+        const std::size_t threads =
+            _count < _minCount || _count < 2u ? 1u : Concurrency();
+        if (threads == 1u)
+        {
+          _func(std::size_t{0u}, _count);
+          return;
+        }
+
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(threads);
+        const std::size_t step = (_count + threads - 1u) / threads;
+        for (std::size_t begin = 0u; begin < _count; begin += step)
+        {
+          const std::size_t end = std::min(_count, begin + step);
+          tasks.push_back([&_func, begin, end]() { _func(begin, end); });
+        }
+        Run(tasks);
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "Parallel.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+using namespace common;
+
+class Parallel : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(Parallel, ForRanges)
+{
+  for (const std::size_t count : {0u, 1u, 7u, 1000u, 100000u})
+  {
+    std::vector<int> visits(count, 0);
+    parallel::ForRanges(count, 100u,
+        [&visits](std::size_t _begin, std::size_t _end)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+            ++visits[i];
+        });
+    EXPECT_EQ(std::vector<int>(count, 1), visits) << count;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(Parallel, Run)
+{
+  EXPECT_FALSE(parallel::OnPoolThread());
+  EXPECT_GE(parallel::Concurrency(), 1u);
+
+  std::atomic<int> sum{0};
+  std::vector<std::function<void()>> tasks;
+  for (int i = 1; i <= 64; ++i)
+    tasks.push_back([&sum, i]() { sum += i; });
+  parallel::Run(tasks);
+  EXPECT_EQ(64 * 65 / 2, sum.load());
+  parallel::Run({});
+}
+
+/////////////////////////////////////////////////
+TEST_F(Parallel, Nested)
+{
+  // Work started from the pool runs on the calling thread, so tasks that
+  // split their own work do not wait on each other
+  std::promise<bool> done;
+  std::future<bool> result = done.get_future();
+  parallel::Post([&done]()
+      {
+        bool ok = parallel::OnPoolThread() &&
+            parallel::Concurrency() == 1u;
+        std::atomic<int> count{0};
+        std::vector<std::function<void()>> tasks(16, [&count]()
+            {
+              parallel::ForRanges(1000u, 1u,
+                  [&count](std::size_t _begin, std::size_t _end)
+                  {
+                    count += static_cast<int>(_end - _begin);
+                  });
+            });
+        parallel::Run(tasks);
+        done.set_value(ok && count == 16000);
+      });
+  EXPECT_TRUE(result.get());
+
+  std::atomic<int> count{0};
+  std::vector<std::function<void()>> tasks(8, [&count]()
+      {
+        std::vector<std::function<void()>> inner(8, [&count]() { ++count; });
+        parallel::Run(inner);
+      });
+  parallel::Run(tasks);
+  EXPECT_EQ(64, count.load());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Parallel, BlockedPool)
+{
+  // Every thread of the pool waits for the first task, which splits its
+  // own work. The calling thread runs the split work the pool can not.
+  std::promise<void> ready;
+  std::shared_future<void> readyResult = ready.get_future().share();
+  std::atomic<int> count{0};
+  std::vector<std::function<void()>> tasks;
+  tasks.push_back([&ready, &count]()
+      {
+        std::vector<std::function<void()>> inner(8, [&count]() { ++count; });
+        parallel::Run(inner);
+        ready.set_value();
+      });
+  for (std::size_t i = 0u; i < parallel::Concurrency(); ++i)
+    tasks.push_back([readyResult]() { readyResult.wait(); });
+  parallel::Run(tasks);
+  EXPECT_EQ(8, count.load());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Parallel, Exceptions)
+{
+  // Every task runs, and the first exception is rethrown once they are
+  // done, on the calling thread or on a thread of the pool
+  for (const bool onPool : {false, true})
+  {
+    std::promise<bool> done;
+    std::future<bool> result = done.get_future();
+    auto check = [&done]()
+    {
+      std::atomic<int> count{0};
+      std::vector<std::function<void()>> tasks(32, [&count]() { ++count; });
+      tasks[0] = []() { throw std::runtime_error("first"); };
+      tasks[7] = []() { throw std::runtime_error("other"); };
+      bool thrown = false;
+      try
+      {
+        parallel::Run(tasks);
+      }
+      catch (const std::runtime_error &)
+      {
+        thrown = true;
+      }
+      done.set_value(thrown && count == 30);
+    };
+    if (onPool)
+      parallel::Post(check);
+    else
+      check();
+    EXPECT_TRUE(result.get()) << onPool;
+  }
+}
@@ -0,0 +1,1146 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "MeshKernels.hh"
+#include "Parallel.hh"
+#include "PixelKernels.hh"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GZ_PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define GZ_PIXEL_KERNELS_SSSE3
+#define GZ_PIXEL_KERNELS_AVX2
+#else
+#define GZ_PIXEL_KERNELS_SSSE3 __attribute__((target("ssse3")))
+#define GZ_PIXEL_KERNELS_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief Number of pixels from which kernels run on several threads
+constexpr std::size_t kParallelPixels = 1u << 20;
+
+/// \brief Run a function over [0, _count) in ranges, on the shared pool
+/// if there are many pixels
+/// \param[in] _count Number of items, pixels or rows
+/// \param[in] _func Function called with the first and last item of each
+/// range
+/// \param[in] _itemPixels Number of pixels in an item
+template <typename Func>
+void ForRanges(std::size_t _count, const Func &_func,
+    std::size_t _itemPixels = 1u)
+{
+  parallel::ForRanges(_count,
+      (kParallelPixels + _itemPixels - 1u) / std::max<std::size_t>(
+          _itemPixels, 1u), _func);
+}
+
+/// \brief Source channel of every converted channel, -1 for opaque alpha,
+/// for the conversions that only move channels
+/// \param[in] _srcChannels Channels of a source pixel
+/// \param[in] _dstChannels Channels of a converted pixel
+/// \return One source channel per converted channel, nullptr for the
+/// conversions that compute a luminance
+const int *ChannelMap(unsigned int _srcChannels, unsigned int _dstChannels)
+{
+  static const int kGrayAlpha[] = {0, -1};
+  static const int kGray[] = {0, 0, 0, -1};
+  static const int kGrayWithAlpha[] = {0, 0, 0, 1};
+  static const int kColor[] = {0, 1, 2, -1};
+  switch (_srcChannels * 8 + _dstChannels)
+  {
+    case 1 * 8 + 2:
+      return kGrayAlpha;
+    case 1 * 8 + 3:
+    case 1 * 8 + 4:
+    case 2 * 8 + 1:
+    case 2 * 8 + 3:
+      return kGray;
+    case 2 * 8 + 4:
+      return kGrayWithAlpha;
+    case 3 * 8 + 4:
+    case 4 * 8 + 3:
+      return kColor;
+    default:
+      return nullptr;
+  }
+}
+
+//////////////////////////////////////////////////
+// Scalar kernels
+
+/// \brief Compute the luminance of an RGB triple, matching stbi__compute_y so
+/// that channel reductions stay bit-identical to stb_image.
+/// \tparam T Sample type (unsigned char for 8-bit, uint16_t for 16-bit).
+/// \param[in] _r Red component.
+/// \param[in] _g Green component.
+/// \param[in] _b Blue component.
+/// \return The computed luminance as type T.
+template <typename T>
+inline T ComputeLuminance(int _r, int _g, int _b)
+{
+  return static_cast<T>(((_r * 77) + (_g * 150) + (29 * _b)) >> 8);
+}
+
+/// \brief Compute the luminance of a float RGB triple, with the weights of
+/// the integer version
+/// \param[in] _r Red component.
+/// \param[in] _g Green component.
+/// \param[in] _b Blue component.
+/// \return The computed luminance.
+template <typename T>
+inline T ComputeLuminance(float _r, float _g, float _b)
+{
+  return (_r * 77.0f + _g * 150.0f + _b * 29.0f) / 256.0f;
+}
+
+/// \brief Convert pixel data from _inCh to _outCh channels in a single pass.
+/// _src is never modified or freed. This mirrors stbi__convert_format /
+/// stbi__convert_format16 byte-for-byte, but avoids the clone-input +
+/// copy-output overhead those functions impose (they free their input, so the
+/// caller previously had to duplicate the bitmap and then copy the result into
+/// the returned vector).
+/// \tparam T Sample type (unsigned char, uint16_t or float).
+/// \param[in] _src Source pixels (_npix * _inCh samples).
+/// \param[in] _inCh Number of channels in the source.
+/// \param[out] _dst Destination buffer (_npix * _outCh samples).
+/// \param[in] _outCh Number of channels to write.
+/// \param[in] _npix Number of pixels to convert.
+/// \param[in] _aMax Opaque alpha to insert (255 for 8-bit, 0xffff for 16-bit).
+/// \return False if the channel combination is unsupported.
+template <typename T>
+bool ConvertChannelsScalar(const T *_src, int _inCh, T *_dst, int _outCh,
+    std::size_t _npix, T _aMax)
+{
+  // Pack the (input, output) channel counts into one integer, _inCh * 8 +
+  // _outCh, so each supported combination maps to a unique case and can be
+  // dispatched by a single switch (mirrors stb_image's STBI__COMBO macro).
+  switch (_inCh * 8 + _outCh)
+  {
+    case 1 * 8 + 2:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 2)
+      {
+        _dst[0] = _src[0];
+        _dst[1] = _aMax;
+      }
+      break;
+    case 1 * 8 + 3:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 3)
+      {
+        _dst[0] = _dst[1] = _dst[2] = _src[0];
+      }
+      break;
+    case 1 * 8 + 4:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 1, _dst += 4)
+      {
+        _dst[0] = _dst[1] = _dst[2] = _src[0];
+        _dst[3] = _aMax;
+      }
+      break;
+    case 2 * 8 + 1:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 1)
+      {
+        _dst[0] = _src[0];
+      }
+      break;
+    case 2 * 8 + 3:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 3)
+      {
+        _dst[0] = _dst[1] = _dst[2] = _src[0];
+      }
+      break;
+    case 2 * 8 + 4:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 2, _dst += 4)
+      {
+        _dst[0] = _dst[1] = _dst[2] = _src[0];
+        _dst[3] = _src[1];
+      }
+      break;
+    case 3 * 8 + 4:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 4)
+      {
+        _dst[0] = _src[0];
+        _dst[1] = _src[1];
+        _dst[2] = _src[2];
+        _dst[3] = _aMax;
+      }
+      break;
+    case 3 * 8 + 1:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 1)
+      {
+        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
+      }
+      break;
+    case 3 * 8 + 2:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 3, _dst += 2)
+      {
+        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
+        _dst[1] = _aMax;
+      }
+      break;
+    case 4 * 8 + 1:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 1)
+      {
+        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
+      }
+      break;
+    case 4 * 8 + 2:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 2)
+      {
+        _dst[0] = ComputeLuminance<T>(_src[0], _src[1], _src[2]);
+        _dst[1] = _src[3];
+      }
+      break;
+    case 4 * 8 + 3:
+      for (std::size_t p = 0; p < _npix; ++p, _src += 4, _dst += 3)
+      {
+        _dst[0] = _src[0];
+        _dst[1] = _src[1];
+        _dst[2] = _src[2];
+      }
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+/// \brief Convert a channel value to 8 bits
+/// \param[in] _value 8 bit value
+/// \return _value
+inline uint8_t ToByte(uint8_t _value)
+{
+  return _value;
+}
+
+/// \brief Convert a channel value to 8 bits
+/// \param[in] _value 16 bit value
+/// \return The 8 most significant bits
+inline uint8_t ToByte(uint16_t _value)
+{
+  return static_cast<uint8_t>(_value >> 8);
+}
+
+/// \brief Convert a channel value to 8 bits
+/// \param[in] _value Value in [0, 1]
+/// \return _value scaled to [0, 255] and truncated
+inline uint8_t ToByte(float _value)
+{
+  return static_cast<unsigned char>(_value * 255.0f);
+}
+
+/// \brief Copy one channel of pixels, converted to 8 bits
+/// \param[in] _src Pixels
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _channel Channel to copy
+/// \param[out] _dst One value per pixel
+/// \param[in] _count Number of pixels
+template <typename T>
+void ExtractChannelScalar(const T *_src, unsigned int _channels,
+    unsigned int _channel, uint8_t *_dst, std::size_t _count)
+{
+  _src += _channel;
+  for (std::size_t i = 0; i < _count; ++i, _src += _channels)
+    _dst[i] = ToByte(*_src);
+}
+
+/// \brief Swap the first and third channels of pixels
+/// \param[in,out] _pixels Pixels
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _count Number of pixels
+void SwapRedBlueScalar(uint8_t *_pixels, unsigned int _channels,
+    std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i, _pixels += _channels)
+    std::swap(_pixels[0], _pixels[2]);
+}
+
+/// \brief Scale an 8 bit channel to [0, 1] like Image::Pixel does
+/// \param[in] _value Channel value
+/// \return Scaled value
+inline float Unit(uint8_t _value)
+{
+  return static_cast<float>(_value) / 255.0f;
+}
+
+/// \brief Scale a 16 bit channel to [0, 1] like Image::Pixel does
+/// \param[in] _value Channel value
+/// \return Scaled value
+inline float Unit(uint16_t _value)
+{
+  return static_cast<float>(_value) / 65535.0f;
+}
+
+/// \brief Compute the brightness of a pixel, with the float additions of
+/// Image::MaxColor
+/// \param[in] _pixel The pixel
+/// \param[in] _channels Channels of the pixel
+/// \return Sum of red, green and blue scaled to [0, 1]
+template <typename T>
+inline float Brightness(const T *_pixel, unsigned int _channels)
+{
+  if (_channels < 3u)
+  {
+    const float gray = Unit(_pixel[0]);
+    return gray + gray + gray;
+  }
+  return Unit(_pixel[0]) + Unit(_pixel[1]) + Unit(_pixel[2]);
+}
+
+/// \brief Best pixel of a search
+struct Candidate
+{
+  /// \brief Brightness of the pixel
+  float key = 0.0f;
+
+  /// \brief Column of the pixel, like Image::Pixel
+  unsigned int x = 0u;
+
+  /// \brief Row of the pixel, like Image::Pixel
+  unsigned int y = 0u;
+
+  /// \brief True if a pixel was found
+  bool found = false;
+};
+
+/// \brief Check if a pixel is better than the best one found before it
+/// \param[in] _key Brightness of the pixel
+/// \param[in] _best Brightness of the best pixel
+/// \return True if the pixel is better
+template <bool Darkest>
+inline bool Better(float _key, float _best)
+{
+  return Darkest ? _key < _best : _key > _best;
+}
+
+/// \brief Get the number of pixels read along a side of a grid
+/// \param[in] _size Number of pixels along the side
+/// \param[in] _stride Distance between two read pixels
+/// \return Number of read pixels
+inline unsigned int Samples(unsigned int _size, unsigned int _stride)
+{
+  return _size / _stride + (_size % _stride != 0u ? 1u : 0u);
+}
+
+/// \brief Get a read row of a grid
+/// \param[in] _grid The grid
+/// \param[in] _row Index of the read row, counted from the bottom
+/// \return First byte of the row
+inline const uint8_t *GridRow(const pixelkernels::Grid &_grid,
+    std::size_t _row)
+{
+  return _grid.data + (_grid.height - 1u - _row * _grid.stride) *
+      _grid.pitch;
+}
+
+/// \brief Sum the channels of the read pixels of a row
+/// \param[in] _row First pixel of the row
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _stride Distance between two read pixels
+/// \param[in] _begin First read pixel to sum
+/// \param[in] _columns Number of read pixels in the row
+/// \param[in,out] _sums Sums of the channels
+template <typename T>
+void SumRowScalar(const T *_row, unsigned int _channels,
+    unsigned int _stride, std::size_t _begin, std::size_t _columns,
+    uint64_t _sums[4])
+{
+  uint64_t sums[4] = {0u, 0u, 0u, 0u};
+  const std::size_t step = static_cast<std::size_t>(_stride) * _channels;
+  const T *pixel = _row + _begin * step;
+  for (std::size_t i = _begin; i < _columns; ++i, pixel += step)
+  {
+    for (unsigned int c = 0u; c < _channels; ++c)
+      sums[c] += pixel[c];
+  }
+  for (unsigned int c = 0u; c < 4u; ++c)
+    _sums[c] += sums[c];
+}
+
+/// \brief Search the read pixels of a row, in the order of Image::MaxColor
+/// \param[in] _row First pixel of the row
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _stride Distance between two read pixels
+/// \param[in] _begin First read pixel to search
+/// \param[in] _columns Number of read pixels in the row
+/// \param[in] _y Row, like Image::Pixel
+/// \param[in,out] _best Best pixel found so far
+template <typename T, bool Darkest>
+void ScanRowScalar(const T *_row, unsigned int _channels,
+    unsigned int _stride, unsigned int _begin, unsigned int _columns,
+    unsigned int _y, Candidate &_best)
+{
+  const std::size_t step = static_cast<std::size_t>(_stride) * _channels;
+  const T *pixel = _row + _begin * step;
+  for (unsigned int i = _begin; i < _columns; ++i, pixel += step)
+  {
+    const float key = Brightness(pixel, _channels);
+    if (Better<Darkest>(key, _best.key))
+      _best = {key, i * _stride, _y, true};
+  }
+}
+
+/// \brief Count the values of one channel of the read pixels of a row
+/// \param[in] _row Channel of the first pixel of the row
+/// \param[in] _step Distance between two read values
+/// \param[in] _columns Number of read pixels in the row
+/// \param[in] _bins Number of bins
+/// \param[in,out] _tables Four tables of _bins counts, used in turn so
+/// that runs of equal values do not wait on one counter
+template <typename T>
+void HistogramRowScalar(const T *_row, std::size_t _step,
+    unsigned int _columns, std::size_t _bins, std::size_t *_tables)
+{
+  for (unsigned int i = 0u; i < _columns; ++i, _row += _step)
+  {
+    const std::size_t bin = static_cast<std::size_t>(
+        (static_cast<uint64_t>(*_row) * _bins) >> (8u * sizeof(T)));
+    ++_tables[(i & 3u) * _bins + bin];
+  }
+}
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+//////////////////////////////////////////////////
+// SSSE3 and AVX2 kernels
+
+/// \brief Byte shuffle that converts a group of pixels held in 16 bytes
+struct Shuffle
+{
+  /// \brief Source byte of every converted byte, 0x80 for a byte of fill
+  alignas(16) uint8_t mask[16];
+
+  /// \brief Bytes of opaque alpha, 0 elsewhere
+  alignas(16) uint8_t fill[16];
+
+  /// \brief Number of pixels in a group
+  std::size_t pixels = 0u;
+
+  /// \brief Size of a group in the source
+  std::size_t srcBytes = 0u;
+
+  /// \brief Size of a group once converted
+  std::size_t dstBytes = 0u;
+};
+
+/// \brief Build the shuffle of a conversion that moves channels
+/// \param[in] _size Size of a channel in bytes
+/// \param[in] _srcChannels Channels of a source pixel
+/// \param[in] _dstChannels Channels of a converted pixel
+/// \param[in] _map Source channel of every converted channel, -1 for alpha
+/// \param[in] _alpha Opaque alpha, _size bytes
+/// \param[in] _inPlace True if the source is overwritten, in which case the
+/// bytes past the group are written back unchanged
+/// \return The shuffle
+Shuffle MakeShuffle(std::size_t _size, unsigned int _srcChannels,
+    unsigned int _dstChannels, const int *_map, const uint8_t *_alpha,
+    bool _inPlace)
+{
+  Shuffle shuffle;
+  shuffle.pixels = std::min(16u / (_srcChannels * _size),
+      16u / (_dstChannels * _size));
+  shuffle.srcBytes = shuffle.pixels * _srcChannels * _size;
+  shuffle.dstBytes = shuffle.pixels * _dstChannels * _size;
+  for (std::size_t i = 0u; i < 16u; ++i)
+  {
+    shuffle.mask[i] = _inPlace ? static_cast<uint8_t>(i) : 0x80u;
+    shuffle.fill[i] = 0u;
+  }
+  for (std::size_t p = 0u; p < shuffle.pixels; ++p)
+  {
+    for (unsigned int c = 0u; c < _dstChannels; ++c)
+    {
+      for (std::size_t k = 0u; k < _size; ++k)
+      {
+        const std::size_t i = (p * _dstChannels + c) * _size + k;
+        if (_map[c] < 0)
+        {
+          shuffle.mask[i] = 0x80u;
+          shuffle.fill[i] = _alpha[k];
+        }
+        else
+        {
+          shuffle.mask[i] = static_cast<uint8_t>(
+              (p * _srcChannels + _map[c]) * _size + k);
+        }
+      }
+    }
+  }
+  return shuffle;
+}
+
+/// \brief Convert groups of pixels with a byte shuffle, one group at a
+/// time, while 16 bytes can be read and written. Every group stores 16
+/// bytes; the bytes past its end are overwritten by the next group, or
+/// written back unchanged by an in-place shuffle.
+/// \param[in] _src Source bytes
+/// \param[in] _srcSize Number of source bytes
+/// \param[out] _dst Converted bytes
+/// \param[in] _dstSize Number of bytes that can be written
+/// \param[in] _shuffle The shuffle
+/// \return Number of groups converted
+GZ_PIXEL_KERNELS_SSSE3
+std::size_t ShuffleSsse3(const uint8_t *_src, std::size_t _srcSize,
+    uint8_t *_dst, std::size_t _dstSize, const Shuffle &_shuffle)
+{
+  const __m128i mask =
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_shuffle.mask));
+  const __m128i fill =
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_shuffle.fill));
+  const std::size_t srcBytes = _shuffle.srcBytes;
+  const std::size_t dstBytes = _shuffle.dstBytes;
+
+  std::size_t g = 0u;
+  for (; g * srcBytes + 16u <= _srcSize && g * dstBytes + 16u <= _dstSize;
+       ++g)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + g * srcBytes));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + g * dstBytes),
+        _mm_or_si128(_mm_shuffle_epi8(v, mask), fill));
+  }
+  return g;
+}
+
+/// \brief Convert groups of pixels with a byte shuffle, two groups at a
+/// time, while 16 bytes can be read and written. Every group stores 16
+/// bytes; the bytes past its end are overwritten by the next group, or
+/// written back unchanged by an in-place shuffle.
+/// \param[in] _src Source bytes
+/// \param[in] _srcSize Number of source bytes
+/// \param[out] _dst Converted bytes
+/// \param[in] _dstSize Number of bytes that can be written
+/// \param[in] _shuffle The shuffle
+/// \return Number of groups converted
+GZ_PIXEL_KERNELS_AVX2
+std::size_t ShuffleAvx2(const uint8_t *_src, std::size_t _srcSize,
+    uint8_t *_dst, std::size_t _dstSize, const Shuffle &_shuffle)
+{
+  const __m256i mask = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_shuffle.mask)));
+  const __m256i fill = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_shuffle.fill)));
+  const std::size_t srcBytes = _shuffle.srcBytes;
+  const std::size_t dstBytes = _shuffle.dstBytes;
+
+  std::size_t g = 0u;
+  for (; (g + 1u) * srcBytes + 16u <= _srcSize &&
+         (g + 1u) * dstBytes + 16u <= _dstSize; g += 2u)
+  {
+    const uint8_t *s = _src + g * srcBytes;
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + srcBytes)), 1);
+    v = _mm256_or_si256(_mm256_shuffle_epi8(v, mask), fill);
+    uint8_t *d = _dst + g * dstBytes;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d),
+        _mm256_castsi256_si128(v));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(d + dstBytes),
+        _mm256_extracti128_si256(v, 1));
+  }
+  return g;
+}
+
+/// \brief Masks that keep the bytes of each channel of 32 byte blocks
+struct ChannelMasks
+{
+  /// \brief Mask of every register of a block and every channel
+  alignas(32) uint8_t bytes[3][4][32];
+
+  /// \brief Number of registers of a block. Pixels of 3 channels line up
+  /// with registers every 96 bytes, the others every 32 bytes.
+  unsigned int registers = 1u;
+};
+
+/// \brief Build the channel masks of pixels
+/// \param[in] _channels Channels of a pixel
+/// \return The masks
+ChannelMasks MakeChannelMasks(unsigned int _channels)
+{
+  ChannelMasks masks;
+  masks.registers = _channels == 3u ? 3u : 1u;
+  for (unsigned int k = 0u; k < 3u; ++k)
+  {
+    for (unsigned int c = 0u; c < 4u; ++c)
+    {
+      for (unsigned int j = 0u; j < 32u; ++j)
+      {
+        masks.bytes[k][c][j] =
+            (k * 32u + j) % _channels == c ? 0xffu : 0u;
+      }
+    }
+  }
+  return masks;
+}
+
+/// \brief Sum the channels of the 8 bit pixels of a row, a block of
+/// registers at a time
+/// \param[in] _row First pixel of the row
+/// \param[in] _count Number of pixels in the row
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _masks Channel masks of the pixels
+/// \param[in,out] _sums Sums of the channels
+/// \return Number of pixels summed
+GZ_PIXEL_KERNELS_AVX2
+std::size_t SumRowAvx2(const uint8_t *_row, std::size_t _count,
+    unsigned int _channels, const ChannelMasks &_masks, uint64_t _sums[4])
+{
+  const std::size_t size = _count * _channels;
+  const std::size_t block = 32u * _masks.registers;
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i acc[4] = {zero, zero, zero, zero};
+
+  std::size_t i = 0u;
+  for (; i + block <= size; i += block)
+  {
+    for (unsigned int k = 0u; k < _masks.registers; ++k)
+    {
+      const __m256i v = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(_row + i + 32u * k));
+      for (unsigned int c = 0u; c < _channels; ++c)
+      {
+        const __m256i mask = _mm256_load_si256(
+            reinterpret_cast<const __m256i *>(_masks.bytes[k][c]));
+        // The sum of absolute differences with 0 adds groups of 8 bytes
+        acc[c] = _mm256_add_epi64(acc[c],
+            _mm256_sad_epu8(_mm256_and_si256(v, mask), zero));
+      }
+    }
+  }
+
+  for (unsigned int c = 0u; c < _channels; ++c)
+  {
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc[c]);
+    _sums[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+  return i / _channels;
+}
+
+/// \brief Search the 8 bit pixels of a row, 8 pixels at a time. The
+/// brightness is computed with the float operations of the scalar version.
+/// \param[in] _row First pixel of the row
+/// \param[in] _channels Channels of a pixel, 1, 3 or 4
+/// \param[in] _width Number of pixels in the row
+/// \param[in] _y Row, like Image::Pixel
+/// \param[in] _rgb Shuffle that turns 4 pixels of 3 bytes into 4 pixels of
+/// 4 bytes
+/// \param[in,out] _best Best pixel found so far
+/// \return Number of pixels searched
+template <bool Darkest>
+GZ_PIXEL_KERNELS_AVX2
+unsigned int ScanRowAvx2(const uint8_t *_row, unsigned int _channels,
+    unsigned int _width, unsigned int _y, const Shuffle &_rgb,
+    Candidate &_best)
+{
+  const __m256 scale = _mm256_set1_ps(255.0f);
+  const __m256i low = _mm256_set1_epi32(0xff);
+  const __m256i mask = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i *>(_rgb.mask)));
+  const std::size_t size = static_cast<std::size_t>(_width) * _channels;
+  __m256 best = _mm256_set1_ps(_best.key);
+
+  unsigned int x = 0u;
+  for (; x + 8u <= _width; x += 8u)
+  {
+    const uint8_t *p = _row + static_cast<std::size_t>(x) * _channels;
+    __m256 key;
+    if (_channels == 1u)
+    {
+      const __m256 gray = _mm256_div_ps(_mm256_cvtepi32_ps(
+          _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)))), scale);
+      key = _mm256_add_ps(_mm256_add_ps(gray, gray), gray);
+    }
+    else
+    {
+      __m256i v;
+      if (_channels == 4u)
+      {
+        v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+      }
+      else
+      {
+        // Each half reads 16 bytes, of which 4 pixels are used
+        if (static_cast<std::size_t>(x) * 3u + 28u > size)
+          break;
+        v = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 12u)), 1);
+        v = _mm256_shuffle_epi8(v, mask);
+      }
+      const __m256 r = _mm256_div_ps(
+          _mm256_cvtepi32_ps(_mm256_and_si256(v, low)), scale);
+      const __m256 g = _mm256_div_ps(_mm256_cvtepi32_ps(
+          _mm256_and_si256(_mm256_srli_epi32(v, 8), low)), scale);
+      const __m256 b = _mm256_div_ps(_mm256_cvtepi32_ps(
+          _mm256_and_si256(_mm256_srli_epi32(v, 16), low)), scale);
+      key = _mm256_add_ps(_mm256_add_ps(r, g), b);
+    }
+
+    const __m256 better = Darkest ?
+        _mm256_cmp_ps(key, best, _CMP_LT_OQ) :
+        _mm256_cmp_ps(key, best, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(better) != 0)
+    {
+      // Pick the first of the better pixels in order, like the scalar
+      // version
+      alignas(32) float keys[8];
+      _mm256_store_ps(keys, key);
+      for (unsigned int i = 0u; i < 8u; ++i)
+      {
+        if (Better<Darkest>(keys[i], _best.key))
+          _best = {keys[i], x + i, _y, true};
+      }
+      best = _mm256_set1_ps(_best.key);
+    }
+  }
+  return x;
+}
+#endif
+
+/// \brief Check if the kernels use AVX2
+/// \return True if the active instruction set is AVX2
+bool UseAvx2()
+{
+#if defined(GZ_PIXEL_KERNELS_X86)
+  return meshkernels::ActiveIsa() == meshkernels::Isa::AVX2;
+#else
+  return false;
+#endif
+}
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+/// \brief Kernel converting groups of pixels with a byte shuffle
+using ShuffleFunc = std::size_t (*)(const uint8_t *, std::size_t,
+    uint8_t *, std::size_t, const Shuffle &);
+
+/// \brief Check if the CPU supports SSSE3
+/// \return True if SSSE3 instructions can be used
+bool CpuHasSsse3()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+/// \brief Get the byte shuffle of the active instruction set. The SSE2
+/// level shuffles with SSSE3 where the CPU has it.
+/// \return The shuffle, nullptr to run the scalar versions
+ShuffleFunc ActiveShuffle()
+{
+  static const bool ssse3 = CpuHasSsse3();
+  switch (meshkernels::ActiveIsa())
+  {
+    case meshkernels::Isa::AVX2:
+      return ShuffleAvx2;
+    case meshkernels::Isa::SSE2:
+      return ssse3 ? ShuffleSsse3 : nullptr;
+    default:
+      return nullptr;
+  }
+}
+#endif
+
+/// \brief Dispatch a channel conversion
+/// \param[in] _src Pixels to convert
+/// \param[in] _srcChannels Channels of a source pixel
+/// \param[out] _dst Converted pixels
+/// \param[in] _dstChannels Channels of a converted pixel
+/// \param[in] _count Number of pixels
+/// \param[in] _alpha Opaque alpha
+/// \return False if the channel counts are not supported
+template <typename T>
+bool Convert(const T *_src, unsigned int _srcChannels, T *_dst,
+    unsigned int _dstChannels, std::size_t _count, T _alpha)
+{
+  if (_srcChannels < 1u || _srcChannels > 4u || _dstChannels < 1u ||
+      _dstChannels > 4u || _srcChannels == _dstChannels)
+  {
+    return false;
+  }
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+  const int *map = ChannelMap(_srcChannels, _dstChannels);
+  const ShuffleFunc shuffleGroups = map ? ActiveShuffle() : nullptr;
+  Shuffle shuffle;
+  if (shuffleGroups)
+  {
+    uint8_t alpha[sizeof(T)];
+    std::memcpy(alpha, &_alpha, sizeof(T));
+    shuffle = MakeShuffle(sizeof(T), _srcChannels, _dstChannels, map, alpha,
+        false);
+  }
+#endif
+
+  ForRanges(_count, [&](std::size_t _begin, std::size_t _end)
+      {
+        const T *src = _src + _begin * _srcChannels;
+        T *dst = _dst + _begin * _dstChannels;
+        std::size_t count = _end - _begin;
+#if defined(GZ_PIXEL_KERNELS_X86)
+        if (shuffleGroups)
+        {
+          const std::size_t done = shuffle.pixels * shuffleGroups(
+              reinterpret_cast<const uint8_t *>(src),
+              count * _srcChannels * sizeof(T),
+              reinterpret_cast<uint8_t *>(dst),
+              count * _dstChannels * sizeof(T), shuffle);
+          src += done * _srcChannels;
+          dst += done * _dstChannels;
+          count -= done;
+        }
+#endif
+        ConvertChannelsScalar(src, static_cast<int>(_srcChannels), dst,
+            static_cast<int>(_dstChannels), count, _alpha);
+      });
+  return true;
+}
+
+/// \brief Dispatch a channel extraction of 8 or 16 bit pixels
+/// \param[in] _src Pixels
+/// \param[in] _channels Channels of a pixel
+/// \param[in] _channel Channel to copy
+/// \param[out] _dst One value per pixel
+/// \param[in] _count Number of pixels
+template <typename T>
+void Extract(const T *_src, unsigned int _channels, unsigned int _channel,
+    uint8_t *_dst, std::size_t _count)
+{
+  if (sizeof(T) == 1u && _channels == 1u)
+  {
+    std::memcpy(_dst, _src, _count);
+    return;
+  }
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+  // Pixels are seen as bytes, and the copied byte of a 16 bit channel is
+  // its most significant one
+  const ShuffleFunc shuffleGroups = ActiveShuffle();
+  Shuffle shuffle;
+  if (shuffleGroups)
+  {
+    const int map[] = {static_cast<int>(
+        (_channel + 1u) * sizeof(T) - 1u)};
+    shuffle = MakeShuffle(1u, _channels * sizeof(T), 1u, map, nullptr,
+        false);
+  }
+#endif
+
+  ForRanges(_count, [&](std::size_t _begin, std::size_t _end)
+      {
+        const T *src = _src + _begin * _channels;
+        uint8_t *dst = _dst + _begin;
+        std::size_t count = _end - _begin;
+#if defined(GZ_PIXEL_KERNELS_X86)
+        if (shuffleGroups)
+        {
+          const std::size_t done = shuffle.pixels * shuffleGroups(
+              reinterpret_cast<const uint8_t *>(src),
+              count * _channels * sizeof(T), dst, count, shuffle);
+          src += done * _channels;
+          dst += done;
+          count -= done;
+        }
+#endif
+        ExtractChannelScalar(src, _channels, _channel, dst, count);
+      });
+}
+
+/// \brief Search the pixels of a grid, in the order of Image::MaxColor
+/// \param[in] _grid The pixels
+/// \return The best pixel
+template <bool Darkest>
+Candidate Search(const pixelkernels::Grid &_grid)
+{
+  Candidate best;
+  if (Darkest)
+    best.key = std::numeric_limits<float>::infinity();
+  const unsigned int rows = Samples(_grid.height, _grid.stride);
+  const unsigned int columns = Samples(_grid.width, _grid.stride);
+  if (rows == 0u || columns == 0u)
+    return best;
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+  const bool avx2 = UseAvx2() && _grid.channelSize == 1u &&
+      _grid.stride == 1u && _grid.channels != 2u;
+  Shuffle rgb;
+  if (avx2)
+  {
+    const uint8_t alpha[] = {0u};
+    rgb = MakeShuffle(1u, 3u, 4u, ChannelMap(3u, 4u), alpha, false);
+  }
+#endif
+
+  const Candidate initial = best;
+  std::mutex mutex;
+  ForRanges(rows, [&](std::size_t _begin, std::size_t _end)
+      {
+        Candidate local = initial;
+        for (std::size_t row = _begin; row < _end; ++row)
+        {
+          const uint8_t *data = GridRow(_grid, row);
+          const auto y = static_cast<unsigned int>(row * _grid.stride);
+          unsigned int x = 0u;
+#if defined(GZ_PIXEL_KERNELS_X86)
+          if (avx2)
+          {
+            x = ScanRowAvx2<Darkest>(data, _grid.channels, _grid.width, y,
+                rgb, local);
+          }
+#endif
+          if (_grid.channelSize == 1u)
+          {
+            ScanRowScalar<uint8_t, Darkest>(data, _grid.channels,
+                _grid.stride, x, columns, y, local);
+          }
+          else
+          {
+            ScanRowScalar<uint16_t, Darkest>(
+                reinterpret_cast<const uint16_t *>(data), _grid.channels,
+                _grid.stride, x, columns, y, local);
+          }
+        }
+
+        // Ranges finish in any order, ties go to the first pixel
+        std::lock_guard<std::mutex> lock(mutex);
+        if (local.found && (!best.found ||
+            Better<Darkest>(local.key, best.key) ||
+            (local.key == best.key && (local.y < best.y ||
+            (local.y == best.y && local.x < best.x)))))
+        {
+          best = local;
+        }
+      }, columns);
+  return best;
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+bool pixelkernels::ConvertChannels(const uint8_t *_src,
+    unsigned int _srcChannels, uint8_t *_dst, unsigned int _dstChannels,
+    std::size_t _count)
+{
+  return Convert(_src, _srcChannels, _dst, _dstChannels, _count,
+      static_cast<uint8_t>(255u));
+}
+
+//////////////////////////////////////////////////
+bool pixelkernels::ConvertChannels(const uint16_t *_src,
+    unsigned int _srcChannels, uint16_t *_dst, unsigned int _dstChannels,
+    std::size_t _count)
+{
+  return Convert(_src, _srcChannels, _dst, _dstChannels, _count,
+      static_cast<uint16_t>(0xffffu));
+}
+
+//////////////////////////////////////////////////
+bool pixelkernels::ConvertChannels(const float *_src,
+    unsigned int _srcChannels, float *_dst, unsigned int _dstChannels,
+    std::size_t _count)
+{
+  return Convert(_src, _srcChannels, _dst, _dstChannels, _count, 1.0f);
+}
+
+//////////////////////////////////////////////////
+void pixelkernels::ExtractChannel(const uint8_t *_src,
+    unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+    std::size_t _count)
+{
+  Extract(_src, _channels, _channel, _dst, _count);
+}
+
+//////////////////////////////////////////////////
+void pixelkernels::ExtractChannel(const uint16_t *_src,
+    unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+    std::size_t _count)
+{
+  Extract(_src, _channels, _channel, _dst, _count);
+}
+
+//////////////////////////////////////////////////
+void pixelkernels::ExtractChannel(const float *_src,
+    unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+    std::size_t _count)
+{
+  // The float to byte conversion stays scalar, so that out of range values
+  // convert like they always did
+  ForRanges(_count, [&](std::size_t _begin, std::size_t _end)
+      {
+        ExtractChannelScalar(_src + _begin * _channels, _channels, _channel,
+            _dst + _begin, _end - _begin);
+      });
+}
+
+//////////////////////////////////////////////////
+void pixelkernels::SwapRedBlue(uint8_t *_pixels, unsigned int _channels,
+    std::size_t _count)
+{
+#if defined(GZ_PIXEL_KERNELS_X86)
+  const ShuffleFunc shuffleGroups = ActiveShuffle();
+  Shuffle shuffle;
+  if (shuffleGroups)
+  {
+    const int map[] = {2, 1, 0, 3};
+    shuffle = MakeShuffle(1u, _channels, _channels, map, nullptr, true);
+  }
+#endif
+
+  ForRanges(_count, [&](std::size_t _begin, std::size_t _end)
+      {
+        uint8_t *pixels = _pixels + _begin * _channels;
+        std::size_t count = _end - _begin;
+#if defined(GZ_PIXEL_KERNELS_X86)
+        if (shuffleGroups)
+        {
+          const std::size_t size = count * _channels;
+          const std::size_t done = shuffle.pixels *
+              shuffleGroups(pixels, size, pixels, size, shuffle);
+          pixels += done * _channels;
+          count -= done;
+        }
+#endif
+        SwapRedBlueScalar(pixels, _channels, count);
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t pixelkernels::SumChannels(const Grid &_grid, uint64_t _sums[4])
+{
+  std::fill(_sums, _sums + 4, 0u);
+  const unsigned int rows = Samples(_grid.height, _grid.stride);
+  const unsigned int columns = Samples(_grid.width, _grid.stride);
+  if (rows == 0u || columns == 0u)
+    return 0u;
+
+#if defined(GZ_PIXEL_KERNELS_X86)
+  const bool avx2 = UseAvx2() && _grid.channelSize == 1u &&
+      _grid.stride == 1u;
+  ChannelMasks masks;
+  if (avx2)
+    masks = MakeChannelMasks(_grid.channels);
+#endif
+
+  std::mutex mutex;
+  ForRanges(rows, [&](std::size_t _begin, std::size_t _end)
+      {
+        uint64_t sums[4] = {0u, 0u, 0u, 0u};
+        for (std::size_t row = _begin; row < _end; ++row)
+        {
+          const uint8_t *data = GridRow(_grid, row);
+          std::size_t done = 0u;
+#if defined(GZ_PIXEL_KERNELS_X86)
+          if (avx2)
+            done = SumRowAvx2(data, columns, _grid.channels, masks, sums);
+#endif
+          if (_grid.channelSize == 1u)
+          {
+            SumRowScalar(data, _grid.channels, _grid.stride, done, columns,
+                sums);
+          }
+          else
+          {
+            SumRowScalar(reinterpret_cast<const uint16_t *>(data),
+                _grid.channels, _grid.stride, done, columns, sums);
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (unsigned int c = 0u; c < 4u; ++c)
+          _sums[c] += sums[c];
+      }, columns);
+  return static_cast<std::size_t>(rows) * columns;
+}
+
+//////////////////////////////////////////////////
+bool pixelkernels::BrightestPixel(const Grid &_grid, unsigned int &_x,
+    unsigned int &_y)
+{
+  const Candidate best = Search<false>(_grid);
+  _x = best.x;
+  _y = best.y;
+  return best.found;
+}
+
+//////////////////////////////////////////////////
+bool pixelkernels::DarkestPixel(const Grid &_grid, unsigned int &_x,
+    unsigned int &_y)
+{
+  const Candidate best = Search<true>(_grid);
+  _x = best.x;
+  _y = best.y;
+  return best.found;
+}
+
+//////////////////////////////////////////////////
+void pixelkernels::Histogram(const Grid &_grid, unsigned int _channel,
+    std::vector<std::size_t> &_bins)
+{
+  const unsigned int rows = Samples(_grid.height, _grid.stride);
+  const unsigned int columns = Samples(_grid.width, _grid.stride);
+  if (rows == 0u || columns == 0u || _bins.empty())
+    return;
+
+  // Counting does not vectorize, rows are only split between threads
+  const std::size_t bins = _bins.size();
+  const std::size_t step =
+      static_cast<std::size_t>(_grid.stride) * _grid.channels;
+  std::mutex mutex;
+  ForRanges(rows, [&](std::size_t _begin, std::size_t _end)
+      {
+        std::vector<std::size_t> tables(4u * bins, 0u);
+        for (std::size_t row = _begin; row < _end; ++row)
+        {
+          const uint8_t *data = GridRow(_grid, row);
+          if (_grid.channelSize == 1u)
+          {
+            HistogramRowScalar(data + _channel, step, columns, bins,
+                tables.data());
+          }
+          else
+          {
+            HistogramRowScalar(
+                reinterpret_cast<const uint16_t *>(data) + _channel, step,
+                columns, bins, tables.data());
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0u; i < bins; ++i)
+        {
+          _bins[i] += tables[i] + tables[bins + i] + tables[2u * bins + i] +
+              tables[3u * bins + i];
+        }
+      }, columns);
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_PIXELKERNELS_HH_
+#define GZ_COMMON_PIXELKERNELS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gz/common/graphics/Export.hh"
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Bulk operations on packed pixels, used by Image.
+    ///
+    /// Every kernel has a scalar version and, on x86-64, an AVX2 version
+    /// that moves bytes with shuffles. The instruction set is the one of
+    /// the mesh kernels, see meshkernels::ActiveIsa. SSE2 has no byte
+    /// shuffle, so at the SSE2 level the channel conversions, extractions
+    /// and swaps use SSSE3 shuffles where the CPU has them, and the
+    /// statistics run the scalar versions. Large images are split into
+    /// ranges of pixels or rows processed on the shared worker pool. The
+    /// result is the same with every instruction set and number of threads.
+    namespace pixelkernels
+    {
+      /// \brief Convert pixels to another number of channels, like
+      /// stb_image does: gray is copied to red, green and blue, missing
+      /// alpha is opaque and color is reduced to gray with the luminance
+      /// (77 r + 150 g + 29 b) / 256. _src and _dst must not overlap.
+      /// \param[in] _src Pixels to convert.
+      /// \param[in] _srcChannels Channels of a source pixel, 1 to 4.
+      /// \param[out] _dst Converted pixels.
+      /// \param[in] _dstChannels Channels of a converted pixel, 1 to 4.
+      /// \param[in] _count Number of pixels.
+      /// \return False if the channel counts are equal or out of range.
+      GZ_COMMON_GRAPHICS_VISIBLE bool ConvertChannels(const uint8_t *_src,
+          unsigned int _srcChannels, uint8_t *_dst,
+          unsigned int _dstChannels, std::size_t _count);
+
+      /// \brief Convert 16 bit pixels to another number of channels.
+      /// \sa ConvertChannels(const uint8_t *, unsigned int, uint8_t *,
+      /// unsigned int, std::size_t)
+      GZ_COMMON_GRAPHICS_VISIBLE bool ConvertChannels(const uint16_t *_src,
+          unsigned int _srcChannels, uint16_t *_dst,
+          unsigned int _dstChannels, std::size_t _count);
+
+      /// \brief Convert float pixels to another number of channels. Opaque
+      /// alpha is 1.
+      /// \sa ConvertChannels(const uint8_t *, unsigned int, uint8_t *,
+      /// unsigned int, std::size_t)
+      GZ_COMMON_GRAPHICS_VISIBLE bool ConvertChannels(const float *_src,
+          unsigned int _srcChannels, float *_dst,
+          unsigned int _dstChannels, std::size_t _count);
+
+      /// \brief Copy one channel of 8 bit pixels.
+      /// \param[in] _src Pixels.
+      /// \param[in] _channels Channels of a pixel, 1 to 4.
+      /// \param[in] _channel Channel to copy, lower than _channels.
+      /// \param[out] _dst One value per pixel.
+      /// \param[in] _count Number of pixels.
+      GZ_COMMON_GRAPHICS_VISIBLE void ExtractChannel(const uint8_t *_src,
+          unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+          std::size_t _count);
+
+      /// \brief Copy the 8 most significant bits of one channel of 16 bit
+      /// pixels.
+      /// \sa ExtractChannel(const uint8_t *, unsigned int, unsigned int,
+      /// uint8_t *, std::size_t)
+      GZ_COMMON_GRAPHICS_VISIBLE void ExtractChannel(const uint16_t *_src,
+          unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+          std::size_t _count);
+
+      /// \brief Copy one channel of float pixels, scaled from [0, 1] to
+      /// [0, 255] and truncated.
+      /// \sa ExtractChannel(const uint8_t *, unsigned int, unsigned int,
+      /// uint8_t *, std::size_t)
+      GZ_COMMON_GRAPHICS_VISIBLE void ExtractChannel(const float *_src,
+          unsigned int _channels, unsigned int _channel, uint8_t *_dst,
+          std::size_t _count);
+
+      /// \brief Swap the first and third channels of 8 bit pixels in place,
+      /// to turn BGR[A] into RGB[A].
+      /// \param[in,out] _pixels Pixels to update.
+      /// \param[in] _channels Channels of a pixel, 3 or 4.
+      /// \param[in] _count Number of pixels.
+      GZ_COMMON_GRAPHICS_VISIBLE void SwapRedBlue(uint8_t *_pixels,
+          unsigned int _channels, std::size_t _count);
+
+      /// \brief Pixels of an image read by the reductions. Only the pixels
+      /// whose coordinates are multiples of the stride are read, with rows
+      /// counted from the bottom like Image::Pixel does.
+      struct Grid
+      {
+        /// \brief First byte of the top row
+        const uint8_t *data = nullptr;
+
+        /// \brief Width in pixels
+        unsigned int width = 0u;
+
+        /// \brief Height in pixels
+        unsigned int height = 0u;
+
+        /// \brief Size of a row in bytes
+        std::size_t pitch = 0u;
+
+        /// \brief Channels of a pixel, 1 to 4
+        unsigned int channels = 0u;
+
+        /// \brief Size of a channel in bytes, 1 or 2
+        unsigned int channelSize = 1u;
+
+        /// \brief Distance between two read pixels, at least 1
+        unsigned int stride = 1u;
+      };
+
+      /// \brief Sum every channel of the pixels of a grid.
+      /// \param[in] _grid The pixels.
+      /// \param[out] _sums Sum of each channel, 0 for the channels the
+      /// pixels do not have.
+      /// \return Number of pixels read.
+      GZ_COMMON_GRAPHICS_VISIBLE std::size_t SumChannels(const Grid &_grid,
+          uint64_t _sums[4]);
+
+      /// \brief Find the first pixel, in the order of Image::MaxColor, with
+      /// the highest brightness greater than 0. The brightness is the float
+      /// sum of red, green and blue scaled to [0, 1], computed like
+      /// Image::MaxColor does so that ties are broken the same way. Gray
+      /// counts for the three colors.
+      /// \param[in] _grid The pixels, with 1, 3 or 4 channels.
+      /// \param[out] _x Column of the pixel, like Image::Pixel.
+      /// \param[out] _y Row of the pixel, like Image::Pixel.
+      /// \return False if all the pixels are black.
+      GZ_COMMON_GRAPHICS_VISIBLE bool BrightestPixel(const Grid &_grid,
+          unsigned int &_x, unsigned int &_y);
+
+      /// \brief Find the first pixel with the lowest brightness.
+      /// \sa BrightestPixel
+      /// \param[in] _grid The pixels, with 1, 3 or 4 channels.
+      /// \param[out] _x Column of the pixel, like Image::Pixel.
+      /// \param[out] _y Row of the pixel, like Image::Pixel.
+      /// \return False if the grid is empty.
+      GZ_COMMON_GRAPHICS_VISIBLE bool DarkestPixel(const Grid &_grid,
+          unsigned int &_x, unsigned int &_y);
+
+      /// \brief Count the values of one channel in bins of equal width. A
+      /// value v of a channel of n bits goes in the bin v * bins / 2^n, so
+      /// that 256 bins of an 8 bit channel count each value separately.
+      /// \param[in] _grid The pixels.
+      /// \param[in] _channel Channel to count, lower than the channels of a
+      /// pixel.
+      /// \param[in,out] _bins Bins, which counts are increased. Must not be
+      /// empty.
+      GZ_COMMON_GRAPHICS_VISIBLE void Histogram(const Grid &_grid,
+          unsigned int _channel, std::vector<std::size_t> &_bins);
+    }
+  }
+}
+#endif
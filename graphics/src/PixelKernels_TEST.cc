@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Color.hh>
+
+#include "MeshKernels.hh"
+#include "PixelKernels.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+using namespace common;
+
+class PixelKernels : public common::testing::AutoLogFixture
+{
+  protected: void SetUp() override
+  {
+    common::testing::AutoLogFixture::SetUp();
+    this->previousIsa = meshkernels::ActiveIsa();
+  }
+
+  protected: void TearDown() override
+  {
+    meshkernels::SetActiveIsa(this->previousIsa);
+    common::testing::AutoLogFixture::TearDown();
+  }
+
+  /// \brief Instruction set active before the test
+  protected: meshkernels::Isa previousIsa = meshkernels::Isa::SCALAR;
+};
+
+/// \brief Instruction sets to check
+static const meshkernels::Isa kIsas[] = {meshkernels::Isa::SCALAR,
+    meshkernels::Isa::SSE2, meshkernels::Isa::AVX2};
+
+/// \brief Numbers of pixels that leave a tail for every group size, and one
+/// large enough to be split between threads
+static const std::size_t kCounts[] = {0u, 1u, 5u, 17u, 1001u,
+    (1u << 20) + 7u};
+
+/// \brief Create random pixels
+/// \param[in] _count Number of samples
+/// \param[in] _seed Random seed
+/// \return The samples
+template <typename T>
+std::vector<T> RandomSamples(std::size_t _count, unsigned int _seed)
+{
+  std::mt19937 gen(_seed);
+  std::vector<T> samples(_count);
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (T &sample : samples)
+      sample = dist(gen);
+  }
+  else
+  {
+    std::uniform_int_distribution<unsigned int> dist(0u,
+        std::numeric_limits<T>::max());
+    for (T &sample : samples)
+      sample = static_cast<T>(dist(gen));
+  }
+  return samples;
+}
+
+/// \brief Convert one pixel like stb_image
+/// \param[in] _src Source pixel
+/// \param[in] _srcChannels Channels of the source pixel
+/// \param[out] _dst Converted pixel
+/// \param[in] _dstChannels Channels of the converted pixel
+/// \param[in] _alpha Opaque alpha
+template <typename T>
+void ExpectedPixel(const T *_src, unsigned int _srcChannels, T *_dst,
+    unsigned int _dstChannels, T _alpha)
+{
+  T gray = _src[0];
+  if (_srcChannels >= 3u)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      gray = (_src[0] * 77.0f + _src[1] * 150.0f + _src[2] * 29.0f) /
+          256.0f;
+    }
+    else
+    {
+      gray = static_cast<T>(
+          (_src[0] * 77 + _src[1] * 150 + _src[2] * 29) >> 8);
+    }
+  }
+  const T alpha = _srcChannels % 2u == 0u ? _src[_srcChannels - 1u] : _alpha;
+  if (_dstChannels <= 2u)
+  {
+    _dst[0] = gray;
+    if (_dstChannels == 2u)
+      _dst[1] = alpha;
+    return;
+  }
+  for (unsigned int c = 0u; c < 3u; ++c)
+    _dst[c] = _srcChannels >= 3u ? _src[c] : _src[0];
+  if (_dstChannels == 4u)
+    _dst[3] = alpha;
+}
+
+/// \brief Check the conversions between all channel counts
+/// \param[in] _alpha Opaque alpha
+template <typename T>
+void CheckConvertChannels(T _alpha)
+{
+  for (const auto isa : kIsas)
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+    for (unsigned int in = 1u; in <= 4u; ++in)
+    {
+      for (unsigned int out = 1u; out <= 4u; ++out)
+      {
+        if (in == out)
+          continue;
+        for (const std::size_t count : kCounts)
+        {
+          const std::vector<T> src = RandomSamples<T>(count * in, in + out);
+          std::vector<T> expected(count * out);
+          for (std::size_t i = 0u; i < count; ++i)
+          {
+            ExpectedPixel(&src[i * in], in, &expected[i * out], out,
+                _alpha);
+          }
+          std::vector<T> dst(count * out);
+          ASSERT_TRUE(pixelkernels::ConvertChannels(src.data(), in,
+              dst.data(), out, count));
+          ASSERT_EQ(expected, dst) << meshkernels::IsaName(isa) << " "
+              << in << " to " << out << " channels, " << count << " pixels";
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelKernels, ConvertChannels)
+{
+  CheckConvertChannels<uint8_t>(255u);
+  CheckConvertChannels<uint16_t>(0xffffu);
+  CheckConvertChannels<float>(1.0f);
+
+  uint8_t pixel[4] = {1u, 2u, 3u, 4u};
+  uint8_t converted[4];
+  EXPECT_FALSE(pixelkernels::ConvertChannels(pixel, 3u, converted, 3u, 1u));
+  EXPECT_FALSE(pixelkernels::ConvertChannels(pixel, 0u, converted, 3u, 1u));
+  EXPECT_FALSE(pixelkernels::ConvertChannels(pixel, 3u, converted, 5u, 1u));
+}
+
+/// \brief Check the extraction of all the channels of all channel counts
+template <typename T>
+void CheckExtractChannel()
+{
+  for (const auto isa : kIsas)
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+    for (unsigned int channels = 1u; channels <= 4u; ++channels)
+    {
+      for (unsigned int channel = 0u; channel < channels; ++channel)
+      {
+        for (const std::size_t count : kCounts)
+        {
+          const std::vector<T> src =
+              RandomSamples<T>(count * channels, channels);
+          std::vector<uint8_t> expected(count);
+          for (std::size_t i = 0u; i < count; ++i)
+          {
+            const T value = src[i * channels + channel];
+            // The most significant byte, or a float scaled to a byte
+            if constexpr (std::is_floating_point_v<T>)
+              expected[i] = static_cast<uint8_t>(value * 255.0f);
+            else
+              expected[i] = static_cast<uint8_t>(value >> (sizeof(T) * 8 - 8));
+          }
+          std::vector<uint8_t> dst(count);
+          pixelkernels::ExtractChannel(src.data(), channels, channel,
+              dst.data(), count);
+          ASSERT_EQ(expected, dst) << meshkernels::IsaName(isa) << " "
+              << channel << " of " << channels << " channels, " << count
+              << " pixels";
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelKernels, ExtractChannel)
+{
+  CheckExtractChannel<uint8_t>();
+  CheckExtractChannel<uint16_t>();
+  CheckExtractChannel<float>();
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelKernels, SwapRedBlue)
+{
+  for (const auto isa : kIsas)
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+    for (unsigned int channels = 3u; channels <= 4u; ++channels)
+    {
+      for (const std::size_t count : kCounts)
+      {
+        std::vector<uint8_t> pixels =
+            RandomSamples<uint8_t>(count * channels, channels);
+        std::vector<uint8_t> expected = pixels;
+        for (std::size_t i = 0u; i < count; ++i)
+          std::swap(expected[i * channels], expected[i * channels + 2u]);
+        pixelkernels::SwapRedBlue(pixels.data(), channels, count);
+        ASSERT_EQ(expected, pixels) << meshkernels::IsaName(isa) << " "
+            << channels << " channels, " << count << " pixels";
+      }
+    }
+  }
+}
+
+/// \brief Image of random pixels for the reductions
+template <typename T>
+struct TestGrid
+{
+  /// \brief Create the image
+  /// \param[in] _width Width in pixels
+  /// \param[in] _height Height in pixels
+  /// \param[in] _channels Channels of a pixel
+  /// \param[in] _stride Distance between two read pixels
+  /// \param[in] _maxValue Largest channel value, small to create ties
+  public: TestGrid(unsigned int _width, unsigned int _height,
+      unsigned int _channels, unsigned int _stride, unsigned int _maxValue)
+  {
+    // Rows are padded, like the rows of an image can be
+    const std::size_t rowSamples = _width * _channels + 3u;
+    std::mt19937 gen(_width * 7u + _height * 3u + _channels + _stride);
+    std::uniform_int_distribution<unsigned int> dist(0u, _maxValue);
+    this->samples.resize(rowSamples * _height);
+    for (T &sample : this->samples)
+      sample = static_cast<T>(dist(gen));
+
+    this->grid.data = reinterpret_cast<const uint8_t *>(this->samples.data());
+    this->grid.width = _width;
+    this->grid.height = _height;
+    this->grid.pitch = rowSamples * sizeof(T);
+    this->grid.channels = _channels;
+    this->grid.channelSize = sizeof(T);
+    this->grid.stride = _stride;
+  }
+
+  /// \brief Get a pixel
+  /// \param[in] _x Column, like Image::Pixel
+  /// \param[in] _y Row, like Image::Pixel
+  /// \return The first channel of the pixel
+  public: const T *Pixel(unsigned int _x, unsigned int _y) const
+  {
+    const std::size_t row = this->grid.height - 1u - _y;
+    return &this->samples[row * this->grid.pitch / sizeof(T) +
+        _x * this->grid.channels];
+  }
+
+  /// \brief Compute the brightness of a pixel like Image::MaxColor
+  /// \param[in] _x Column, like Image::Pixel
+  /// \param[in] _y Row, like Image::Pixel
+  /// \return Brightness of the pixel
+  public: float Brightness(unsigned int _x, unsigned int _y) const
+  {
+    const float scale = static_cast<float>(std::numeric_limits<T>::max());
+    const T *pixel = this->Pixel(_x, _y);
+    math::Color clr;
+    if (this->grid.channels < 3u)
+      clr.Set(pixel[0] / scale, pixel[0] / scale, pixel[0] / scale);
+    else
+      clr.Set(pixel[0] / scale, pixel[1] / scale, pixel[2] / scale);
+    return clr.R() + clr.G() + clr.B();
+  }
+
+  /// \brief Samples of the pixels
+  public: std::vector<T> samples;
+
+  /// \brief Grid of the pixels
+  public: pixelkernels::Grid grid;
+};
+
+/// \brief Sizes of the images of the reductions, the last large enough to
+/// be split between threads
+static const unsigned int kSizes[][2] = {{0u, 3u}, {1u, 1u}, {7u, 5u},
+    {37u, 11u}, {1030u, 1030u}};
+
+/// \brief Check the reductions against a scalar version
+/// \param[in] _maxValue Largest channel value
+template <typename T>
+void CheckReductions(unsigned int _maxValue)
+{
+  for (const auto isa : kIsas)
+  {
+    if (!meshkernels::SetActiveIsa(isa))
+      continue;
+    for (const auto &size : kSizes)
+    {
+      for (unsigned int channels = 1u; channels <= 4u; ++channels)
+      {
+        for (unsigned int stride : {1u, 3u})
+        {
+          const TestGrid<T> test(size[0], size[1], channels, stride,
+              _maxValue);
+          std::ostringstream context;
+          context << meshkernels::IsaName(isa) << " " << size[0] << "x"
+              << size[1] << ", " << channels << " channels, stride "
+              << stride;
+
+          uint64_t expectedSums[4] = {0u, 0u, 0u, 0u};
+          std::size_t expectedCount = 0u;
+          std::vector<std::size_t> expectedBins(10u, 0u);
+          float maxKey = 0.0f;
+          float minKey = std::numeric_limits<float>::infinity();
+          bool maxFound = false;
+          bool minFound = false;
+          unsigned int maxX = 0u, maxY = 0u, minX = 0u, minY = 0u;
+          for (unsigned int y = 0u; y < size[1]; y += stride)
+          {
+            for (unsigned int x = 0u; x < size[0]; x += stride)
+            {
+              const T *pixel = test.Pixel(x, y);
+              for (unsigned int c = 0u; c < channels; ++c)
+                expectedSums[c] += pixel[c];
+              ++expectedCount;
+              ++expectedBins[pixel[channels - 1u] * 10u /
+                  (std::numeric_limits<T>::max() + 1u)];
+
+              const float key = test.Brightness(x, y);
+              if (key > maxKey)
+              {
+                maxKey = key;
+                maxX = x;
+                maxY = y;
+                maxFound = true;
+              }
+              if (key < minKey)
+              {
+                minKey = key;
+                minX = x;
+                minY = y;
+                minFound = true;
+              }
+            }
+          }
+
+          uint64_t sums[4];
+          EXPECT_EQ(expectedCount, pixelkernels::SumChannels(test.grid,
+              sums)) << context.str();
+          for (unsigned int c = 0u; c < 4u; ++c)
+            EXPECT_EQ(expectedSums[c], sums[c]) << context.str();
+
+          std::vector<std::size_t> bins(10u, 0u);
+          pixelkernels::Histogram(test.grid, channels - 1u, bins);
+          EXPECT_EQ(expectedBins, bins) << context.str();
+
+          // Pixel() does not read 2 channels
+          if (channels == 2u)
+            continue;
+          unsigned int x = 0u, y = 0u;
+          EXPECT_EQ(maxFound, pixelkernels::BrightestPixel(test.grid, x, y))
+              << context.str();
+          if (maxFound)
+          {
+            EXPECT_EQ(maxX, x) << context.str();
+            EXPECT_EQ(maxY, y) << context.str();
+          }
+          EXPECT_EQ(minFound, pixelkernels::DarkestPixel(test.grid, x, y))
+              << context.str();
+          if (minFound)
+          {
+            EXPECT_EQ(minX, x) << context.str();
+            EXPECT_EQ(minY, y) << context.str();
+          }
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelKernels, Reductions)
+{
+  CheckReductions<uint8_t>(255u);
+  CheckReductions<uint16_t>(0xffffu);
+
+  // Few values, so that many pixels tie
+  CheckReductions<uint8_t>(2u);
+  CheckReductions<uint16_t>(2u);
+}
@@ -0,0 +1,705 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/QuantizedMesh.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief Largest value of a 16-bit normalized integer.
+constexpr double kUnorm16Max = 65535.0;
+
+/// \brief Largest value of a 16-bit signed normalized integer.
+constexpr double kSnorm16Max = 32767.0;
+
+/// \brief Convert a float to a half float, rounding to the nearest even
+/// value. Values too large for a half float become infinity.
+uint16_t FloatToHalf(float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  const uint32_t exponent = (bits >> 23) & 0xFFu;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  // Infinity and NaN
+  if (exponent == 0xFFu)
+  {
+    return sign | 0x7C00u | (mantissa ? 0x200u : 0u);
+  }
+
+  const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+  if (halfExponent >= 31)
+    return sign | 0x7C00u;
+
+  if (halfExponent <= 0)
+  {
+    // Subnormal half, or zero
+    if (halfExponent < -10)
+      return sign;
+    mantissa |= 0x800000u;
+    const unsigned int shift = static_cast<unsigned int>(14 - halfExponent);
+    uint32_t half = mantissa >> shift;
+    const uint32_t rest = mantissa & ((1u << shift) - 1u);
+    const uint32_t halfway = 1u << (shift - 1u);
+    if (rest > halfway || (rest == halfway && (half & 1u)))
+      ++half;
+    return sign | static_cast<uint16_t>(half);
+  }
+
+  uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) |
+      (mantissa >> 13);
+  const uint32_t rest = mantissa & 0x1FFFu;
+  // Rounding may carry into the exponent, which is still correct
+  if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+    ++half;
+  return sign | static_cast<uint16_t>(half);
+}
+
+/// \brief Convert a half float to a float.
+float HalfToFloat(uint16_t _half)
+{
+  const uint32_t sign = static_cast<uint32_t>(_half & 0x8000u) << 16;
+  const uint32_t exponent = (_half >> 10) & 0x1Fu;
+  uint32_t mantissa = _half & 0x3FFu;
+
+  uint32_t bits;
+  if (exponent == 0x1Fu)
+  {
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  }
+  else if (exponent == 0u)
+  {
+    if (mantissa == 0u)
+    {
+      bits = sign;
+    }
+    else
+    {
+      // Normalize the subnormal half
+      int e = -1;
+      do
+      {
+        ++e;
+        mantissa <<= 1;
+      } while ((mantissa & 0x400u) == 0u);
+      bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) |
+          ((mantissa & 0x3FFu) << 13);
+    }
+  }
+  else
+  {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/// \brief Convert a value in [-1, 1] to a 16-bit signed normalized integer.
+int16_t ToSnorm16(double _value)
+{
+  return static_cast<int16_t>(std::lround(
+      std::clamp(_value, -1.0, 1.0) * kSnorm16Max));
+}
+
+/// \brief Sign of a value, treating 0 as positive.
+double SignNotZero(double _value)
+{
+  return _value >= 0.0 ? 1.0 : -1.0;
+}
+
+/// \brief Encode a normal with the octahedral mapping from Cigolle et al.,
+/// A Survey of Efficient Representations for Independent Unit Vectors.
+std::array<int16_t, 2> EncodeOctahedral(const math::Vector3d &_n)
+{
+  const double l1 = std::abs(_n.X()) + std::abs(_n.Y()) + std::abs(_n.Z());
+  if (l1 <= 0.0 || !std::isfinite(l1))
+    return {0, 0};
+
+  double x = _n.X() / l1;
+  double y = _n.Y() / l1;
+  if (_n.Z() < 0.0)
+  {
+    const double ox = (1.0 - std::abs(y)) * SignNotZero(x);
+    const double oy = (1.0 - std::abs(x)) * SignNotZero(y);
+    x = ox;
+    y = oy;
+  }
+
+  // Pick the rounding of the two components that decodes closest to the
+  // original normal
+  const math::Vector3d target = _n / _n.Length();
+  std::array<int16_t, 2> best = {ToSnorm16(x), ToSnorm16(y)};
+  double bestDot = -2.0;
+  const double fx = std::floor(std::clamp(x, -1.0, 1.0) * kSnorm16Max);
+  const double fy = std::floor(std::clamp(y, -1.0, 1.0) * kSnorm16Max);
+  for (int i = 0; i < 2; ++i)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      const double qx = std::min(fx + i, kSnorm16Max);
+      const double qy = std::min(fy + j, kSnorm16Max);
+      double dx = qx / kSnorm16Max;
+      double dy = qy / kSnorm16Max;
+      const double dz = 1.0 - std::abs(dx) - std::abs(dy);
+      if (dz < 0.0)
+      {
+        const double ox = (1.0 - std::abs(dy)) * SignNotZero(dx);
+        dy = (1.0 - std::abs(dx)) * SignNotZero(dy);
+        dx = ox;
+      }
+      const double dot = math::Vector3d(dx, dy, dz).Normalize().Dot(target);
+      if (dot > bestDot)
+      {
+        bestDot = dot;
+        best = {static_cast<int16_t>(qx), static_cast<int16_t>(qy)};
+      }
+    }
+  }
+  return best;
+}
+
+/// \brief Decode an octahedral encoded normal.
+math::Vector3d DecodeOctahedral(int16_t _x, int16_t _y)
+{
+  double x = std::max(_x / kSnorm16Max, -1.0);
+  double y = std::max(_y / kSnorm16Max, -1.0);
+  const double z = 1.0 - std::abs(x) - std::abs(y);
+  if (z < 0.0)
+  {
+    const double ox = (1.0 - std::abs(y)) * SignNotZero(x);
+    y = (1.0 - std::abs(x)) * SignNotZero(y);
+    x = ox;
+  }
+  math::Vector3d n(x, y, z);
+  const double length = n.Length();
+  return length > 0.0 ? n / length : math::Vector3d::Zero;
+}
+}  // namespace
+
+/// \brief Private data for the QuantizedSubMesh class
+class gz::common::QuantizedSubMesh::Implementation
+{
+  /// \brief Decode a vertex.
+  /// \param[in] _index Index of the vertex, must be valid.
+  /// \return The vertex.
+  public: math::Vector3d DecodeVertex(std::size_t _index) const
+  {
+    const uint16_t *q = &this->positions[3 * _index];
+    return math::Vector3d(
+        this->min.X() + q[0] * this->scale.X(),
+        this->min.Y() + q[1] * this->scale.Y(),
+        this->min.Z() + q[2] * this->scale.Z());
+  }
+
+  /// \brief Name of the submesh
+  public: std::string name;
+
+  /// \brief Primitive type
+  public: SubMesh::PrimitiveType primitiveType = SubMesh::TRIANGLES;
+
+  /// \brief Material index
+  public: std::optional<unsigned int> materialIndex;
+
+  /// \brief Minimum corner of the vertex bounding box
+  public: math::Vector3d min;
+
+  /// \brief Maximum corner of the vertex bounding box
+  public: math::Vector3d max;
+
+  /// \brief Size of a quantization step along each axis
+  public: math::Vector3d scale;
+
+  /// \brief Quantized positions, three per vertex
+  public: std::vector<uint16_t> positions;
+
+  /// \brief Octahedral encoded normals, two per normal
+  public: std::vector<int16_t> normals;
+
+  /// \brief Half float texture coordinates, two per coordinate, by set
+  public: std::map<unsigned int, std::vector<uint16_t>> texCoords;
+
+  /// \brief Indices when they fit in 16 bits
+  public: std::vector<uint16_t> indices16;
+
+  /// \brief Indices when they need 32 bits
+  public: std::vector<uint32_t> indices32;
+
+  /// \brief Format of the indices
+  public: SubMesh::IndexFormat indexFormat = SubMesh::IndexFormat::UINT16;
+
+  /// \brief Node assignments
+  public: std::vector<NodeAssignment> nodeAssignments;
+
+  /// \brief Memory used by the original submesh
+  public: std::size_t sourceMemorySize = 0u;
+};
+
+/// \brief Private data for the QuantizedMesh class
+class gz::common::QuantizedMesh::Implementation
+{
+  /// \brief Name of the mesh
+  public: std::string name;
+
+  /// \brief Path of the mesh
+  public: std::string path;
+
+  /// \brief Quantized submeshes
+  public: std::vector<QuantizedSubMesh> subMeshes;
+
+  /// \brief Materials of the original mesh
+  public: std::vector<MaterialPtr> materials;
+
+  /// \brief Skeleton of the original mesh
+  public: SkeletonPtr skeleton;
+};
+
+//////////////////////////////////////////////////
+QuantizedSubMesh::QuantizedSubMesh()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+QuantizedSubMesh::QuantizedSubMesh(const SubMesh &_subMesh)
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  auto &d = *this->dataPtr;
+  d.name = _subMesh.Name();
+  d.primitiveType = _subMesh.SubMeshPrimitiveType();
+  d.materialIndex = _subMesh.GetMaterialIndex();
+
+  const unsigned int vertexCount = _subMesh.VertexCount();
+  const math::Vector3d *vertices = _subMesh.VertexPtr();
+  if (vertexCount > 0u)
+  {
+    d.min = _subMesh.Min();
+    d.max = _subMesh.Max();
+  }
+  const math::Vector3d extent = d.max - d.min;
+  math::Vector3d invScale;
+  for (int k = 0; k < 3; ++k)
+  {
+    d.scale[k] = extent[k] > 0.0 ? extent[k] / kUnorm16Max : 0.0;
+    invScale[k] = extent[k] > 0.0 ? kUnorm16Max / extent[k] : 0.0;
+  }
+  d.positions.resize(3u * vertexCount);
+  for (unsigned int i = 0u; i < vertexCount; ++i)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      const double q = (vertices[i][k] - d.min[k]) * invScale[k];
+      d.positions[3 * i + k] = static_cast<uint16_t>(
+          std::lround(std::clamp(q, 0.0, kUnorm16Max)));
+    }
+  }
+
+  const unsigned int normalCount = _subMesh.NormalCount();
+  d.normals.resize(2u * normalCount);
+  for (unsigned int i = 0u; i < normalCount; ++i)
+  {
+    const auto q = EncodeOctahedral(_subMesh.Normal(i));
+    d.normals[2 * i] = q[0];
+    d.normals[2 * i + 1] = q[1];
+  }
+
+  for (unsigned int set = 0u; set < _subMesh.TexCoordSetCount(); ++set)
+  {
+    const unsigned int count = _subMesh.TexCoordCountBySet(set);
+    auto &uv = d.texCoords[set];
+    uv.resize(2u * count);
+    for (unsigned int i = 0u; i < count; ++i)
+    {
+      const math::Vector2d t = _subMesh.TexCoordBySet(i, set);
+      uv[2 * i] = FloatToHalf(static_cast<float>(t.X()));
+      uv[2 * i + 1] = FloatToHalf(static_cast<float>(t.Y()));
+    }
+  }
+
+  const SubMesh::IndexView indices = _subMesh.Indices();
+  d.indexFormat = indices.Format();
+  if (indices.Format() == SubMesh::IndexFormat::UINT16)
+  {
+    d.indices16.assign(indices.Data16(), indices.Data16() + indices.Count());
+  }
+  else
+  {
+    d.indices32.assign(indices.Data32(), indices.Data32() + indices.Count());
+  }
+
+  d.nodeAssignments.reserve(_subMesh.NodeAssignmentsCount());
+  for (unsigned int i = 0u; i < _subMesh.NodeAssignmentsCount(); ++i)
+    d.nodeAssignments.push_back(_subMesh.NodeAssignmentByIndex(i));
+
+  d.sourceMemorySize = _subMesh.MemorySize();
+}
+
+//////////////////////////////////////////////////
+std::string QuantizedSubMesh::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+SubMesh::PrimitiveType QuantizedSubMesh::SubMeshPrimitiveType() const
+{
+  return this->dataPtr->primitiveType;
+}
+
+//////////////////////////////////////////////////
+std::optional<unsigned int> QuantizedSubMesh::GetMaterialIndex() const
+{
+  return this->dataPtr->materialIndex;
+}
+
+//////////////////////////////////////////////////
+math::Vector3d QuantizedSubMesh::Min() const
+{
+  return this->dataPtr->min;
+}
+
+//////////////////////////////////////////////////
+math::Vector3d QuantizedSubMesh::Max() const
+{
+  return this->dataPtr->max;
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::VertexCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->positions.size() / 3);
+}
+
+//////////////////////////////////////////////////
+math::Vector3d QuantizedSubMesh::Vertex(unsigned int _index) const
+{
+  if (_index >= this->VertexCount())
+  {
+    gzerr << "Index too large" << std::endl;
+    return math::Vector3d::Zero;
+  }
+  return this->dataPtr->DecodeVertex(_index);
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::NormalCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->normals.size() / 2);
+}
+
+//////////////////////////////////////////////////
+math::Vector3d QuantizedSubMesh::Normal(unsigned int _index) const
+{
+  if (_index >= this->NormalCount())
+  {
+    gzerr << "Index too large" << std::endl;
+    return math::Vector3d::Zero;
+  }
+  return DecodeOctahedral(this->dataPtr->normals[2 * _index],
+      this->dataPtr->normals[2 * _index + 1]);
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::TexCoordSetCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->texCoords.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::TexCoordCountBySet(
+    unsigned int _setIndex) const
+{
+  auto it = this->dataPtr->texCoords.find(_setIndex);
+  if (it == this->dataPtr->texCoords.end())
+    return 0u;
+  return static_cast<unsigned int>(it->second.size() / 2);
+}
+
+//////////////////////////////////////////////////
+math::Vector2d QuantizedSubMesh::TexCoordBySet(unsigned int _index,
+    unsigned int _setIndex) const
+{
+  auto it = this->dataPtr->texCoords.find(_setIndex);
+  if (it == this->dataPtr->texCoords.end())
+  {
+    gzerr << "Texture coordinate set does not exist: " << _setIndex
+          << std::endl;
+    return math::Vector2d::Zero;
+  }
+  if (2u * _index >= it->second.size())
+  {
+    gzerr << "Index too large" << std::endl;
+    return math::Vector2d::Zero;
+  }
+  return math::Vector2d(HalfToFloat(it->second[2 * _index]),
+      HalfToFloat(it->second[2 * _index + 1]));
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::IndexCount() const
+{
+  return static_cast<unsigned int>(this->Indices().Count());
+}
+
+//////////////////////////////////////////////////
+SubMesh::IndexView QuantizedSubMesh::Indices() const
+{
+  if (this->dataPtr->indexFormat == SubMesh::IndexFormat::UINT16)
+  {
+    return SubMesh::IndexView(SubMesh::IndexFormat::UINT16,
+        this->dataPtr->indices16.data(), this->dataPtr->indices16.size());
+  }
+  return SubMesh::IndexView(SubMesh::IndexFormat::UINT32,
+      this->dataPtr->indices32.data(), this->dataPtr->indices32.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedSubMesh::NodeAssignmentsCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->nodeAssignments.size());
+}
+
+//////////////////////////////////////////////////
+NodeAssignment QuantizedSubMesh::NodeAssignmentByIndex(
+    unsigned int _index) const
+{
+  if (_index >= this->dataPtr->nodeAssignments.size())
+  {
+    gzerr << "Index too large" << std::endl;
+    return NodeAssignment();
+  }
+  return this->dataPtr->nodeAssignments[_index];
+}
+
+//////////////////////////////////////////////////
+std::vector<float> QuantizedSubMesh::VertexBuffer() const
+{
+  const auto &d = *this->dataPtr;
+  std::vector<float> buffer(d.positions.size());
+  for (std::size_t i = 0u; i < d.positions.size(); i += 3)
+  {
+    buffer[i] = static_cast<float>(d.min.X() + d.positions[i] * d.scale.X());
+    buffer[i + 1] =
+        static_cast<float>(d.min.Y() + d.positions[i + 1] * d.scale.Y());
+    buffer[i + 2] =
+        static_cast<float>(d.min.Z() + d.positions[i + 2] * d.scale.Z());
+  }
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+std::vector<float> QuantizedSubMesh::NormalBuffer() const
+{
+  const auto &normals = this->dataPtr->normals;
+  std::vector<float> buffer(normals.size() / 2 * 3);
+  for (std::size_t i = 0u, o = 0u; i < normals.size(); i += 2, o += 3)
+  {
+    const math::Vector3d n = DecodeOctahedral(normals[i], normals[i + 1]);
+    buffer[o] = static_cast<float>(n.X());
+    buffer[o + 1] = static_cast<float>(n.Y());
+    buffer[o + 2] = static_cast<float>(n.Z());
+  }
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+std::vector<float> QuantizedSubMesh::TexCoordBufferBySet(
+    unsigned int _setIndex) const
+{
+  std::vector<float> buffer;
+  auto it = this->dataPtr->texCoords.find(_setIndex);
+  if (it == this->dataPtr->texCoords.end())
+    return buffer;
+
+  buffer.resize(it->second.size());
+  std::transform(it->second.begin(), it->second.end(), buffer.begin(),
+      HalfToFloat);
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+SubMesh QuantizedSubMesh::Decode() const
+{
+  const auto &d = *this->dataPtr;
+  SubMesh subMesh(d.name);
+  subMesh.SetPrimitiveType(d.primitiveType);
+  if (d.materialIndex)
+    subMesh.SetMaterialIndex(*d.materialIndex);
+
+  for (unsigned int i = 0u; i < this->VertexCount(); ++i)
+    subMesh.AddVertex(d.DecodeVertex(i));
+  for (std::size_t i = 0u; i < d.normals.size(); i += 2)
+    subMesh.AddNormal(DecodeOctahedral(d.normals[i], d.normals[i + 1]));
+  for (const auto &[set, uv] : d.texCoords)
+  {
+    for (std::size_t i = 0u; i < uv.size(); i += 2)
+    {
+      subMesh.AddTexCoordBySet(HalfToFloat(uv[i]), HalfToFloat(uv[i + 1]),
+          set);
+    }
+  }
+
+  const SubMesh::IndexView indices = this->Indices();
+  for (std::size_t i = 0u; i < indices.Count(); ++i)
+    subMesh.AddIndex(indices[i]);
+
+  for (const auto &na : d.nodeAssignments)
+    subMesh.AddNodeAssignment(na.vertexIndex, na.nodeIndex, na.weight);
+  return subMesh;
+}
+
+//////////////////////////////////////////////////
+std::size_t QuantizedSubMesh::MemorySize() const
+{
+  const auto &d = *this->dataPtr;
+  std::size_t size = d.positions.size() * sizeof(uint16_t) +
+      d.normals.size() * sizeof(int16_t) +
+      d.indices16.size() * sizeof(uint16_t) +
+      d.indices32.size() * sizeof(uint32_t) +
+      d.nodeAssignments.size() * sizeof(NodeAssignment);
+  for (const auto &uv : d.texCoords)
+    size += uv.second.size() * sizeof(uint16_t);
+  return size;
+}
+
+//////////////////////////////////////////////////
+std::size_t QuantizedSubMesh::SourceMemorySize() const
+{
+  return this->dataPtr->sourceMemorySize;
+}
+
+//////////////////////////////////////////////////
+QuantizedMesh::QuantizedMesh()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+QuantizedMesh::QuantizedMesh(const Mesh &_mesh)
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->name = _mesh.Name();
+  this->dataPtr->path = _mesh.Path();
+  this->dataPtr->skeleton = _mesh.MeshSkeleton();
+  for (unsigned int i = 0u; i < _mesh.MaterialCount(); ++i)
+    this->dataPtr->materials.push_back(_mesh.MaterialByIndex(i));
+
+  this->dataPtr->subMeshes.reserve(_mesh.SubMeshCount());
+  for (unsigned int i = 0u; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (subMesh)
+      this->dataPtr->subMeshes.emplace_back(*subMesh);
+  }
+}
+
+//////////////////////////////////////////////////
+std::string QuantizedMesh::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+std::string QuantizedMesh::Path() const
+{
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedMesh::SubMeshCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->subMeshes.size());
+}
+
+//////////////////////////////////////////////////
+const QuantizedSubMesh *QuantizedMesh::SubMeshByIndex(
+    unsigned int _index) const
+{
+  if (_index >= this->dataPtr->subMeshes.size())
+  {
+    gzerr << "Invalid index: " << _index << " >= "
+          << this->dataPtr->subMeshes.size() << std::endl;
+    return nullptr;
+  }
+  return &this->dataPtr->subMeshes[_index];
+}
+
+//////////////////////////////////////////////////
+unsigned int QuantizedMesh::MaterialCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->materials.size());
+}
+
+//////////////////////////////////////////////////
+MaterialPtr QuantizedMesh::MaterialByIndex(unsigned int _index) const
+{
+  if (_index >= this->dataPtr->materials.size())
+    return nullptr;
+  return this->dataPtr->materials[_index];
+}
+
+//////////////////////////////////////////////////
+SkeletonPtr QuantizedMesh::MeshSkeleton() const
+{
+  return this->dataPtr->skeleton;
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<Mesh> QuantizedMesh::Decode() const
+{
+  auto mesh = std::make_unique<Mesh>();
+  mesh->SetName(this->dataPtr->name);
+  mesh->SetPath(this->dataPtr->path);
+  mesh->SetSkeleton(this->dataPtr->skeleton);
+  for (const auto &material : this->dataPtr->materials)
+    mesh->AddMaterial(material);
+  for (const auto &subMesh : this->dataPtr->subMeshes)
+    mesh->AddSubMesh(subMesh.Decode());
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+std::size_t QuantizedMesh::MemorySize() const
+{
+  std::size_t size = 0u;
+  for (const auto &subMesh : this->dataPtr->subMeshes)
+    size += subMesh.MemorySize();
+  return size;
+}
+
+//////////////////////////////////////////////////
+std::size_t QuantizedMesh::SourceMemorySize() const
+{
+  std::size_t size = 0u;
+  for (const auto &subMesh : this->dataPtr->subMeshes)
+    size += subMesh.SourceMemorySize();
+  return size;
+}
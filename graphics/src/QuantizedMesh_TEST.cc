@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+#include "gz/common/Material.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshManager.hh"
+#include "gz/common/QuantizedMesh.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class QuantizedMesh : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(QuantizedMesh, SubMesh)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("quantized_sphere", 2.0, 32, 32);
+  const common::Mesh *mesh = mgr->MeshByName("quantized_sphere");
+  ASSERT_NE(nullptr, mesh);
+  auto subMesh = mesh->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+  subMesh->SetMaterialIndex(2);
+
+  common::QuantizedSubMesh quantized(*subMesh);
+  EXPECT_EQ(subMesh->Name(), quantized.Name());
+  EXPECT_EQ(common::SubMesh::TRIANGLES, quantized.SubMeshPrimitiveType());
+  ASSERT_TRUE(quantized.GetMaterialIndex());
+  EXPECT_EQ(2u, *quantized.GetMaterialIndex());
+  EXPECT_EQ(subMesh->Min(), quantized.Min());
+  EXPECT_EQ(subMesh->Max(), quantized.Max());
+  ASSERT_EQ(subMesh->VertexCount(), quantized.VertexCount());
+  ASSERT_EQ(subMesh->NormalCount(), quantized.NormalCount());
+  ASSERT_EQ(1u, quantized.TexCoordSetCount());
+  ASSERT_EQ(subMesh->TexCoordCount(), quantized.TexCoordCountBySet(0));
+  ASSERT_EQ(subMesh->IndexCount(), quantized.IndexCount());
+
+  // Positions are within half a step of 4 / 65535
+  const double positionTol = 0.5 * 4.0 / 65535.0 + 1e-12;
+  for (unsigned int i = 0; i < subMesh->VertexCount(); ++i)
+  {
+    const math::Vector3d v = quantized.Vertex(i);
+    EXPECT_NEAR(subMesh->Vertex(i).X(), v.X(), positionTol);
+    EXPECT_NEAR(subMesh->Vertex(i).Y(), v.Y(), positionTol);
+    EXPECT_NEAR(subMesh->Vertex(i).Z(), v.Z(), positionTol);
+
+    // Normals within 0.01 degree
+    const math::Vector3d n = quantized.Normal(i);
+    EXPECT_NEAR(1.0, n.Length(), 1e-9);
+    EXPECT_GT(n.Dot(subMesh->Normal(i).Normalized()),
+        std::cos(GZ_DTOR(0.01)));
+
+    // Half floats have 11 significant bits
+    const math::Vector2d uv = quantized.TexCoordBySet(i, 0);
+    EXPECT_NEAR(subMesh->TexCoord(i).X(), uv.X(), 1.0 / 2048.0);
+    EXPECT_NEAR(subMesh->TexCoord(i).Y(), uv.Y(), 1.0 / 2048.0);
+  }
+
+  // Indices are unchanged
+  const common::SubMesh::IndexView indices = quantized.Indices();
+  EXPECT_EQ(subMesh->IndexBufferFormat(), indices.Format());
+  for (unsigned int i = 0; i < subMesh->IndexCount(); ++i)
+    EXPECT_EQ(static_cast<unsigned int>(subMesh->Index(i)), indices[i]);
+
+  // Bulk decoding matches decoding on access
+  const std::vector<float> vertices = quantized.VertexBuffer();
+  const std::vector<float> normals = quantized.NormalBuffer();
+  const std::vector<float> texCoords = quantized.TexCoordBufferBySet(0);
+  ASSERT_EQ(3u * quantized.VertexCount(), vertices.size());
+  ASSERT_EQ(3u * quantized.NormalCount(), normals.size());
+  ASSERT_EQ(2u * quantized.TexCoordCountBySet(0), texCoords.size());
+  for (unsigned int i = 0; i < quantized.VertexCount(); ++i)
+  {
+    EXPECT_FLOAT_EQ(static_cast<float>(quantized.Vertex(i).Z()),
+        vertices[3 * i + 2]);
+    EXPECT_FLOAT_EQ(static_cast<float>(quantized.Normal(i).Y()),
+        normals[3 * i + 1]);
+    EXPECT_FLOAT_EQ(static_cast<float>(quantized.TexCoordBySet(i, 0).X()),
+        texCoords[2 * i]);
+  }
+  EXPECT_TRUE(quantized.TexCoordBufferBySet(1).empty());
+
+  // Vertex data shrinks to a fifth, indices are unchanged
+  EXPECT_GT(quantized.SourceMemorySize(), 0u);
+  EXPECT_LT(quantized.MemorySize(), quantized.SourceMemorySize() / 2);
+
+  // Decoding gives back an equivalent submesh
+  common::SubMesh decoded = quantized.Decode();
+  EXPECT_EQ(subMesh->Name(), decoded.Name());
+  EXPECT_EQ(subMesh->VertexCount(), decoded.VertexCount());
+  EXPECT_EQ(subMesh->NormalCount(), decoded.NormalCount());
+  EXPECT_EQ(subMesh->TexCoordCount(), decoded.TexCoordCount());
+  EXPECT_EQ(subMesh->IndexCount(), decoded.IndexCount());
+  ASSERT_TRUE(decoded.GetMaterialIndex());
+  EXPECT_EQ(2u, *decoded.GetMaterialIndex());
+  EXPECT_NEAR(subMesh->Volume(), decoded.Volume(), 1e-3);
+
+  // Out of bounds access
+  EXPECT_EQ(math::Vector3d::Zero, quantized.Vertex(100000));
+  EXPECT_EQ(math::Vector3d::Zero, quantized.Normal(100000));
+  EXPECT_EQ(math::Vector2d::Zero, quantized.TexCoordBySet(100000, 0));
+  EXPECT_EQ(math::Vector2d::Zero, quantized.TexCoordBySet(0, 3));
+}
+
+/////////////////////////////////////////////////
+TEST_F(QuantizedMesh, FlatAndSkinned)
+{
+  // Flat submesh with a restart, node assignments and extreme normals
+  common::SubMesh strip("strip");
+  strip.SetPrimitiveType(common::SubMesh::TRISTRIPS);
+  strip.AddVertex(-1, 2, 0);
+  strip.AddVertex(1, 2, 0);
+  strip.AddVertex(-1, 4, 0);
+  strip.AddVertex(1, 4, 0);
+  strip.AddNormal(math::Vector3d::UnitZ);
+  strip.AddNormal(-math::Vector3d::UnitZ);
+  strip.AddNormal(math::Vector3d(-1, -1, -1).Normalize());
+  strip.AddNormal(math::Vector3d(1, 0, 0));
+  strip.AddTexCoord(-0.5, 100.25);
+  strip.AddTexCoord(0.0, 1.0);
+  strip.AddTexCoord(1e-5, 0.3);
+  strip.AddTexCoord(1.0, 0.0);
+  strip.AddIndex(0);
+  strip.AddIndex(1);
+  strip.AddIndex(2);
+  strip.AddPrimitiveRestart();
+  strip.AddIndex(1);
+  strip.AddIndex(2);
+  strip.AddIndex(3);
+  strip.AddNodeAssignment(2, 5, 0.25f);
+
+  common::QuantizedSubMesh quantized(strip);
+  for (unsigned int i = 0; i < strip.VertexCount(); ++i)
+  {
+    // Flat axes and corners are exact
+    EXPECT_EQ(strip.Vertex(i), quantized.Vertex(i));
+    EXPECT_GT(quantized.Normal(i).Dot(strip.Normal(i)), 0.9999999);
+  }
+  EXPECT_DOUBLE_EQ(-0.5, quantized.TexCoordBySet(0, 0).X());
+  EXPECT_DOUBLE_EQ(100.25, quantized.TexCoordBySet(0, 0).Y());
+  EXPECT_NEAR(1e-5, quantized.TexCoordBySet(2, 0).X(), 1e-7);
+  ASSERT_EQ(1u, quantized.NodeAssignmentsCount());
+  EXPECT_EQ(2u, quantized.NodeAssignmentByIndex(0).vertexIndex);
+  EXPECT_EQ(5u, quantized.NodeAssignmentByIndex(0).nodeIndex);
+  EXPECT_FLOAT_EQ(0.25f, quantized.NodeAssignmentByIndex(0).weight);
+
+  common::SubMesh decoded = quantized.Decode();
+  EXPECT_EQ(common::SubMesh::TRISTRIPS, decoded.SubMeshPrimitiveType());
+  EXPECT_TRUE(decoded.HasPrimitiveRestart());
+  EXPECT_TRUE(decoded.HasValidIndices());
+  EXPECT_EQ(7u, decoded.IndexCount());
+  EXPECT_EQ(1u, decoded.NodeAssignmentsCount());
+
+  // Empty submesh
+  common::QuantizedSubMesh empty{common::SubMesh()};
+  EXPECT_EQ(0u, empty.VertexCount());
+  EXPECT_EQ(0u, empty.MemorySize());
+  EXPECT_TRUE(empty.VertexBuffer().empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(QuantizedMesh, Mesh)
+{
+  auto *mgr = common::MeshManager::Instance();
+  mgr->CreateBox("quantized_box", math::Vector3d(1, 2, 3),
+      math::Vector2d(1, 1));
+  const common::Mesh *box = mgr->MeshByName("quantized_box");
+  ASSERT_NE(nullptr, box);
+
+  common::Mesh mesh;
+  mesh.SetName("quantized_mesh");
+  mesh.SetPath("/tmp/quantized");
+  auto material = std::make_shared<common::Material>();
+  mesh.AddMaterial(material);
+  mesh.AddSubMesh(*box->SubMeshByIndex(0).lock());
+  common::SubMesh translated(*box->SubMeshByIndex(0).lock());
+  translated.Translate(math::Vector3d(10, 0, 0));
+  mesh.AddSubMesh(translated);
+
+  common::QuantizedMesh quantized(mesh);
+  EXPECT_EQ("quantized_mesh", quantized.Name());
+  EXPECT_EQ("/tmp/quantized", quantized.Path());
+  ASSERT_EQ(2u, quantized.SubMeshCount());
+  EXPECT_EQ(nullptr, quantized.SubMeshByIndex(2));
+  ASSERT_EQ(1u, quantized.MaterialCount());
+  EXPECT_EQ(material, quantized.MaterialByIndex(0));
+  EXPECT_EQ(nullptr, quantized.MaterialByIndex(1));
+  EXPECT_EQ(nullptr, quantized.MeshSkeleton());
+  EXPECT_EQ(quantized.SubMeshByIndex(0)->MemorySize() +
+      quantized.SubMeshByIndex(1)->MemorySize(), quantized.MemorySize());
+  EXPECT_LT(quantized.MemorySize(), quantized.SourceMemorySize());
+
+  std::unique_ptr<common::Mesh> decoded = quantized.Decode();
+  EXPECT_EQ("quantized_mesh", decoded->Name());
+  EXPECT_EQ("/tmp/quantized", decoded->Path());
+  ASSERT_EQ(2u, decoded->SubMeshCount());
+  EXPECT_EQ(material, decoded->MaterialByIndex(0));
+  EXPECT_EQ(mesh.Min(), decoded->Min());
+  EXPECT_EQ(mesh.Max(), decoded->Max());
+  EXPECT_DOUBLE_EQ(12.0, decoded->Volume());
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/STLExporter.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "FileWriter.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief Size of the header of a binary STL file, before the face count
+constexpr std::size_t kHeaderSize = 80u;
+
+/// \brief Size of a face in a binary STL file: a normal, three vertices
+/// and a 2 byte attribute
+constexpr std::size_t kFaceSize = 50u;
+
+/////////////////////////////////////////////////
+/// \brief Get the number of triangles a submesh exports
+/// \param[in] _subMesh The submesh
+/// \return Number of triangles, 0 if the submesh is not made of triangles
+uint64_t TriangleCount(const SubMesh &_subMesh)
+{
+  if (_subMesh.SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+    return 0u;
+  const uint64_t count = _subMesh.IndexCount() != 0u ?
+      _subMesh.IndexCount() : _subMesh.VertexCount();
+  return count / 3u;
+}
+}  // namespace
+
+/// \brief Private data for the STLExporter class
+class gz::common::STLExporter::Implementation
+{
+};
+
+//////////////////////////////////////////////////
+STLExporter::STLExporter()
+: MeshExporter(), dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+STLExporter::~STLExporter()
+{
+}
+
+//////////////////////////////////////////////////
+void STLExporter::Export(const Mesh *_mesh, const std::string &_filename,
+    bool /*_exportTextures*/)
+{
+  if (!_mesh)
+  {
+    gzerr << "Unable to export a null mesh to STL\n";
+    return;
+  }
+
+  // The header holds the number of faces, so count them first
+  uint64_t faceCount = 0u;
+  for (unsigned int i = 0u; i < _mesh->SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh->SubMeshByIndex(i).lock();
+    if (!subMesh)
+      continue;
+    if (subMesh->SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+    {
+      gzwarn << "Submesh[" << subMesh->Name() << "] is not made of "
+             << "triangles and is not exported to STL\n";
+    }
+    faceCount += TriangleCount(*subMesh);
+  }
+  if (faceCount > std::numeric_limits<uint32_t>::max())
+  {
+    gzerr << "Mesh[" << _mesh->Name() << "] has " << faceCount
+          << " triangles, more than an STL file can hold\n";
+    return;
+  }
+
+  const std::string filename = _filename + ".stl";
+  FileWriter writer(filename);
+  if (!writer.Valid())
+  {
+    gzerr << "Unable to create file[" << filename << "]\n";
+    return;
+  }
+
+  char header[kHeaderSize] = {};
+  const char name[] = "Exported by gz-common";
+  std::memcpy(header, name, sizeof(name));
+  writer.Write(header, sizeof(header));
+  const uint32_t count = static_cast<uint32_t>(faceCount);
+  writer.Write(&count, sizeof(count));
+
+  for (unsigned int i = 0u; i < _mesh->SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh->SubMeshByIndex(i).lock();
+    if (!subMesh)
+      continue;
+    const uint64_t triangles = TriangleCount(*subMesh);
+    const SubMesh::IndexView indices = subMesh->Indices();
+    const math::Vector3d *vertices = subMesh->VertexPtr();
+    const unsigned int vertexCount = subMesh->VertexCount();
+
+    // Indices that are out of range give the origin, like SubMesh::Vertex
+    auto vertex = [&](std::size_t _corner) -> math::Vector3d
+    {
+      const std::size_t index = indices.Count() != 0u ?
+          indices[_corner] : _corner;
+      return index < vertexCount ? vertices[index] : math::Vector3d::Zero;
+    };
+
+    for (uint64_t t = 0u; t < triangles; ++t)
+    {
+      const math::Vector3d v0 = vertex(3u * t);
+      const math::Vector3d v1 = vertex(3u * t + 1u);
+      const math::Vector3d v2 = vertex(3u * t + 2u);
+      const math::Vector3d normal = (v1 - v0).Cross(v2 - v0).Normalize();
+
+      const float values[12] = {
+          static_cast<float>(normal.X()), static_cast<float>(normal.Y()),
+          static_cast<float>(normal.Z()),
+          static_cast<float>(v0.X()), static_cast<float>(v0.Y()),
+          static_cast<float>(v0.Z()),
+          static_cast<float>(v1.X()), static_cast<float>(v1.Y()),
+          static_cast<float>(v1.Z()),
+          static_cast<float>(v2.X()), static_cast<float>(v2.Y()),
+          static_cast<float>(v2.Z())};
+      char face[kFaceSize] = {};
+      std::memcpy(face, values, sizeof(values));
+      writer.Write(face, sizeof(face));
+    }
+  }
+
+  if (!writer.Close())
+    gzerr << "Unable to write file[" << filename << "]\n";
+}
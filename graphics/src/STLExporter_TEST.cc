@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/STLExporter.hh"
+#include "gz/common/STLLoader.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+
+class STLExporter : public common::testing::AutoLogFixture
+{
+  /// \brief Setup the test fixture. This gets called by gtest.
+  public: void SetUp() override
+  {
+    this->common::testing::AutoLogFixture::SetUp();
+    this->pathOut = common::testing::TempPath();
+    common::createDirectories(this->pathOut);
+  }
+
+  /// \brief Path to temporary output (removed during TearDown)
+  public: std::string pathOut;
+};
+
+/////////////////////////////////////////////////
+TEST_F(STLExporter, ExportCube)
+{
+  common::STLLoader loader;
+  std::unique_ptr<common::Mesh> meshOriginal(
+      loader.Load(common::testing::TestFile("data", "cube.stl")));
+  ASSERT_NE(nullptr, meshOriginal);
+
+  // A submesh of lines is skipped
+  auto lines = meshOriginal->AddSubMesh(
+      std::make_unique<common::SubMesh>()).lock();
+  lines->SetPrimitiveType(common::SubMesh::LINES);
+  lines->AddVertex(0, 0, 0);
+  lines->AddVertex(1, 1, 1);
+
+  const auto filenameOut = common::joinPaths(this->pathOut, "cube_exported");
+  common::STLExporter exporter;
+  exporter.Export(meshOriginal.get(), filenameOut);
+
+  // 80 byte header, face count and 50 bytes per face
+  const auto filenameOutExt = filenameOut + ".stl";
+  ASSERT_TRUE(common::exists(filenameOutExt));
+  EXPECT_EQ(84u + 50u * 12u, std::filesystem::file_size(filenameOutExt));
+
+  std::unique_ptr<common::Mesh> meshReloaded(loader.Load(filenameOutExt));
+  ASSERT_NE(nullptr, meshReloaded);
+  ASSERT_EQ(1u, meshReloaded->SubMeshCount());
+  auto original = meshOriginal->SubMeshByIndex(0u).lock();
+  auto reloaded = meshReloaded->SubMeshByIndex(0u).lock();
+  ASSERT_EQ(original->IndexCount(), reloaded->IndexCount());
+  for (unsigned int i = 0u; i < original->IndexCount(); ++i)
+  {
+    const unsigned int o = static_cast<unsigned int>(original->Index(i));
+    const unsigned int r = static_cast<unsigned int>(reloaded->Index(i));
+    EXPECT_EQ(original->Vertex(o), reloaded->Vertex(r)) << i;
+    EXPECT_EQ(original->Normal(o), reloaded->Normal(r)) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(STLExporter, InvalidOutput)
+{
+  common::STLExporter exporter;
+  exporter.Export(nullptr, common::joinPaths(this->pathOut, "null"));
+  EXPECT_FALSE(common::exists(common::joinPaths(this->pathOut, "null.stl")));
+
+  // The directory does not exist
+  common::Mesh mesh;
+  const auto filenameOut = common::joinPaths(this->pathOut, "missing",
+      "mesh");
+  exporter.Export(&mesh, filenameOut);
+  EXPECT_FALSE(common::exists(filenameOut + ".stl"));
+}
@@ -14,10 +14,20 @@
  * limitations under the License.
  *
  */
-#include <string.h>
-#include <ctype.h>
-#include <stdio.h>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/common/Console.hh"
@@ -25,27 +35,351 @@
 #include "gz/common/SubMesh.hh"
 #include "gz/common/STLLoader.hh"
 
+#include "MappedFile.hh"
+#include "Parallel.hh"
+
 using namespace gz;
 using namespace common;
 
 namespace {
-/// \brief Append a vertex with its face normal and index it at its own
-/// position (no deduplication). Shared by the ASCII and binary readers.
-/// \param[in,out] _subMesh Submesh to append the vertex, normal and index to.
-/// \param[in] _vertex Vertex position to append.
-/// \param[in] _normal Face normal associated with the vertex.
-void AppendVertex(SubMesh &_subMesh,
-    const gz::math::Vector3d &_vertex, const gz::math::Vector3d &_normal)
+/// \brief Size of the header of a binary STL file
+constexpr std::size_t kBinaryHeaderSize = 84u;
+
+/// \brief Size of a face in a binary STL file: a normal, three vertices
+/// and a 2 byte attribute
+constexpr std::size_t kBinaryFaceSize = 50u;
+
+/// \brief Number of faces or vertices above which they are decoded and
+/// welded on several threads
+constexpr std::size_t kParallelSize = 3u * 65536u;
+
+/////////////////////////////////////////////////
+/// \brief A vertex of a triangle, with the normal of the triangle, as
+/// stored in the file
+struct Corner
+{
+  /// \brief Position
+  float position[3];
+
+  /// \brief Face normal
+  float normal[3];
+};
+static_assert(sizeof(Corner) == 6u * sizeof(float),
+    "Corner must be six packed floats");
+
+/////////////////////////////////////////////////
+/// \brief Get the bits of the values of a corner, with -0 turned into 0 so
+/// the two compare equal. NaNs compare equal to NaNs with the same bits.
+/// \param[in] _c The corner
+/// \param[out] _bits Bits of the position, then the normal
+void CornerBits(const Corner &_c, uint32_t _bits[6])
+{
+  float values[6];
+  for (int i = 0; i < 3; ++i)
+  {
+    values[i] = _c.position[i] == 0.0f ? 0.0f : _c.position[i];
+    values[i + 3] = _c.normal[i] == 0.0f ? 0.0f : _c.normal[i];
+  }
+  std::memcpy(_bits, values, sizeof(values));
+}
+
+/////////////////////////////////////////////////
+/// \brief Hash of a corner
+struct CornerHash
+{
+  std::size_t operator()(const Corner &_c) const
+  {
+    uint32_t bits[6];
+    CornerBits(_c, bits);
+    uint64_t h = 0x9e3779b97f4a7c15ull;
+    for (const uint32_t b : bits)
+    {
+      h ^= b;
+      h *= 0xff51afd7ed558ccdull;
+      h ^= h >> 32;
+    }
+    return static_cast<std::size_t>(h);
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Equality of corners, consistent with CornerHash
+struct CornerEqual
+{
+  bool operator()(const Corner &_a, const Corner &_b) const
+  {
+    uint32_t a[6];
+    uint32_t b[6];
+    CornerBits(_a, a);
+    CornerBits(_b, b);
+    return std::memcmp(a, b, sizeof(a)) == 0;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Find, for every corner, the first corner equal to it. Corners
+/// are split into shards by hash, and each shard is searched in order on
+/// its own thread, so the result does not depend on the number of threads.
+/// \param[in] _corners Corners to weld
+/// \return Index of the first corner equal to each corner
+std::vector<uint32_t> WeldCorners(const std::vector<Corner> &_corners)
+{
+  std::vector<std::size_t> hashes(_corners.size());
+  parallel::ForRanges(_corners.size(), kParallelSize,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        CornerHash hash;
+        for (std::size_t i = _begin; i < _end; ++i)
+          hashes[i] = hash(_corners[i]);
+      });
+
+  const std::size_t shards =
+      _corners.size() < kParallelSize ? 1u : parallel::Concurrency();
+  std::vector<uint32_t> first(_corners.size());
+  auto weld = [&](std::size_t _shard)
+  {
+    // The hash is reused, and the table holds indices of corners
+    auto hash = [&hashes](uint32_t _i) { return hashes[_i]; };
+    auto equal = [&_corners](uint32_t _a, uint32_t _b)
+    {
+      return CornerEqual()(_corners[_a], _corners[_b]);
+    };
+    std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)>
+        seen(_corners.size() / shards + 1u, hash, equal);
+    for (std::size_t i = 0u; i < _corners.size(); ++i)
+    {
+      if (hashes[i] % shards != _shard)
+        continue;
+      const uint32_t index = static_cast<uint32_t>(i);
+      first[i] = seen.emplace(index, index).first->second;
+    }
+  };
+
+  std::vector<std::function<void()>> tasks;
+  for (std::size_t shard = 0u; shard < shards; ++shard)
+    tasks.push_back([&weld, shard]() { weld(shard); });
+  parallel::Run(tasks);
+  return first;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the positions and normals of corners to a submesh
+/// \param[in] _corners Corners to add
+/// \param[in] _count Number of corners
+/// \param[out] _subMesh Submesh to add the vertices and normals to
+void AddCorners(const Corner *_corners, std::size_t _count,
+    SubMesh &_subMesh)
 {
-  _subMesh.AddVertex(_vertex);
-  _subMesh.AddNormal(_normal);
-  _subMesh.AddIndex(_subMesh.VertexCount() - 1);
+  if (_count == 0u)
+    return;
+  // The corners are read as arrays of floats, 6 floats apart
+  _subMesh.AddVertices(_corners->position, _count, 6u);
+  _subMesh.AddNormals(_corners->normal, _count, 6u);
 }
+
+/////////////////////////////////////////////////
+/// \brief Fill a submesh with the corners of a list of triangles
+/// \param[in] _corners Three corners per triangle
+/// \param[in] _weld True to merge equal corners into one vertex
+/// \param[out] _subMesh Submesh to add the vertices, normals and indices to
+void FillSubMesh(const std::vector<Corner> &_corners, bool _weld,
+    SubMesh &_subMesh)
+{
+  std::vector<unsigned int> indices(_corners.size());
+  if (!_weld)
+  {
+    for (std::size_t i = 0u; i < _corners.size(); ++i)
+      indices[i] = static_cast<unsigned int>(i);
+    AddCorners(_corners.data(), _corners.size(), _subMesh);
+    _subMesh.AddIndices(indices.data(), indices.size());
+    return;
+  }
+
+  // Vertices are numbered in the order they first appear
+  const std::vector<uint32_t> first = WeldCorners(_corners);
+  std::vector<Corner> vertices;
+  for (std::size_t i = 0u; i < _corners.size(); ++i)
+  {
+    if (first[i] == i)
+    {
+      indices[i] = static_cast<unsigned int>(vertices.size());
+      vertices.push_back(_corners[i]);
+    }
+    else
+    {
+      indices[i] = indices[first[i]];
+    }
+  }
+  AddCorners(vertices.data(), vertices.size(), _subMesh);
+  _subMesh.AddIndices(indices.data(), indices.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a file from the current position to its end
+/// \param[in] _filein The file
+/// \return The bytes read
+std::string ReadToEnd(FILE *_filein)
+{
+  std::string contents;
+  char buffer[65536];
+  std::size_t count;
+  while ((count = std::fread(buffer, 1u, sizeof(buffer), _filein)) > 0u)
+    contents.append(buffer, count);
+  return contents;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a buffer has exactly the size of a binary STL file with
+/// the face count in its header
+/// \param[in] _data Contents of the file
+/// \param[in] _size Size of the file in bytes
+/// \return True if the file is binary
+bool IsBinary(const char *_data, std::size_t _size)
+{
+  if (_size < kBinaryHeaderSize)
+    return false;
+  uint32_t faceCount;
+  std::memcpy(&faceCount, _data + 80, sizeof(faceCount));
+  return _size == kBinaryHeaderSize + kBinaryFaceSize * faceCount;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check if a character separates tokens
+/// \param[in] _c Character
+/// \return True for spaces, tabs and line endings
+bool IsSpace(char _c)
+{
+  return std::isspace(static_cast<unsigned char>(_c)) != 0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Take the next whitespace separated token from a line
+/// \param[in,out] _line Rest of the line, advanced past the token
+/// \return The token, empty at the end of the line
+std::string_view NextToken(std::string_view &_line)
+{
+  std::size_t begin = 0u;
+  while (begin < _line.size() && IsSpace(_line[begin]))
+    ++begin;
+  std::size_t end = begin;
+  while (end < _line.size() && !IsSpace(_line[end]))
+    ++end;
+  const std::string_view token = _line.substr(begin, end - begin);
+  _line.remove_prefix(end);
+  return token;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare two strings, disregarding case
+/// \param[in] _a First string
+/// \param[in] _b Second string
+/// \return True if the strings are equal
+bool EqualsIgnoreCase(std::string_view _a, std::string_view _b)
+{
+  return _a.size() == _b.size() &&
+      std::equal(_a.begin(), _a.end(), _b.begin(), [](char _x, char _y)
+          {
+            return std::toupper(static_cast<unsigned char>(_x)) ==
+                std::toupper(static_cast<unsigned char>(_y));
+          });
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the number at the start of a token, like scanf's %e
+/// \param[in] _token Token
+/// \param[out] _value The number
+/// \return False if the token does not start with a number
+bool ParseFloat(std::string_view _token, float &_value)
+{
+  if (_token.size() > 1u && _token[0] == '+')
+    _token.remove_prefix(1u);
+#if defined(__cpp_lib_to_chars)
+  auto result = std::from_chars(_token.data(), _token.data() + _token.size(),
+      _value);
+  if (result.ec == std::errc())
+    return true;
+  if (result.ec == std::errc::invalid_argument)
+    return false;
+#endif
+  // Out of range values are clamped like scanf does. The token is not
+  // null terminated, so it is copied for strtof.
+  char buffer[64];
+  if (_token.empty() || _token.size() >= sizeof(buffer))
+    return false;
+  std::memcpy(buffer, _token.data(), _token.size());
+  buffer[_token.size()] = '\0';
+  char *end = nullptr;
+  _value = std::strtof(buffer, &end);
+  return end != buffer;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the three numbers after the first word of a line, like
+/// "vertex 1 2 3"
+/// \param[in] _line The line
+/// \param[out] _values The numbers
+/// \return Number of values parsed
+int ParseTriple(std::string_view _line, float _values[3])
+{
+  NextToken(_line);
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!ParseFloat(NextToken(_line), _values[i]))
+      return i;
+  }
+  return 3;
+}
+
+/////////////////////////////////////////////////
+/// \brief Splits a buffer into lines without copying
+class LineReader
+{
+  /// \brief Constructor
+  /// \param[in] _data Text to read
+  /// \param[in] _size Size of the text in bytes
+  public: LineReader(const char *_data, std::size_t _size)
+    : text(_data, _size)
+  {
+  }
+
+  /// \brief Get the next line
+  /// \param[out] _line The line, without its line ending
+  /// \return False at the end of the text
+  public: bool Next(std::string_view &_line)
+  {
+    if (this->text.empty())
+      return false;
+    const std::size_t end = this->text.find('\n');
+    _line = this->text.substr(0u, end);
+    this->text.remove_prefix(
+        end == std::string_view::npos ? this->text.size() : end + 1u);
+    return true;
+  }
+
+  /// \brief Text that has not been read
+  private: std::string_view text;
+};
 }  // namespace
 
 //////////////////////////////////////////////////
 class gz::common::STLLoader::Implementation
 {
+  /// \brief Read an ASCII STL file
+  /// \param[in] _data Contents of the file
+  /// \param[in] _size Size of the file in bytes
+  /// \param[out] _mesh Mesh to add the submesh to
+  /// \return True if any triangle was read
+  public: bool ReadAscii(const char *_data, std::size_t _size, Mesh *_mesh);
+
+  /// \brief Read a binary STL file
+  /// \param[in] _data Contents of the file
+  /// \param[in] _size Size of the file in bytes
+  /// \param[out] _mesh Mesh to add the submesh to
+  /// \return True if all the faces in the header were read
+  public: bool ReadBinary(const char *_data, std::size_t _size, Mesh *_mesh);
+
+  /// \brief True to merge equal vertices
+  public: bool weldVertices = false;
 };
 
 //////////////////////////////////////////////////
@@ -63,9 +397,9 @@ STLLoader::~STLLoader()
 //////////////////////////////////////////////////
 Mesh *STLLoader::Load(const std::string &_filename)
 {
-  FILE *file = fopen(_filename.c_str(), "r");
+  MappedFile file(_filename);
 
-  if (!file)
+  if (!file.valid)
   {
     gzerr << "Unable to open file[" << _filename << "]\n";
     return nullptr;
@@ -73,118 +407,92 @@ Mesh *STLLoader::Load(const std::string &_filename)
 
   Mesh *mesh = new Mesh();
 
-  // Try to read ASCII first. If that fails, try binary
-  if (!this->ReadAscii(file, mesh))
-  {
-    fclose(file);
-    file = fopen(_filename.c_str(), "rb");
-    if (!this->ReadBinary(file, mesh))
-      gzerr << "Unable to read STL[" << _filename << "]\n";
-  }
+  // A file with exactly the size of a binary STL is binary, even if its
+  // header starts with "solid". Otherwise try ASCII first, then binary.
+  bool read = IsBinary(file.data, file.size) &&
+      this->dataPtr->ReadBinary(file.data, file.size, mesh);
+  if (!read)
+    read = this->dataPtr->ReadAscii(file.data, file.size, mesh);
+  if (!read && !this->dataPtr->ReadBinary(file.data, file.size, mesh))
+    gzerr << "Unable to read STL[" << _filename << "]\n";
 
-  fclose(file);
   return mesh;
 }
 
 //////////////////////////////////////////////////
-bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
+void STLLoader::SetWeldVertices(bool _weld)
 {
-  int count;
-  char *next;
-  float r1;
-  float r2;
-  float r3;
-  float r4;
-  char token[LINE_MAX_LEN];
-  int width;
-  char input[LINE_MAX_LEN];
-  bool result = true;
-  char name[LINE_MAX_LEN] = "";
-
-  SubMesh subMesh;
-
-  // Read the next line of the file into INPUT.
-  while (fgets (input, LINE_MAX_LEN, _filein) != nullptr)
-  {
-    // Advance to the first nonspace character in INPUT.
-    for (next = input; *next != '\0' && iswspace(*next); ++next)
-    {
-    }
+  this->dataPtr->weldVertices = _weld;
+}
 
-    // Skip blank lines and comments.
-    if (*next == '\0' || *next == '#' || *next == '!' || *next == '$')
-      continue;
+//////////////////////////////////////////////////
+bool STLLoader::WeldVertices() const
+{
+  return this->dataPtr->weldVertices;
+}
+
+//////////////////////////////////////////////////
+bool STLLoader::Implementation::ReadAscii(const char *_data,
+    std::size_t _size, Mesh *_mesh)
+{
+  LineReader reader(_data, _size);
+  std::string_view input;
+  std::string name;
+  std::vector<Corner> corners;
 
+  while (reader.Next(input))
+  {
     // Extract the first word in this line.
-    // cppcheck-suppress invalidscanf
-    sscanf(next, "%s%n", token, &width);
+    std::string_view next = input;
+    const std::string_view token = NextToken(next);
 
-    // Set NEXT to point to just after this token.
-    next = next + width;
+    // Skip blank lines and comments.
+    if (token.empty() || token[0] == '#' || token[0] == '!' ||
+        token[0] == '$')
+    {
+      continue;
+    }
 
     // FACET
-    if (this->Leqi(token, const_cast<char*>("facet")))
+    if (EqualsIgnoreCase(token, "facet"))
     {
-      gz::math::Vector3d normal;
-
       // Get the XYZ coordinates of the normal vector to the face.
-      sscanf(next, "%*s %e %e %e", &r1, &r2, &r3);
+      float normal[3] = {0.0f, 0.0f, 0.0f};
+      ParseTriple(next, normal);
 
-      normal.X(r1);
-      normal.Y(r2);
-      normal.Z(r3);
-
-      if (fgets (input, LINE_MAX_LEN, _filein) == nullptr)
-      {
-        result = false;
+      // Skip "outer loop"
+      if (!reader.Next(input))
         break;
-      }
 
-      for (; result; )
+      // Read vertices until "endloop"
+      bool complete = true;
+      Corner corner;
+      std::copy(normal, normal + 3, corner.normal);
+      while ((complete = reader.Next(input)) &&
+             ParseTriple(input, corner.position) == 3)
       {
-        gz::math::Vector3d vertex;
-        if (fgets (input, LINE_MAX_LEN, _filein) == nullptr)
-        {
-          result = false;
-          break;
-        }
-
-        count = sscanf(input, "%*s %e %e %e", &r1, &r2, &r3);
-
-        if (count != 3)
-          break;
-
-        vertex.X(r1);
-        vertex.Y(r2);
-        vertex.Z(r3);
-
-        AppendVertex(subMesh, vertex, normal);
+        corners.push_back(corner);
       }
 
-      if (fgets (input, LINE_MAX_LEN, _filein) == nullptr)
-      {
-        result = false;
+      // Skip "endfacet"
+      if (!complete || !reader.Next(input))
         break;
-      }
     }
     // COLOR
-    else if (this->Leqi (token, const_cast<char*>("color")))
+    else if (EqualsIgnoreCase(token, "color"))
     {
-      sscanf(next, "%*s %f %f %f %f", &r1, &r2, &r3, &r4);
     }
     // SOLID
-    else if (this->Leqi (token, const_cast<char*>("solid")))
+    else if (EqualsIgnoreCase(token, "solid"))
     {
-      sscanf(next, "%s", name);
+      name = std::string(NextToken(next));
     }
     // ENDSOLID
-    else if (this->Leqi (token, const_cast<char*>("endsolid")))
+    else if (EqualsIgnoreCase(token, "endsolid"))
     {
       // warn if name after 'endsolid 'is different from name after 'solid'
-      char endSolidName[LINE_MAX_LEN] = "";
-      sscanf(next, "%s", endSolidName);
-
-      if (strcmp(endSolidName, name) != 0)
+      const std::string_view endSolidName = NextToken(next);
+      if (endSolidName != name)
       {
         gzwarn << "End solid name: [" << endSolidName << \
         "] is not the same as solid name [" << name << "]\n";
@@ -193,128 +501,59 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
     // Unexpected or unrecognized.
     else
     {
-      /*printf("\n");
-      printf("stl - Fatal error!\n");
-      printf(" Unrecognized first word on line.\n");
-      */
-      result = false;
       break;
     }
   }
 
-  result = subMesh.VertexCount() > 0;
-
-  if (result)
-  {
-    std::string meshName(name);
-    subMesh.SetName(meshName);
-    _mesh->AddSubMesh(subMesh);
-  }
+  if (corners.empty())
+    return false;
 
-  return result;
+  auto subMesh = std::make_unique<SubMesh>(name);
+  FillSubMesh(corners, this->weldVertices, *subMesh);
+  _mesh->AddSubMesh(std::move(subMesh));
+  return true;
 }
 
 //////////////////////////////////////////////////
-bool STLLoader::ReadBinary(FILE *_filein, Mesh *_mesh)
+bool STLLoader::Implementation::ReadBinary(const char *_data,
+    std::size_t _size, Mesh *_mesh)
 {
-  int i;
-  int iface;
-  int face_num;
-
-  SubMesh subMesh;
-
-  // 80 byte Header.
-  for (i = 0; i < 80; ++i)
-    fgetc(_filein);
-
-  // Number of faces.
-  face_num = this->LongIntRead(_filein);
+  if (_size < kBinaryHeaderSize)
+    return false;
 
-  gz::math::Vector3d normal;
-  gz::math::Vector3d vertex;
+  // 80 byte header, then the number of faces
+  uint32_t faceCount;
+  std::memcpy(&faceCount, _data + 80, sizeof(faceCount));
+  if ((_size - kBinaryHeaderSize) / kBinaryFaceSize < faceCount)
+    return false;
 
   // For each (triangular) face,
   // components of normal vector,
   // coordinates of three vertices,
   // 2 byte "attribute".
-  for (iface = 0; iface < face_num; iface++)
-  {
-    if (!this->FloatRead(_filein, normal.X()))
-      return false;
-    if (!this->FloatRead(_filein, normal.Y()))
-      return false;
-    if (!this->FloatRead(_filein, normal.Z()))
-      return false;
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-
-    AppendVertex(subMesh, vertex, normal);
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-    AppendVertex(subMesh, vertex, normal);
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-    AppendVertex(subMesh, vertex, normal);
-
-    uint16_t shortTmp;
-    if (!ShortIntRead(_filein, shortTmp))
-      return false;
-  }
-
-  _mesh->AddSubMesh(subMesh);
-  return true;
-}
-
-//////////////////////////////////////////////////
-bool STLLoader::Leqi(char* _string1, char* _string2)
-{
-  int i;
-  int nchar;
-  int nchar1;
-  int nchar2;
-
-  nchar1 = strlen(_string1);
-  nchar2 = strlen(_string2);
-
-  if (nchar1 < nchar2)
-    nchar = nchar1;
-  else
-    nchar = nchar2;
-
-  // The strings are not equal if they differ over their common length.
-  for (i = 0; i < nchar; ++i)
-    if (toupper (_string1[i]) != toupper (_string2[i]))
-      return false;
-
-  // The strings are not equal if the longer one includes nonblanks in the tail.
-  if (nchar1 > nchar)
-  {
-    for (i = nchar; i < nchar1; ++i)
-      if (_string1[i] != ' ')
-        return false;
-  }
-  else if (nchar2 > nchar)
-  {
-    for (i = nchar; i < nchar2; ++i)
-      if (_string2[i] != ' ')
-        return false;
-  }
+  std::vector<Corner> corners(3u * static_cast<std::size_t>(faceCount));
+  parallel::ForRanges(faceCount, kParallelSize,
+      [&](std::size_t _begin, std::size_t _end)
+      {
+        for (std::size_t face = _begin; face < _end; ++face)
+        {
+          float values[12];
+          std::memcpy(values,
+              _data + kBinaryHeaderSize + face * kBinaryFaceSize,
+              sizeof(values));
+          for (std::size_t v = 0u; v < 3u; ++v)
+          {
+            Corner &corner = corners[3u * face + v];
+            std::copy(values, values + 3, corner.normal);
+            std::copy(values + 3 * (v + 1), values + 3 * (v + 2),
+                corner.position);
+          }
+        }
+      });
 
+  auto subMesh = std::make_unique<SubMesh>();
+  FillSubMesh(corners, this->weldVertices, *subMesh);
+  _mesh->AddSubMesh(std::move(subMesh));
   return true;
 }
 
@@ -342,45 +581,59 @@ int STLLoader::RcolFind(float _a[][COR3_MAX], int _m, int _n, float _r[])
 }
 
 //////////////////////////////////////////////////
-bool STLLoader::FloatRead(FILE *_filein, double &_value)
+bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
 {
-  float v;
-  if (fread (&v, sizeof(v), 1, _filein) == 0)
-    return false;
+  const std::string contents = ReadToEnd(_filein);
+  return this->dataPtr->ReadAscii(contents.data(), contents.size(), _mesh);
+}
 
-  _value = v;
-  return true;
+//////////////////////////////////////////////////
+bool STLLoader::ReadBinary(FILE *_filein, Mesh *_mesh)
+{
+  const std::string contents = ReadToEnd(_filein);
+  return this->dataPtr->ReadBinary(contents.data(), contents.size(), _mesh);
 }
 
 //////////////////////////////////////////////////
-uint32_t STLLoader::LongIntRead(FILE *_filein)
+bool STLLoader::Leqi(char* _string1, char* _string2)
 {
-  union
+  // The strings are equal if they only differ by trailing blanks
+  std::string_view a(_string1);
+  std::string_view b(_string2);
+  const std::size_t common = std::min(a.size(), b.size());
+  auto blank = [](std::string_view _tail)
   {
-    uint32_t yint;
-    char ychar[4];
-  } y;
-
-  y.ychar[0] = fgetc(_filein);
-  y.ychar[1] = fgetc(_filein);
-  y.ychar[2] = fgetc(_filein);
-  y.ychar[3] = fgetc(_filein);
+    return _tail.find_first_not_of(' ') == std::string_view::npos;
+  };
+  return EqualsIgnoreCase(a.substr(0u, common), b.substr(0u, common)) &&
+      blank(a.substr(common)) && blank(b.substr(common));
+}
 
-  return y.yint;
+//////////////////////////////////////////////////
+uint32_t STLLoader::LongIntRead(FILE *_filein)
+{
+  uint32_t value = 0u;
+  if (std::fread(&value, sizeof(value), 1u, _filein) != 1u)
+    return 0u;
+  return value;
 }
 
 //////////////////////////////////////////////////
 bool STLLoader::ShortIntRead(FILE *_filein, uint16_t &_value)
 {
-  uint8_t c1;
-  uint8_t c2;
-
-  c1 = fgetc(_filein);
-  c2 = fgetc(_filein);
-
-  _value = c1 | (c2 << 8);
-
+  uint8_t bytes[2] = {0u, 0u};
+  if (std::fread(bytes, 1u, 2u, _filein) != 2u)
+    return false;
+  _value = static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
   return true;
 }
 
-
+//////////////////////////////////////////////////
+bool STLLoader::FloatRead(FILE *_filein, double &_value)
+{
+  float v;
+  if (std::fread(&v, sizeof(v), 1u, _filein) != 1u)
+    return false;
+  _value = v;
+  return true;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "gz/common/Console.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/STLLoader.hh"
+#include "gz/common/SubMesh.hh"
+#include "gz/common/TempDirectory.hh"
+#include "gz/common/Util.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+class STLLoaderTest : public common::testing::AutoLogFixture
+{
+  protected: void SetUp() override
+  {
+    common::testing::AutoLogFixture::SetUp();
+    this->temp = std::make_unique<TempDirectory>(
+        "stl_loader", "gz_common", true);
+    ASSERT_TRUE(this->temp->Valid());
+  }
+
+  /// \brief Write a file
+  /// \param[in] _name Name of the file in the temporary directory
+  /// \param[in] _content Content of the file
+  /// \return Path of the file
+  protected: std::string Write(const std::string &_name,
+                 const std::string &_content)
+  {
+    const std::string path =
+        (std::filesystem::path(this->temp->Path()) / _name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << _content;
+    return path;
+  }
+
+  /// \brief Temporary directory of the files
+  protected: std::unique_ptr<TempDirectory> temp;
+};
+
+/////////////////////////////////////////////////
+/// \brief Build a binary STL file
+/// \param[in] _header First bytes of the header
+/// \param[in] _faceCount Number of faces, which are strips of a grid
+/// \return Content of the file
+static std::string BinaryStl(const std::string &_header, uint32_t _faceCount)
+{
+  std::string content(84u + 50u * _faceCount, '\0');
+  std::memcpy(&content[0], _header.data(), _header.size());
+  std::memcpy(&content[80], &_faceCount, sizeof(_faceCount));
+  for (uint32_t face = 0u; face < _faceCount; ++face)
+  {
+    // Pairs of faces make quads along x, sharing two vertices
+    const float x = static_cast<float>(face / 2u);
+    const float values[12] = {0.0f, 0.0f, 1.0f,
+        x, 0.0f, 0.0f,
+        (face % 2u) ? x : x + 1.0f, (face % 2u) ? 1.0f : 0.0f, 0.0f,
+        x + 1.0f, 1.0f, 0.0f};
+    std::memcpy(&content[84u + 50u * face], values, sizeof(values));
+  }
+  return content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that two submeshes have the same triangles
+/// \param[in] _expected Submesh with a vertex per corner
+/// \param[in] _actual Submesh to compare
+static void ExpectSameTriangles(const SubMesh &_expected,
+    const SubMesh &_actual)
+{
+  ASSERT_EQ(_expected.IndexCount(), _actual.IndexCount());
+  for (unsigned int i = 0u; i < _expected.IndexCount(); ++i)
+  {
+    const unsigned int e = static_cast<unsigned int>(_expected.Index(i));
+    const unsigned int a = static_cast<unsigned int>(_actual.Index(i));
+    ASSERT_EQ(_expected.Vertex(e), _actual.Vertex(a)) << i;
+    ASSERT_EQ(_expected.Normal(e), _actual.Normal(a)) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(STLLoaderTest, WeldVertices)
+{
+  common::STLLoader loader;
+  EXPECT_FALSE(loader.WeldVertices());
+
+  for (const std::string file : {"cube.stl", "cube_binary.stl"})
+  {
+    const std::string path = common::testing::TestFile("data", file);
+    loader.SetWeldVertices(false);
+    std::unique_ptr<Mesh> split(loader.Load(path));
+    loader.SetWeldVertices(true);
+    EXPECT_TRUE(loader.WeldVertices());
+    std::unique_ptr<Mesh> welded(loader.Load(path));
+    ASSERT_NE(nullptr, split);
+    ASSERT_NE(nullptr, welded);
+    ASSERT_EQ(1u, split->SubMeshCount());
+    ASSERT_EQ(1u, welded->SubMeshCount());
+
+    // Each face of the cube is two triangles sharing two corners
+    auto splitSubMesh = split->SubMeshByIndex(0u).lock();
+    auto weldedSubMesh = welded->SubMeshByIndex(0u).lock();
+    EXPECT_EQ(36u, splitSubMesh->VertexCount());
+    EXPECT_EQ(24u, weldedSubMesh->VertexCount());
+    EXPECT_EQ(24u, weldedSubMesh->NormalCount());
+    EXPECT_EQ(splitSubMesh->Name(), weldedSubMesh->Name());
+    ExpectSameTriangles(*splitSubMesh, *weldedSubMesh);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(STLLoaderTest, Binary)
+{
+  // Binary files may start with "solid", like ASCII files
+  const std::string path = this->Write("solid.stl",
+      BinaryStl("solid exported", 4u));
+  common::STLLoader loader;
+  std::unique_ptr<Mesh> mesh(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  ASSERT_EQ(1u, mesh->SubMeshCount());
+  auto subMesh = mesh->SubMeshByIndex(0u).lock();
+  EXPECT_EQ(12u, subMesh->VertexCount());
+  EXPECT_EQ(math::Vector3d(0, 0, 0), subMesh->Vertex(0u));
+  EXPECT_EQ(math::Vector3d(1, 0, 0), subMesh->Vertex(1u));
+  EXPECT_EQ(math::Vector3d(0, 0, 1), subMesh->Normal(0u));
+  EXPECT_EQ(math::Vector3d(2, 1, 0), mesh->Max());
+
+  // Trailing bytes are ignored, missing faces are an error
+  std::string content = BinaryStl("", 4u);
+  mesh.reset(loader.Load(this->Write("trailing.stl", content + "xx")));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(12u, mesh->VertexCount());
+  mesh.reset(loader.Load(this->Write("truncated.stl",
+      content.substr(0u, content.size() - 10u))));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(0u, mesh->SubMeshCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(STLLoaderTest, LargeBinary)
+{
+  // Enough faces to decode and weld on several threads
+  const uint32_t faceCount = 100000u;
+  const std::string path = this->Write("large.stl",
+      BinaryStl("", faceCount));
+  common::STLLoader loader;
+  std::unique_ptr<Mesh> split(loader.Load(path));
+  loader.SetWeldVertices(true);
+  std::unique_ptr<Mesh> welded(loader.Load(path));
+  ASSERT_NE(nullptr, split);
+  ASSERT_NE(nullptr, welded);
+
+  auto splitSubMesh = split->SubMeshByIndex(0u).lock();
+  auto weldedSubMesh = welded->SubMeshByIndex(0u).lock();
+  EXPECT_EQ(3u * faceCount, splitSubMesh->VertexCount());
+  // A strip of n quads has 2 * (n + 1) vertices
+  EXPECT_EQ(faceCount + 2u, weldedSubMesh->VertexCount());
+  ExpectSameTriangles(*splitSubMesh, *weldedSubMesh);
+
+  // Vertices are numbered in the order they first appear
+  EXPECT_EQ(0, weldedSubMesh->Index(0u));
+  EXPECT_EQ(1, weldedSubMesh->Index(1u));
+  EXPECT_EQ(2, weldedSubMesh->Index(2u));
+  EXPECT_EQ(0, weldedSubMesh->Index(3u));
+  EXPECT_EQ(3, weldedSubMesh->Index(4u));
+  EXPECT_EQ(2, weldedSubMesh->Index(5u));
+}
+
+/////////////////////////////////////////////////
+TEST_F(STLLoaderTest, Ascii)
+{
+  // Keywords are case insensitive, lines may end with \r\n and numbers may
+  // have a sign or an exponent
+  const std::string path = this->Write("ascii.stl",
+      "SOLID part\r\n"
+      "# comment\r\n"
+      "\r\n"
+      "  facet normal 0 0 +1\r\n"
+      "    outer loop\r\n"
+      "      vertex 0 0 0\r\n"
+      "      vertex 1e0 0 0\r\n"
+      "      VERTEX 1 1 -0.0\r\n"
+      "    endloop\r\n"
+      "  endfacet\r\n"
+      "  facet normal 0 0 1\r\n"
+      "    outer loop\r\n"
+      "      vertex 0 0 0\r\n"
+      "      vertex 1 1 -0.0\r\n"
+      "      vertex 0 1 0\r\n"
+      "    endloop\r\n"
+      "  endfacet\r\n"
+      "endsolid other");
+  common::STLLoader loader;
+  loader.SetWeldVertices(true);
+  std::unique_ptr<Mesh> mesh(loader.Load(path));
+  ASSERT_NE(nullptr, mesh);
+  ASSERT_EQ(1u, mesh->SubMeshCount());
+  auto subMesh = mesh->SubMeshByIndex(0u).lock();
+  EXPECT_EQ("part", subMesh->Name());
+  EXPECT_EQ(6u, subMesh->IndexCount());
+  EXPECT_EQ(4u, subMesh->VertexCount());
+  EXPECT_EQ(math::Vector3d(1, 0, 0), subMesh->Vertex(1u));
+  EXPECT_EQ(math::Vector3d(0, 0, 1), subMesh->Normal(3u));
+  EXPECT_EQ(2, subMesh->Index(4u));
+#ifndef _WIN32
+  common::Console::Root().RawLogger().flush();
+  EXPECT_NE(LogContent().find("is not the same as solid name"),
+      std::string::npos);
+#endif
+
+  // Neither ASCII nor binary
+  mesh.reset(loader.Load(this->Write("empty.stl", "")));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(0u, mesh->SubMeshCount());
+  EXPECT_EQ(nullptr, loader.Load(
+      common::joinPaths(this->temp->Path(), "missing.stl")));
+}
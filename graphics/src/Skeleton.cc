@@ -274,6 +274,12 @@ void Skeleton::SetNumVertAttached(const unsigned int _vertices)
   this->dataPtr->rawNodeWeights.resize(_vertices);
 }
 
+//////////////////////////////////////////////////
+unsigned int Skeleton::NumVertAttached() const
+{
+  return static_cast<unsigned int>(this->dataPtr->rawNodeWeights.size());
+}
+
 //////////////////////////////////////////////////
 void Skeleton::AddVertNodeWeight(
     const unsigned int _vertex, const std::string &_node,
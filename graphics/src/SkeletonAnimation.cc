@@ -15,6 +15,8 @@
  *
 */
 
+#include <iterator>
+
 #include "gz/common/Console.hh"
 #include "gz/common/NodeAnimation.hh"
 #include "gz/common/SkeletonAnimation.hh"
@@ -75,6 +77,17 @@ NodeAnimation *SkeletonAnimation::NodeAnimationByName(
   return nullptr;
 }
 
+//////////////////////////////////////////////////
+NodeAnimation *SkeletonAnimation::NodeAnimationByIndex(
+    const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->animations.size())
+    return nullptr;
+  auto it = this->dataPtr->animations.begin();
+  std::advance(it, _index);
+  return it->second.get();
+}
+
 //////////////////////////////////////////////////
 bool SkeletonAnimation::XDisplacement() const
 {
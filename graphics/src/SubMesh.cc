@@ -16,8 +16,10 @@
  */
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -27,12 +29,249 @@
 #include "gz/common/Material.hh"
 #include "gz/common/SubMesh.hh"
 
+#include "MeshKernels.hh"
+
 using namespace gz;
 using namespace common;
 
+namespace
+{
+/// \brief Restart value of 16-bit indices.
+constexpr uint16_t kRestart16 = std::numeric_limits<uint16_t>::max();
+
+/// \brief Mutex of a submesh, which copies of the submesh do not share
+struct IndexMutex
+{
+  IndexMutex() = default;
+
+  IndexMutex(const IndexMutex &)
+  {
+  }
+
+  IndexMutex &operator=(const IndexMutex &)
+  {
+    return *this;
+  }
+
+  /// \brief Protects the conversion of the indices from concurrent
+  /// IndexPtr calls
+  std::mutex mutex;
+};
+
+/// \brief Values derived from the vertices and indices, computed on
+/// demand and kept until the data they depend on changes.
+struct GeometryCache
+{
+  GeometryCache() = default;
+
+  GeometryCache(const GeometryCache &_other)
+  {
+    *this = _other;
+  }
+
+  GeometryCache &operator=(const GeometryCache &_other)
+  {
+    if (this == &_other)
+      return *this;
+    std::lock_guard<std::mutex> lock(_other.mutex);
+    this->boundsValid = _other.boundsValid;
+    this->min = _other.min;
+    this->max = _other.max;
+    this->massValid = _other.massValid;
+    this->validIndices = _other.validIndices;
+    this->signedVolume = _other.signedVolume;
+    this->moment = _other.moment;
+    return *this;
+  }
+
+  /// \brief Protects the values from concurrent const calls
+  mutable std::mutex mutex;
+
+  /// \brief True if min and max are up to date
+  bool boundsValid = false;
+
+  /// \brief Minimum vertex coordinates
+  gz::math::Vector3d min;
+
+  /// \brief Maximum vertex coordinates
+  gz::math::Vector3d max;
+
+  /// \brief True if validIndices, signedVolume and moment are up to date
+  bool massValid = false;
+
+  /// \brief Result of HasValidIndices
+  bool validIndices = false;
+
+  /// \brief Sum of the signed tetrahedron volumes of the triangles
+  double signedVolume = 0.0;
+
+  /// \brief Sum of the signed tetrahedron first moments of the triangles
+  gz::math::Vector3d moment;
+};
+
+/// \brief Copy vectors of doubles from a strided array into a packed one
+/// \param[in] _src First component of the first vector
+/// \param[in] _stride Number of doubles from one vector to the next
+/// \param[in] _dims Number of components of a vector
+/// \param[in] _count Number of vectors
+/// \param[out] _dst Packed vectors
+void CopyStrided(const double *_src, std::size_t _stride, std::size_t _dims,
+    std::size_t _count, double *_dst)
+{
+  if (_stride == _dims)
+  {
+    std::copy(_src, _src + _count * _dims, _dst);
+    return;
+  }
+  for (std::size_t i = 0u; i < _count; ++i)
+    std::copy(_src + i * _stride, _src + i * _stride + _dims, _dst + i * _dims);
+}
+}  // namespace
+
 /// \brief Private data for SubMesh
 class gz::common::SubMesh::Implementation
 {
+  /// \brief Get the number of indices
+  /// \return Number of indices in the active array
+  public: std::size_t IndexCount() const
+  {
+    return this->wideIndices ? this->indices.size() : this->indices16.size();
+  }
+
+  /// \brief Get an index, converted to 32 bits
+  /// \param[in] _i Position of the index, must be valid
+  /// \return The index, or PrimitiveRestartIndex for a restart
+  public: unsigned int IndexAt(std::size_t _i) const
+  {
+    if (this->wideIndices)
+      return this->indices[_i];
+    return this->indices16[_i] == kRestart16 ?
+        SubMesh::PrimitiveRestartIndex : this->indices16[_i];
+  }
+
+  /// \brief Call a function with the active index array
+  /// \param[in] _func Function called with a pointer to the first index,
+  /// the number of indices and the restart value of the array
+  public: template<typename Func>
+  void VisitIndices(Func &&_func) const
+  {
+    if (this->wideIndices)
+    {
+      _func(this->indices.data(), this->indices.size(),
+          SubMesh::PrimitiveRestartIndex);
+    }
+    else
+    {
+      _func(this->indices16.data(), this->indices16.size(), kRestart16);
+    }
+  }
+
+  /// \brief Make sure an index can be stored, converting the array to 32
+  /// bits if needed, and drop the values that depend on the indices
+  /// \param[in] _index Index that is about to be stored
+  public: void PrepareIndex(unsigned int _index)
+  {
+    this->geometry.massValid = false;
+    if (!this->wideIndices && _index != SubMesh::PrimitiveRestartIndex &&
+        _index >= kRestart16)
+    {
+      this->WidenIndices(this->indices16.size() + 1);
+    }
+  }
+
+  /// \brief Convert the index array to 32 bits
+  /// \param[in] _capacity Number of indices to reserve space for
+  public: void WidenIndices(std::size_t _capacity)
+  {
+    if (this->wideIndices)
+      return;
+
+    this->indices.reserve(std::max(this->indices16.capacity(), _capacity));
+    for (const uint16_t index : this->indices16)
+    {
+      this->indices.push_back(index == kRestart16 ?
+          SubMesh::PrimitiveRestartIndex : index);
+    }
+    this->indices16.clear();
+    this->indices16.shrink_to_fit();
+    this->wideIndices = true;
+  }
+
+  /// \brief Update the cached bounds if needed
+  public: void UpdateBounds() const
+  {
+    if (this->geometry.boundsValid)
+      return;
+
+    this->geometry.min.Set(gz::math::MAX_F, gz::math::MAX_F,
+        gz::math::MAX_F);
+    this->geometry.max.Set(-gz::math::MAX_F, -gz::math::MAX_F,
+        -gz::math::MAX_F);
+    meshkernels::Bounds(this->vertices.data(), this->vertices.size(),
+        this->geometry.min, this->geometry.max);
+    this->geometry.boundsValid = true;
+  }
+
+  /// \brief Update the cached index validity, volume and moment if needed
+  public: void UpdateMass() const
+  {
+    if (this->geometry.massValid)
+      return;
+
+    auto &cache = this->geometry;
+    cache.signedVolume = 0.0;
+    cache.moment = gz::math::Vector3d::Zero;
+    cache.validIndices = this->IndexCount() > 0u &&
+        (this->restartCount == 0u ||
+         SubMesh::PrimitiveRestartSupported(this->primitiveType));
+    const std::size_t vertexCount = this->vertices.size();
+    this->VisitIndices(
+        [&](const auto *_indices, std::size_t _count, auto _restart)
+        {
+          for (std::size_t idx = 0u; idx < _count && cache.validIndices;
+               ++idx)
+          {
+            if (_indices[idx] != _restart && _indices[idx] >= vertexCount)
+              cache.validIndices = false;
+          }
+        });
+
+    if (cache.validIndices && this->primitiveType == SubMesh::TRIANGLES &&
+        this->IndexCount() % 3 == 0)
+    {
+      this->VisitIndices(
+          [&](const auto *_indices, std::size_t _count, auto)
+          {
+            // Signed tetrahedron volume and first moment: contributions
+            // outside the solid cancel, so the sums are correct for any
+            // closed mesh regardless of where its origin lies.
+            meshkernels::MassProperties(this->vertices.data(), _indices,
+                _count, cache.signedVolume, cache.moment);
+          });
+    }
+    cache.massValid = true;
+  }
+
+  /// \brief Store an index at the end of the active array
+  /// \param[in] _index Index to add
+  public: void PushIndex(unsigned int _index)
+  {
+    this->PrepareIndex(_index);
+    if (_index == SubMesh::PrimitiveRestartIndex)
+      ++this->restartCount;
+
+    if (this->wideIndices)
+    {
+      this->indices.push_back(_index);
+    }
+    else
+    {
+      this->indices16.push_back(_index == SubMesh::PrimitiveRestartIndex ?
+          kRestart16 : static_cast<uint16_t>(_index));
+    }
+  }
+
+
   /// \brief the vertex array
   public: std::vector<gz::math::Vector3d> vertices;
 
@@ -43,9 +282,26 @@ class gz::common::SubMesh::Implementation
   public: std::map<unsigned int, std::vector<gz::math::Vector2d>>
       texCoords;
 
-  /// \brief the vertex index array
+  /// \brief the vertex index array, used once an index does not fit in
+  /// 16 bits
   public: std::vector<unsigned int> indices;
 
+  /// \brief the vertex index array while all indices fit in 16 bits
+  public: std::vector<uint16_t> indices16;
+
+  /// \brief True if the indices are stored in indices, false if they are
+  /// stored in indices16
+  public: bool wideIndices = false;
+
+  /// \brief Number of primitive restarts in the index array
+  public: std::size_t restartCount = 0u;
+
+  /// \brief Protects the conversion of the indices by IndexPtr
+  public: mutable IndexMutex indexMutex;
+
+  /// \brief Cached bounds, volume and moment
+  public: mutable GeometryCache geometry;
+
   /// \brief node assignment array
   public: std::vector<NodeAssignment> nodeAssignments;
 
@@ -82,6 +338,7 @@ SubMesh::~SubMesh()
 void SubMesh::SetPrimitiveType(PrimitiveType _type)
 {
   this->dataPtr->primitiveType = _type;
+  this->dataPtr->geometry.massValid = false;
 }
 
 //////////////////////////////////////////////////
@@ -93,13 +350,74 @@ SubMesh::PrimitiveType SubMesh::SubMeshPrimitiveType() const
 //////////////////////////////////////////////////
 void SubMesh::AddIndex(const unsigned int _index)
 {
-  this->dataPtr->indices.push_back(_index);
+  this->dataPtr->PushIndex(_index);
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddIndices(const unsigned int *_indices, std::size_t _count)
+{
+  if (_count == 0u)
+    return;
+
+  // Convert to 32 bits once, for the largest index
+  unsigned int maxIndex = 0u;
+  std::size_t restarts = 0u;
+  for (std::size_t i = 0u; i < _count; ++i)
+  {
+    if (_indices[i] == PrimitiveRestartIndex)
+      ++restarts;
+    else
+      maxIndex = std::max(maxIndex, _indices[i]);
+  }
+  this->dataPtr->PrepareIndex(maxIndex);
+  this->dataPtr->restartCount += restarts;
+
+  if (this->dataPtr->wideIndices)
+  {
+    this->dataPtr->indices.insert(this->dataPtr->indices.end(),
+        _indices, _indices + _count);
+    return;
+  }
+  auto &indices16 = this->dataPtr->indices16;
+  const std::size_t offset = indices16.size();
+  indices16.resize(offset + _count);
+  for (std::size_t i = 0u; i < _count; ++i)
+  {
+    indices16[offset + i] = _indices[i] == PrimitiveRestartIndex ?
+        kRestart16 : static_cast<uint16_t>(_indices[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddPrimitiveRestart()
+{
+  this->dataPtr->PushIndex(PrimitiveRestartIndex);
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::HasPrimitiveRestart() const
+{
+  return this->dataPtr->restartCount > 0u;
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::PrimitiveRestartSupported(PrimitiveType _type)
+{
+  return _type == LINESTRIPS || _type == TRIFANS || _type == TRISTRIPS;
 }
 
 //////////////////////////////////////////////////
 void SubMesh::AddVertex(const gz::math::Vector3d &_v)
 {
   this->dataPtr->vertices.push_back(_v);
+
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    cache.min.Min(_v);
+    cache.max.Max(_v);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -149,6 +467,90 @@ void SubMesh::AddTexCoordBySet(const gz::math::Vector2d &_uv,
   this->AddTexCoordBySet(_uv.X(), _uv.Y(), _setIndex);
 }
 
+//////////////////////////////////////////////////
+void SubMesh::AddVertices(const float *_xyz, std::size_t _count,
+    std::size_t _stride)
+{
+  auto &vertices = this->dataPtr->vertices;
+  const std::size_t offset = vertices.size();
+  vertices.resize(offset + _count);
+  meshkernels::Widen(_xyz, _stride, 3u, _count,
+      reinterpret_cast<double *>(vertices.data() + offset));
+
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    meshkernels::Bounds(vertices.data() + offset, _count, cache.min,
+        cache.max);
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddNormals(const float *_xyz, std::size_t _count,
+    std::size_t _stride)
+{
+  auto &normals = this->dataPtr->normals;
+  const std::size_t offset = normals.size();
+  normals.resize(offset + _count);
+  meshkernels::Widen(_xyz, _stride, 3u, _count,
+      reinterpret_cast<double *>(normals.data() + offset));
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddTexCoordsBySet(const float *_uv, std::size_t _count,
+    unsigned int _setIndex, std::size_t _stride)
+{
+  static_assert(sizeof(gz::math::Vector2d) == 2 * sizeof(double),
+      "Vector2d must be two packed doubles");
+  auto &texCoords = this->dataPtr->texCoords[_setIndex];
+  const std::size_t offset = texCoords.size();
+  texCoords.resize(offset + _count);
+  meshkernels::Widen(_uv, _stride, 2u, _count,
+      reinterpret_cast<double *>(texCoords.data() + offset));
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddVertices(const double *_xyz, std::size_t _count,
+    std::size_t _stride)
+{
+  auto &vertices = this->dataPtr->vertices;
+  const std::size_t offset = vertices.size();
+  vertices.resize(offset + _count);
+  CopyStrided(_xyz, _stride, 3u, _count,
+      reinterpret_cast<double *>(vertices.data() + offset));
+
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    meshkernels::Bounds(vertices.data() + offset, _count, cache.min,
+        cache.max);
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddNormals(const double *_xyz, std::size_t _count,
+    std::size_t _stride)
+{
+  auto &normals = this->dataPtr->normals;
+  const std::size_t offset = normals.size();
+  normals.resize(offset + _count);
+  CopyStrided(_xyz, _stride, 3u, _count,
+      reinterpret_cast<double *>(normals.data() + offset));
+}
+
+//////////////////////////////////////////////////
+void SubMesh::AddTexCoordsBySet(const double *_uv, std::size_t _count,
+    unsigned int _setIndex, std::size_t _stride)
+{
+  auto &texCoords = this->dataPtr->texCoords[_setIndex];
+  const std::size_t offset = texCoords.size();
+  texCoords.resize(offset + _count);
+  CopyStrided(_uv, _stride, 2u, _count,
+      reinterpret_cast<double *>(texCoords.data() + offset));
+}
+
 //////////////////////////////////////////////////
 void SubMesh::AddNodeAssignment(const unsigned int _vertex,
     const unsigned int _node, const float _weight)
@@ -195,6 +597,21 @@ void SubMesh::SetVertex(const unsigned int _index,
     return;
   }
 
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    // The bounds can only grow, unless the previous position was on them
+    const gz::math::Vector3d &prev = this->dataPtr->vertices[_index];
+    for (int k = 0; k < 3; ++k)
+    {
+      if (prev[k] <= cache.min[k] || prev[k] >= cache.max[k])
+        cache.boundsValid = false;
+    }
+    cache.min.Min(_v);
+    cache.max.Max(_v);
+  }
+
   this->dataPtr->vertices[_index] = _v;
 }
 
@@ -346,31 +763,73 @@ void SubMesh::SetTexCoordBySet(unsigned int _index,
 //////////////////////////////////////////////////
 int SubMesh::Index(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->IndexCount())
   {
     gzerr << "Index too large" << std::endl;
     return -1;
   }
 
-  return this->dataPtr->indices[_index];
+  return this->dataPtr->IndexAt(_index);
 }
 
 //////////////////////////////////////////////////
 const unsigned int* SubMesh::IndexPtr() const
 {
+  // The indices are converted to 32 bits instead of keeping a 32-bit copy
+  // next to them, so that users of IndexPtr need no more memory than
+  // before indices were stored with 16 bits
+  std::lock_guard<std::mutex> lock(this->dataPtr->indexMutex.mutex);
+  if (!this->dataPtr->wideIndices)
+  {
+    auto &data = const_cast<Implementation &>(*this->dataPtr);
+    data.WidenIndices(data.indices16.size());
+  }
   return this->dataPtr->indices.data();
 }
 
+//////////////////////////////////////////////////
+SubMesh::IndexView SubMesh::Indices() const
+{
+  if (this->dataPtr->wideIndices)
+  {
+    return IndexView(IndexFormat::UINT32, this->dataPtr->indices.data(),
+        this->dataPtr->indices.size());
+  }
+  return IndexView(IndexFormat::UINT16, this->dataPtr->indices16.data(),
+      this->dataPtr->indices16.size());
+}
+
+//////////////////////////////////////////////////
+SubMesh::IndexFormat SubMesh::IndexBufferFormat() const
+{
+  return this->dataPtr->wideIndices ? IndexFormat::UINT32 :
+      IndexFormat::UINT16;
+}
+
 //////////////////////////////////////////////////
 void SubMesh::SetIndex(const unsigned int _index, const unsigned int _i)
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->IndexCount())
   {
     gzerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->indices[_index] = _i;
+  if (this->dataPtr->IndexAt(_index) == PrimitiveRestartIndex)
+    --this->dataPtr->restartCount;
+  if (_i == PrimitiveRestartIndex)
+    ++this->dataPtr->restartCount;
+
+  this->dataPtr->PrepareIndex(_i);
+  if (this->dataPtr->wideIndices)
+  {
+    this->dataPtr->indices[_index] = _i;
+  }
+  else
+  {
+    this->dataPtr->indices16[_index] = _i == PrimitiveRestartIndex ?
+        kRestart16 : static_cast<uint16_t>(_i);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -392,20 +851,9 @@ gz::math::Vector3d SubMesh::Max() const
   if (this->dataPtr->vertices.empty())
     return gz::math::Vector3d::Zero;
 
-  gz::math::Vector3d max;
-
-  max.X(-gz::math::MAX_F);
-  max.Y(-gz::math::MAX_F);
-  max.Z(-gz::math::MAX_F);
-
-  for (const auto &v : this->dataPtr->vertices)
-  {
-    max.X(std::max(max.X(), v.X()));
-    max.Y(std::max(max.Y(), v.Y()));
-    max.Z(std::max(max.Z(), v.Z()));
-  }
-
-  return max;
+  std::lock_guard<std::mutex> lock(this->dataPtr->geometry.mutex);
+  this->dataPtr->UpdateBounds();
+  return this->dataPtr->geometry.max;
 }
 
 //////////////////////////////////////////////////
@@ -414,20 +862,9 @@ gz::math::Vector3d SubMesh::Min() const
   if (this->dataPtr->vertices.empty())
     return gz::math::Vector3d::Zero;
 
-  gz::math::Vector3d min;
-
-  min.X(gz::math::MAX_F);
-  min.Y(gz::math::MAX_F);
-  min.Z(gz::math::MAX_F);
-
-  for (const auto &v : this->dataPtr->vertices)
-  {
-    min.X(std::min(min.X(), v.X()));
-    min.Y(std::min(min.Y(), v.Y()));
-    min.Z(std::min(min.Z(), v.Z()));
-  }
-
-  return min;
+  std::lock_guard<std::mutex> lock(this->dataPtr->geometry.mutex);
+  this->dataPtr->UpdateBounds();
+  return this->dataPtr->geometry.min;
 }
 
 //////////////////////////////////////////////////
@@ -445,7 +882,7 @@ unsigned int SubMesh::NormalCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::IndexCount() const
 {
-  return this->dataPtr->indices.size();
+  return this->dataPtr->IndexCount();
 }
 
 //////////////////////////////////////////////////
@@ -490,13 +927,17 @@ unsigned int SubMesh::NodeAssignmentsCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::MaxIndex() const
 {
-  auto maxIter = std::max_element(this->dataPtr->indices.begin(),
-      this->dataPtr->indices.end());
-
-  if (maxIter != this->dataPtr->indices.end())
-    return *maxIter;
-
-  return 0;
+  unsigned int maxIndex = 0u;
+  this->dataPtr->VisitIndices(
+      [&](const auto *_indices, std::size_t _count, auto _restart)
+      {
+        for (std::size_t i = 0u; i < _count; ++i)
+        {
+          if (_indices[i] != _restart)
+            maxIndex = std::max<unsigned int>(maxIndex, _indices[i]);
+        }
+      });
+  return maxIndex;
 }
 
 //////////////////////////////////////////////////
@@ -536,7 +977,8 @@ int SubMesh::IndexOfVertex(const gz::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
 {
-  if (this->dataPtr->vertices.empty() || this->dataPtr->indices.empty())
+  const std::size_t indexCount = this->dataPtr->IndexCount();
+  if (this->dataPtr->vertices.empty() || indexCount == 0u)
   {
     gzerr << "No vertices or indices\n";
     return;
@@ -549,7 +991,7 @@ void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
     delete [] *_indArr;
 
   *_vertArr = new double[this->dataPtr->vertices.size() * 3];
-  *_indArr = new int[this->dataPtr->indices.size()];
+  *_indArr = new int[indexCount];
 
   unsigned int vi = 0;
   for (auto &v : this->dataPtr->vertices)
@@ -559,10 +1001,9 @@ void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
     (*_vertArr)[vi++] = static_cast<float>(v.Z());
   }
 
-  unsigned int ii = 0;
-  for (auto &i : this->dataPtr->indices)
+  for (std::size_t i = 0u; i < indexCount; ++i)
   {
-    (*_indArr)[ii++] = i;
+    (*_indArr)[i] = static_cast<int>(this->dataPtr->IndexAt(i));
   }
 }
 
@@ -572,11 +1013,12 @@ namespace {
 // but not sure about construction overhead
 struct Neighbors
 {
-  Neighbors(const std::vector<unsigned int> &_indices,
+  template<typename Index>
+  Neighbors(const Index *_indices, std::size_t _count,
             const std::vector<gz::math::Vector3d> &_vertices)
     : vertices(_vertices)
   {
-    for (unsigned int i = 0; i < _indices.size(); ++i)
+    for (std::size_t i = 0; i < _count; ++i)
     {
       const auto index = _indices[i];
       this->groups[_vertices[index].X()].push_back(index);
@@ -625,7 +1067,7 @@ struct Neighbors
 void SubMesh::RecalculateNormals()
 {
   if (this->dataPtr->primitiveType != SubMesh::TRIANGLES
-      || this->dataPtr->indices.size() % 3u != 0)
+      || this->dataPtr->IndexCount() % 3u != 0)
     return;
 
   if (!this->HasValidIndices())
@@ -638,25 +1080,27 @@ void SubMesh::RecalculateNormals()
   if (this->dataPtr->normals.size() != this->dataPtr->vertices.size())
     this->dataPtr->normals.resize(this->dataPtr->vertices.size());
 
-  Neighbors neighbors(this->dataPtr->indices, this->dataPtr->vertices);
-
-  // For each face, which is defined by three indices, calculate the normals
-  for (unsigned int i = 0; i < this->dataPtr->indices.size(); i+= 3)
+  this->dataPtr->VisitIndices(
+      [&](const auto *_indices, std::size_t _count, auto)
   {
-    gz::math::Vector3d v1 =
-        this->dataPtr->vertices[this->dataPtr->indices[i]];
-    gz::math::Vector3d v2 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+1]];
-    gz::math::Vector3d v3 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+2]];
-    gz::math::Vector3d n = gz::math::Vector3d::Normal(v1, v2, v3);
+    Neighbors neighbors(_indices, _count, this->dataPtr->vertices);
 
-    for (const auto &point : {v1, v2, v3})
-      neighbors.Visit(point, [&](const unsigned int index)
-      {
-        this->dataPtr->normals[index] += n;
-      });
-  }
+    // For each face, which is defined by three indices, calculate the
+    // normals
+    for (std::size_t i = 0; i < _count; i+= 3)
+    {
+      gz::math::Vector3d v1 = this->dataPtr->vertices[_indices[i]];
+      gz::math::Vector3d v2 = this->dataPtr->vertices[_indices[i+1]];
+      gz::math::Vector3d v3 = this->dataPtr->vertices[_indices[i+2]];
+      gz::math::Vector3d n = gz::math::Vector3d::Normal(v1, v2, v3);
+
+      for (const auto &point : {v1, v2, v3})
+        neighbors.Visit(point, [&](const unsigned int index)
+        {
+          this->dataPtr->normals[index] += n;
+        });
+    }
+  });
 
   // Normalize the results
   for (auto &n : this->dataPtr->normals)
@@ -701,15 +1145,28 @@ void SubMesh::GenSphericalTexCoordBySet(const gz::math::Vector3d &_center,
 //////////////////////////////////////////////////
 void SubMesh::Scale(const gz::math::Vector3d &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v *= _factor;
+  meshkernels::Scale(this->dataPtr->vertices.data(),
+      this->dataPtr->vertices.size(), _factor);
+
+  // Rounding is monotonic, so scaling the bounds gives the same result as
+  // scaling every vertex
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    const gz::math::Vector3d min = cache.min * _factor;
+    const gz::math::Vector3d max = cache.max * _factor;
+    cache.min = min;
+    cache.max = max;
+    cache.min.Min(max);
+    cache.max.Max(min);
+  }
 }
 
 //////////////////////////////////////////////////
 void SubMesh::Scale(const double &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v *= _factor;
+  this->Scale(gz::math::Vector3d(_factor, _factor, _factor));
 }
 
 //////////////////////////////////////////////////
@@ -726,8 +1183,66 @@ void SubMesh::Center(const gz::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Translate(const gz::math::Vector3d &_vec)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v += _vec;
+  meshkernels::Translate(this->dataPtr->vertices.data(),
+      this->dataPtr->vertices.size(), _vec);
+
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  if (cache.boundsValid)
+  {
+    cache.min += _vec;
+    cache.max += _vec;
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMesh::Transform(const gz::math::Matrix4d &_transform)
+{
+  meshkernels::Transform(this->dataPtr->vertices.data(),
+      this->dataPtr->vertices.size(), _transform);
+
+  // Normals follow the cofactor matrix of the linear part, which is its
+  // inverse transpose scaled by the determinant. Unlike the inverse, it
+  // exists for singular transforms such as nodes scaled to zero. Its rows
+  // are the cross products of the rows of the linear part.
+  if (!this->dataPtr->normals.empty())
+  {
+    gz::math::Vector3d rows[3];
+    for (int i = 0; i < 3; ++i)
+      rows[i].Set(_transform(i, 0), _transform(i, 1), _transform(i, 2));
+    gz::math::Vector3d cofactors[3] = {
+        rows[1].Cross(rows[2]), rows[2].Cross(rows[0]),
+        rows[0].Cross(rows[1])};
+
+    // Keep the orientation of the inverse transpose for mirroring
+    // transforms
+    const double sign = rows[0].Dot(cofactors[0]) < 0.0 ? -1.0 : 1.0;
+    double norm = 0.0;
+    for (auto &c : cofactors)
+    {
+      c *= sign;
+      norm += c.SquaredLength();
+    }
+
+    // Normals are left as they are if the transform collapses the submesh
+    // to a line or a point, which has no normal direction
+    if (norm > 0.0)
+    {
+      const gz::math::Matrix4d normalMatrix(
+          cofactors[0].X(), cofactors[0].Y(), cofactors[0].Z(), 0,
+          cofactors[1].X(), cofactors[1].Y(), cofactors[1].Z(), 0,
+          cofactors[2].X(), cofactors[2].Y(), cofactors[2].Z(), 0,
+          0, 0, 0, 1);
+      meshkernels::Transform(this->dataPtr->normals.data(),
+          this->dataPtr->normals.size(), normalMatrix);
+      for (auto &n : this->dataPtr->normals)
+        n.Normalize();
+    }
+  }
+
+  auto &cache = this->dataPtr->geometry;
+  cache.massValid = false;
+  cache.boundsValid = false;
 }
 
 //////////////////////////////////////////////////
@@ -745,95 +1260,72 @@ std::string SubMesh::Name() const
 //////////////////////////////////////////////////
 double SubMesh::Volume() const
 {
-  if (!this->HasValidIndices())
+  std::unique_lock<std::mutex> lock(this->dataPtr->geometry.mutex);
+  this->dataPtr->UpdateMass();
+  const auto &cache = this->dataPtr->geometry;
+  if (!cache.validIndices)
     return 0.0;
 
-  double volume = 0.0;
-  if (this->dataPtr->primitiveType == SubMesh::TRIANGLES)
-  {
-    if (this->dataPtr->indices.size() % 3 == 0)
-    {
-      for (unsigned int idx = 0; idx < this->dataPtr->indices.size(); idx += 3)
-      {
-        gz::math::Vector3d v1 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx]];
-        gz::math::Vector3d v2 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx+1]];
-        gz::math::Vector3d v3 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx+2]];
-
-        // Signed tetrahedron volume: contributions outside the solid
-        // cancel, so the sum is correct for any closed mesh regardless of
-        // where its origin lies. The absolute value is taken once on the
-        // total, making the result independent of winding orientation.
-        volume += v1.Cross(v2).Dot(v3) / 6.0;
-      }
-    }
-    else
-    {
-      gzerr << "The number of indices is not a multiple of three.\n";
-    }
-  }
-  else
+  if (this->dataPtr->primitiveType != SubMesh::TRIANGLES)
   {
     gzerr << "Volume calculation can only be accomplished on a triangulated "
       << " mesh.\n";
+    return 0.0;
+  }
+  if (this->dataPtr->IndexCount() % 3 != 0)
+  {
+    gzerr << "The number of indices is not a multiple of three.\n";
+    return 0.0;
   }
 
-  return std::abs(volume);
+  // The absolute value is taken once on the total, making the result
+  // independent of winding orientation.
+  return std::abs(cache.signedVolume);
 }
 
 //////////////////////////////////////////////////
 gz::math::Vector3d SubMesh::Centroid() const
 {
-  gz::math::Vector3d moment;
-  double volume = 0.0;
-
-  if (!this->HasValidIndices())
-    return moment;
+  std::unique_lock<std::mutex> lock(this->dataPtr->geometry.mutex);
+  this->dataPtr->UpdateMass();
+  const auto &cache = this->dataPtr->geometry;
+  if (!cache.validIndices)
+    return gz::math::Vector3d::Zero;
 
   if (this->dataPtr->primitiveType != SubMesh::TRIANGLES ||
-      this->dataPtr->indices.size() % 3 != 0)
+      this->dataPtr->IndexCount() % 3 != 0)
   {
     gzerr << "Centroid calculation can only be accomplished on a "
       << "triangulated mesh.\n";
-    return moment;
-  }
-
-  for (unsigned int idx = 0; idx < this->dataPtr->indices.size(); idx += 3)
-  {
-    gz::math::Vector3d v1 =
-      this->dataPtr->vertices[this->dataPtr->indices[idx]];
-    gz::math::Vector3d v2 =
-      this->dataPtr->vertices[this->dataPtr->indices[idx+1]];
-    gz::math::Vector3d v3 =
-      this->dataPtr->vertices[this->dataPtr->indices[idx+2]];
-
-    // Signed tetrahedron volume and first moment; the winding orientation
-    // cancels in the moment to volume ratio.
-    double v = v1.Cross(v2).Dot(v3) / 6.0;
-    volume += v;
-    moment += v * (v1 + v2 + v3) / 4.0;
+    return gz::math::Vector3d::Zero;
   }
 
-  if (std::abs(volume) < 1e-16)
+  // The winding orientation cancels in the moment to volume ratio.
+  if (std::abs(cache.signedVolume) < 1e-16)
     return gz::math::Vector3d::Zero;
 
-  return moment / volume;
+  return cache.moment / cache.signedVolume;
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasValidIndices() const
 {
-  if (this->dataPtr->indices.empty())
-    return false;
+  std::lock_guard<std::mutex> lock(this->dataPtr->geometry.mutex);
+  this->dataPtr->UpdateMass();
+  return this->dataPtr->geometry.validIndices;
+}
 
-  for (unsigned int idx = 0u; idx < this->dataPtr->indices.size(); ++idx)
-  {
-    if (this->dataPtr->indices[idx] >= this->dataPtr->vertices.size())
-      return false;
-  }
-  return true;
+//////////////////////////////////////////////////
+std::size_t SubMesh::MemorySize() const
+{
+  std::size_t size =
+      this->dataPtr->vertices.size() * sizeof(gz::math::Vector3d) +
+      this->dataPtr->normals.size() * sizeof(gz::math::Vector3d) +
+      this->Indices().ByteSize() +
+      this->dataPtr->nodeAssignments.size() * sizeof(NodeAssignment);
+  for (const auto &set : this->dataPtr->texCoords)
+    size += set.second.size() * sizeof(gz::math::Vector2d);
+  return size;
 }
 
 //////////////////////////////////////////////////
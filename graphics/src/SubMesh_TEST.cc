@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
 
 #include "gz/math/Vector3.hh"
 #include "gz/common/Mesh.hh"
@@ -293,7 +294,7 @@ TEST_F(SubMeshTest, SubMesh)
   for (unsigned int i = 0; i < submeshCopy->IndexCount(); ++i)
   {
     EXPECT_EQ(submeshCopy->Index(i), submesh->Index(i));
-    EXPECT_EQ(submeshCopy->IndexPtr()[i], submesh->IndexPtr()[i]);
+    EXPECT_EQ(submeshCopy->Indices()[i], submesh->Indices()[i]);
   }
   for (unsigned int i = 0; i < submeshCopy->NodeAssignmentsCount(); ++i)
   {
@@ -328,7 +329,7 @@ TEST_F(SubMeshTest, SubMesh)
   for (unsigned int i = 0; i < submeshCopy->IndexCount(); ++i)
   {
     EXPECT_EQ(indices[i], submesh->Index(i));
-    EXPECT_EQ(indices[i], submesh->IndexPtr()[i]);
+    EXPECT_EQ(indices[i], static_cast<int>(submesh->Indices()[i]));
   }
 
   delete[] vertices;
@@ -338,7 +339,7 @@ TEST_F(SubMeshTest, SubMesh)
   submesh->RecalculateNormals();
 
   EXPECT_NE(submeshCopy->VertexPtr(), submesh->VertexPtr());
-  EXPECT_NE(submeshCopy->IndexPtr(), submesh->IndexPtr());
+  EXPECT_NE(submeshCopy->Indices().Data(), submesh->Indices().Data());
 
   for (unsigned int i = 0; i < submeshCopy->NormalCount(); ++i)
     EXPECT_NE(submeshCopy->Normal(i), submesh->Normal(i));
@@ -352,7 +353,7 @@ TEST_F(SubMeshTest, SubMesh)
   for (unsigned int i = 0; i < submeshCopy->IndexCount(); ++i)
   {
     EXPECT_EQ(submeshCopy->Index(i), submesh->Index(i));
-    EXPECT_EQ(submeshCopy->IndexPtr()[i], submesh->IndexPtr()[i]);
+    EXPECT_EQ(submeshCopy->Indices()[i], submesh->Indices()[i]);
   }
   for (unsigned int i = 0; i < submeshCopy->NodeAssignmentsCount(); ++i)
   {
@@ -376,7 +377,7 @@ TEST_F(SubMeshTest, SubMesh)
   for (unsigned int i = 0; i < submeshCopy->IndexCount(); ++i)
   {
     EXPECT_EQ(submeshCopy->Index(i), submesh->Index(i));
-    EXPECT_EQ(submeshCopy->IndexPtr()[i], submesh->IndexPtr()[i]);
+    EXPECT_EQ(submeshCopy->Indices()[i], submesh->Indices()[i]);
   }
   for (unsigned int i = 0; i < submeshCopy->NodeAssignmentsCount(); ++i)
   {
@@ -401,7 +402,7 @@ TEST_F(SubMeshTest, SubMesh)
   for (unsigned int i = 0; i < submeshCopy->IndexCount(); ++i)
   {
     EXPECT_EQ(submeshCopy->Index(i), submesh->Index(i));
-    EXPECT_EQ(submeshCopy->IndexPtr()[i], submesh->IndexPtr()[i]);
+    EXPECT_EQ(submeshCopy->Indices()[i], submesh->Indices()[i]);
   }
   for (unsigned int i = 0; i < submeshCopy->NodeAssignmentsCount(); ++i)
   {
@@ -657,3 +658,419 @@ TEST_F(SubMeshTest, VolumeAndCentroidOffsetMesh)
   EXPECT_DOUBLE_EQ(24.0, offset.Volume());
   EXPECT_EQ(shift, offset.Centroid());
 }
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, IndexFormat)
+{
+  common::SubMesh submesh;
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16,
+      submesh.IndexBufferFormat());
+  EXPECT_EQ(0u, submesh.Indices().Count());
+
+  // Small indices are stored with 16 bits
+  for (unsigned int i = 0; i < 3; ++i)
+    submesh.AddVertex(gz::math::Vector3d(i, 0, 0));
+  submesh.AddIndex(0);
+  submesh.AddIndex(2);
+  submesh.AddIndex(1);
+  common::SubMesh::IndexView view = submesh.Indices();
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16, view.Format());
+  EXPECT_EQ(3u, view.Count());
+  EXPECT_EQ(2u, view.ElementSize());
+  EXPECT_EQ(6u, view.ByteSize());
+  ASSERT_NE(nullptr, view.Data16());
+  EXPECT_EQ(nullptr, view.Data32());
+  EXPECT_EQ(view.Data(), view.Data16());
+  EXPECT_EQ(2u, view.Data16()[1]);
+  EXPECT_EQ(1u, view[2]);
+
+  // IndexPtr converts the indices to 32 bits instead of keeping a copy
+  common::SubMesh wide(submesh);
+  const unsigned int *ptr = wide.IndexPtr();
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32, wide.IndexBufferFormat());
+  EXPECT_EQ(12u, wide.Indices().ByteSize());
+  EXPECT_EQ(ptr, wide.Indices().Data32());
+  EXPECT_EQ(0u, ptr[0]);
+  EXPECT_EQ(2u, ptr[1]);
+  EXPECT_EQ(1u, ptr[2]);
+  wide.SetIndex(1, 0);
+  EXPECT_EQ(0u, wide.IndexPtr()[1]);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16,
+      submesh.IndexBufferFormat());
+
+  // 0xFFFF is the 16-bit restart value, so it needs 32 bits
+  submesh.AddIndex(65534);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16,
+      submesh.IndexBufferFormat());
+  submesh.AddIndex(65535);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32,
+      submesh.IndexBufferFormat());
+  view = submesh.Indices();
+  EXPECT_EQ(4u, view.ElementSize());
+  ASSERT_NE(nullptr, view.Data32());
+  EXPECT_EQ(nullptr, view.Data16());
+  EXPECT_EQ(5u, view.Count());
+  EXPECT_EQ(0u, view.Data32()[0]);
+  EXPECT_EQ(2u, view.Data32()[1]);
+  EXPECT_EQ(65534u, view[3]);
+  EXPECT_EQ(65535u, view[4]);
+  EXPECT_EQ(view.Data32(), submesh.IndexPtr());
+  EXPECT_EQ(65535u, submesh.MaxIndex());
+  EXPECT_FALSE(submesh.HasValidIndices());
+
+  // Setting a large index also converts to 32 bits, and copies keep the
+  // format
+  common::SubMesh other;
+  other.AddIndex(1);
+  other.SetIndex(0, 100000);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32,
+      other.IndexBufferFormat());
+  EXPECT_EQ(100000, other.Index(0));
+  common::SubMesh copy(other);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32,
+      copy.IndexBufferFormat());
+  EXPECT_EQ(100000u, copy.Indices()[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, PrimitiveRestart)
+{
+  EXPECT_FALSE(common::SubMesh::PrimitiveRestartSupported(
+      common::SubMesh::TRIANGLES));
+  EXPECT_TRUE(common::SubMesh::PrimitiveRestartSupported(
+      common::SubMesh::TRISTRIPS));
+
+  // Two strips of two triangles each
+  common::SubMesh strips;
+  strips.SetPrimitiveType(common::SubMesh::TRISTRIPS);
+  for (unsigned int i = 0; i < 8; ++i)
+    strips.AddVertex(gz::math::Vector3d(i / 2, i % 2, 0));
+  for (unsigned int i = 0; i < 4; ++i)
+    strips.AddIndex(i);
+  EXPECT_FALSE(strips.HasPrimitiveRestart());
+  strips.AddPrimitiveRestart();
+  for (unsigned int i = 4; i < 8; ++i)
+    strips.AddIndex(i);
+  EXPECT_TRUE(strips.HasPrimitiveRestart());
+  EXPECT_TRUE(strips.HasValidIndices());
+  EXPECT_EQ(9u, strips.IndexCount());
+  EXPECT_EQ(7u, strips.MaxIndex());
+  EXPECT_EQ(-1, strips.Index(4));
+
+  common::SubMesh::IndexView view = strips.Indices();
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16, view.Format());
+  EXPECT_EQ(0xFFFFu, view.RestartValue());
+  EXPECT_EQ(0xFFFFu, view.Data16()[4]);
+  EXPECT_EQ(common::SubMesh::PrimitiveRestartIndex, view[4]);
+  common::SubMesh widened(strips);
+  EXPECT_EQ(common::SubMesh::PrimitiveRestartIndex, widened.IndexPtr()[4]);
+
+  // Restarts are kept when converting to 32 bits
+  strips.AddIndex(100000);
+  view = strips.Indices();
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32, view.Format());
+  EXPECT_EQ(0xFFFFFFFFu, view.RestartValue());
+  EXPECT_EQ(0xFFFFFFFFu, view.Data32()[4]);
+  EXPECT_EQ(4u, view[5]);
+
+  // Restarts are not supported by list types
+  strips.SetIndex(9, 0);
+  EXPECT_TRUE(strips.HasValidIndices());
+  strips.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  EXPECT_FALSE(strips.HasValidIndices());
+  strips.SetIndex(4, 0);
+  EXPECT_FALSE(strips.HasPrimitiveRestart());
+  EXPECT_TRUE(strips.HasValidIndices());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, CachedGeometry)
+{
+  common::MeshManager::Instance()->CreateBox("cached_box",
+      gz::math::Vector3d(2, 4, 6), gz::math::Vector2d::One);
+  const common::Mesh *box =
+    common::MeshManager::Instance()->MeshByName("cached_box");
+  ASSERT_NE(nullptr, box);
+  common::SubMesh submesh(*box->SubMeshByIndex(0).lock());
+
+  // Recompute the values from scratch with a copy of the vertices and
+  // indices, which starts without any cached value
+  auto fresh = [&submesh]()
+  {
+    common::SubMesh copy;
+    copy.SetPrimitiveType(submesh.SubMeshPrimitiveType());
+    for (unsigned int i = 0; i < submesh.VertexCount(); ++i)
+      copy.AddVertex(submesh.Vertex(i));
+    for (unsigned int i = 0; i < submesh.IndexCount(); ++i)
+      copy.AddIndex(submesh.Index(i));
+    return copy;
+  };
+  auto expectFresh = [&]()
+  {
+    common::SubMesh copy = fresh();
+    EXPECT_EQ(copy.Min(), submesh.Min());
+    EXPECT_EQ(copy.Max(), submesh.Max());
+    EXPECT_DOUBLE_EQ(copy.Volume(), submesh.Volume());
+    EXPECT_EQ(copy.Centroid(), submesh.Centroid());
+    EXPECT_EQ(copy.HasValidIndices(), submesh.HasValidIndices());
+  };
+
+  EXPECT_EQ(gz::math::Vector3d(-1, -2, -3), submesh.Min());
+  EXPECT_EQ(gz::math::Vector3d(1, 2, 3), submesh.Max());
+  EXPECT_DOUBLE_EQ(48.0, submesh.Volume());
+  expectFresh();
+
+  submesh.Translate(gz::math::Vector3d(1, 2, 3));
+  EXPECT_EQ(gz::math::Vector3d::Zero, submesh.Min());
+  EXPECT_EQ(gz::math::Vector3d(2, 4, 6), submesh.Centroid() * 2);
+  expectFresh();
+
+  submesh.Scale(gz::math::Vector3d(-1, 2, 0.5));
+  EXPECT_EQ(gz::math::Vector3d(-2, 0, 0), submesh.Min());
+  EXPECT_EQ(gz::math::Vector3d(0, 8, 3), submesh.Max());
+  EXPECT_DOUBLE_EQ(48.0, submesh.Volume());
+  expectFresh();
+
+  submesh.Scale(0.5);
+  expectFresh();
+
+  submesh.Center(gz::math::Vector3d(5, 5, 5));
+  EXPECT_EQ(gz::math::Vector3d(5, 5, 5), submesh.Centroid());
+  expectFresh();
+
+  // Moving an inner vertex outwards grows the bounds, moving a vertex on
+  // the bounds inwards shrinks them
+  const gz::math::Vector3d first = submesh.Vertex(0);
+  submesh.SetVertex(0, gz::math::Vector3d(100, 5, 5));
+  EXPECT_DOUBLE_EQ(100.0, submesh.Max().X());
+  expectFresh();
+  submesh.SetVertex(0, first);
+  EXPECT_DOUBLE_EQ(5.5, submesh.Max().X());
+  expectFresh();
+
+  submesh.AddVertex(gz::math::Vector3d(-50, 0, 0));
+  EXPECT_DOUBLE_EQ(-50.0, submesh.Min().X());
+  expectFresh();
+
+  // Index changes update the volume
+  submesh.SetIndex(0, submesh.Index(1));
+  expectFresh();
+  submesh.AddIndex(1000);
+  EXPECT_FALSE(submesh.HasValidIndices());
+  EXPECT_DOUBLE_EQ(0.0, submesh.Volume());
+  expectFresh();
+
+  // Copies keep their own values
+  common::SubMesh copy(submesh);
+  copy.Translate(gz::math::Vector3d(1, 0, 0));
+  EXPECT_DOUBLE_EQ(-50.0, submesh.Min().X());
+  EXPECT_DOUBLE_EQ(-49.0, copy.Min().X());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, Transform)
+{
+  common::MeshManager::Instance()->CreateBox("transform_box",
+      gz::math::Vector3d(2, 4, 6), gz::math::Vector2d::One);
+  const common::Mesh *box =
+    common::MeshManager::Instance()->MeshByName("transform_box");
+  ASSERT_NE(nullptr, box);
+  common::SubMesh submesh(*box->SubMeshByIndex(0).lock());
+  EXPECT_DOUBLE_EQ(48.0, submesh.Volume());
+
+  // Rotate 90 degrees about Z, scale X by 2 and translate
+  const gz::math::Matrix4d transform(
+      0, -1, 0, 10,
+      2, 0, 0, 20,
+      0, 0, 1, 30,
+      0, 0, 0, 1);
+  submesh.Transform(transform);
+  EXPECT_EQ(gz::math::Vector3d(8, 18, 27), submesh.Min());
+  EXPECT_EQ(gz::math::Vector3d(12, 22, 33), submesh.Max());
+  EXPECT_DOUBLE_EQ(96.0, submesh.Volume());
+  EXPECT_EQ(gz::math::Vector3d(10, 20, 30), submesh.Centroid());
+
+  // Normals stay perpendicular to the faces and unit length
+  for (unsigned int i = 0; i < submesh.NormalCount(); ++i)
+  {
+    const gz::math::Vector3d n = submesh.Normal(i);
+    EXPECT_NEAR(1.0, n.Length(), 1e-12);
+    const gz::math::Vector3d v = submesh.Vertex(i);
+    if (std::abs(n.X()) > 0.5)
+    {
+      EXPECT_NEAR(v.X() > 10 ? 1.0 : -1.0, n.X(), 1e-12);
+    }
+    if (std::abs(n.Y()) > 0.5)
+    {
+      EXPECT_NEAR(v.Y() > 20 ? 1.0 : -1.0, n.Y(), 1e-12);
+    }
+  }
+
+  // Translations and scales give the same result as the dedicated calls
+  common::SubMesh copy(*box->SubMeshByIndex(0).lock());
+  common::SubMesh expected(copy);
+  copy.Transform(gz::math::Matrix4d(
+      3, 0, 0, 1,
+      0, 0.5, 0, 2,
+      0, 0, -1, 3,
+      0, 0, 0, 1));
+  expected.Scale(gz::math::Vector3d(3, 0.5, -1));
+  expected.Translate(gz::math::Vector3d(1, 2, 3));
+  ASSERT_EQ(expected.VertexCount(), copy.VertexCount());
+  for (unsigned int i = 0; i < copy.VertexCount(); ++i)
+    EXPECT_EQ(expected.Vertex(i), copy.Vertex(i));
+  EXPECT_EQ(expected.Min(), copy.Min());
+  EXPECT_DOUBLE_EQ(expected.Volume(), copy.Volume());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, TransformSingular)
+{
+  common::MeshManager::Instance()->CreateBox("transform_singular_box",
+      gz::math::Vector3d(1, 1, 1), gz::math::Vector2d::One);
+  const common::Mesh *box =
+    common::MeshManager::Instance()->MeshByName("transform_singular_box");
+  ASSERT_NE(nullptr, box);
+  const common::SubMesh source(*box->SubMeshByIndex(0).lock());
+
+  // Flattening along Z keeps the normals of the top and bottom faces, the
+  // side faces become edges without a normal direction
+  common::SubMesh flat(source);
+  flat.Transform(gz::math::Matrix4d(
+      2, 0, 0, 0,
+      0, 2, 0, 0,
+      0, 0, 0, 0,
+      0, 0, 0, 1));
+  EXPECT_DOUBLE_EQ(0.0, flat.Max().Z());
+  for (unsigned int i = 0; i < flat.NormalCount(); ++i)
+  {
+    const gz::math::Vector3d n = flat.Normal(i);
+    EXPECT_TRUE(std::isfinite(n.X()) && std::isfinite(n.Y()) &&
+        std::isfinite(n.Z())) << i;
+    if (std::abs(source.Normal(i).Z()) > 0.5)
+      EXPECT_EQ(source.Normal(i), n);
+    else
+      EXPECT_EQ(gz::math::Vector3d::Zero, n);
+  }
+
+  // A zero scale leaves the normals as they are
+  common::SubMesh zero(source);
+  zero.Transform(gz::math::Matrix4d(
+      0, 0, 0, 1,
+      0, 0, 0, 2,
+      0, 0, 0, 3,
+      0, 0, 0, 1));
+  EXPECT_EQ(gz::math::Vector3d(1, 2, 3), zero.Min());
+  EXPECT_EQ(gz::math::Vector3d(1, 2, 3), zero.Max());
+  ASSERT_EQ(source.NormalCount(), zero.NormalCount());
+  for (unsigned int i = 0; i < zero.NormalCount(); ++i)
+    EXPECT_EQ(source.Normal(i), zero.Normal(i));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, BulkAdd)
+{
+  // Positions, normals and texture coordinates interleaved like the
+  // vectors of a model loader
+  const float data[] = {
+      0.0f, 0.0f, 0.0f, 0.5f,
+      1.0f, 0.0f, 0.0f, 0.5f,
+      0.0f, 1.5f, 0.0f, 0.5f,
+      0.0f, 0.0f, -2.0f, 0.5f};
+
+  common::SubMesh submesh;
+  submesh.AddVertex(gz::math::Vector3d(-1, -1, -1));
+  EXPECT_EQ(gz::math::Vector3d(-1, -1, -1), submesh.Max());
+  submesh.AddVertices(data, 4u, 4u);
+  ASSERT_EQ(5u, submesh.VertexCount());
+  EXPECT_EQ(gz::math::Vector3d(0, 1.5, 0), submesh.Vertex(3u));
+  EXPECT_EQ(gz::math::Vector3d(0, 0, -2), submesh.Vertex(4u));
+  EXPECT_EQ(gz::math::Vector3d(1, 1.5, 0), submesh.Max());
+  EXPECT_EQ(gz::math::Vector3d(-1, -1, -2), submesh.Min());
+
+  submesh.AddNormals(data + 4, 3u);
+  ASSERT_EQ(3u, submesh.NormalCount());
+  EXPECT_EQ(gz::math::Vector3d(0.5, 0, 1.5), submesh.Normal(1u));
+
+  submesh.AddTexCoordsBySet(data + 1, 3u, 1u, 4u);
+  EXPECT_EQ(0u, submesh.TexCoordCountBySet(0u));
+  ASSERT_EQ(3u, submesh.TexCoordCountBySet(1u));
+  EXPECT_EQ(gz::math::Vector2d(1.5, 0), submesh.TexCoordBySet(2u, 1u));
+
+  // Indices stay 16 bits until one does not fit, restarts are kept
+  const unsigned int indices[] = {0u, 1u, 2u,
+      common::SubMesh::PrimitiveRestartIndex, 2u, 3u, 4u};
+  submesh.SetPrimitiveType(common::SubMesh::TRISTRIPS);
+  submesh.AddIndices(indices, 7u);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT16, submesh.IndexBufferFormat());
+  EXPECT_TRUE(submesh.HasPrimitiveRestart());
+  ASSERT_EQ(7u, submesh.IndexCount());
+  EXPECT_EQ(4, submesh.Index(6u));
+  EXPECT_TRUE(submesh.HasValidIndices());
+
+  const unsigned int wide[] = {70000u, 1u};
+  submesh.AddIndices(wide, 2u);
+  EXPECT_EQ(common::SubMesh::IndexFormat::UINT32, submesh.IndexBufferFormat());
+  ASSERT_EQ(9u, submesh.IndexCount());
+  EXPECT_EQ(2, submesh.Index(4u));
+  EXPECT_EQ(70000, submesh.Index(7u));
+  EXPECT_EQ(common::SubMesh::PrimitiveRestartIndex,
+      submesh.Indices()[3u]);
+  submesh.AddIndices(nullptr, 0u);
+  EXPECT_EQ(9u, submesh.IndexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, BulkAddDouble)
+{
+  // Double precision values are copied without rounding
+  const double data[] = {
+      0.1, 0.2, 0.3, 7.0,
+      -1e-300, 1e300, 0.5, 7.0};
+
+  common::SubMesh submesh;
+  submesh.AddVertices(data, 2u, 4u);
+  ASSERT_EQ(2u, submesh.VertexCount());
+  EXPECT_EQ(gz::math::Vector3d(0.1, 0.2, 0.3), submesh.Vertex(0u));
+  EXPECT_EQ(gz::math::Vector3d(-1e-300, 1e300, 0.5), submesh.Vertex(1u));
+  EXPECT_EQ(gz::math::Vector3d(0.1, 1e300, 0.5), submesh.Max());
+  EXPECT_EQ(gz::math::Vector3d(-1e-300, 0.2, 0.3), submesh.Min());
+
+  submesh.AddNormals(data, 2u);
+  ASSERT_EQ(2u, submesh.NormalCount());
+  EXPECT_EQ(gz::math::Vector3d(7.0, -1e-300, 1e300), submesh.Normal(1u));
+
+  submesh.AddTexCoordsBySet(data + 1, 2u, 0u, 4u);
+  ASSERT_EQ(2u, submesh.TexCoordCountBySet(0u));
+  EXPECT_EQ(gz::math::Vector2d(1e300, 0.5), submesh.TexCoordBySet(1u, 0u));
+
+  submesh.AddVertices(static_cast<const double *>(nullptr), 0u);
+  EXPECT_EQ(2u, submesh.VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, MemorySize)
+{
+  common::SubMesh submesh;
+  EXPECT_EQ(0u, submesh.MemorySize());
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    submesh.AddVertex(gz::math::Vector3d(i, 0, 0));
+    submesh.AddNormal(gz::math::Vector3d::UnitZ);
+    submesh.AddTexCoord(gz::math::Vector2d(i, 0));
+    submesh.AddIndex(i);
+  }
+  const std::size_t expected =
+      6 * sizeof(gz::math::Vector3d) + 3 * sizeof(gz::math::Vector2d) +
+      submesh.Indices().ByteSize();
+  EXPECT_EQ(expected, submesh.MemorySize());
+
+  submesh.AddNodeAssignment(0, 0, 1.0f);
+  EXPECT_EQ(expected + sizeof(common::NodeAssignment), submesh.MemorySize());
+
+  common::Mesh mesh;
+  mesh.AddSubMesh(submesh);
+  mesh.AddSubMesh(submesh);
+  EXPECT_EQ(2 * submesh.MemorySize(), mesh.MemorySize());
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gz/math/Color.hh>
+
+#include "gz/common/Image.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+// The pixel conversions and statistics use the instruction set of the mesh
+// kernels. Set GZ_MESH_SIMD to scalar, sse2 or avx2 to compare them.
+
+using namespace gz;
+
+/// \brief Create an image of the size given by the benchmark arguments
+/// \param[in] _st Benchmark state, holding the width and height
+/// \param[in] _format RGB_INT8, RGBA_INT8, BGR_INT8, BGRA_INT8 or L_INT8
+/// \param[out] _data Pixels of the image
+/// \return The image
+common::Image MakeImage(const benchmark::State &_st,
+    common::Image::PixelFormatType _format, std::vector<unsigned char> &_data)
+{
+  const auto width = static_cast<unsigned int>(_st.range(0));
+  const auto height = static_cast<unsigned int>(_st.range(1));
+  unsigned int channels = 1u;
+  if (_format == common::Image::RGB_INT8 ||
+      _format == common::Image::BGR_INT8)
+  {
+    channels = 3u;
+  }
+  else if (_format == common::Image::RGBA_INT8 ||
+      _format == common::Image::BGRA_INT8)
+  {
+    channels = 4u;
+  }
+
+  _data.resize(static_cast<std::size_t>(width) * height * channels);
+  for (std::size_t i = 0; i < _data.size(); ++i)
+    _data[i] = static_cast<unsigned char>((i * 31u) ^ (i >> 7));
+
+  common::Image image;
+  image.SetFromData(_data.data(), width, height, _format);
+  return image;
+}
+
+/// \brief Convert an image to RGBA with RGBAData
+/// \param[in] _format Pixel format of the image
+void BM_RGBAData(benchmark::State &_st,
+    common::Image::PixelFormatType _format)
+{
+  std::vector<unsigned char> data;
+  common::Image image = MakeImage(_st, _format, data);
+  for (auto _ : _st)
+    benchmark::DoNotOptimize(image.RGBAData());
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0) * _st.range(1));
+}
+
+/// \brief Convert an image to RGB with RGBData
+/// \param[in] _format Pixel format of the image
+void BM_RGBData(benchmark::State &_st,
+    common::Image::PixelFormatType _format)
+{
+  std::vector<unsigned char> data;
+  common::Image image = MakeImage(_st, _format, data);
+  for (auto _ : _st)
+    benchmark::DoNotOptimize(image.RGBData());
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0) * _st.range(1));
+}
+
+/// \brief Copy the green channel of an image with ChannelData
+/// \param[in] _format Pixel format of the image
+void BM_ChannelData(benchmark::State &_st,
+    common::Image::PixelFormatType _format)
+{
+  std::vector<unsigned char> data;
+  common::Image image = MakeImage(_st, _format, data);
+  for (auto _ : _st)
+    benchmark::DoNotOptimize(image.ChannelData(common::Image::Channel::GREEN));
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0) * _st.range(1));
+}
+
+/// \brief Set an image from BGR or BGRA pixels, which swaps red and blue
+/// \param[in] _format BGR_INT8 or BGRA_INT8
+void BM_SetFromData(benchmark::State &_st,
+    common::Image::PixelFormatType _format)
+{
+  std::vector<unsigned char> data;
+  common::Image image = MakeImage(_st, _format, data);
+  const auto width = static_cast<unsigned int>(_st.range(0));
+  const auto height = static_cast<unsigned int>(_st.range(1));
+  for (auto _ : _st)
+    image.SetFromData(data.data(), width, height, _format);
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0) * _st.range(1));
+}
+
+/// \brief Convert and extract the channels of a 16 bit image file
+/// \param[in] _file Image file in the test data directory
+void BM_Image16(benchmark::State &_st, const std::string &_file)
+{
+  common::Image image(common::testing::TestFile("data", _file));
+  for (auto _ : _st)
+  {
+    benchmark::DoNotOptimize(image.RGBAData());
+    benchmark::DoNotOptimize(image.ChannelData(common::Image::Channel::RED));
+  }
+  _st.SetItemsProcessed(_st.iterations() * image.Width() * image.Height());
+}
+
+/// \brief Register a benchmark for VGA, full HD and 4K images
+/// \param[in] _bm The benchmark
+void ImageSizes(benchmark::internal::Benchmark *_bm)
+{
+  _bm->Args({640, 480})
+     ->Args({1920, 1080})
+     ->Args({3840, 2160})
+     ->Unit(benchmark::kMicrosecond);
+}
+
+/// \brief Compute a statistic of an image, reading every pixel or a
+/// subset of them
+/// \param[in] _format Pixel format of the image
+/// \param[in] _func Statistic to compute, called with the image and the
+/// stride given by the third benchmark argument
+template <typename Func>
+void BM_Statistics(benchmark::State &_st,
+    common::Image::PixelFormatType _format, Func _func)
+{
+  std::vector<unsigned char> data;
+  common::Image image = MakeImage(_st, _format, data);
+  const auto stride = static_cast<unsigned int>(_st.range(2));
+  for (auto _ : _st)
+    benchmark::DoNotOptimize(_func(image, stride));
+  _st.SetItemsProcessed(_st.iterations() * _st.range(0) * _st.range(1));
+}
+
+/// \brief Average color
+/// \param[in] _image The image
+/// \param[in] _stride Distance between two read pixels
+/// \return The average color
+math::Color AvgColor(const common::Image &_image, unsigned int _stride)
+{
+  return _image.AvgColor(_stride);
+}
+
+/// \brief Max color
+/// \param[in] _image The image
+/// \param[in] _stride Distance between two read pixels
+/// \return The max color
+math::Color MaxColor(const common::Image &_image, unsigned int _stride)
+{
+  return _image.MaxColor(_stride);
+}
+
+/// \brief Histogram of the green channel
+/// \param[in] _image The image
+/// \param[in] _stride Distance between two read pixels
+/// \return The histogram
+std::vector<std::size_t> Histogram(const common::Image &_image,
+    unsigned int _stride)
+{
+  return _image.Histogram(common::Image::Channel::GREEN, 256u, _stride);
+}
+
+/// \brief Register a statistics benchmark for full HD and 4K images,
+/// reading every pixel, and for a 4K preview reading one pixel in 16
+/// \param[in] _bm The benchmark
+void StatisticsSizes(benchmark::internal::Benchmark *_bm)
+{
+  _bm->Args({1920, 1080, 1})
+     ->Args({3840, 2160, 1})
+     ->Args({3840, 2160, 4})
+     ->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_CAPTURE(BM_RGBAData, L8, common::Image::L_INT8)->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_RGBAData, RGB8, common::Image::RGB_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_RGBData, L8, common::Image::L_INT8)->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_RGBData, RGBA8, common::Image::RGBA_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_ChannelData, RGB8, common::Image::RGB_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_ChannelData, RGBA8, common::Image::RGBA_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_SetFromData, BGR8, common::Image::BGR_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_SetFromData, BGRA8, common::Image::BGRA_INT8)
+    ->Apply(ImageSizes);
+BENCHMARK_CAPTURE(BM_Statistics, AvgColor_RGB8, common::Image::RGB_INT8,
+    AvgColor)->Apply(StatisticsSizes);
+BENCHMARK_CAPTURE(BM_Statistics, AvgColor_RGBA8, common::Image::RGBA_INT8,
+    AvgColor)->Apply(StatisticsSizes);
+BENCHMARK_CAPTURE(BM_Statistics, MaxColor_RGB8, common::Image::RGB_INT8,
+    MaxColor)->Apply(StatisticsSizes);
+BENCHMARK_CAPTURE(BM_Statistics, MaxColor_RGBA8, common::Image::RGBA_INT8,
+    MaxColor)->Apply(StatisticsSizes);
+BENCHMARK_CAPTURE(BM_Statistics, Histogram_RGB8, common::Image::RGB_INT8,
+    Histogram)->Apply(StatisticsSizes);
+BENCHMARK_CAPTURE(BM_Image16, rgb_16bit, "rgb_16bit.png")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Image16, rgba_16bit, "rgba_16bit.png")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
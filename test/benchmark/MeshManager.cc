@@ -18,10 +18,25 @@
 #include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gz/common/testing/TestPaths.hh"
+#include "gz/common/AssimpLoader.hh"
 #include "gz/common/ColladaLoader.hh"
+#include "gz/common/Filesystem.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/MeshManager.hh"
+#include "gz/common/OBJLoader.hh"
+#include "gz/common/SubMesh.hh"
+#include "gz/common/TempDirectory.hh"
 #include "gz/common/testing/AutoLogFixture.hh"
 
 using namespace gz;
@@ -84,4 +99,514 @@ BENCHMARK_CAPTURE(BM_MeshManager, PurpleCube_gltf, "gltf/PurpleCube.gltf")
     ->Arg(1)
     ->Unit(benchmark::kMillisecond);
 
+/// \brief Load a mesh with the binary mesh cache enabled
+/// \param[in] _meshFile Mesh file in the test data directory
+/// \param[in] _warm If true, the cache holds the mesh before every load
+/// (warm start). Otherwise the cache is emptied before every load, which
+/// measures parsing the file and writing the cache (cold start).
+void BM_MeshManagerCache(benchmark::State &_st, const std::string &_meshFile,
+    bool _warm)
+{
+  auto *mgr = common::MeshManager::Instance();
+  common::TempDirectory temp("mesh_cache_benchmark", "gz_common", true);
+  const std::string dir = common::joinPaths(temp.Path(), "cache");
+  const std::string path = common::testing::TestFile("data", _meshFile);
+  mgr->SetCacheDirectory(dir);
+  if (_warm)
+  {
+    mgr->Load(path);
+    mgr->RemoveAll();
+  }
+
+  for (auto _ : _st)
+  {
+    benchmark::DoNotOptimize(mgr->Load(path));
+
+    _st.PauseTiming();
+    mgr->RemoveAll();
+    if (!_warm)
+      std::filesystem::remove_all(dir);
+    _st.ResumeTiming();
+  }
+  mgr->SetCacheDirectory("");
+}
+
+// Compare with BM_MeshManager, which loads without a cache
+BENCHMARK_CAPTURE(BM_MeshManagerCache, cordless_drill_dae_cold,
+    "cordless_drill/meshes/cordless_drill.dae", false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerCache, cordless_drill_dae_warm,
+    "cordless_drill/meshes/cordless_drill.dae", true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerCache, fully_featured_glb_cold,
+    "fully_featured.glb", false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerCache, fully_featured_glb_warm,
+    "fully_featured.glb", true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerCache, box_obj_cold, "box.obj", false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerCache, box_obj_warm, "box.obj", true)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Write a COLLADA file holding a triangulated grid
+/// \param[in] _path Path of the file
+/// \param[in] _side Number of vertices along each side of the grid
+void WriteGridDae(const std::string &_path, int64_t _side)
+{
+  std::ofstream out(_path);
+  const int64_t vertexCount = _side * _side;
+  const int64_t triangleCount = 2 * (_side - 1) * (_side - 1);
+  out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+      << "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" "
+      << "version=\"1.4.1\">\n"
+      << "<asset><unit name=\"meter\" meter=\"1\"/>"
+      << "<up_axis>Z_UP</up_axis></asset>\n"
+      << "<library_geometries><geometry id=\"grid\"><mesh>\n"
+      << "<source id=\"grid-positions\">"
+      << "<float_array id=\"grid-positions-array\" count=\""
+      << 3 * vertexCount << "\">";
+  out.precision(9);
+  for (int64_t y = 0; y < _side; ++y)
+  {
+    for (int64_t x = 0; x < _side; ++x)
+    {
+      out << 0.01 * x << ' ' << 0.01 * y << ' '
+          << 0.001 * ((x * 7 + y * 13) % 101) << '\n';
+    }
+  }
+  out << "</float_array><technique_common>"
+      << "<accessor source=\"#grid-positions-array\" count=\""
+      << vertexCount << "\" stride=\"3\">"
+      << "<param name=\"X\" type=\"float\"/>"
+      << "<param name=\"Y\" type=\"float\"/>"
+      << "<param name=\"Z\" type=\"float\"/>"
+      << "</accessor></technique_common></source>\n"
+      << "<vertices id=\"grid-vertices\">"
+      << "<input semantic=\"POSITION\" source=\"#grid-positions\"/>"
+      << "</vertices>\n"
+      << "<triangles count=\"" << triangleCount << "\">"
+      << "<input semantic=\"VERTEX\" source=\"#grid-vertices\" "
+      << "offset=\"0\"/><p>";
+  for (int64_t y = 0; y + 1 < _side; ++y)
+  {
+    for (int64_t x = 0; x + 1 < _side; ++x)
+    {
+      const int64_t i = y * _side + x;
+      out << i << ' ' << i + 1 << ' ' << i + _side << ' '
+          << i + 1 << ' ' << i + _side + 1 << ' ' << i + _side << '\n';
+    }
+  }
+  out << "</p></triangles></mesh></geometry></library_geometries>\n"
+      << "<library_visual_scenes><visual_scene id=\"scene\">"
+      << "<node id=\"node\"><instance_geometry url=\"#grid\"/></node>"
+      << "</visual_scene></library_visual_scenes>\n"
+      << "<scene><instance_visual_scene url=\"#scene\"/></scene>\n"
+      << "</COLLADA>\n";
+}
+
+/// \brief Load a large generated COLLADA file, which is dominated by
+/// parsing the <float_array> and <p> elements
+/// \param[in] _st Benchmark state, with the number of vertices along each
+/// side of the grid as argument
+void BM_ColladaLoaderLarge(benchmark::State &_st)
+{
+  common::TempDirectory temp("collada_benchmark", "gz_common", true);
+  const std::string path = common::joinPaths(temp.Path(), "grid.dae");
+  WriteGridDae(path, _st.range(0));
+  const auto size = std::filesystem::file_size(path);
+
+  for (auto _ : _st)
+  {
+    common::ColladaLoader loader;
+    std::unique_ptr<common::Mesh> mesh(loader.Load(path));
+    benchmark::DoNotOptimize(mesh.get());
+  }
+  _st.SetBytesProcessed(_st.iterations() * static_cast<int64_t>(size));
+}
+
+// 10k, 250k and 1M vertices, up to about 50 MB of text
+BENCHMARK(BM_ColladaLoaderLarge)
+    ->Arg(100)->Arg(500)->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Write an OBJ file of a square grid, with a texture coordinate and
+/// a normal per vertex and a quad per cell
+/// \param[in] _path Path of the file
+/// \param[in] _side Number of vertices along each side of the grid
+void WriteGridObj(const std::string &_path, int64_t _side)
+{
+  std::ofstream out(_path);
+  out << "o grid\n";
+  out.precision(9);
+  for (int64_t y = 0; y < _side; ++y)
+  {
+    for (int64_t x = 0; x < _side; ++x)
+    {
+      out << "v " << 0.01 * x << ' ' << 0.01 * y << ' '
+          << 0.001 * ((x * 7 + y * 13) % 101) << '\n';
+    }
+  }
+  for (int64_t y = 0; y < _side; ++y)
+  {
+    for (int64_t x = 0; x < _side; ++x)
+    {
+      out << "vt " << static_cast<double>(x) / _side << ' '
+          << static_cast<double>(y) / _side << '\n';
+    }
+  }
+  out << "vn 0 0 1\n";
+  for (int64_t y = 0; y + 1 < _side; ++y)
+  {
+    for (int64_t x = 0; x + 1 < _side; ++x)
+    {
+      const int64_t i = y * _side + x + 1;
+      out << "f " << i << '/' << i << "/1 "
+          << i + 1 << '/' << i + 1 << "/1 "
+          << i + _side + 1 << '/' << i + _side + 1 << "/1 "
+          << i + _side << '/' << i + _side << "/1\n";
+    }
+  }
+}
+
+/// \brief Load a large generated OBJ file. The bytes processed counter
+/// gives the parse throughput.
+/// \param[in] _st Benchmark state, with the number of vertices along each
+/// side of the grid as argument
+/// \param[in] _parallel True to use the parallel parser, false for
+/// tinyobjloader
+void BM_OBJLoaderLarge(benchmark::State &_st, bool _parallel)
+{
+  common::TempDirectory temp("obj_benchmark", "gz_common", true);
+  const std::string path = common::joinPaths(temp.Path(), "grid.obj");
+  WriteGridObj(path, _st.range(0));
+  const auto size = std::filesystem::file_size(path);
+
+  for (auto _ : _st)
+  {
+    common::OBJLoader loader;
+    loader.SetParallelParsing(_parallel);
+    std::unique_ptr<common::Mesh> mesh(loader.Load(path));
+    benchmark::DoNotOptimize(mesh.get());
+  }
+  _st.SetBytesProcessed(_st.iterations() * static_cast<int64_t>(size));
+}
+
+// 10k, 250k and 1M vertices, up to about 110 MB of text
+BENCHMARK_CAPTURE(BM_OBJLoaderLarge, tinyobjloader, false)
+    ->Arg(100)->Arg(500)->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OBJLoaderLarge, parallel, true)
+    ->Arg(100)->Arg(500)->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Load a mesh with or without decoding its textures
+/// \param[in] _st Benchmark state
+/// \param[in] _meshFile Mesh file, relative to test/data
+/// \param[in] _decode True to decode the textures, false to skip them
+void BM_MeshManagerTextures(benchmark::State &_st,
+    const std::string &_meshFile, bool _decode)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const std::string path = common::testing::TestFile("data", _meshFile);
+  mgr->SetTextureDecoding(_decode);
+
+  for (auto _ : _st)
+  {
+    benchmark::DoNotOptimize(mgr->Load(path));
+
+    _st.PauseTiming();
+    mgr->RemoveAll();
+    _st.ResumeTiming();
+  }
+  mgr->SetTextureDecoding(true);
+}
+
+// The difference between the two runs is the time spent decoding textures
+BENCHMARK_CAPTURE(BM_MeshManagerTextures, fully_featured_glb_decode,
+    "fully_featured.glb", true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerTextures, fully_featured_glb_skip,
+    "fully_featured.glb", false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerTextures, box_texture_jpg_glb_decode,
+    "box_texture_jpg.glb", true)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerTextures, box_texture_jpg_glb_skip,
+    "box_texture_jpg.glb", false)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Load a mesh with a set of assimp post-processing passes, reporting
+/// the average time of every pass as a counter in milliseconds
+/// \param[in] _st Benchmark state
+/// \param[in] _meshFile Mesh file, relative to test/data
+/// \param[in] _profile Set of passes
+void BM_AssimpLoaderProfiles(benchmark::State &_st,
+    const std::string &_meshFile, common::AssimpPostProcess _profile)
+{
+  common::AssimpLoader loader;
+  loader.SetPostProcessProfile(_profile);
+  loader.SetPostProcessTiming(true);
+  const std::string path = common::testing::TestFile("data", _meshFile);
+
+  std::map<std::string, double> passTimes;
+  for (auto _ : _st)
+  {
+    std::unique_ptr<common::Mesh> mesh(loader.Load(path));
+    benchmark::DoNotOptimize(mesh);
+
+    _st.PauseTiming();
+    for (const auto &[name, time] : loader.PostProcessTimes())
+    {
+      passTimes[name] +=
+          std::chrono::duration<double, std::milli>(time).count();
+    }
+    mesh.reset();
+    _st.ResumeTiming();
+  }
+  for (const auto &[name, time] : passTimes)
+  {
+    _st.counters[name] =
+        benchmark::Counter(time, benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, cordless_drill_dae_fast,
+    "cordless_drill/meshes/cordless_drill.dae",
+    common::AssimpPostProcess::FAST)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, cordless_drill_dae_default,
+    "cordless_drill/meshes/cordless_drill.dae",
+    common::AssimpPostProcess::DEFAULT)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, cordless_drill_dae_optimize,
+    "cordless_drill/meshes/cordless_drill.dae",
+    common::AssimpPostProcess::OPTIMIZE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, fully_featured_glb_fast,
+    "fully_featured.glb", common::AssimpPostProcess::FAST)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, fully_featured_glb_default,
+    "fully_featured.glb", common::AssimpPostProcess::DEFAULT)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AssimpLoaderProfiles, fully_featured_glb_optimize,
+    "fully_featured.glb", common::AssimpPostProcess::OPTIMIZE)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Create 10k primitives of mixed types
+/// \param[in] _batch True to create the primitives with CreateBatch,
+/// false to create them one after the other on the calling thread
+void BM_MeshManagerPrimitives(benchmark::State &_st, bool _batch)
+{
+  auto *mgr = common::MeshManager::Instance();
+  const int count = 10000;
+
+  std::vector<std::function<void()>> creators;
+  creators.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    const std::string name = "primitive_" + std::to_string(i);
+    const float size = 1.0f + 0.01f * static_cast<float>(i % 16);
+    switch (i % 5)
+    {
+      case 0:
+        creators.push_back([=]() { mgr->CreateSphere(name, size, 32, 32); });
+        break;
+      case 1:
+        creators.push_back([=]()
+            { mgr->CreateBox(name, math::Vector3d(size, 1, 1),
+                             math::Vector2d(1, 1)); });
+        break;
+      case 2:
+        creators.push_back([=]()
+            { mgr->CreateCylinder(name, size, 2.0f, 1, 32); });
+        break;
+      case 3:
+        creators.push_back([=]()
+            { mgr->CreateCapsule(name, size, 2.0, 16, 32); });
+        break;
+      default:
+        creators.push_back([=]() { mgr->CreateCone(name, size, 2.0f, 1, 32); });
+        break;
+    }
+  }
+
+  for (auto _ : _st)
+  {
+    if (_batch)
+    {
+      mgr->CreateBatch(creators);
+    }
+    else
+    {
+      for (const auto &creator : creators)
+        creator();
+    }
+
+    _st.PauseTiming();
+    mgr->RemoveAll();
+    _st.ResumeTiming();
+  }
+  _st.SetItemsProcessed(_st.iterations() * count);
+}
+
+BENCHMARK_CAPTURE(BM_MeshManagerPrimitives, serial, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MeshManagerPrimitives, batch, true)
+    ->Unit(benchmark::kMillisecond);
+
+/// \brief Create a triangulated grid with at least _vertexCount vertices
+/// \param[in] _vertexCount Number of vertices
+/// \return The grid, with vertex 0 on its minimum corner
+common::SubMesh GridSubMesh(int64_t _vertexCount)
+{
+  const auto side = static_cast<unsigned int>(
+      std::ceil(std::sqrt(static_cast<double>(_vertexCount))));
+  common::SubMesh subMesh;
+  subMesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (unsigned int y = 0; y < side; ++y)
+  {
+    for (unsigned int x = 0; x < side; ++x)
+      subMesh.AddVertex(x, y, 0.001 * ((x * 7 + y * 13) % 101));
+  }
+  for (unsigned int y = 0; y + 1 < side; ++y)
+  {
+    for (unsigned int x = 0; x + 1 < side; ++x)
+    {
+      const unsigned int i = y * side + x;
+      subMesh.AddIndex(i);
+      subMesh.AddIndex(i + 1);
+      subMesh.AddIndex(i + side);
+      subMesh.AddIndex(i + 1);
+      subMesh.AddIndex(i + side + 1);
+      subMesh.AddIndex(i + side);
+    }
+  }
+  return subMesh;
+}
+
+// The SubMesh benchmarks use the best instruction set of the CPU. Set
+// GZ_MESH_SIMD to scalar, sse2 or avx2 to compare them.
+void BM_SubMeshTranslate(benchmark::State &_st)
+{
+  common::SubMesh subMesh = GridSubMesh(_st.range(0));
+  for (auto _ : _st)
+    subMesh.Translate(math::Vector3d(0.5, -0.5, 0.25));
+  _st.SetItemsProcessed(_st.iterations() * subMesh.VertexCount());
+}
+
+void BM_SubMeshScale(benchmark::State &_st)
+{
+  common::SubMesh subMesh = GridSubMesh(_st.range(0));
+  for (auto _ : _st)
+    subMesh.Scale(math::Vector3d(1.0, -1.0, 1.0));
+  _st.SetItemsProcessed(_st.iterations() * subMesh.VertexCount());
+}
+
+void BM_SubMeshTransform(benchmark::State &_st)
+{
+  common::SubMesh subMesh = GridSubMesh(_st.range(0));
+  const math::Matrix4d rotation(
+      0, -1, 0, 1,
+      1, 0, 0, 2,
+      0, 0, 1, 3,
+      0, 0, 0, 1);
+  for (auto _ : _st)
+    subMesh.Transform(rotation);
+  _st.SetItemsProcessed(_st.iterations() * subMesh.VertexCount());
+}
+
+void BM_SubMeshBounds(benchmark::State &_st)
+{
+  common::SubMesh subMesh = GridSubMesh(_st.range(0));
+  const math::Vector3d corner = subMesh.Vertex(0);
+  for (auto _ : _st)
+  {
+    // Rewriting a vertex on the bounds drops the cached bounds
+    subMesh.SetVertex(0, corner);
+    benchmark::DoNotOptimize(subMesh.Min());
+  }
+  _st.SetItemsProcessed(_st.iterations() * subMesh.VertexCount());
+}
+
+void BM_SubMeshVolume(benchmark::State &_st)
+{
+  common::SubMesh subMesh = GridSubMesh(_st.range(0));
+  const math::Vector3d corner = subMesh.Vertex(0);
+  for (auto _ : _st)
+  {
+    subMesh.SetVertex(0, corner);
+    benchmark::DoNotOptimize(subMesh.Volume());
+    benchmark::DoNotOptimize(subMesh.Centroid());
+  }
+  _st.SetItemsProcessed(_st.iterations() * subMesh.IndexCount() / 3);
+}
+
+/// \brief Fill a submesh from interleaved single precision positions,
+/// normals and texture coordinates, like the buffers of a model loader
+/// \param[in] _st Benchmark state, the range is the number of vertices
+/// \param[in] _bulk True to add the arrays in bulk, false to add the
+/// elements one at a time
+void BM_SubMeshAddArrays(benchmark::State &_st, bool _bulk)
+{
+  const std::size_t count = static_cast<std::size_t>(_st.range(0));
+  std::vector<float> positions(3u * count);
+  std::vector<float> normals(3u * count);
+  std::vector<float> texCoords(3u * count);
+  for (std::size_t i = 0u; i < 3u * count; ++i)
+  {
+    positions[i] = static_cast<float>(i);
+    normals[i] = static_cast<float>(i % 3u == 2u);
+    texCoords[i] = static_cast<float>(i) / static_cast<float>(3u * count);
+  }
+
+  for (auto _ : _st)
+  {
+    common::SubMesh subMesh;
+    if (_bulk)
+    {
+      subMesh.AddVertices(positions.data(), count);
+      subMesh.AddNormals(normals.data(), count);
+      subMesh.AddTexCoordsBySet(texCoords.data(), count, 0u, 3u);
+    }
+    else
+    {
+      for (std::size_t i = 0u; i < count; ++i)
+      {
+        const float *p = &positions[3u * i];
+        const float *n = &normals[3u * i];
+        const float *t = &texCoords[3u * i];
+        subMesh.AddVertex(p[0], p[1], p[2]);
+        subMesh.AddNormal(n[0], n[1], n[2]);
+        subMesh.AddTexCoordBySet(t[0], t[1], 0u);
+      }
+    }
+    benchmark::DoNotOptimize(subMesh);
+  }
+  _st.SetItemsProcessed(_st.iterations() * count);
+}
+
+// 1k to 10M vertices
+BENCHMARK(BM_SubMeshTranslate)
+    ->RangeMultiplier(10)->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubMeshScale)
+    ->RangeMultiplier(10)->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubMeshTransform)
+    ->RangeMultiplier(10)->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubMeshBounds)
+    ->RangeMultiplier(10)->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubMeshVolume)
+    ->RangeMultiplier(10)->Range(1000, 10000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SubMeshAddArrays, per_element, false)
+    ->RangeMultiplier(10)->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SubMeshAddArrays, bulk, true)
+    ->RangeMultiplier(10)->Range(1000, 1000000)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
@@ -254,19 +254,29 @@ TEST_F(MeshTest, RoundtripStl)
 /////////////////////////////////////////////////
 TEST_F(MeshTest, Export)
 {
-  std::ofstream stlFile("gz_stl_test.stl", std::ios::out);
+  // The files are written to a temporary directory, which is removed with
+  // everything the exporters wrote
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  const std::string stlPath =
+      common::joinPaths(tempDir->Path(), "gz_stl_test.stl");
+  std::ofstream stlFile(stlPath, std::ios::out);
   stlFile << asciiSTLBox;
   stlFile.close();
 
-  common::systemPaths()->AddFilePaths(common::cwd());
-  auto mesh = common::MeshManager::Instance()->Load("gz_stl_test.stl");
+  auto mesh = common::MeshManager::Instance()->Load(stlPath);
   ASSERT_NE(nullptr, mesh);
 
-  common::MeshManager::Instance()->Export(mesh,
-      common::joinPaths(common::cwd(), "gz_stl_test2"), "stl", false);
-  common::MeshManager::Instance()->Export(mesh,
-      common::joinPaths(common::cwd(), "gz_stl_test2"), "dae", false);
-
-  EXPECT_FALSE(common::exists("gz_stl_test2.stl"));
-  EXPECT_TRUE(common::exists("gz_stl_test2.dae"));
+  const std::string exported =
+      common::joinPaths(tempDir->Path(), "gz_stl_test2");
+  common::MeshManager::Instance()->Export(mesh, exported, "stl", false);
+  common::MeshManager::Instance()->Export(mesh, exported, "dae", false);
+  common::MeshManager::Instance()->Export(mesh, exported, "obj", false);
+  common::MeshManager::Instance()->Export(mesh, exported, "fbx", false);
+
+  EXPECT_TRUE(common::exists(exported + ".stl"));
+  EXPECT_TRUE(common::exists(exported + ".dae"));
+  EXPECT_TRUE(common::exists(exported + ".obj"));
+  EXPECT_FALSE(common::exists(exported + ".fbx"));
 }